@@ -1,10 +1,684 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 //˺ϰдײдĿһأ
-//
-class LRU
+//ɫֽ롢񡢲/PSOҪԤ̭Ļ
+
+/**
+ * @brief LRUͳ
+ */
+struct LRUCacheStats
+{
+	uint64_t Hits = 0;
+	uint64_t Misses = 0;
+	uint64_t Evictions = 0;
+};
+
+/**
+ * @brief LRU棨̣߳
+ * @details Get/Put/EraseΪO(1)ڵʽعڳطĽڵϣΪ̽ĿѰַϣ
+ *          ȶ״̬²ٷڴ档Ԥ̭ÿĿĴСSizeFuncĬÿĿΪ1Ŀ
+ * @note ɿҲƶ߳ʹShardedLRUCache
+ */
+template<typename Key, typename Value, typename Hasher = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class LRUCache
 {
+public:
+	using SizeFunc = std::function<size_t(const Key&, const Value&)>;
+	using EvictFunc = std::function<void(const Key&, Value&)>;
+
+	/**
+	 * @brief 
+	 * @param budget Ԥ㣨λSizeFuncһ£
+	 * @param sizeFunc ĿСΪʱÿĿ1
+	 */
+	explicit LRUCache(size_t budget, SizeFunc sizeFunc = nullptr)
+		: m_budget(budget)
+		, m_sizeFunc(std::move(sizeFunc))
+	{
+		m_head.Prev = &m_head;
+		m_head.Next = &m_head;
+	}
+
+	~LRUCache()
+	{
+		Clear();
+	}
+
+	LRUCache(const LRUCache&) = delete;
+	LRUCache& operator=(const LRUCache&) = delete;
+
+	/**
+	 * @brief ҲΪʹãҲnullptr
+	 * @note صָһPut/Erase/Clear֮ǰЧ
+	 */
+	Value* Get(const Key& key)
+	{
+		size_t slot = FindSlot(key, HashKey(key));
+		if (slot == kNotFound)
+		{
+			++m_stats.Misses;
+			return nullptr;
+		}
+
+		++m_stats.Hits;
+		Node* node = m_buckets[slot].Entry;
+		MoveToFront(node);
+		return &node->Data.second;
+	}
+
+	/**
+	 * @brief Ҳֵ
+	 */
+	bool TryGet(const Key& key, Value& outValue)
+	{
+		Value* value = Get(key);
+		if (!value)
+		{
+			return false;
+		}
+		outValue = *value;
+		return true;
+	}
+
+	/**
+	 * @brief ҵıʹ˳򣬲ͳ
+	 */
+	Value* Peek(const Key& key)
+	{
+		size_t slot = FindSlot(key, HashKey(key));
+		return slot != kNotFound ? &m_buckets[slot].Entry->Data.second : nullptr;
+	}
+
+	/**
+	 * @brief Ƿıʹ˳򣬲ͳƣ
+	 */
+	bool Contains(const Key& key) const
+	{
+		return FindSlot(key, HashKey(key)) != kNotFound;
+	}
+
+	/**
+	 * @brief 滻֮Ԥ̭δʹõĿ
+	 * @return ĿԤʱ棬false
+	 */
+	bool Put(const Key& key, Value value)
+	{
+		size_t size = m_sizeFunc ? m_sizeFunc(key, value) : 1;
+		if (size > m_budget)
+		{
+			Erase(key);
+			return false;
+		}
+
+		size_t hash = HashKey(key);
+		size_t slot = FindSlot(key, hash);
+		if (slot != kNotFound)
+		{
+			Node* node = m_buckets[slot].Entry;
+			m_usage = m_usage - node->Size + size;
+			node->Data.second = std::move(value);
+			node->Size = size;
+			MoveToFront(node);
+		}
+		else
+		{
+			// ٽڵ㣺쳣ʱڵ㻹û䣬ᶪڳ
+			ReserveSlot();
+			Node* node = m_pool.Allocate(key, std::move(value));
+			node->Hash = hash;
+			node->Size = size;
+			InsertSlot(node);
+			LinkFront(node);
+			m_usage += size;
+			++m_count;
+		}
+
+		EvictToBudget();
+		return true;
+	}
+
+	/**
+	 * @brief ɾĿ̭ص
+	 */
+	bool Erase(const Key& key)
+	{
+		size_t slot = FindSlot(key, HashKey(key));
+		if (slot == kNotFound)
+		{
+			return false;
+		}
+
+		Node* node = m_buckets[slot].Entry;
+		EraseSlot(slot);
+		RemoveNode(node);
+		return true;
+	}
+
+	/**
+	 * @brief գ̭صѷĳغ͹ϣ
+	 */
+	void Clear()
+	{
+		ListLink* link = m_head.Next;
+		while (link != &m_head)
+		{
+			ListLink* next = link->Next;
+			m_pool.Free(static_cast<Node*>(link));
+			link = next;
+		}
+
+		m_head.Prev = &m_head;
+		m_head.Next = &m_head;
+		for (Bucket& bucket : m_buckets)
+		{
+			bucket = Bucket();
+		}
+		m_count = 0;
+		m_usage = 0;
+	}
+
+	/**
+	 * @brief ޸Ԥ㣨Сʱ̭
+	 */
+	void SetBudget(size_t budget)
+	{
+		m_budget = budget;
+		EvictToBudget();
+	}
+
+	/**
+	 * @brief ̭صԤ㱻̭ʱãͷGPUԴ
+	 */
+	void SetEvictCallback(EvictFunc onEvict) { m_onEvict = std::move(onEvict); }
+
+	size_t GetBudget() const { return m_budget; }
+	size_t GetUsage() const { return m_usage; }
+	size_t GetCount() const { return m_count; }
+	const LRUCacheStats& GetStats() const { return m_stats; }
+	void ResetStats() { m_stats = LRUCacheStats(); }
+
+	/**
+	 * @brief ñı˳
+	 */
+	template<typename Func>
+	void ForEach(Func func) const
+	{
+		for (const ListLink* link = m_head.Next; link != &m_head; link = link->Next)
+		{
+			const Node* node = static_cast<const Node*>(link);
+			func(node->Data.first, node->Data.second);
+		}
+	}
+
+private:
+	// =======================================================================
+	//                        ڵͽڵ
+	// =======================================================================
+
+	struct ListLink
+	{
+		ListLink* Prev = nullptr;
+		ListLink* Next = nullptr;
+	};
+
+	struct Node : ListLink
+	{
+		template<typename K, typename V>
+		Node(K&& key, V&& value)
+			: Data(std::forward<K>(key), std::forward<V>(value))
+		{
+		}
+
+		std::pair<Key, Value> Data;
+		size_t Hash = 0;
+		size_t Size = 0;
+	};
+
+	/**
+	 * @brief ڵأ䣬ͷŵĽڵڿϸ
+	 */
+	class NodePool
+	{
+	public:
+		NodePool() = default;
+		NodePool(const NodePool&) = delete;
+		NodePool& operator=(const NodePool&) = delete;
+
+		template<typename... Args>
+		Node* Allocate(Args&&... args)
+		{
+			if (!m_freeList)
+			{
+				Grow();
+			}
+
+			Slot* slot = m_freeList;
+			m_freeList = slot->NextFree;
+			try
+			{
+				return new (slot->Storage) Node(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				slot->NextFree = m_freeList;
+				m_freeList = slot;
+				throw;
+			}
+		}
+
+		void Free(Node* node)
+		{
+			node->~Node();
+			Slot* slot = reinterpret_cast<Slot*>(node);
+			slot->NextFree = m_freeList;
+			m_freeList = slot;
+		}
+
+	private:
+		union Slot
+		{
+			Slot* NextFree;
+			alignas(Node) unsigned char Storage[sizeof(Node)];
+		};
+
+		void Grow()
+		{
+			// С16ʼ1024ڵ
+			size_t count = m_blocks.empty() ? 16 : std::min<size_t>(m_lastBlockSize * 2, 1024);
+			m_blocks.push_back(std::make_unique<Slot[]>(count));
+			m_lastBlockSize = count;
+
+			Slot* block = m_blocks.back().get();
+			for (size_t i = 0; i < count; ++i)
+			{
+				block[i].NextFree = m_freeList;
+				m_freeList = &block[i];
+			}
+		}
+
+		std::vector<std::unique_ptr<Slot[]>> m_blocks;
+		Slot* m_freeList = nullptr;
+		size_t m_lastBlockSize = 0;
+	};
+
+
+	// =======================================================================
+	//                        
+	// =======================================================================
+
+	void LinkFront(Node* node)
+	{
+		node->Prev = &m_head;
+		node->Next = m_head.Next;
+		m_head.Next->Prev = node;
+		m_head.Next = node;
+	}
+
+	static void Unlink(Node* node)
+	{
+		node->Prev->Next = node->Next;
+		node->Next->Prev = node->Prev;
+	}
+
+	void MoveToFront(Node* node)
+	{
+		if (m_head.Next != node)
+		{
+			Unlink(node);
+			LinkFront(node);
+		}
+	}
+
+	void RemoveNode(Node* node)
+	{
+		Unlink(node);
+		m_usage -= node->Size;
+		--m_count;
+		m_pool.Free(node);
+	}
 
+	void EvictToBudget()
+	{
+		while (m_usage > m_budget && m_head.Prev != &m_head)
+		{
+			Node* victim = static_cast<Node*>(m_head.Prev);
+			EraseSlot(FindSlot(victim->Data.first, victim->Hash));
+			if (m_onEvict)
+			{
+				m_onEvict(victim->Data.first, victim->Data.second);
+			}
+			RemoveNode(victim);
+			++m_stats.Evictions;
+		}
+	}
 
+
+	// =======================================================================
+	//                        Ѱַ
+	// =======================================================================
+
+	struct Bucket
+	{
+		Node* Entry = nullptr;
+		size_t Hash = 0;
+	};
+
+	static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+	/**
+	 * @brief ɢĹϣ
+	 * @details std::hashһǺӳ䣬ļ̽һƬҺɾҪߺܳ
+	 *          MurmurHash3fmix64һ飬λҲܸλӰ
+	 */
+	size_t HashKey(const Key& key) const
+	{
+		uint64_t hash = static_cast<uint64_t>(m_hasher(key));
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb9fe1a85ec53ull;
+		hash ^= hash >> 33;
+		return static_cast<size_t>(hash);
+	}
+
+	size_t FindSlot(const Key& key, size_t hash) const
+	{
+		if (m_buckets.empty())
+		{
+			return kNotFound;
+		}
+
+		size_t mask = m_buckets.size() - 1;
+		for (size_t i = hash & mask; ; i = (i + 1) & mask)
+		{
+			const Bucket& bucket = m_buckets[i];
+			if (!bucket.Entry)
+			{
+				return kNotFound;
+			}
+			if (bucket.Hash == hash && m_keyEqual(bucket.Entry->Data.first, key))
+			{
+				return i;
+			}
+		}
+	}
+
+	// ֤ٲһĿӲ0.75
+	void ReserveSlot()
+	{
+		if ((m_count + 1) * 4 > m_buckets.size() * 3)
+		{
+			Rehash(m_buckets.empty() ? 16 : m_buckets.size() * 2);
+		}
+	}
+
+	// ǰҪReserveSlotﲻ
+	void InsertSlot(Node* node)
+	{
+		size_t mask = m_buckets.size() - 1;
+		size_t i = node->Hash & mask;
+		while (m_buckets[i].Entry)
+		{
+			i = (i + 1) & mask;
+		}
+		m_buckets[i] = { node, node->Hash };
+	}
+
+	void EraseSlot(size_t slot)
+	{
+		// λɾĹ
+		size_t mask = m_buckets.size() - 1;
+		size_t hole = slot;
+		size_t i = slot;
+		while (true)
+		{
+			i = (i + 1) & mask;
+			if (!m_buckets[i].Entry)
+			{
+				break;
+			}
+
+			// λ(hole, i]֮Ŀƶ
+			size_t home = m_buckets[i].Hash & mask;
+			bool stays = (hole <= i) ? (hole < home && home <= i) : (hole < home || home <= i);
+			if (!stays)
+			{
+				m_buckets[hole] = m_buckets[i];
+				hole = i;
+			}
+		}
+		m_buckets[hole] = Bucket();
+	}
+
+	void Rehash(size_t bucketCount)
+	{
+		// ±ٻʧʱɱԭ
+		std::vector<Bucket> buckets(bucketCount, Bucket());
+
+		size_t mask = bucketCount - 1;
+		for (const Bucket& bucket : m_buckets)
+		{
+			if (bucket.Entry)
+			{
+				size_t i = bucket.Hash & mask;
+				while (buckets[i].Entry)
+				{
+					i = (i + 1) & mask;
+				}
+				buckets[i] = bucket;
+			}
+		}
+		m_buckets.swap(buckets);
+	}
+
+
+	ListLink m_head;                    // ڱNextΪʹãPrevΪδʹ
+	NodePool m_pool;
+	std::vector<Bucket> m_buckets;      // СΪ2
+	size_t m_count = 0;
+	size_t m_usage = 0;
+	size_t m_budget = 0;
+	SizeFunc m_sizeFunc;
+	EvictFunc m_onEvict;
+	Hasher m_hasher;
+	KeyEqual m_keyEqual;
+	LRUCacheStats m_stats;
 };
 
+
+/**
+ * @brief ƬĲLRU
+ * @details ĹϣֵLRUCacheͬƬķʻԤƽָƬ
+ *          ̭ڷƬڰLRUУΪLRU
+ * @note GetֵĿⲻָܳ룩ValueΪshared_ptrС
+ */
+template<typename Key, typename Value, typename Hasher = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class ShardedLRUCache
+{
+public:
+	using Cache = LRUCache<Key, Value, Hasher, KeyEqual>;
+	using SizeFunc = typename Cache::SizeFunc;
+	using EvictFunc = typename Cache::EvictFunc;
+
+	/**
+	 * @brief 
+	 * @param shardCount ƬȡΪ2ݣ
+	 */
+	ShardedLRUCache(size_t budget, size_t shardCount = 16, SizeFunc sizeFunc = nullptr)
+	{
+		if (shardCount == 0)
+		{
+			throw std::invalid_argument("ShardedLRUCache: shard count must be positive");
+		}
+
+		size_t count = 1;
+		while (count < shardCount)
+		{
+			count <<= 1;
+		}
+
+		m_shardMask = count - 1;
+		m_shards = std::make_unique<Shard[]>(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			m_shards[i].Instance = std::make_unique<Cache>(SplitBudget(budget, count, i), sizeFunc);
+		}
+	}
+
+	ShardedLRUCache(const ShardedLRUCache&) = delete;
+	ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+
+	std::optional<Value> Get(const Key& key)
+	{
+		Shard& shard = GetShard(key);
+		std::lock_guard<std::mutex> lock(shard.Mutex);
+		Value* value = shard.Instance->Get(key);
+		return value ? std::optional<Value>(*value) : std::nullopt;
+	}
+
+	bool Put(const Key& key, Value value)
+	{
+		Shard& shard = GetShard(key);
+		std::lock_guard<std::mutex> lock(shard.Mutex);
+		return shard.Instance->Put(key, std::move(value));
+	}
+
+	bool Erase(const Key& key)
+	{
+		Shard& shard = GetShard(key);
+		std::lock_guard<std::mutex> lock(shard.Mutex);
+		return shard.Instance->Erase(key);
+	}
+
+	bool Contains(const Key& key) const
+	{
+		Shard& shard = GetShard(key);
+		std::lock_guard<std::mutex> lock(shard.Mutex);
+		return shard.Instance->Contains(key);
+	}
+
+	/**
+	 * @brief ңҲʱfactory
+	 * @note factoryڷƬִУܺʱɫʱͬһܱΣȲΪ׼
+	 */
+	template<typename Factory>
+	Value GetOrCreate(const Key& key, Factory&& factory)
+	{
+		if (std::optional<Value> cached = Get(key))
+		{
+			return std::move(*cached);
+		}
+
+		Value created = factory(key);
+
+		Shard& shard = GetShard(key);
+		std::lock_guard<std::mutex> lock(shard.Mutex);
+		if (Value* existing = shard.Instance->Peek(key))
+		{
+			return *existing;
+		}
+		shard.Instance->Put(key, created);
+		return created;
+	}
+
+	void Clear()
+	{
+		ForEachShard([](Cache& cache) { cache.Clear(); });
+	}
+
+	/**
+	 * @brief ̭صڳзƬʱãصڲҪʱ棩
+	 */
+	void SetEvictCallback(EvictFunc onEvict)
+	{
+		ForEachShard([&](Cache& cache) { cache.SetEvictCallback(onEvict); });
+	}
+
+	void SetBudget(size_t budget)
+	{
+		size_t count = m_shardMask + 1;
+		for (size_t i = 0; i < count; ++i)
+		{
+			std::lock_guard<std::mutex> lock(m_shards[i].Mutex);
+			m_shards[i].Instance->SetBudget(SplitBudget(budget, count, i));
+		}
+	}
+
+	size_t GetShardCount() const { return m_shardMask + 1; }
+
+	size_t GetCount() const
+	{
+		size_t count = 0;
+		ForEachShard([&](const Cache& cache) { count += cache.GetCount(); });
+		return count;
+	}
+
+	size_t GetUsage() const
+	{
+		size_t usage = 0;
+		ForEachShard([&](const Cache& cache) { usage += cache.GetUsage(); });
+		return usage;
+	}
+
+	LRUCacheStats GetStats() const
+	{
+		LRUCacheStats total;
+		ForEachShard([&](const Cache& cache)
+		{
+			total.Hits += cache.GetStats().Hits;
+			total.Misses += cache.GetStats().Misses;
+			total.Evictions += cache.GetStats().Evictions;
+		});
+		return total;
+	}
+
+private:
+	/**
+	 * @brief ƬռУڷƬα
+	 */
+	struct alignas(64) Shard
+	{
+		mutable std::mutex Mutex;
+		std::unique_ptr<Cache> Instance;
+	};
+
+	static size_t SplitBudget(size_t budget, size_t count, size_t index)
+	{
+		return budget / count + (index < budget % count ? 1 : 0);
+	}
+
+	Shard& GetShard(const Key& key) const
+	{
+		// ùϣĸλѡƬλƬڵĹϣ
+		uint64_t hash = static_cast<uint64_t>(m_hasher(key));
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 33;
+		return m_shards[static_cast<size_t>(hash >> 40) & m_shardMask];
+	}
+
+	template<typename Func>
+	void ForEachShard(Func func) const
+	{
+		for (size_t i = 0; i <= m_shardMask; ++i)
+		{
+			std::lock_guard<std::mutex> lock(m_shards[i].Mutex);
+			func(*m_shards[i].Instance);
+		}
+	}
+
+	std::unique_ptr<Shard[]> m_shards;
+	size_t m_shardMask = 0;
+	Hasher m_hasher;
+};
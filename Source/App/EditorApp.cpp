@@ -1,9 +1,84 @@
 #include "App/EditorApp.h"
+#include "Core/KJUtil.h"
 #include "DX12/DX12Device.h"
+#include "Timer/Profiler.h"
+#include "Renderer/Resources/MeshFile.h"
+#include "Renderer/Resources/MeshOptimizer.h"
+#include "Renderer/Resources/Vertex.h"
+#include "Renderer/Resources/VertexWelder.h"
 #include <commdlg.h>
 #include "imgui_internal.h"  // Ҫ DockBuilder API
+#include <DirectXMath.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 
+namespace
+{
+	//BasicVS.hlslcbufferӦHLSLĬϰϴǰת
+	struct PassConstants
+	{
+		DirectX::XMFLOAT4X4 View;
+		DirectX::XMFLOAT4X4 Proj;
+		DirectX::XMFLOAT4X4 ViewProj;
+		float EyePos;   //ɫһfloatûõ
+		float Pad;
+	};
+
+	struct ObjectConstants
+	{
+		DirectX::XMFLOAT4X4 World;
+		DirectX::XMFLOAT4X4 WorldInvTranspose;
+	};
+
+	//ÿߵ
+	constexpr int kGridHalfLines = 10;
+
+	//ļԷּ棨ÿһֻۣһ㻺壬ﰴ˳򽻴һ
+	//ͬһʱûϲfalse
+	bool InterleaveVertexStreams(const MeshFile& mesh, DynamicVertexData& outVertices, std::string& outError)
+	{
+		VertexLayout layout;
+		uint32_t stride = 0;
+		for (uint32_t stream = 0; stream < mesh.GetVertexStreamCount(); ++stream)
+		{
+			const VertexLayout& streamLayout = mesh.GetVertexStream(stream).GetLayout();
+			for (uint32_t i = 0; i < streamLayout.GetElementCount(); ++i)
+			{
+				const VertexElement& element = streamLayout.GetElement(i);
+				for (uint32_t j = 0; j < layout.GetElementCount(); ++j)
+				{
+					if (layout.GetElement(j).SemanticName == element.SemanticName && layout.GetElement(j).SemanticIndex == element.SemanticIndex)
+					{
+						outError = element.SemanticName + std::to_string(element.SemanticIndex) + " appears in more than one vertex stream";
+						return false;
+					}
+				}
+				layout.AddElement(element.SemanticName, element.Format, stride + element.Offset, element.SemanticIndex);
+			}
+			stride += streamLayout.GetStride();
+		}
+		layout.SetStride(stride);
+
+		outVertices = DynamicVertexData(layout, mesh.GetVertexCount());
+		uint32_t streamOffset = 0;
+		for (uint32_t stream = 0; stream < mesh.GetVertexStreamCount(); ++stream)
+		{
+			const VertexDataView view = mesh.GetVertexStream(stream);
+			const uint32_t streamStride = view.GetStride();
+			for (size_t v = 0; v < view.GetVertexCount(); ++v)
+			{
+				std::memcpy(static_cast<uint8_t*>(outVertices.GetVertexDataPtr(v)) + streamOffset, view.GetVertexDataPtr(v), streamStride);
+			}
+			streamOffset += streamStride;
+		}
+		return true;
+	}
+}
+
 EditorApp::EditorApp(HINSTANCE hInstance): KJApp(hInstance)
 {
 	SetWindowTitle("KJ Editor");
@@ -13,6 +88,9 @@ EditorApp::EditorApp(HINSTANCE hInstance): KJApp(hInstance)
 
 EditorApp::~EditorApp()
 {
+	//GPUԱһȵGPUڷɵ֡
+	GetDevice().WaitForIdle();
+
 	//imgui
 	ShutdownImGui();
 }
@@ -24,6 +102,8 @@ bool EditorApp::Initialize()
 		return false;
 	}
 
+	InitializePipelines();
+
 
 
 	//ʼȷһcubeдobjloader
@@ -32,7 +112,18 @@ bool EditorApp::Initialize()
 	obj.position[0] = 0.0f;
 	obj.position[1] = 0.0f;
 	obj.position[2] = 0.0f;
-	m_sceneObjects.push_back(obj);
+
+	//012λֱʾxyzȡȡɫŽ
+	obj.vertices = DynamicVertexData(VertexLayoutOf<SPositionColorVertex>.ToLayout(), 8);
+	const AttributeView<VertexComponents::Position> positions = obj.vertices.GetAttributeView<VertexComponents::Position>();
+	const AttributeView<VertexComponents::Color> colors = obj.vertices.GetAttributeView<VertexComponents::Color>();
+	for (uint32_t corner = 0; corner < 8; ++corner)
+	{
+		positions.Set(corner, { (corner & 1) ? 0.5f : -0.5f, (corner & 2) ? 0.5f : -0.5f, (corner & 4) ? 0.5f : -0.5f });
+		colors.Set(corner, { (corner & 1) ? 1.0f : 0.2f, (corner & 2) ? 1.0f : 0.2f, (corner & 4) ? 1.0f : 0.2f, 1.0f });
+	}
+	obj.indices = { 0,2,3, 0,3,1, 4,5,7, 4,7,6, 0,1,5, 0,5,4, 2,6,7, 2,7,3, 0,4,6, 0,6,2, 1,3,7, 1,7,5 };
+	m_sceneObjects.push_back(std::move(obj));
 
 
 
@@ -42,7 +133,41 @@ bool EditorApp::Initialize()
 
 void EditorApp::Update(float deltaTime)
 {
-	//
+	PollPendingImport();
+
+	//ػֽ룬ɼĹϣԲˣֽؽPSOڻٱ鵽
+	if (m_scenePipelineDesc.RootSignature != 0 && GetDevice().GetShaderManager().GetGeneration() != m_shaderGeneration)
+	{
+		BuildPipelineKeys();
+	}
+}
+
+void EditorApp::PollPendingImport()
+{
+	if (!m_pendingImport.valid() || m_pendingImport.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return;
+	}
+
+	ObjImportResult imported = m_pendingImport.get();
+	if (imported.Success)
+	{
+		const ObjImportStats& stats = imported.Stats;
+		std::cout << "Imported " << m_pendingImportPath << ": " << stats.VertexCount << " vertices, " << stats.TriangleCount
+			<< " triangles, " << stats.TotalMilliseconds << " ms (" << stats.GetThroughputMBps() << " MB/s, "
+			<< stats.ThreadCount << " threads)" << std::endl;
+
+		SceneObject obj;
+		obj.name = std::filesystem::path(m_pendingImportPath).filename().string();
+		obj.vertices = std::move(imported.Vertices);
+		obj.indices = std::move(imported.Indices);
+		m_sceneObjects.push_back(std::move(obj));
+	}
+	else
+	{
+		std::cerr << "Failed to import OBJ: " << imported.Error << std::endl;
+	}
+	m_pendingImportPath.clear();
 }
 
 void EditorApp::Draw()
@@ -50,7 +175,7 @@ void EditorApp::Draw()
 	auto& device = GetDevice();
 	auto& swapChain = GetSwapChain();
 
-	device.ResetCommandList();
+	device.BeginFrame();
 
 	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = swapChain.GetCurrentRTVHandle(GetRTVHeap());
 	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = GetDepthStencilBuffer().GetDSVHandle(GetDSVHeap(), 0);
@@ -91,7 +216,8 @@ void EditorApp::Draw()
 		ImGuiWindowFlags_NoResize |
 		ImGuiWindowFlags_NoMove |
 		ImGuiWindowFlags_NoBringToFrontOnFocus |
-		ImGuiWindowFlags_NoNavFocus;
+		ImGuiWindowFlags_NoNavFocus |
+		ImGuiWindowFlags_NoBackground;  //Ȼں̨ϣScene View͸
 
 
 	ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0.0f);
@@ -134,6 +260,7 @@ void EditorApp::Draw()
 
 	DrawSceneView();
 	DrawInspectorPanel();
+	DrawFrameStatsPanel();
 
 	//demoĴڣһ
 	if (m_showDemoWindow)
@@ -145,12 +272,14 @@ void EditorApp::Draw()
 
 	ImGui::Render();
 
+	//ImGui棬λõһ֡DrawSceneViewµĴ
+	DrawScene(device.GetCommandList());
 
 	// ȾImGui
 	ImDrawData* drawData = ImGui::GetDrawData();
 	if (drawData)
 	{
-		ID3D12DescriptorHeap* heaps[] = { m_imguiSrvHeap };
+		ID3D12DescriptorHeap* heaps[] = { device.GetShaderVisibleHeap().Get() };
 		device.GetCommandList()->SetDescriptorHeaps(1, heaps);
 		ImGui_ImplDX12_RenderDrawData(drawData, device.GetCommandList());
 	}
@@ -162,7 +291,309 @@ void EditorApp::Draw()
 	device.GetCommandQueue()->ExecuteCommandLists(1, cmdLists);
 
 	swapChain.Present(1, 0);
-	device.GetMainFence().Flush(device.GetCommandQueue());
+	device.EndFrame();
+}
+
+void EditorApp::InitializePipelines()
+{
+	auto& device = GetDevice();
+	ShaderManager& shaders = device.GetShaderManager();
+	DX12PipelineStateCache& pipelines = device.GetPipelineStateCache();
+
+	shaders.RegisterShader("BasicVS", L"BasicVS.hlsl", "VS", "vs_5_1");
+	shaders.RegisterShader("BasicPS", L"BasicPS.hlsl", "PS", "ps_5_1");
+	//ѡеBasicPSSELECTED廭
+	uint64_t selectedMask = 0;
+	if (shaders.RegisterShaderKeywords("BasicPS", { "SELECTED" }) && shaders.GetKeywordMask("BasicPS", { "SELECTED" }, selectedMask))
+	{
+		m_selectedPixelShader = ShaderManager::MakeVariantName("BasicPS", selectedMask);
+	}
+
+	//עһԲмأֽ뻺潨PSOʱͲ߳
+	if (!shaders.PreloadAllShaders())
+	{
+		std::cerr << "Some shaders failed to load, see the debug output" << std::endl;
+	}
+	//岻PreloadAllShadersԤȣ಻ֻѡе岻
+	if (!m_selectedPixelShader.empty() && !shaders.PrewarmShaderVariants({ { "BasicPS", selectedMask } }))
+	{
+		std::cerr << "Failed to compile " << m_selectedPixelShader << ", the selected object won't be highlighted" << std::endl;
+	}
+
+	//b0ÿ֡PassConstantsb1ÿObjectConstantsøCBV
+	D3D12_ROOT_PARAMETER parameters[2] = {};
+	for (UINT i = 0; i < 2; ++i)
+	{
+		parameters[i].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+		parameters[i].Descriptor.ShaderRegister = i;
+		parameters[i].Descriptor.RegisterSpace = 0;
+		parameters[i].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+	}
+	D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
+	rootSignatureDesc.NumParameters = 2;
+	rootSignatureDesc.pParameters = parameters;
+	rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+
+	DX12GraphicsPipelineDesc desc;
+	desc.VertexShader = "BasicVS";
+	desc.PixelShader = "BasicPS";
+	desc.RootSignature = pipelines.CreateRootSignature(rootSignatureDesc);
+	desc.Layout = VertexLayoutRegistry::Get<SPositionColorVertex>();
+	desc.RenderTargetFormats[0] = GetSwapChain().GetFormat();
+	desc.DepthStencilFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
+	//ͳһOBJһʱ룩༭Ȳ޳
+	desc.RenderState.Cull = PipelineCullMode::None;
+
+	//ɫʧܡֶԲ϶ֻûߣ༭
+	if (desc.RootSignature == 0)
+	{
+		std::cerr << "Failed to create the scene root signature" << std::endl;
+		return;
+	}
+	m_scenePipelineDesc = desc;
+	BuildPipelineKeys();
+
+#if defined(DEBUG) || defined(_DEBUG)
+	//԰hlslֱЧUpdate﷢ִ˾ؽ
+	if (!shaders.EnableHotReload())
+	{
+		std::cerr << "Failed to enable shader hot reload" << std::endl;
+	}
+#endif
+}
+
+void EditorApp::BuildPipelineKeys()
+{
+	DX12PipelineStateCache& pipelines = GetDevice().GetPipelineStateCache();
+	//ȼǴȡֽ룬мһ֡ٽһΣ©
+	m_shaderGeneration = GetDevice().GetShaderManager().GetGeneration();
+	m_scenePipelines.clear();
+
+	//õcubeOBJĲں̨
+	for (const VertexLayoutHandle& layout : { VertexLayoutRegistry::Get<SPositionColorVertex>(), VertexLayoutRegistry::Get<SPositionColorNormalTexVertex>() })
+	{
+		const ScenePipeline& scenePipeline = GetScenePipeline(layout);
+		if (scenePipeline.Valid)
+		{
+			pipelines.Prewarm(scenePipeline.Key);
+		}
+		if (scenePipeline.SelectedValid)
+		{
+			pipelines.Prewarm(scenePipeline.SelectedKey);
+		}
+	}
+
+	DX12GraphicsPipelineDesc desc = m_scenePipelineDesc;
+	desc.RenderState.Topology = PipelineTopologyType::Line;
+	m_linePipelineValid = pipelines.BuildKey(desc, m_linePipelineKey);
+	if (m_linePipelineValid)
+	{
+		pipelines.Prewarm(m_linePipelineKey);
+	}
+}
+
+const EditorApp::ScenePipeline& EditorApp::GetScenePipeline(const VertexLayoutHandle& layout)
+{
+	auto it = m_scenePipelines.find(layout);
+	if (it != m_scenePipelines.end())
+	{
+		return it->second;
+	}
+
+	ScenePipeline scenePipeline;
+	if (m_scenePipelineDesc.RootSignature != 0)
+	{
+		DX12GraphicsPipelineDesc desc = m_scenePipelineDesc;
+		desc.Layout = layout;
+		scenePipeline.Valid = GetDevice().GetPipelineStateCache().BuildKey(desc, scenePipeline.Key);
+		if (!scenePipeline.Valid)
+		{
+			std::cerr << "Scene pipeline can't use vertex layout " << std::hex << layout.GetHash() << std::dec
+				<< " (see the debug output for the input layout check)" << std::endl;
+		}
+		else if (!m_selectedPixelShader.empty())
+		{
+			desc.PixelShader = m_selectedPixelShader;
+			scenePipeline.SelectedValid = GetDevice().GetPipelineStateCache().BuildKey(desc, scenePipeline.SelectedKey);
+		}
+	}
+	return m_scenePipelines.emplace(layout, scenePipeline).first->second;
+}
+
+void EditorApp::DrawScene(ID3D12GraphicsCommandList* commandList)
+{
+	if (!m_sceneViewVisible || m_scenePipelineDesc.RootSignature == 0)
+	{
+		return;
+	}
+
+	auto& device = GetDevice();
+	DX12PipelineStateCache& pipelines = device.GetPipelineStateCache();
+	DX12UploadRing& uploadRing = device.GetUploadRing();
+
+	const float x = m_sceneViewRect[0];
+	const float y = m_sceneViewRect[1];
+	const float width = m_sceneViewRect[2];
+	const float height = m_sceneViewRect[3];
+	const D3D12_VIEWPORT viewport = { x, y, width, height, 0.0f, 1.0f };
+	const D3D12_RECT scissor = { static_cast<LONG>(x), static_cast<LONG>(y), static_cast<LONG>(x + width), static_cast<LONG>(y + height) };
+	commandList->RSSetViewports(1, &viewport);
+	commandList->RSSetScissorRects(1, &scissor);
+	commandList->SetGraphicsRootSignature(pipelines.GetRootSignature(m_scenePipelineDesc.RootSignature));
+
+	using namespace DirectX;
+	const XMVECTOR eye = XMVectorSet(
+		m_cameraDistance * std::cos(m_cameraPitch) * std::sin(m_cameraYaw),
+		m_cameraDistance * std::sin(m_cameraPitch),
+		-m_cameraDistance * std::cos(m_cameraPitch) * std::cos(m_cameraYaw),
+		1.0f);
+	const XMMATRIX view = XMMatrixLookAtLH(eye, XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, width / height, 0.05f, 2000.0f);
+
+	PassConstants pass = {};
+	XMStoreFloat4x4(&pass.View, XMMatrixTranspose(view));
+	XMStoreFloat4x4(&pass.Proj, XMMatrixTranspose(projection));
+	XMStoreFloat4x4(&pass.ViewProj, XMMatrixTranspose(view * projection));
+	commandList->SetGraphicsRootConstantBufferView(0, uploadRing.PushConstants(pass).GPUAddress);
+
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	ID3D12PipelineState* currentPipeline = nullptr;
+	for (size_t i = 0; i < m_sceneObjects.size(); ++i)
+	{
+		SceneObject& object = m_sceneObjects[i];
+		if (!object.vertices.IsValid() || object.indices.empty())
+		{
+			continue;
+		}
+
+		//PSOں̨Ļһ֡Ȳ
+		const ScenePipeline& scenePipeline = GetScenePipeline(object.vertices.GetLayoutHandle());
+		ID3D12PipelineState* pipeline = nullptr;
+		if (scenePipeline.SelectedValid && static_cast<int>(i) == m_selectedObjectIndex)
+		{
+			pipeline = pipelines.TryGet(scenePipeline.SelectedKey);
+		}
+		//ѡеģ߸PSOûãͨĻ
+		if (pipeline == nullptr && scenePipeline.Valid)
+		{
+			pipeline = pipelines.TryGet(scenePipeline.Key);
+		}
+		if (pipeline == nullptr || (!object.vertexBuffer && !CreateGeometry(object, commandList)))
+		{
+			continue;
+		}
+		if (pipeline != currentPipeline)
+		{
+			commandList->SetPipelineState(pipeline);
+			currentPipeline = pipeline;
+		}
+
+		const XMMATRIX world =
+			XMMatrixScaling(object.scale[0], object.scale[1], object.scale[2]) *
+			XMMatrixRotationRollPitchYaw(XMConvertToRadians(object.rotation[0]), XMConvertToRadians(object.rotation[1]), XMConvertToRadians(object.rotation[2])) *
+			XMMatrixTranslation(object.position[0], object.position[1], object.position[2]);
+		ObjectConstants constants = {};
+		XMStoreFloat4x4(&constants.World, XMMatrixTranspose(world));
+		XMStoreFloat4x4(&constants.WorldInvTranspose, XMMatrixInverse(nullptr, world));
+		commandList->SetGraphicsRootConstantBufferView(1, uploadRing.PushConstants(constants).GPUAddress);
+
+		D3D12_VERTEX_BUFFER_VIEW vertexBufferView = {};
+		vertexBufferView.BufferLocation = object.vertexBuffer->GetGPUVirtualAddress();
+		vertexBufferView.SizeInBytes = static_cast<UINT>(object.vertices.GetDataSize());
+		vertexBufferView.StrideInBytes = object.vertices.GetStride();
+		D3D12_INDEX_BUFFER_VIEW indexBufferView = {};
+		indexBufferView.BufferLocation = object.indexBuffer->GetGPUVirtualAddress();
+		indexBufferView.SizeInBytes = static_cast<UINT>(object.indices.size() * sizeof(uint32_t));
+		indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+		commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+		commandList->IASetIndexBuffer(&indexBufferView);
+		commandList->DrawIndexedInstanced(static_cast<UINT>(object.indices.size()), 1, 0, 0, 0);
+	}
+
+	DrawGrid(commandList);
+}
+
+void EditorApp::DrawGrid(ID3D12GraphicsCommandList* commandList)
+{
+	ID3D12PipelineState* pipeline = m_linePipelineValid ? GetDevice().GetPipelineStateCache().TryGet(m_linePipelineKey) : nullptr;
+	if (pipeline == nullptr)
+	{
+		return;
+	}
+	DX12UploadRing& uploadRing = GetDevice().GetUploadRing();
+
+	//밴10ÿ֡ɣֱдϴ
+	const float spacing = std::pow(10.0f, std::floor(std::log10(m_cameraDistance * 0.5f)));
+	const float extent = spacing * kGridHalfLines;
+	const size_t lineCount = (kGridHalfLines * 2 + 1) * 2;
+	DynamicVertexData grid(VertexLayoutOf<SPositionColorVertex>.ToLayout(), lineCount * 2);
+	const AttributeView<VertexComponents::Position> positions = grid.GetAttributeView<VertexComponents::Position>();
+	const AttributeView<VertexComponents::Color> colors = grid.GetAttributeView<VertexComponents::Color>();
+	size_t vertex = 0;
+	for (int i = -kGridHalfLines; i <= kGridHalfLines; ++i)
+	{
+		const float offset = spacing * i;
+		const float shade = i == 0 ? 0.6f : 0.3f;
+		positions.Set(vertex, { offset, 0.0f, -extent });
+		colors.Set(vertex++, { shade, shade, shade, 1.0f });
+		positions.Set(vertex, { offset, 0.0f, extent });
+		colors.Set(vertex++, { shade, shade, shade, 1.0f });
+		positions.Set(vertex, { -extent, 0.0f, offset });
+		colors.Set(vertex++, { shade, shade, shade, 1.0f });
+		positions.Set(vertex, { extent, 0.0f, offset });
+		colors.Set(vertex++, { shade, shade, shade, 1.0f });
+	}
+
+	ObjectConstants constants = {};
+	DirectX::XMStoreFloat4x4(&constants.World, DirectX::XMMatrixIdentity());
+	DirectX::XMStoreFloat4x4(&constants.WorldInvTranspose, DirectX::XMMatrixIdentity());
+	commandList->SetGraphicsRootConstantBufferView(1, uploadRing.PushConstants(constants).GPUAddress);
+
+	const UploadAllocation vertices = uploadRing.PushData(grid.GetData(), grid.GetDataSize());
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView = {};
+	vertexBufferView.BufferLocation = vertices.GPUAddress;
+	vertexBufferView.SizeInBytes = static_cast<UINT>(vertices.Size);
+	vertexBufferView.StrideInBytes = grid.GetStride();
+
+	commandList->SetPipelineState(pipeline);
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+	commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+	commandList->DrawInstanced(static_cast<UINT>(grid.GetVertexCount()), 1, 0, 0);
+}
+
+bool EditorApp::CreateGeometry(SceneObject& object, ID3D12GraphicsCommandList* commandList)
+{
+	auto& device = GetDevice();
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertexUpload;
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexUpload;
+	bool success = true;
+	try
+	{
+		object.vertexBuffer = KJUtil::CreateDefaultBuffer(device.GetDevice(), commandList,
+			object.vertices.GetData(), object.vertices.GetDataSize(), vertexUpload);
+		object.indexBuffer = KJUtil::CreateDefaultBuffer(device.GetDevice(), commandList,
+			object.indices.data(), object.indices.size() * sizeof(uint32_t), indexUpload);
+	}
+	catch (const std::exception& exception)
+	{
+		std::cerr << "Failed to create GPU buffers for " << object.name << ": " << exception.what() << std::endl;
+		ReleaseGeometry(object);
+		success = false;
+	}
+
+	//Ѿ¼бʧʱ¼һҲһҪGPUٷ
+	device.GetFrameContext().AddTransientResource(std::move(vertexUpload));
+	device.GetFrameContext().AddTransientResource(std::move(indexUpload));
+	return success;
+}
+
+void EditorApp::ReleaseGeometry(SceneObject& object)
+{
+	DX12FrameContext& frameContext = GetDevice().GetFrameContext();
+	frameContext.AddTransientResource(std::move(object.vertexBuffer));
+	frameContext.AddTransientResource(std::move(object.indexBuffer));
+	object.vertexBuffer.Reset();
+	object.indexBuffer.Reset();
 }
 
 bool EditorApp::InitializeImGui()
@@ -223,17 +654,9 @@ bool EditorApp::InitializeImGui()
 	DXGI_FORMAT rtvFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
 	DXGI_FORMAT dsvFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
 
-	//SRV
-	D3D12_DESCRIPTOR_HEAP_DESC desc = {};
-	desc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	desc.NumDescriptors = 1;
-	desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-
-	HRESULT hr = device.GetDevice()->CreateDescriptorHeap(
-		&desc,
-		IID_PPV_ARGS(&m_imguiSrvHeap)
-	);
-	if (FAILED(hr))
+	//SRV豸ɫɼѣImGuiҪʹӳפ伸
+	auto& srvHeap = device.GetShaderVisibleHeap();
+	if (!srvHeap.IsInitialized())
 	{
 		return false;
 	}
@@ -245,19 +668,21 @@ bool EditorApp::InitializeImGui()
 	initInfo.NumFramesInFlight = 3;  
 	initInfo.RTVFormat = rtvFormat;
 	initInfo.DSVFormat = dsvFormat;
-	initInfo.SrvDescriptorHeap = m_imguiSrvHeap;
+	initInfo.SrvDescriptorHeap = srvHeap.Get();
+	initInfo.UserData = &srvHeap;
 
 
 	
 	initInfo.SrvDescriptorAllocFn = [](ImGui_ImplDX12_InitInfo* info, D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle, D3D12_GPU_DESCRIPTOR_HANDLE* out_gpu_handle)
 		{
-			*out_cpu_handle = info->SrvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-			*out_gpu_handle = info->SrvDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+			DX12Descriptor descriptor = static_cast<DX12ShaderVisibleDescriptorHeap*>(info->UserData)->AllocatePersistent();
+			*out_cpu_handle = descriptor.CPUHandle;
+			*out_gpu_handle = descriptor.GPUHandle;
 		};
 
-	initInfo.SrvDescriptorFreeFn = [](ImGui_ImplDX12_InitInfo* info, D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_GPU_DESCRIPTOR_HANDLE)
+	initInfo.SrvDescriptorFreeFn = [](ImGui_ImplDX12_InitInfo* info, D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle, D3D12_GPU_DESCRIPTOR_HANDLE)
 		{
-			
+			static_cast<DX12ShaderVisibleDescriptorHeap*>(info->UserData)->FreePersistent(cpuHandle);
 		};
 
 	if (!ImGui_ImplDX12_Init(&initInfo))
@@ -271,14 +696,13 @@ bool EditorApp::InitializeImGui()
 
 void EditorApp::ShutdownImGui()
 {
-	if (m_imguiSrvHeap)
+	if (m_imguiInitialized)
 	{
 		ImGui_ImplDX12_Shutdown();
 		ImGui_ImplWin32_Shutdown();
 		ImGui::DestroyContext();
 
-		m_imguiSrvHeap->Release();
-		m_imguiSrvHeap = nullptr;
+		SetImGuiInitialized(false);
 	}
 }
 
@@ -289,7 +713,7 @@ void EditorApp::DrawMainMenuBar()
 		bool fileMenuOpen = ImGui::BeginMenu("File");
 		if (fileMenuOpen)
 		{
-			if (ImGui::MenuItem("Import OBJ...", "Ctrl+O"))
+			if (ImGui::MenuItem("Import OBJ...", "Ctrl+O", false, !m_pendingImport.valid()))
 			{
 				OPENFILENAMEA ofn;
 				char szFile[260] = { 0 };
@@ -307,10 +731,63 @@ void EditorApp::DrawMainMenuBar()
 
 				if (GetOpenFileNameA(&ofn))
 				{
-					// TODO: Load OBJ file
-					SceneObject obj;
-					obj.name = szFile;
-					m_sceneObjects.push_back(obj);
+					//ں̨ܣɺUpdateӽ
+					m_pendingImportPath = szFile;
+					m_pendingImport = std::async(std::launch::async, [path = m_pendingImportPath]()
+					{
+						ObjImportOptions options;
+						options.Layout = VertexLayoutOf<SPositionColorNormalTexVertex>.ToLayout();
+						return ObjImporter::ImportFile(path, options);
+					});
+				}
+			}
+			if (ImGui::MenuItem("Open Mesh..."))
+			{
+				OPENFILENAMEA ofn;
+				char szFile[260] = { 0 };
+				ZeroMemory(&ofn, sizeof(ofn));
+				ofn.lStructSize = sizeof(ofn);
+				ofn.hwndOwner = GetMainWindow();
+				ofn.lpstrFile = szFile;
+				ofn.nMaxFile = sizeof(szFile);
+				ofn.lpstrFilter = "Mesh Files\0*.kjmesh\0All Files\0*.*\0";
+				ofn.nFilterIndex = 1;
+				ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST;
+
+				if (GetOpenFileNameA(&ofn))
+				{
+					MeshFile mesh;
+					std::string error;
+					if (mesh.Open(szFile, &error))
+					{
+						//Լж㣬�һݣȾ·ֱӳڴϴ
+						SceneObject obj;
+						obj.name = std::filesystem::path(szFile).filename().string();
+						bool loaded = true;
+						if (mesh.GetVertexStreamCount() == 1)
+						{
+							obj.vertices = mesh.GetVertexStream(0).ToVertexData();
+						}
+						else
+						{
+							loaded = InterleaveVertexStreams(mesh, obj.vertices, error);
+						}
+
+						if (loaded)
+						{
+							obj.indices = mesh.CopyIndices();
+							obj.meshlets = MeshletData::FromView(mesh.GetMeshlets());
+							m_sceneObjects.push_back(std::move(obj));
+						}
+						else
+						{
+							std::cerr << "Failed to open mesh: " << error << std::endl;
+						}
+					}
+					else
+					{
+						std::cerr << "Failed to open mesh: " << error << std::endl;
+					}
 				}
 			}
 
@@ -329,44 +806,159 @@ void EditorApp::DrawMainMenuBar()
 		if (windowMenuOpen)
 		{
 			ImGui::MenuItem("ImGui Demo", nullptr, &m_showDemoWindow);
+			ImGui::MenuItem("Frame Stats", nullptr, &m_showFrameStats);
 		}
 		if (windowMenuOpen)
 		{
 			ImGui::EndMenu();
 		}
 
+		bool profilerMenuOpen = ImGui::BeginMenu("Profiler");
+		if (profilerMenuOpen)
+		{
+			if (ImGui::MenuItem(Profiler::IsCapturing() ? "Stop Capture and Save..." : "Start Capture", "F9"))
+			{
+				ToggleProfilerCapture();
+			}
+		}
+		if (profilerMenuOpen)
+		{
+			ImGui::EndMenu();
+		}
+
 		ImGui::EndMainMenuBar();
 	}
+
+	//˵Ҳÿݼʼ/¼
+	if (ImGui::IsKeyPressed(ImGuiKey_F9, false))
+	{
+		ToggleProfilerCapture();
+	}
 }
 
-void EditorApp::DrawSceneView()
+void EditorApp::ToggleProfilerCapture()
 {
-	ImGui::Begin("Scene View");
+	if (!Profiler::IsCapturing())
+	{
+		Profiler::StartCapture();
+		return;
+	}
+
+	Profiler::StopCapture();
+
+	OPENFILENAMEA ofn;
+	char szFile[260] = "capture.json";
+	ZeroMemory(&ofn, sizeof(ofn));
+	ofn.lStructSize = sizeof(ofn);
+	ofn.hwndOwner = GetMainWindow();
+	ofn.lpstrFile = szFile;
+	ofn.nMaxFile = sizeof(szFile);
+	ofn.lpstrFilter = "Chrome Trace\0*.json\0All Files\0*.*\0";
+	ofn.nFilterIndex = 1;
+	ofn.lpstrDefExt = "json";
+	ofn.Flags = OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT;
+
+	if (GetSaveFileNameA(&ofn))
+	{
+		if (Profiler::WriteChromeTrace(std::string(szFile)))
+		{
+			std::cout << "Wrote " << Profiler::GetCapturedEventCount() << " profiler events to " << szFile << std::endl;
+		}
+		else
+		{
+			std::cerr << "Failed to write profiler trace: " << szFile << std::endl;
+		}
+	}
+}
+
+void EditorApp::DrawFrameStatsPanel()
+{
+	if (!m_showFrameStats)
+	{
+		return;
+	}
 
-	ImVec2 contentSize = ImGui::GetContentRegionAvail();
+	if (!ImGui::Begin("Frame Stats", &m_showFrameStats))
+	{
+		ImGui::End();
+		return;
+	}
 
-	// Render 3D scene here
+	const Profiler::FrameStats& stats = Profiler::GetLastFrameStats();
+	ImGui::Text("Frame %llu: %.3f ms", static_cast<unsigned long long>(stats.FrameIndex), stats.FrameMs);
+	if (stats.DroppedEvents > 0)
+	{
+		ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "Dropped events: %llu", static_cast<unsigned long long>(stats.DroppedEvents));
+	}
+	if (Profiler::IsCapturing())
+	{
+		ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Capturing... %zu events (F9 to stop)", Profiler::GetCapturedEventCount());
+	}
 
-	ImVec2 canvasPos = ImGui::GetCursorScreenPos();
-	ImVec2 canvasSize = ImGui::GetContentRegionAvail();
+	//䰴Ƕ
+	if (ImGui::BeginTable("Zones", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+	{
+		ImGui::TableSetupColumn("Zone");
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableSetupColumn("Total ms");
+		ImGui::TableSetupColumn("Self ms");
+		ImGui::TableHeadersRow();
 
-	if (canvasSize.x < 50.0f) canvasSize.x = 50.0f;
-	if (canvasSize.y < 50.0f) canvasSize.y = 50.0f;
+		for (const Profiler::ZoneStats& zone : stats.Zones)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%*s%s", static_cast<int>(zone.Depth * 2), "", zone.Name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", zone.CallCount);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", zone.TotalMs);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", zone.SelfMs);
+		}
+		ImGui::EndTable();
+	}
 
-	ImDrawList* drawList = ImGui::GetWindowDrawList();
-	drawList->AddRectFilled(canvasPos, ImVec2(canvasPos.x + canvasSize.x, canvasPos.y + canvasSize.y),
-		IM_COL32(30, 30, 30, 255));
-	drawList->AddRect(canvasPos, ImVec2(canvasPos.x + canvasSize.x, canvasPos.y + canvasSize.y),
-		IM_COL32(100, 100, 100, 255));
+	ImGui::Separator();
+	const PipelineCacheStats pipelineStats = GetDevice().GetPipelineStateCache().GetStats();
+	ImGui::Text("PSO cache: %zu entries, %zu pending, hit rate %.1f%%",
+		pipelineStats.EntryCount, pipelineStats.PendingCount, pipelineStats.GetHitRate() * 100.0);
 
-	ImVec2 textSize = ImGui::CalcTextSize("3D Scene View");
-	ImGui::SetCursorPosX((canvasSize.x - textSize.x) * 0.5f);
-	ImGui::SetCursorPosY(canvasSize.y * 0.5f - textSize.y);
-	ImGui::Text("3D Scene View");
+	ImGui::End();
+}
 
-	textSize = ImGui::CalcTextSize("(Scene will be displayed after rendering pipeline is complete)");
-	ImGui::SetCursorPosX((canvasSize.x - textSize.x) * 0.5f);
-	ImGui::Text("(Scene will be displayed after rendering pipeline is complete)");
+void EditorApp::DrawSceneView()
+{
+	//ڲDrawSceneں̨ϵĳ͸
+	m_sceneViewVisible = ImGui::Begin("Scene View", nullptr, ImGuiWindowFlags_NoBackground);
+	if (m_sceneViewVisible)
+	{
+		ImVec2 canvasPos = ImGui::GetCursorScreenPos();
+		ImVec2 canvasSize = ImGui::GetContentRegionAvail();
+		m_sceneViewVisible = canvasSize.x >= 1.0f && canvasSize.y >= 1.0f;
+
+		//ӿڵĻǿͻ
+		const ImVec2 viewportPos = ImGui::GetMainViewport()->Pos;
+		m_sceneViewRect[0] = canvasPos.x - viewportPos.x;
+		m_sceneViewRect[1] = canvasPos.y - viewportPos.y;
+		m_sceneViewRect[2] = canvasSize.x;
+		m_sceneViewRect[3] = canvasSize.y;
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		drawList->AddRect(canvasPos, ImVec2(canvasPos.x + canvasSize.x, canvasPos.y + canvasSize.y),
+			IM_COL32(100, 100, 100, 255));
+
+		if (ImGui::IsWindowHovered())
+		{
+			ImGuiIO& io = ImGui::GetIO();
+			if (ImGui::IsMouseDown(ImGuiMouseButton_Right))
+			{
+				m_cameraYaw -= io.MouseDelta.x * 0.01f;
+				m_cameraPitch = std::clamp(m_cameraPitch + io.MouseDelta.y * 0.01f, -1.5f, 1.5f);
+			}
+			m_cameraDistance = std::clamp(m_cameraDistance * std::pow(0.9f, io.MouseWheel), 0.5f, 1000.0f);
+		}
+	}
 
 	ImGui::End();
 }
@@ -376,6 +968,11 @@ void EditorApp::DrawInspectorPanel()
 	ImGui::Begin("Inspector");
 
 	ImGui::Text("Scene Objects:");
+	if (m_pendingImport.valid())
+	{
+		ImGui::SameLine();
+		ImGui::TextDisabled("(importing %s...)", std::filesystem::path(m_pendingImportPath).filename().string().c_str());
+	}
 	ImGui::Separator();
 
 	if (m_sceneObjects.empty())
@@ -402,6 +999,93 @@ void EditorApp::DrawInspectorPanel()
 
 		ImGui::Text("Properties:");
 		ImGui::Text("Name: %s", obj.name.c_str());
+		if (obj.vertices.IsValid())
+		{
+			ImGui::Text("Vertices: %zu", obj.vertices.GetVertexCount());
+			ImGui::Text("Triangles: %zu", obj.indices.size() / 3);
+			ImGui::Text("Meshlets: %zu", obj.meshlets.Meshlets.size());
+
+			if (ImGui::Button("Weld Vertices"))
+			{
+				try
+				{
+					//ֽڱȽϣֻϲȫͬĶ㣨OBJƴӳظ㣩۲
+					VertexWeldOptions options;
+					options.AllowIndex16 = false;
+					VertexWeldResult result = VertexWelder::Weld(obj.vertices.GetView(), obj.indices.data(), obj.indices.size(), options);
+					ReleaseGeometry(obj);
+					obj.vertices = std::move(result.Vertices);
+					obj.indices = result.CopyIndices();
+					obj.meshlets.Clear();
+					std::cout << "Welded " << obj.name << ": " << result.InputVertexCount << " -> " << obj.vertices.GetVertexCount()
+						<< " vertices, " << result.ThreadCount << " threads, " << result.Milliseconds << " ms" << std::endl;
+				}
+				catch (const std::exception& exception)
+				{
+					std::cerr << "Failed to weld vertices: " << exception.what() << std::endl;
+				}
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Optimize Mesh"))
+			{
+				try
+				{
+					ReleaseGeometry(obj);
+					MeshOptimizeReport report = MeshOptimizer::Optimize(obj.vertices, obj.indices);
+					obj.meshlets.Clear();
+					std::cout << "Optimized " << obj.name << ": ACMR " << report.Before.ACMR << " -> " << report.After.ACMR
+						<< ", ATVR " << report.Before.ATVR << " -> " << report.After.ATVR << ", " << report.ClusterCount
+						<< " clusters, " << report.Milliseconds << " ms" << std::endl;
+				}
+				catch (const std::exception& exception)
+				{
+					std::cerr << "Failed to optimize mesh: " << exception.what() << std::endl;
+				}
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Build Meshlets"))
+			{
+				try
+				{
+					MeshletBuildReport report = MeshletBuilder::Build(obj.vertices.GetView(), obj.indices.data(), obj.indices.size(), obj.meshlets);
+					std::cout << "Built " << report.MeshletCount << " meshlets for " << obj.name << " (avg " << report.AverageVertexCount
+						<< " vertices, " << report.AverageTriangleCount << " triangles), " << report.Milliseconds << " ms" << std::endl;
+				}
+				catch (const std::exception& exception)
+				{
+					std::cerr << "Failed to build meshlets: " << exception.what() << std::endl;
+				}
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Save Mesh..."))
+			{
+				OPENFILENAMEA ofn;
+				char szFile[260] = { 0 };
+				ZeroMemory(&ofn, sizeof(ofn));
+				ofn.lStructSize = sizeof(ofn);
+				ofn.hwndOwner = GetMainWindow();
+				ofn.lpstrFile = szFile;
+				ofn.nMaxFile = sizeof(szFile);
+				ofn.lpstrFilter = "Mesh Files\0*.kjmesh\0";
+				ofn.lpstrDefExt = "kjmesh";
+				ofn.Flags = OFN_OVERWRITEPROMPT;
+
+				if (GetSaveFileNameA(&ofn))
+				{
+					MeshFileSource source;
+					source.VertexStreams.push_back(obj.vertices.GetView());
+					source.Indices = obj.indices.data();
+					source.IndexCount = obj.indices.size();
+					source.Meshlets = obj.meshlets.GetView();
+
+					std::string error;
+					if (!MeshFile::Write(szFile, source, {}, &error))
+					{
+						std::cerr << "Failed to save mesh: " << error << std::endl;
+					}
+				}
+			}
+		}
 
 		ImGui::Separator();
 		ImGui::Text("Transform:");
@@ -414,6 +1098,7 @@ void EditorApp::DrawInspectorPanel()
 
 		if (ImGui::Button("Delete Object"))
 		{
+			ReleaseGeometry(obj);
 			m_sceneObjects.erase(m_sceneObjects.begin() + m_selectedObjectIndex);
 			m_selectedObjectIndex = -1;
 		}
@@ -3,6 +3,12 @@
 #include "imgui.h"
 #include "backends/imgui_impl_win32.h"
 #include "backends/imgui_impl_dx12.h"
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/MeshletBuilder.h"
+#include "DX12/DX12PipelineStateCache.h"
+#include "Renderer/Resources/ObjImporter.h"
+#include <future>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -28,12 +34,38 @@ private:
 	//imguiص
 	bool InitializeImGui();
 	void ShutdownImGui();
+
+	//עɫں̨ԤȽóҪõPSO߿еĻֱӶ
+	void InitializePipelines();
+	//ǰֽؽ͵Ĺ߼غҲ
+	void BuildPipelineKeys();
 	//void RenderImGui();
 
+	//ImGui֮ǰScene Viewռǿ̨ϣͶ̬豸ϴ
+	void DrawScene(ID3D12GraphicsCommandList* commandList);
+	void DrawGrid(ID3D12GraphicsCommandList* commandList);
+
+	//ߵļ㲼ָһݣһμĳʱ֮ÿ֡
+	struct ScenePipeline
+	{
+		PipelineStateKey Key;
+		bool Valid = false;     //ιBasicVSûCOLORʱΪfalse岻
+		PipelineStateKey SelectedKey;	//ѡʱõģɫSELECTED
+		bool SelectedValid = false;
+	};
+	const ScenePipeline& GetScenePipeline(const VertexLayoutHandle& layout);
+
 	//UI
 	void DrawMainMenuBar();//ͷ
 	void DrawSceneView();//ͼ
 	void DrawInspectorPanel();//
+	void DrawFrameStatsPanel();//ÿ֡ͳ
+
+	//ʼ¼ƣѾ¼ͣ²Chrome trace
+	void ToggleProfilerCapture();
+
+	//̨ɺѽӽ
+	void PollPendingImport();
 
 
 	//
@@ -43,15 +75,50 @@ private:
 		float position[3] = { 0,0,0 };
 		float rotation[3] = { 0,0,0 };
 		float scale[3] = { 1,1,1 };
+
+		//
+		DynamicVertexData vertices;
+		std::vector<uint32_t> indices;
+		MeshletData meshlets;  //ĶɣҪ
+
+		//GPUϵĶһλʱ򽨣ҪReleaseGeometry´λʱؽ
+		Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer;
+		Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer;
 	};
 
+	//һ֡б¼ϴõʱҵ֡ϣGPUŷ
+	bool CreateGeometry(SceneObject& object, ID3D12GraphicsCommandList* commandList);
+	//ɻܻǰ֡ţҲҵ֡Ϸ
+	void ReleaseGeometry(SceneObject& object);
+
 	std::vector<SceneObject> m_sceneObjects;
 	int m_selectedObjectIndex = -1;
 
+	//̨еOBJ룬ͬһʱֻһ
+	std::future<ObjImportResult> m_pendingImport;
+	std::string m_pendingImportPath;
+
+	//ɫĳߣBasicVS/BasicPSm_scenePipelineDesc˲ֶˣͬɫ
+	DX12GraphicsPipelineDesc m_scenePipelineDesc;
+	std::unordered_map<VertexLayoutHandle, ScenePipeline> m_scenePipelines;
+	std::string m_selectedPixelShader;	//BasicPSSELECTEDؼעʧʱΪ
+	PipelineStateKey m_linePipelineKey;
+	bool m_linePipelineValid = false;
+	uint64_t m_shaderGeneration = 0;	//ЩʱɫĴ
+
+	//Scene ViewڿͻλúʹСx, y, , ߣʱ
+	float m_sceneViewRect[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	bool m_sceneViewVisible = false;
+
+	//ԭתҼ϶ķ򣬹ָľ
+	float m_cameraYaw = 0.6f;
+	float m_cameraPitch = 0.5f;
+	float m_cameraDistance = 8.0f;
+
 
-	//Imgui
-	ID3D12DescriptorHeap* m_imguiSrvHeap = nullptr;
+	//ImguiSRV豸ɫɼ䣩
 	bool m_showDemoWindow = false;
+	bool m_showFrameStats = false;
 	bool m_dockspaceInitialized = false;  //  DockSpace ǷѳʼĬϲ
 
 };
\ No newline at end of file
@@ -14,7 +14,7 @@ void TestApp::Draw()
 	auto& device = GetDevice();
 	auto& swapChain = GetSwapChain();
 
-	device.ResetCommandList();
+	device.BeginFrame();
 
 	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = swapChain.GetCurrentRTVHandle(GetRTVHeap());
 	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = GetDepthStencilBuffer().GetDSVHandle(GetDSVHeap(), 0);
@@ -35,7 +35,7 @@ void TestApp::Draw()
 	device.GetCommandQueue()->ExecuteCommandLists(1, cmdLists);
 
 	swapChain.Present(1, 0);
-	device.GetMainFence().Flush(device.GetCommandQueue());
+	device.EndFrame();
 }
 
 void TestApp::OnResize()
@@ -14,6 +14,9 @@
 //}
 
 #include "App/EditorApp.h"
+#include "Benchmark/Benchmark.h"
+#include <cstdio>
+#include <cstring>
 
 int WINAPI WinMain(
     HINSTANCE hInstance,
@@ -21,6 +24,25 @@ int WINAPI WinMain(
     LPSTR lpCmdLine,
     int nCmdShow)
 {
+    //--bench [˴]ֻܻ׼ԣ
+    if (lpCmdLine != nullptr && std::strncmp(lpCmdLine, "--bench", 7) == 0)
+    {
+        //Windowsϵͳûп̨ӵ
+        FILE* stream = nullptr;
+        if (AttachConsole(ATTACH_PARENT_PROCESS))
+        {
+            freopen_s(&stream, "CONOUT$", "w", stdout);
+            freopen_s(&stream, "CONOUT$", "w", stderr);
+        }
+
+        const char* filter = lpCmdLine + 7;
+        while (*filter == ' ')
+        {
+            ++filter;
+        }
+        return Benchmark::Run(filter);
+    }
+
     EditorApp app(hInstance);
     return app.Run();
 }
@@ -0,0 +1,64 @@
+#include "Benchmark/Benchmark.h"
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/Vertex.h"
+
+//дһλãңԭSetPosition·ԤȽľAttributeView
+namespace {
+
+	constexpr size_t kVertexCount = 1000000;
+	constexpr int kRepeats = 5;
+
+	void ReportPerVertex(Benchmark::Context& context, const char* metric, double milliseconds)
+	{
+		context.Report(metric, milliseconds * 1.0e6 / kVertexCount, "ns/vertex");
+	}
+}
+
+KJ_BENCHMARK("DynamicVertexData attribute access")
+{
+	DynamicVertexData vertices(VertexLayoutOf<SPositionNormalTexVertex>.ToLayout(), kVertexCount);
+
+	const double byName = Benchmark::BestOfMilliseconds(kRepeats, [&vertices]()
+	{
+		for (size_t i = 0; i < kVertexCount; ++i)
+		{
+			const float position[3] = { static_cast<float>(i), 1.0f, 2.0f };
+			vertices.SetVertexAttribute(i, "POSITION", 0, position);
+		}
+	});
+	ReportPerVertex(context, "set by name", byName);
+
+	const VertexAttributeHandle handle = vertices.FindAttribute("POSITION");
+	const double byHandle = Benchmark::BestOfMilliseconds(kRepeats, [&vertices, &handle]()
+	{
+		for (size_t i = 0; i < kVertexCount; ++i)
+		{
+			const float position[3] = { static_cast<float>(i), 1.0f, 2.0f };
+			vertices.SetVertexAttribute(i, handle, position);
+		}
+	});
+	ReportPerVertex(context, "set by handle", byHandle);
+
+	const AttributeView<VertexComponents::Position> positions = vertices.GetAttributeView<VertexComponents::Position>();
+	const double byView = Benchmark::BestOfMilliseconds(kRepeats, [&positions]()
+	{
+		for (size_t i = 0; i < kVertexCount; ++i)
+		{
+			positions.Set(i, { static_cast<float>(i), 1.0f, 2.0f });
+		}
+	});
+	ReportPerVertex(context, "set by AttributeView", byView);
+
+	double sum = 0.0;
+	const double readView = Benchmark::BestOfMilliseconds(kRepeats, [&positions, &sum]()
+	{
+		for (size_t i = 0; i < kVertexCount; ++i)
+		{
+			sum += positions.Get(i).x;
+		}
+	});
+	Benchmark::DoNotOptimize(sum);
+	ReportPerVertex(context, "get by AttributeView", readView);
+
+	context.Report("view speedup over name lookup", byName / byView, "x");
+}
@@ -0,0 +1,89 @@
+#include "Benchmark/Benchmark.h"
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Benchmark {
+
+	struct Entry
+	{
+		const char* Name;
+		Function Body;
+	};
+
+	//עᷢھ̬ʼ׶Σúھ̬ܿʼ˳
+	static std::vector<Entry>& GetEntries()
+	{
+		static std::vector<Entry> entries;
+		return entries;
+	}
+
+	static volatile uint64_t g_sink = 0;
+
+	static std::string ToLower(std::string text)
+	{
+		std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return text;
+	}
+
+
+	Context::Context(const char* name)
+		: m_name(name)
+	{
+	}
+
+	void Context::Report(const std::string& metric, double value, const char* unit)
+	{
+		std::cout << m_name << " / " << metric << ": " << std::fixed << std::setprecision(value < 100.0 ? 3 : 1) << value << " " << unit << std::endl;
+	}
+
+	Registration::Registration(const char* name, Function function)
+	{
+		GetEntries().push_back({ name, function });
+	}
+
+	void Consume(uint64_t value)
+	{
+		g_sink = g_sink + value;
+	}
+
+	int Run(const std::string& filter)
+	{
+		std::vector<Entry> entries = GetEntries();
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return std::string(a.Name) < std::string(b.Name); });
+
+		const std::string loweredFilter = ToLower(filter);
+		int ran = 0;
+		int failed = 0;
+		for (const Entry& entry : entries)
+		{
+			if (!loweredFilter.empty() && ToLower(entry.Name).find(loweredFilter) == std::string::npos)
+			{
+				continue;
+			}
+
+			std::cout << "== " << entry.Name << std::endl;
+			++ran;
+			try
+			{
+				Context context(entry.Name);
+				entry.Body(context);
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << entry.Name << " failed: " << e.what() << std::endl;
+				++failed;
+			}
+		}
+
+		if (ran == 0)
+		{
+			std::cerr << "No benchmark matches \"" << filter << "\"" << std::endl;
+			return 1;
+		}
+		return failed;
+	}
+}
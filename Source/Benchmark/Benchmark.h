@@ -0,0 +1,76 @@
+#pragma once
+//޴ڵĻ׼ԣ --bench [˴] ʱmain.cppֻעĻ׼Ҳ豸
+//ÿ׼KJ_BENCHMARK("")עᣬ˴ʵĲܣִСд˴ʾȫܣ
+//һһ / ָ: ֵ λ
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Benchmark
+{
+	class Context
+	{
+	public:
+		explicit Context(const char* name);
+
+		const char* GetName() const { return m_name; }
+
+		//һ
+		void Report(const std::string& metric, double value, const char* unit);
+
+	private:
+		const char* m_name;
+	};
+
+	using Function = void(*)(Context&);
+
+	//עᣨһͨKJ_BENCHMARKʹã
+	struct Registration
+	{
+		Registration(const char* name, Function function);
+	};
+
+	//filterĻ׼ʧܣ쳣ĸ
+	int Run(const std::string& filter);
+
+
+	//ֵдһvolatileֹõĽŻ
+	void Consume(uint64_t value);
+
+	template<typename T>
+	void DoNotOptimize(const T& value)
+	{
+		Consume(static_cast<uint64_t>(*reinterpret_cast<const volatile unsigned char*>(&value)));
+	}
+
+	//һԤȣrepeatsΣһεĺ
+	template<typename Fn>
+	double BestOfMilliseconds(int repeats, Fn&& fn);
+}
+
+
+#define KJ_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define KJ_BENCHMARK_CONCAT(a, b) KJ_BENCHMARK_CONCAT_INNER(a, b)
+
+#define KJ_BENCHMARK(name) \
+	static void KJ_BENCHMARK_CONCAT(kjBenchmark, __LINE__)(::Benchmark::Context& context); \
+	static ::Benchmark::Registration KJ_BENCHMARK_CONCAT(kjBenchmarkRegistration, __LINE__)(name, &KJ_BENCHMARK_CONCAT(kjBenchmark, __LINE__)); \
+	static void KJ_BENCHMARK_CONCAT(kjBenchmark, __LINE__)(::Benchmark::Context& context)
+
+
+#include "Timer/Clock.h"
+
+template<typename Fn>
+double Benchmark::BestOfMilliseconds(int repeats, Fn&& fn)
+{
+	fn();
+	int64_t best = INT64_MAX;
+	for (int i = 0; i < repeats; ++i)
+	{
+		const int64_t start = SteadyClock::Now();
+		fn();
+		const int64_t elapsed = SteadyClock::Now() - start;
+		best = elapsed < best ? elapsed : best;
+	}
+	return static_cast<double>(best) / 1.0e6;
+}
@@ -0,0 +1,107 @@
+#include "Benchmark/Benchmark.h"
+#include "Renderer/Core/PagedDescriptorAllocator.h"
+#include "Renderer/Core/RingBufferAllocator.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+//߼ٶȣD3D12ѣҳصΪգ
+//פķ/ͷšդӳͷţԼɫɼÿ֡Է
+namespace {
+
+	constexpr uint32_t kPageSize = 1024;
+	constexpr uint32_t kLiveCount = 64 * 1024;
+	constexpr size_t kOperations = 4000000;
+	constexpr uint32_t kFramesInFlight = 3;
+	constexpr uint32_t kFrames = 2000;
+	constexpr uint32_t kTablesPerFrame = 2000;
+	constexpr int kRepeats = 5;
+
+	void ReportPerOperation(Benchmark::Context& context, const char* metric, double milliseconds, double operations)
+	{
+		context.Report(metric, milliseconds * 1.0e6 / operations, "ns/op");
+	}
+}
+
+KJ_BENCHMARK("Descriptor allocator alloc/free")
+{
+	PagedDescriptorAllocator allocator(kPageSize);
+
+	//ͷţջ
+	double milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&allocator]()
+	{
+		for (size_t i = 0; i < kOperations; ++i)
+		{
+			allocator.Free(allocator.Allocate());
+		}
+	});
+	ReportPerOperation(context, "allocate + free", milliseconds, kOperations);
+
+	//ռkLiveCountٰ˳ȫͷţģԴڽ
+	std::vector<uint32_t> indices(kLiveCount);
+	std::mt19937 random(1);
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (uint32_t& index : indices)
+		{
+			index = allocator.Allocate();
+		}
+		std::shuffle(indices.begin(), indices.end(), random);
+		for (uint32_t index : indices)
+		{
+			allocator.Free(index);
+		}
+	});
+	ReportPerOperation(context, "allocate all, free shuffled (incl. shuffle)", milliseconds, kLiveCount * 2.0);
+
+	//ÿ֡һһ֡դӳͷţGPUkFramesInFlight֡ҳӦֻ;ļ֡
+	PagedDescriptorAllocator deferredAllocator(kPageSize);
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&allocator = deferredAllocator]()
+	{
+		uint64_t fence = 0;
+		for (uint32_t frame = 0; frame < kFrames; ++frame)
+		{
+			++fence;
+			for (uint32_t i = 0; i < kTablesPerFrame; ++i)
+			{
+				allocator.FreeDeferred(allocator.Allocate(), fence);
+			}
+			if (fence > kFramesInFlight)
+			{
+				allocator.ReleaseCompleted(fence - kFramesInFlight);
+			}
+		}
+		allocator.ReleaseCompleted(fence);
+	});
+	ReportPerOperation(context, "allocate + deferred free", milliseconds, static_cast<double>(kFrames) * kTablesPerFrame);
+	context.Report("pages used with deferred frees", deferredAllocator.GetPageCount(), "pages");
+
+	//ɫɼѣÿ֡1~16ı֡դ
+	RingBufferAllocator ring(kLiveCount);
+	std::vector<uint32_t> tableSizes(kTablesPerFrame);
+	for (uint32_t& size : tableSizes)
+	{
+		size = 1 + random() % 16;
+	}
+	uint64_t failed = 0;
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		uint64_t fence = 0;
+		for (uint32_t frame = 0; frame < kFrames; ++frame)
+		{
+			++fence;
+			for (uint32_t size : tableSizes)
+			{
+				failed += ring.Allocate(size, 1) == RingBufferAllocator::kInvalidOffset;
+			}
+			ring.FinishFrame(fence);
+			if (fence > kFramesInFlight)
+			{
+				ring.ReleaseCompleted(fence - kFramesInFlight);
+			}
+		}
+		ring.ReleaseCompleted(fence);
+	});
+	ReportPerOperation(context, "ring table allocate", milliseconds, static_cast<double>(kFrames) * kTablesPerFrame);
+	Benchmark::DoNotOptimize(failed);
+}
@@ -0,0 +1,154 @@
+#include "Benchmark/FakeShaderCompiler.h"
+#include "Renderer/Core/ShaderReflection.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+	constexpr int kMaxIncludeDepth = 32;
+
+	bool ReadTextFile(const std::filesystem::path& path, std::string& outText)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		outText = stream.str();
+		return true;
+	}
+
+	//ȡ#include "name"nameincludeзfalse
+	bool ParseInclude(const std::string& line, std::string& outName)
+	{
+		const size_t start = line.find_first_not_of(" \t");
+		if (start == std::string::npos || line.compare(start, 8, "#include") != 0)
+		{
+			return false;
+		}
+		const size_t open = line.find('"', start + 8);
+		const size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+		if (close == std::string::npos)
+		{
+			return false;
+		}
+		outName = line.substr(open + 1, close - open - 1);
+		return true;
+	}
+
+	bool ExpandFile(const std::filesystem::path& path, int depth, ShaderPreprocessResult& result)
+	{
+		if (depth > kMaxIncludeDepth)
+		{
+			result.Errors += "include depth exceeded (recursive include?): " + path.string() + "\n";
+			return false;
+		}
+
+		std::string text;
+		if (!ReadTextFile(path, text))
+		{
+			result.Errors += "cannot open: " + path.string() + "\n";
+			return false;
+		}
+
+		std::istringstream lines(text);
+		std::string line;
+		std::string includeName;
+		while (std::getline(lines, line))
+		{
+			if (!ParseInclude(line, includeName))
+			{
+				result.Source += line;
+				result.Source += '\n';
+				continue;
+			}
+
+			const std::filesystem::path includePath = path.parent_path() / includeName;
+			result.Includes.push_back(includePath);
+			if (!ExpandFile(includePath, depth + 1, result))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+ShaderPreprocessResult FakeShaderCompiler::Preprocess(const ShaderCompileRequest& request)
+{
+	++m_preprocessCount;
+
+	ShaderPreprocessResult result;
+	for (const ShaderDefine& define : request.Defines)
+	{
+		result.Source += "#define " + define.Name + " " + define.Value + "\n";
+	}
+	result.Success = ExpandFile(request.SourcePath, 0, result);
+	return result;
+}
+
+ShaderCompileResult FakeShaderCompiler::Compile(const ShaderCompileRequest& request, const std::string& preprocessedSource)
+{
+	++m_compileCount;
+
+	ShaderCompileResult result;
+	if (preprocessedSource.find(kErrorMarker) != std::string::npos)
+	{
+		result.Errors = request.SourcePath.string() + ": error: " + kErrorMarker + " found\n";
+		return result;
+	}
+
+	const std::string header = "FAKE " + request.EntryPoint + " " + request.Target + "\n";
+	result.Bytecode.assign(header.begin(), header.end());
+	result.Bytecode.insert(result.Bytecode.end(), preprocessedSource.begin(), preprocessedSource.end());
+	result.Success = true;
+	return result;
+}
+
+bool FakeShaderCompiler::Reflect(const void* bytecode, size_t size, ShaderReflection& outReflection)
+{
+	++m_reflectCount;
+
+	outReflection = ShaderReflection();
+	std::istringstream lines(std::string(static_cast<const char*>(bytecode), size));
+	std::string line;
+	while (std::getline(lines, line))
+	{
+		std::istringstream fields(line);
+		std::string tag;
+		fields >> tag;
+		if (tag == "@cbuffer")
+		{
+			ShaderConstantBufferInfo buffer;
+			fields >> buffer.Name >> buffer.BindPoint >> buffer.Size;
+			outReflection.Bindings.push_back({ buffer.Name, ShaderResourceKind::ConstantBuffer, buffer.BindPoint, 1, 0 });
+			outReflection.ConstantBuffers.push_back(std::move(buffer));
+		}
+		else if (tag == "@var" && !outReflection.ConstantBuffers.empty())
+		{
+			ShaderVariableInfo variable;
+			fields >> variable.Name >> variable.Offset >> variable.Size;
+			outReflection.ConstantBuffers.back().Variables.push_back(std::move(variable));
+		}
+		else if (tag == "@input" || tag == "@sv")
+		{
+			ShaderInputParameter input;
+			uint32_t components = 4;
+			std::string type = "float";
+			fields >> input.SemanticName;
+			if (tag == "@input")
+			{
+				fields >> input.SemanticIndex >> components >> type;
+			}
+			input.Register = static_cast<uint32_t>(outReflection.InputParameters.size());
+			input.ComponentType = type == "uint" ? ShaderComponentType::UInt32 :
+				type == "int" ? ShaderComponentType::SInt32 : ShaderComponentType::Float32;
+			input.Mask = static_cast<uint8_t>((1u << std::min(components, 4u)) - 1);
+			input.IsSystemValue = tag == "@sv";
+			outReflection.InputParameters.push_back(std::move(input));
+		}
+	}
+	return true;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Renderer/Core/ShaderCompiler.h"
+#include <atomic>
+#include <cstdint>
+
+//d3dcompilerļٱ׼
+//Preprocessֻչ#include "..."ڵǰļ#defineмǰ
+//CompileڡĿԤԴԭƴ"ֽ"һͱ䣬黺ʧЧǷȷ
+//Reflect"ֽ"ﰴжϢ
+//"@cbuffer  λ С""@var  ƫ С"һcbuffer"@input    float|uint|int""@sv "
+//#pragma once룬includeǶ׳32㵱ѭ
+class FakeShaderCompiler final : public IShaderCompiler
+{
+public:
+	explicit FakeShaderCompiler(uint64_t identity = 1) : m_identity(identity) {}
+
+	uint64_t GetIdentity() const override { return m_identity; }
+	ShaderPreprocessResult Preprocess(const ShaderCompileRequest& request) override;
+	ShaderCompileResult Compile(const ShaderCompileRequest& request, const std::string& preprocessedSource) override;
+	bool Reflect(const void* bytecode, size_t size, ShaderReflection& outReflection) override;
+
+	//ԴַʱCompileʧܣģ
+	static constexpr const char* kErrorMarker = "#error";
+
+	uint32_t GetPreprocessCount() const { return m_preprocessCount.load(); }
+	uint32_t GetCompileCount() const { return m_compileCount.load(); }
+	uint32_t GetReflectCount() const { return m_reflectCount.load(); }
+
+private:
+	uint64_t m_identity;
+	std::atomic<uint32_t> m_preprocessCount = 0;
+	std::atomic<uint32_t> m_compileCount = 0;
+	std::atomic<uint32_t> m_reflectCount = 0;
+};
@@ -0,0 +1,198 @@
+#include "Benchmark/Benchmark.h"
+#include "../../LRU.h"
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//·ĵӳ٣std::list + unordered_mapĳд̭·PutԼƬĶ߳
+namespace {
+
+	constexpr size_t kEntryCount = 64 * 1024;
+	constexpr size_t kOperations = 4000000;
+	constexpr size_t kOperationsPerThread = 1000000;
+	constexpr int kRepeats = 5;
+
+	//дLRUֻ
+	class ListLRU
+	{
+	public:
+		explicit ListLRU(size_t capacity) : m_capacity(capacity) {}
+
+		uint64_t* Get(uint64_t key)
+		{
+			auto it = m_index.find(key);
+			if (it == m_index.end())
+			{
+				return nullptr;
+			}
+			m_order.splice(m_order.begin(), m_order, it->second);
+			return &it->second->second;
+		}
+
+		void Put(uint64_t key, uint64_t value)
+		{
+			if (uint64_t* existing = Get(key))
+			{
+				*existing = value;
+				return;
+			}
+			m_order.emplace_front(key, value);
+			m_index[key] = m_order.begin();
+			if (m_order.size() > m_capacity)
+			{
+				m_index.erase(m_order.back().first);
+				m_order.pop_back();
+			}
+		}
+
+	private:
+		size_t m_capacity;
+		std::list<std::pair<uint64_t, uint64_t>> m_order;
+		std::unordered_map<uint64_t, std::list<std::pair<uint64_t, uint64_t>>::iterator> m_index;
+	};
+
+	std::vector<uint64_t> MakeKeys(size_t count, uint64_t range, uint32_t seed)
+	{
+		std::mt19937_64 random(seed);
+		std::vector<uint64_t> keys(count);
+		for (uint64_t& key : keys)
+		{
+			key = random() % range;
+		}
+		return keys;
+	}
+
+	void ReportPerOperation(Benchmark::Context& context, const char* metric, double milliseconds)
+	{
+		context.Report(metric, milliseconds * 1.0e6 / kOperations, "ns/op");
+	}
+
+	//߳һʼ9Get 1Putܺʱ룩
+	double RunSharded(ShardedLRUCache<uint64_t, uint64_t>& cache, uint32_t threadCount, const std::vector<uint64_t>& keys)
+	{
+		std::atomic<uint32_t> ready = 0;
+		std::atomic<bool> start = false;
+		std::vector<std::thread> workers;
+		workers.reserve(threadCount);
+		for (uint32_t t = 0; t < threadCount; ++t)
+		{
+			workers.emplace_back([&, t]()
+			{
+				ready.fetch_add(1);
+				while (!start.load(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+				uint64_t sum = 0;
+				const size_t offset = t * 7919;
+				for (size_t i = 0; i < kOperationsPerThread; ++i)
+				{
+					const uint64_t key = keys[(offset + i) % keys.size()];
+					if (i % 10 == 9)
+					{
+						cache.Put(key, key);
+					}
+					else if (std::optional<uint64_t> value = cache.Get(key))
+					{
+						sum += *value;
+					}
+				}
+				Benchmark::DoNotOptimize(sum);
+			});
+		}
+
+		while (ready.load() != threadCount)
+		{
+			std::this_thread::yield();
+		}
+		const int64_t begin = SteadyClock::Now();
+		start.store(true, std::memory_order_release);
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		return static_cast<double>(SteadyClock::Now() - begin) / 1.0e6;
+	}
+}
+
+KJ_BENCHMARK("LRUCache hit path and sharded throughput")
+{
+	const std::vector<uint64_t> hitKeys = MakeKeys(kOperations, kEntryCount, 1);
+
+	LRUCache<uint64_t, uint64_t> cache(kEntryCount);
+	ListLRU listCache(kEntryCount);
+	for (uint64_t key = 0; key < kEntryCount; ++key)
+	{
+		cache.Put(key, key);
+		listCache.Put(key, key);
+	}
+
+	uint64_t sum = 0;
+	double milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (uint64_t key : hitKeys)
+		{
+			sum += *cache.Get(key);
+		}
+	});
+	ReportPerOperation(context, "LRUCache Get (hit)", milliseconds);
+
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (uint64_t key : hitKeys)
+		{
+			sum += *listCache.Get(key);
+		}
+	});
+	ReportPerOperation(context, "std::list LRU Get (hit)", milliseconds);
+
+	//ķΧ4󲿷PutҪ̭һĿ
+	const std::vector<uint64_t> missKeys = MakeKeys(kOperations, kEntryCount * 4, 2);
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (uint64_t key : missKeys)
+		{
+			cache.Put(key, key);
+		}
+	});
+	ReportPerOperation(context, "LRUCache Put (evicting)", milliseconds);
+
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (uint64_t key : missKeys)
+		{
+			listCache.Put(key, key);
+		}
+	});
+	ReportPerOperation(context, "std::list LRU Put (evicting)", milliseconds);
+	Benchmark::DoNotOptimize(sum);
+
+	//ƬΪ1ʱ൱һȫ
+	const std::vector<uint64_t> mixedKeys = MakeKeys(kOperationsPerThread, kEntryCount * 2, 3);
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (size_t shardCount : { size_t(1), size_t(16) })
+	{
+		ShardedLRUCache<uint64_t, uint64_t> sharded(kEntryCount, shardCount);
+		for (uint64_t key = 0; key < kEntryCount; ++key)
+		{
+			sharded.Put(key, key);
+		}
+
+		for (uint32_t threadCount = 1; ; threadCount = std::min(threadCount * 2, maxThreads))
+		{
+			milliseconds = RunSharded(sharded, threadCount, mixedKeys);
+			const double totalOperations = static_cast<double>(kOperationsPerThread) * threadCount;
+			context.Report(std::to_string(shardCount) + " shards, " + std::to_string(threadCount) + " threads",
+				totalOperations / (milliseconds * 1.0e3), "M ops/s");
+			if (threadCount == maxThreads)
+			{
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,168 @@
+#include "Benchmark/Benchmark.h"
+#include "Renderer/Resources/MeshOptimizer.h"
+#include "Renderer/Resources/Vertex.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//ȼŻǰεĶؼϲ䣨һξ˻Ρ㺸ӹ򣩣ٲŻĺʱACMR
+//ΰλñȽϣתС㵫ıԶźŶӰȽ
+namespace {
+
+	constexpr int kSphereSegments = 300;
+	constexpr int kRepeats = 3;
+
+	using TriangleKey = std::array<float, 9>;
+
+	std::vector<TriangleKey> CollectTriangles(const DynamicVertexData& vertices, const std::vector<uint32_t>& indices)
+	{
+		const AttributeView<const VertexComponents::Position> positions = vertices.GetAttributeView<VertexComponents::Position>();
+		std::vector<TriangleKey> triangles;
+		triangles.reserve(indices.size() / 3);
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			TriangleKey best = {};
+			for (int rotation = 0; rotation < 3; ++rotation)
+			{
+				TriangleKey key;
+				for (int k = 0; k < 3; ++k)
+				{
+					const VertexComponents::Position p = positions.Get(indices[i + (k + rotation) % 3]);
+					key[k * 3 + 0] = p.x;
+					key[k * 3 + 1] = p.y;
+					key[k * 3 + 2] = p.z;
+				}
+				best = rotation == 0 ? key : std::min(best, key);
+			}
+			triangles.push_back(best);
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	void Require(bool condition, const std::string& message)
+	{
+		if (!condition)
+		{
+			throw std::runtime_error(message);
+		}
+	}
+
+	//OptimizeOverdrawܺOptimizeܶܶ
+	void CheckPreservesTriangles(const std::string& name, const DynamicVertexData& vertices, const std::vector<uint32_t>& indices)
+	{
+		const std::vector<TriangleKey> expected = CollectTriangles(vertices, indices);
+
+		std::vector<uint32_t> overdrawIndices = indices;
+		MeshOptimizer::OptimizeOverdraw(overdrawIndices, vertices.GetView());
+		Require(overdrawIndices.size() == indices.size(), name + ": OptimizeOverdraw changed the index count");
+		Require(CollectTriangles(vertices, overdrawIndices) == expected, name + ": OptimizeOverdraw changed the triangles");
+
+		DynamicVertexData optimizedVertices = vertices;
+		std::vector<uint32_t> optimizedIndices = indices;
+		const MeshOptimizeReport report = MeshOptimizer::Optimize(optimizedVertices, optimizedIndices);
+		Require(report.After.TriangleCount == report.Before.TriangleCount, name + ": Optimize changed the triangle count");
+		Require(CollectTriangles(optimizedVertices, optimizedIndices) == expected, name + ": Optimize changed the triangles");
+	}
+
+	//UVweldedΪtrueʱһ㡢ȽӷҲö㣬㸽ظ
+	void BuildSphere(int segments, bool welded, DynamicVertexData& outVertices, std::vector<uint32_t>& outIndices)
+	{
+		const int columns = welded ? segments : segments + 1;
+		const int vertexCount = welded ? (segments - 1) * columns + 2 : (segments + 1) * columns;
+		auto vertexIndex = [=](int y, int x) -> uint32_t
+		{
+			if (!welded)
+			{
+				return static_cast<uint32_t>(y * columns + x);
+			}
+			if (y == 0)
+			{
+				return 0;
+			}
+			if (y == segments)
+			{
+				return static_cast<uint32_t>(vertexCount - 1);
+			}
+			return static_cast<uint32_t>(1 + (y - 1) * columns + x % columns);
+		};
+
+		outVertices = DynamicVertexData(VertexLayoutOf<SPositionNormalTexVertex>.ToLayout(), static_cast<size_t>(vertexCount));
+		const AttributeView<VertexComponents::Position> positions = outVertices.GetAttributeView<VertexComponents::Position>();
+		const AttributeView<VertexComponents::Normal> normals = outVertices.GetAttributeView<VertexComponents::Normal>();
+		for (int y = 0; y <= segments; ++y)
+		{
+			for (int x = 0; x <= segments; ++x)
+			{
+				const float theta = 3.14159265f * y / segments;
+				const float phi = 6.28318531f * x / segments;
+				const float p[3] = { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+				positions.Set(vertexIndex(y, x), { p[0], p[1], p[2] });
+				normals.Set(vertexIndex(y, x), { p[0], p[1], p[2] });
+			}
+		}
+
+		outIndices.clear();
+		for (int y = 0; y < segments; ++y)
+		{
+			for (int x = 0; x < segments; ++x)
+			{
+				const uint32_t a = vertexIndex(y, x);
+				const uint32_t b = vertexIndex(y, x + 1);
+				const uint32_t c = vertexIndex(y + 1, x);
+				const uint32_t d = vertexIndex(y + 1, x + 1);
+				outIndices.insert(outIndices.end(), { a, b, c, b, d, c });
+			}
+		}
+	}
+}
+
+KJ_BENCHMARK("MeshOptimizer triangles and timing")
+{
+	//һظģδ
+	{
+		DynamicVertexData vertices(VertexLayoutOf<SPositionNormalTexVertex>.ToLayout(), 4);
+		const AttributeView<VertexComponents::Position> positions = vertices.GetAttributeView<VertexComponents::Position>();
+		positions.Set(0, { 0.0f, 0.0f, 0.0f });
+		positions.Set(1, { 1.0f, 0.0f, 0.0f });
+		positions.Set(2, { 0.0f, 1.0f, 0.0f });
+		positions.Set(3, { 1.0f, 1.0f, 0.0f });
+		CheckPreservesTriangles("degenerate first triangle", vertices, { 0, 0, 1, 0, 1, 2, 1, 3, 2 });
+	}
+
+	DynamicVertexData vertices;
+	std::vector<uint32_t> indices;
+	BuildSphere(60, true, vertices, indices);
+	CheckPreservesTriangles("welded sphere", vertices, indices);
+
+	//˳ģûŻĵ
+	BuildSphere(kSphereSegments, false, vertices, indices);
+	std::vector<std::array<uint32_t, 3>> triangles(indices.size() / 3);
+	for (size_t t = 0; t < triangles.size(); ++t)
+	{
+		triangles[t] = { indices[t * 3 + 0], indices[t * 3 + 1], indices[t * 3 + 2] };
+	}
+	std::shuffle(triangles.begin(), triangles.end(), std::mt19937(1));
+	for (size_t t = 0; t < triangles.size(); ++t)
+	{
+		std::copy(triangles[t].begin(), triangles[t].end(), indices.begin() + t * 3);
+	}
+	CheckPreservesTriangles("shuffled sphere", vertices, indices);
+
+	MeshOptimizeReport report;
+	const double milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		DynamicVertexData optimizedVertices = vertices;
+		std::vector<uint32_t> optimizedIndices = indices;
+		report = MeshOptimizer::Optimize(optimizedVertices, optimizedIndices);
+	});
+	context.Report("triangles", static_cast<double>(report.Before.TriangleCount), "triangles");
+	context.Report("optimize (incl. copy)", milliseconds, "ms");
+	context.Report("ACMR before", report.Before.ACMR, "vertices/triangle");
+	context.Report("ACMR after", report.After.ACMR, "vertices/triangle");
+	context.Report("clusters", static_cast<double>(report.ClusterCount), "clusters");
+}
@@ -0,0 +1,149 @@
+#include "Benchmark/Benchmark.h"
+#include "Renderer/Resources/MeshletBuilder.h"
+#include "Renderer/Resources/Vertex.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+//һܼmeshlet͸׶+׶޳һ࣬Ĵ󲿷ֱ׶޳
+namespace {
+
+	constexpr int kSphereSegments = 1000;   //
+	constexpr int kCullRepeats = 50;
+
+	//Լv * MExtractFrustumPlanesһ
+	VertexKernels::Matrix4x4 Multiply(const VertexKernels::Matrix4x4& a, const VertexKernels::Matrix4x4& b)
+	{
+		VertexKernels::Matrix4x4 result = {};
+		for (int r = 0; r < 4; ++r)
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				for (int k = 0; k < 4; ++k)
+				{
+					result.m[r][c] += a.m[r][k] * b.m[k][c];
+				}
+			}
+		}
+		return result;
+	}
+
+	//ϵeyeԭ㣬y
+	VertexKernels::Matrix4x4 LookAtOrigin(const float eye[3])
+	{
+		float forward[3] = { -eye[0], -eye[1], -eye[2] };
+		float length = std::sqrt(forward[0] * forward[0] + forward[1] * forward[1] + forward[2] * forward[2]);
+		for (float& f : forward) f /= length;
+
+		//right = up x forwardup = forward x right
+		float right[3] = { forward[2], 0.0f, -forward[0] };
+		length = std::sqrt(right[0] * right[0] + right[2] * right[2]);
+		right[0] /= length;
+		right[2] /= length;
+		const float up[3] =
+		{
+			forward[1] * right[2] - forward[2] * right[1],
+			forward[2] * right[0] - forward[0] * right[2],
+			forward[0] * right[1] - forward[1] * right[0],
+		};
+
+		auto dot = [eye](const float* axis) { return axis[0] * eye[0] + axis[1] * eye[1] + axis[2] * eye[2]; };
+		return { { { right[0], up[0], forward[0], 0.0f },
+				   { right[1], up[1], forward[1], 0.0f },
+				   { right[2], up[2], forward[2], 0.0f },
+				   { -dot(right), -dot(up), -dot(forward), 1.0f } } };
+	}
+
+	//ϵ͸ͶӰӳ䵽[0, 1]
+	VertexKernels::Matrix4x4 PerspectiveFov(float fovY, float aspect, float nearZ, float farZ)
+	{
+		const float yScale = 1.0f / std::tan(fovY * 0.5f);
+		const float xScale = yScale / aspect;
+		const float range = farZ / (farZ - nearZ);
+		return { { { xScale, 0.0f, 0.0f, 0.0f },
+				   { 0.0f, yScale, 0.0f, 0.0f },
+				   { 0.0f, 0.0f, range, 1.0f },
+				   { 0.0f, 0.0f, -nearZ * range, 0.0f } } };
+	}
+
+	void BuildSphere(DynamicVertexData& outVertices, std::vector<uint32_t>& outIndices)
+	{
+		const int side = kSphereSegments + 1;
+		outVertices = DynamicVertexData(VertexLayoutOf<SPositionNormalTexVertex>.ToLayout(), static_cast<size_t>(side) * side);
+		const AttributeView<VertexComponents::Position> positions = outVertices.GetAttributeView<VertexComponents::Position>();
+		const AttributeView<VertexComponents::Normal> normals = outVertices.GetAttributeView<VertexComponents::Normal>();
+		for (int y = 0; y < side; ++y)
+		{
+			for (int x = 0; x < side; ++x)
+			{
+				const float theta = 3.14159265f * y / kSphereSegments;
+				const float phi = 6.28318531f * x / kSphereSegments;
+				const float p[3] = { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+				positions.Set(static_cast<size_t>(y) * side + x, { p[0], p[1], p[2] });
+				normals.Set(static_cast<size_t>(y) * side + x, { p[0], p[1], p[2] });
+			}
+		}
+
+		outIndices.clear();
+		outIndices.reserve(static_cast<size_t>(kSphereSegments) * kSphereSegments * 6);
+		for (int y = 0; y < kSphereSegments; ++y)
+		{
+			for (int x = 0; x < kSphereSegments; ++x)
+			{
+				const uint32_t a = static_cast<uint32_t>(y * side + x);
+				const uint32_t b = a + 1;
+				const uint32_t c = a + side;
+				const uint32_t d = c + 1;
+				outIndices.insert(outIndices.end(), { a, b, c, b, d, c });
+			}
+		}
+	}
+}
+
+KJ_BENCHMARK("MeshletCuller cull")
+{
+	DynamicVertexData vertices;
+	std::vector<uint32_t> indices;
+	BuildSphere(vertices, indices);
+
+	MeshletData meshlets;
+	const MeshletBuildReport build = MeshletBuilder::Build(vertices.GetView(), indices.data(), indices.size(), meshlets);
+	context.Report("meshlets", static_cast<double>(build.MeshletCount), "meshlets");
+	context.Report("build", build.Milliseconds, "ms");
+
+	//2.5Ұ60ȣֻõһ
+	MeshletCullParams params;
+	const float eye[3] = { 0.0f, 0.5f, -2.5f };
+	std::copy(eye, eye + 3, params.CameraPosition);
+	const VertexKernels::Matrix4x4 viewProjection = Multiply(LookAtOrigin(eye), PerspectiveFov(1.0471976f, 16.0f / 9.0f, 0.1f, 100.0f));
+	MeshletCuller::ExtractFrustumPlanes(viewProjection, params.FrustumPlanes);
+
+	const MeshletDataView view = meshlets.GetView();
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (uint32_t threadCount = 1; ; threadCount = std::min(threadCount * 2, maxThreads))
+	{
+		params.ThreadCount = threadCount;
+		MeshletCullResult result;
+		double best = 0.0;
+		for (int i = 0; i < kCullRepeats; ++i)
+		{
+			result = MeshletCuller::Cull(view, params);
+			best = i == 0 ? result.Milliseconds : std::min(best, result.Milliseconds);
+		}
+
+		const std::string suffix = ", " + std::to_string(result.ThreadCount) + " threads";
+		context.Report("cull" + suffix, best * 1.0e3, "us");
+		context.Report("cull rate" + suffix, static_cast<double>(view.MeshletCount) / (best * 1.0e3), "M meshlets/s");
+		if (threadCount == 1)
+		{
+			context.Report("visible", static_cast<double>(result.VisibleMeshlets.size()), "meshlets");
+			context.Report("frustum culled", static_cast<double>(result.FrustumCulledCount), "meshlets");
+			context.Report("cone culled", static_cast<double>(result.ConeCulledCount), "meshlets");
+		}
+		if (threadCount == maxThreads)
+		{
+			break;
+		}
+	}
+}
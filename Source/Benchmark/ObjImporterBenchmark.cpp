@@ -0,0 +1,135 @@
+#include "Benchmark/Benchmark.h"
+#include "Renderer/Resources/ObjImporter.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+//һ״ĴOBJļv/vt/vnı棩дʱĿ¼⵼£MB/sɾ
+//vtvn±vʱ߿·ʱҪ(v, vt, vn)ȥأָһ
+namespace {
+
+	constexpr int kGridSize = 1000;     //(kGridSize+1)^2λãkGridSize^2ıΣһļһٶMB
+	constexpr int kRepeats = 3;
+
+	void WriteGridObj(const std::filesystem::path& path, bool sharedIndices)
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file)
+		{
+			throw std::runtime_error("Cannot create " + path.string());
+		}
+
+		std::string buffer;
+		buffer.reserve(1 << 20);
+		char line[128];
+		auto append = [&](int length)
+		{
+			buffer.append(line, static_cast<size_t>(length));
+			if (buffer.size() > (1 << 20) - sizeof(line))
+			{
+				file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				buffer.clear();
+			}
+		};
+
+		const int side = kGridSize + 1;
+		for (int y = 0; y < side; ++y)
+		{
+			for (int x = 0; x < side; ++x)
+			{
+				append(std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", x * 0.01, y * 0.01, 0.001 * ((x * 7 + y * 13) % 97)));
+			}
+		}
+		for (int y = 0; y < side; ++y)
+		{
+			for (int x = 0; x < side; ++x)
+			{
+				append(std::snprintf(line, sizeof(line), "vt %.6f %.6f\n", x / double(kGridSize), y / double(kGridSize)));
+			}
+		}
+		for (int y = 0; y < side; ++y)
+		{
+			for (int x = 0; x < side; ++x)
+			{
+				append(std::snprintf(line, sizeof(line), "vn %.6f %.6f %.6f\n", 0.0, 0.0, 1.0));
+			}
+		}
+		for (int y = 0; y < kGridSize; ++y)
+		{
+			for (int x = 0; x < kGridSize; ++x)
+			{
+				const int a = y * side + x + 1;
+				const int b = a + 1;
+				const int c = a + side + 1;
+				const int d = a + side;
+				//ʱ߶ָһvn(v, vt, vn)Ҫȥ
+				const int na = sharedIndices ? a : 1;
+				const int nb = sharedIndices ? b : 1;
+				const int nc = sharedIndices ? c : 1;
+				const int nd = sharedIndices ? d : 1;
+				append(std::snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, na, b, b, nb, c, c, nc, d, d, nd));
+			}
+		}
+		file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	}
+
+	void RunImport(Benchmark::Context& context, const std::filesystem::path& path, const std::string& label, uint32_t threadCount)
+	{
+		ObjImportOptions options;
+		options.ThreadCount = threadCount;
+
+		ObjImportStats best;
+		for (int i = 0; i <= kRepeats; ++i)
+		{
+			ObjImportResult result = ObjImporter::ImportFile(path, options);
+			if (!result.Success)
+			{
+				throw std::runtime_error(result.Error);
+			}
+			//һֻǰļҳ
+			if (i > 0 && (best.TotalMilliseconds == 0.0 || result.Stats.TotalMilliseconds < best.TotalMilliseconds))
+			{
+				best = result.Stats;
+			}
+		}
+
+		const std::string prefix = label + ", " + std::to_string(best.ThreadCount) + " threads";
+		context.Report(prefix + " throughput", best.GetThroughputMBps(), "MB/s");
+		context.Report(prefix + " parse", best.ParseMilliseconds, "ms");
+		context.Report(prefix + " merge", best.MergeMilliseconds, "ms");
+		context.Report(prefix + " build", best.BuildMilliseconds, "ms");
+	}
+}
+
+KJ_BENCHMARK("ObjImporter throughput")
+{
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	const std::filesystem::path directory = std::filesystem::temp_directory_path();
+
+	for (bool sharedIndices : { true, false })
+	{
+		const std::filesystem::path path = directory / (sharedIndices ? "KaiJingBenchmarkShared.obj" : "KaiJingBenchmarkWelded.obj");
+		WriteGridObj(path, sharedIndices);
+		const std::string label = sharedIndices ? "shared indices" : "welded";
+		context.Report(label + " file size", static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0), "MB");
+
+		try
+		{
+			RunImport(context, path, label, 1);
+			if (maxThreads > 1)
+			{
+				RunImport(context, path, label, maxThreads);
+			}
+		}
+		catch (...)
+		{
+			std::filesystem::remove(path);
+			throw;
+		}
+		std::filesystem::remove(path);
+	}
+}
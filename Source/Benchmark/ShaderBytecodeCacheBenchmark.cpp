@@ -0,0 +1,129 @@
+#include "Benchmark/Benchmark.h"
+#include "Benchmark/FakeShaderCompiler.h"
+#include "Renderer/Core/ShaderBytecodeCache.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//ʱĿ¼һһͷļɫüٱֽ뻺棺ȫ벢д̣ȫУ
+//ٸһͷļɫʧЧر࣬ɾĿ¼
+namespace {
+
+	constexpr int kShaderCount = 256;
+	constexpr int kLinesPerShader = 200;
+
+	void WriteTextFile(const std::filesystem::path& path, const std::string& text)
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file)
+		{
+			throw std::runtime_error("Cannot create " + path.string());
+		}
+		file << text;
+	}
+
+	void Require(bool condition, const std::string& message)
+	{
+		if (!condition)
+		{
+			throw std::runtime_error(message);
+		}
+	}
+
+	std::vector<ShaderCompileRequest> WriteShaders(const std::filesystem::path& directory)
+	{
+		WriteTextFile(directory / "Common.hlsli", "cbuffer PassConstants : register(b0) { float4x4 gViewProj; };\n");
+
+		std::vector<ShaderCompileRequest> requests;
+		for (int i = 0; i < kShaderCount; ++i)
+		{
+			std::string source = "#include \"Common.hlsli\"\n";
+			for (int line = 0; line < kLinesPerShader; ++line)
+			{
+				source += "static const float gValue" + std::to_string(line) + " = " + std::to_string(i * kLinesPerShader + line) + ".0;\n";
+			}
+			source += "float4 PS() : SV_Target { return gValue0; }\n";
+
+			ShaderCompileRequest request;
+			request.SourcePath = directory / ("Shader" + std::to_string(i) + ".hlsl");
+			request.EntryPoint = "PS";
+			request.Target = "ps_5_1";
+			WriteTextFile(request.SourcePath, source);
+			requests.push_back(std::move(request));
+		}
+		return requests;
+	}
+
+	//
+	size_t CompileAll(ShaderBytecodeCache& cache, const std::vector<ShaderCompileRequest>& requests)
+	{
+		size_t hits = 0;
+		for (const ShaderCompileRequest& request : requests)
+		{
+			const ShaderCacheResult result = cache.GetOrCompile(request);
+			Require(result.Success, request.SourcePath.string() + ": " + result.Errors);
+			hits += result.FromCache ? 1 : 0;
+		}
+		return hits;
+	}
+
+	void RunCacheBenchmark(Benchmark::Context& context, const std::filesystem::path& directory)
+	{
+		const std::vector<ShaderCompileRequest> requests = WriteShaders(directory);
+		FakeShaderCompiler compiler;
+
+		//ÿһµĿĿ¼һε
+		std::filesystem::path cacheDirectory;
+		int coldRun = 0;
+		const double coldMilliseconds = Benchmark::BestOfMilliseconds(2, [&]()
+		{
+			cacheDirectory = directory / ("Cache" + std::to_string(coldRun++));
+			const uint32_t compiles = compiler.GetCompileCount();
+			ShaderBytecodeCache cache(cacheDirectory, compiler);
+			Require(!cache.LoadIndex(), "Cold start found an index");
+			Require(CompileAll(cache, requests) == 0, "Cold start hit the cache");
+			Require(compiler.GetCompileCount() - compiles == kShaderCount, "Cold start didn't compile every shader");
+			Require(cache.SaveIndex(), "Cannot save the cache index");
+		});
+
+		const uint32_t compiles = compiler.GetCompileCount();
+		const double warmMilliseconds = Benchmark::BestOfMilliseconds(3, [&]()
+		{
+			ShaderBytecodeCache cache(cacheDirectory, compiler);
+			Require(cache.LoadIndex(), "Cannot load the cache index");
+			Require(CompileAll(cache, requests) == requests.size(), "Warm start missed the cache");
+		});
+		Require(compiler.GetCompileCount() == compiles, "Warm start called the compiler");
+
+		//ͷļԤͱ䣬ɫҪر
+		WriteTextFile(directory / "Common.hlsli", "cbuffer PassConstants : register(b0) { float4x4 gViewProj; float4 gEyePos; };\n");
+		ShaderBytecodeCache cache(cacheDirectory, compiler);
+		Require(cache.LoadIndex(), "Cannot load the cache index");
+		Require(CompileAll(cache, requests) == 0, "Editing the include didn't invalidate every shader");
+
+		context.Report("shaders", static_cast<double>(kShaderCount), "shaders");
+		context.Report("cold (compile + write)", coldMilliseconds, "ms");
+		context.Report("warm (load index + read)", warmMilliseconds, "ms");
+		context.Report("speedup", coldMilliseconds / warmMilliseconds, "x");
+	}
+}
+
+KJ_BENCHMARK("ShaderBytecodeCache cold and warm start")
+{
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "KaiJingShaderCacheBenchmark";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	try
+	{
+		RunCacheBenchmark(context, directory);
+	}
+	catch (...)
+	{
+		std::filesystem::remove_all(directory);
+		throw;
+	}
+	std::filesystem::remove_all(directory);
+}
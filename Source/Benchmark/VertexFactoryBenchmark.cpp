@@ -0,0 +1,108 @@
+#include "Benchmark/Benchmark.h"
+#include "Renderer/Resources/Vertex.h"
+#include "Renderer/Resources/VertexFactory.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//߳ͬʱעGet<T>()ͱգGet(typeId)Ĺϣ
+//ԭunordered_map<std::string>ÿβѯһstring
+namespace {
+
+	constexpr size_t kLookupsPerThread = 2000000;
+
+	//̵߳һʼܺʱ룩
+	template<typename Lookup>
+	double RunContended(uint32_t threadCount, const Lookup& lookup)
+	{
+		std::atomic<uint32_t> ready = 0;
+		std::atomic<bool> start = false;
+		std::vector<std::thread> workers;
+		workers.reserve(threadCount);
+		for (uint32_t t = 0; t < threadCount; ++t)
+		{
+			workers.emplace_back([&ready, &start, &lookup]()
+			{
+				ready.fetch_add(1);
+				while (!start.load(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+				size_t found = 0;
+				for (size_t i = 0; i < kLookupsPerThread; ++i)
+				{
+					found += lookup(i) != nullptr;
+				}
+				Benchmark::DoNotOptimize(found);
+			});
+		}
+
+		while (ready.load() != threadCount)
+		{
+			std::this_thread::yield();
+		}
+		const int64_t begin = SteadyClock::Now();
+		start.store(true, std::memory_order_release);
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		return static_cast<double>(SteadyClock::Now() - begin) / 1.0e6;
+	}
+}
+
+KJ_BENCHMARK("SVertexFactoryRegistry contention")
+{
+	SVertexFactoryRegistry::RegisterAll();
+
+	const char* typeIds[] =
+	{
+		SVertexFactory<SPositionColorVertex>::Get().GetTypeId(),
+		SVertexFactory<SPositionNormalTexVertex>::Get().GetTypeId(),
+		SVertexFactory<SPositionNormalTexTangentVertex>::Get().GetTypeId(),
+		SVertexFactory<SPositionColorNormalTexVertex>::Get().GetTypeId(),
+	};
+
+	std::mutex legacyMutex;
+	std::unordered_map<std::string, SVertexFactoryBase*> legacyMap;
+	for (const char* typeId : typeIds)
+	{
+		legacyMap.emplace(typeId, SVertexFactoryRegistry::Get(typeId));
+	}
+
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (uint32_t threadCount = 1; ; threadCount = std::min(threadCount * 2, maxThreads))
+	{
+		const double totalLookups = static_cast<double>(kLookupsPerThread) * threadCount;
+		const std::string suffix = ", " + std::to_string(threadCount) + " threads";
+
+		double milliseconds = RunContended(threadCount, [](size_t i)
+		{
+			return (i & 1) != 0 ? SVertexFactoryRegistry::Get<SPositionNormalTexVertex>() : SVertexFactoryRegistry::Get<SPositionColorVertex>();
+		});
+		context.Report("Get<T>" + suffix, totalLookups / (milliseconds * 1.0e3), "M lookups/s");
+
+		milliseconds = RunContended(threadCount, [&typeIds](size_t i)
+		{
+			return SVertexFactoryRegistry::Get(typeIds[i & 3]);
+		});
+		context.Report("Get(typeId)" + suffix, totalLookups / (milliseconds * 1.0e3), "M lookups/s");
+
+		milliseconds = RunContended(threadCount, [&typeIds, &legacyMutex, &legacyMap](size_t i) -> SVertexFactoryBase*
+		{
+			std::lock_guard<std::mutex> lock(legacyMutex);
+			auto it = legacyMap.find(std::string(typeIds[i & 3]));
+			return it != legacyMap.end() ? it->second : nullptr;
+		});
+		context.Report("locked string map" + suffix, totalLookups / (milliseconds * 1.0e3), "M lookups/s");
+
+		if (threadCount == maxThreads)
+		{
+			break;
+		}
+	}
+}
@@ -0,0 +1,123 @@
+#include "Benchmark/Benchmark.h"
+#include "Renderer/Resources/Vertex.h"
+#include "Renderer/Resources/VertexLayoutRegistry.h"
+#include <unordered_map>
+#include <vector>
+
+//ֱȽϺϣĿԪرȽϣԭoperator==ȱȹϣoperator==פľ
+namespace {
+
+	constexpr size_t kIterations = 10000000;
+	constexpr int kRepeats = 5;
+	constexpr size_t kLayoutCount = 5;  //ڳȡģȱıȽϱ
+
+	//ԭıȽϷʽϣԪرȽֶ
+	bool CompareElementwise(const VertexLayout& a, const VertexLayout& b)
+	{
+		if (a.GetElementCount() != b.GetElementCount() || a.GetStride() != b.GetStride())
+		{
+			return false;
+		}
+		for (uint32_t i = 0; i < a.GetElementCount(); ++i)
+		{
+			if (!(a.GetElement(i) == b.GetElement(i)))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void ReportPerOperation(Benchmark::Context& context, const char* metric, double milliseconds)
+	{
+		context.Report(metric, milliseconds * 1.0e6 / kIterations, "ns/op");
+	}
+}
+
+KJ_BENCHMARK("VertexLayout compare and lookup")
+{
+	//ò֣Կһݣ֤Ƚϵݶͬһ
+	const std::vector<VertexLayout> layouts =
+	{
+		VertexLayoutOf<SPositionColorVertex>.ToLayout(),
+		VertexLayoutOf<SPositionNormalTexVertex>.ToLayout(),
+		VertexLayoutOf<SPositionNormalTexTangentVertex>.ToLayout(),
+		VertexLayoutOf<SPositionNormalTexTangentBinormalVertex>.ToLayout(),
+		VertexLayoutOf<SPositionColorNormalTexVertex>.ToLayout(),
+	};
+	const std::vector<VertexLayout> copies = layouts;
+
+	std::vector<VertexLayoutHandle> handles;
+	std::vector<VertexLayoutHandle> handleCopies;
+	for (size_t i = 0; i < kLayoutCount; ++i)
+	{
+		handles.push_back(VertexLayoutRegistry::Intern(layouts[i]));
+		handleCopies.push_back(VertexLayoutRegistry::Intern(copies[i]));
+	}
+
+	//ii*3ģkLayoutCountʱͬȺͲ
+	size_t matches = 0;
+	double milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (size_t i = 0; i < kIterations; ++i)
+		{
+			matches += CompareElementwise(layouts[i % kLayoutCount], copies[i * 3 % kLayoutCount]);
+		}
+	});
+	ReportPerOperation(context, "compare element-wise", milliseconds);
+
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (size_t i = 0; i < kIterations; ++i)
+		{
+			matches += layouts[i % kLayoutCount] == copies[i * 3 % kLayoutCount];
+		}
+	});
+	ReportPerOperation(context, "compare VertexLayout (hash first)", milliseconds);
+
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (size_t i = 0; i < kIterations; ++i)
+		{
+			matches += handles[i % kLayoutCount] == handleCopies[i * 3 % kLayoutCount];
+		}
+	});
+	ReportPerOperation(context, "compare VertexLayoutHandle", milliseconds);
+
+	std::unordered_map<VertexLayout, size_t> byLayout;
+	std::unordered_map<VertexLayoutHandle, size_t> byHandle;
+	for (size_t i = 0; i < kLayoutCount; ++i)
+	{
+		byLayout.emplace(layouts[i], i);
+		byHandle.emplace(handles[i], i);
+	}
+
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (size_t i = 0; i < kIterations; ++i)
+		{
+			matches += byLayout.find(copies[i % kLayoutCount])->second;
+		}
+	});
+	ReportPerOperation(context, "map lookup by VertexLayout", milliseconds);
+
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (size_t i = 0; i < kIterations; ++i)
+		{
+			matches += byHandle.find(handleCopies[i % kLayoutCount])->second;
+		}
+	});
+	ReportPerOperation(context, "map lookup by VertexLayoutHandle", milliseconds);
+
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		for (size_t i = 0; i < kIterations; ++i)
+		{
+			matches += VertexLayoutRegistry::Intern(copies[i % kLayoutCount]) == handles[i % kLayoutCount];
+		}
+	});
+	ReportPerOperation(context, "Intern existing layout", milliseconds);
+
+	Benchmark::DoNotOptimize(matches);
+}
@@ -0,0 +1,84 @@
+#include "Benchmark/Benchmark.h"
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/DynamicVertexStreams.h"
+#include "Renderer/Resources/Vertex.h"
+#include "Renderer/Resources/VertexKernels.h"
+
+//ֻ任λãֻΧУʱ洢ͰԷ洢£Լִ洢֮תĿ
+namespace {
+
+	constexpr size_t kVertexCount = 2000000;
+	constexpr int kRepeats = 5;
+
+	void ReportThroughput(Benchmark::Context& context, const std::string& metric, double milliseconds)
+	{
+		context.Report(metric, static_cast<double>(kVertexCount) / (milliseconds * 1.0e3), "M vertices/s");
+	}
+}
+
+KJ_BENCHMARK("DynamicVertexStreams bulk transform")
+{
+	DynamicVertexData interleaved(VertexLayoutOf<SPositionNormalTexTangentVertex>.ToLayout(), kVertexCount);
+	const AttributeView<VertexComponents::Position> positions = interleaved.GetAttributeView<VertexComponents::Position>();
+	for (size_t i = 0; i < kVertexCount; ++i)
+	{
+		positions.Set(i, { static_cast<float>(i % 1000), static_cast<float>(i / 1000), 0.5f });
+	}
+
+	double milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		DynamicVertexStreams converted(interleaved);
+		Benchmark::DoNotOptimize(converted.GetVertexCount());
+	});
+	ReportThroughput(context, "interleaved to streams", milliseconds);
+
+	DynamicVertexStreams streams(interleaved);
+	DynamicVertexData roundTrip;
+	milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+	{
+		streams.ToInterleaved(roundTrip);
+	});
+	ReportThroughput(context, "streams to interleaved", milliseconds);
+
+	//λתƽƣ任ֵҲᷢɢ
+	VertexKernels::Matrix4x4 matrix = VertexKernels::Matrix4x4::Identity();
+	matrix.m[0][0] = 0.0f; matrix.m[0][1] = 1.0f;
+	matrix.m[1][0] = -1.0f; matrix.m[1][1] = 0.0f;
+	matrix.m[3][2] = 0.25f;
+
+	const AttributeView<VertexComponents::Position> streamPositions = streams.GetStreamView<VertexComponents::Position>();
+	for (VertexKernels::SimdLevel level : { VertexKernels::SimdLevel::Scalar, VertexKernels::SimdLevel::SSE2, VertexKernels::SimdLevel::AVX2 })
+	{
+		if (level > VertexKernels::GetSupportedSimdLevel())
+		{
+			continue;
+		}
+		VertexKernels::SetSimdLevel(level);
+		const std::string suffix = level == VertexKernels::SimdLevel::Scalar ? " (scalar)" : level == VertexKernels::SimdLevel::SSE2 ? " (SSE2)" : " (AVX2)";
+
+		milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+		{
+			VertexKernels::TransformPositions(positions.GetRawPtr(0), positions.GetStride(), kVertexCount, matrix);
+		});
+		ReportThroughput(context, "transform positions, interleaved" + suffix, milliseconds);
+
+		milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+		{
+			VertexKernels::TransformPositions(streamPositions.GetRawPtr(0), streamPositions.GetStride(), kVertexCount, matrix);
+		});
+		ReportThroughput(context, "transform positions, streams" + suffix, milliseconds);
+
+		milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+		{
+			Benchmark::DoNotOptimize(VertexKernels::ComputeBounds(positions.GetRawPtr(0), positions.GetStride(), kVertexCount));
+		});
+		ReportThroughput(context, "bounds, interleaved" + suffix, milliseconds);
+
+		milliseconds = Benchmark::BestOfMilliseconds(kRepeats, [&]()
+		{
+			Benchmark::DoNotOptimize(VertexKernels::ComputeBounds(streamPositions.GetRawPtr(0), streamPositions.GetStride(), kVertexCount));
+		});
+		ReportThroughput(context, "bounds, streams" + suffix, milliseconds);
+	}
+	VertexKernels::SetSimdLevel(VertexKernels::GetSupportedSimdLevel());
+}
@@ -0,0 +1,400 @@
+#include "Core/Compression.h"
+#include <cstring>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define KJ_COMPRESSION_SSE2 1
+#include <emmintrin.h>
+#else
+#define KJ_COMPRESSION_SSE2 0
+#endif
+
+namespace
+{
+	constexpr size_t kMinMatch = 4;
+	constexpr size_t kMaxOffset = 65535;
+	constexpr uint32_t kHashBits = 16;
+	constexpr size_t kShuffleBlock = 1024;		//ShuffleÿԪ
+
+	inline uint32_t Read32(const uint8_t* p)
+	{
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	inline uint32_t HashSequence(uint32_t sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - kHashBits);
+	}
+
+	//>=15ʱtoken֮255
+	inline bool WriteLength(uint8_t*& out, const uint8_t* outEnd, size_t length)
+	{
+		for (; length >= 255; length -= 255)
+		{
+			if (out == outEnd)
+			{
+				return false;
+			}
+			*out++ = 255;
+		}
+		if (out == outEnd)
+		{
+			return false;
+		}
+		*out++ = static_cast<uint8_t>(length);
+		return true;
+	}
+
+	inline bool ReadLength(const uint8_t*& in, const uint8_t* inEnd, size_t& length)
+	{
+		uint8_t byte;
+		do
+		{
+			if (in == inEnd)
+			{
+				return false;
+			}
+			byte = *in++;
+			length += byte;
+		} while (byte == 255);
+		return true;
+	}
+
+	//һУ + һʱƥ
+	bool WriteSequence(uint8_t*& out, const uint8_t* outEnd, const uint8_t* literals, size_t literalLength,
+		size_t offset, size_t matchLength)
+	{
+		if (out == outEnd)
+		{
+			return false;
+		}
+		uint8_t* token = out++;
+		const size_t matchCode = matchLength != 0 ? matchLength - kMinMatch : 0;
+		*token = static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4 | (matchCode < 15 ? matchCode : 15));
+
+		if (literalLength >= 15 && !WriteLength(out, outEnd, literalLength - 15))
+		{
+			return false;
+		}
+		if (static_cast<size_t>(outEnd - out) < literalLength)
+		{
+			return false;
+		}
+		if (literalLength > 0)
+		{
+			std::memcpy(out, literals, literalLength);
+			out += literalLength;
+		}
+
+		if (matchLength == 0)
+		{
+			return true;
+		}
+		if (outEnd - out < 2)
+		{
+			return false;
+		}
+		*out++ = static_cast<uint8_t>(offset);
+		*out++ = static_cast<uint8_t>(offset >> 8);
+		return matchCode < 15 || WriteLength(out, outEnd, matchCode - 15);
+	}
+
+#if KJ_COMPRESSION_SSE2
+	//16x16ֽתãout[b]ĵaֽ = in[a]ĵbֽ
+	//unpackÿְѽȷ8163264λ
+	inline void Transpose16x16(const __m128i in[16], __m128i out[16])
+	{
+		__m128i a[16], b[16], c[16];
+		//a[i]2i2i+1еĵ0~7ֽڽa[8+i]8~15ֽ
+		for (int i = 0; i < 8; ++i)
+		{
+			a[i] = _mm_unpacklo_epi8(in[2 * i], in[2 * i + 1]);
+			a[8 + i] = _mm_unpackhi_epi8(in[2 * i], in[2 * i + 1]);
+		}
+		//b[q * 4 + j]4j~4j+3еĵ4q~4q+3ֽ
+		for (int half = 0; half < 2; ++half)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				b[half * 8 + j] = _mm_unpacklo_epi16(a[half * 8 + 2 * j], a[half * 8 + 2 * j + 1]);
+				b[half * 8 + 4 + j] = _mm_unpackhi_epi16(a[half * 8 + 2 * j], a[half * 8 + 2 * j + 1]);
+			}
+		}
+		//c[q * 4 + h * 2 + m]8m~8m+7еĵ4q+2h4q+2h+1ֽ
+		for (int q = 0; q < 4; ++q)
+		{
+			for (int m = 0; m < 2; ++m)
+			{
+				c[q * 4 + m] = _mm_unpacklo_epi32(b[q * 4 + 2 * m], b[q * 4 + 2 * m + 1]);
+				c[q * 4 + 2 + m] = _mm_unpackhi_epi32(b[q * 4 + 2 * m], b[q * 4 + 2 * m + 1]);
+			}
+		}
+		for (int q = 0; q < 4; ++q)
+		{
+			for (int h = 0; h < 2; ++h)
+			{
+				out[q * 4 + h * 2] = _mm_unpacklo_epi64(c[q * 4 + h * 2], c[q * 4 + h * 2 + 1]);
+				out[q * 4 + h * 2 + 1] = _mm_unpackhi_epi64(c[q * 4 + h * 2], c[q * 4 + h * 2 + 1]);
+			}
+		}
+	}
+
+	//ÿ16Ԫ x 16ֽλãstride16ıʱһŲǰһصظдֵͬ
+	//شԪʣµɱѭβ
+	size_t ShuffleSSE2(const uint8_t* in, size_t count, uint32_t stride, uint8_t* out)
+	{
+		if (stride < 16)
+		{
+			return 0;
+		}
+		const size_t simdCount = count & ~size_t(15);
+		__m128i rows[16], lanes[16];
+		for (size_t i = 0; i < simdCount; i += 16)
+		{
+			for (uint32_t k = 0; k < stride; k += 16)
+			{
+				const uint32_t k0 = k + 16 <= stride ? k : stride - 16;
+				for (int r = 0; r < 16; ++r)
+				{
+					rows[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + (i + r) * stride + k0));
+				}
+				Transpose16x16(rows, lanes);
+				for (int r = 0; r < 16; ++r)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + (k0 + r) * count + i), lanes[r]);
+				}
+			}
+		}
+		return simdCount;
+	}
+
+	size_t UnshuffleSSE2(const uint8_t* in, size_t count, uint32_t stride, uint8_t* out)
+	{
+		if (stride < 16)
+		{
+			return 0;
+		}
+		const size_t simdCount = count & ~size_t(15);
+		__m128i lanes[16], rows[16];
+		for (size_t i = 0; i < simdCount; i += 16)
+		{
+			for (uint32_t k = 0; k < stride; k += 16)
+			{
+				const uint32_t k0 = k + 16 <= stride ? k : stride - 16;
+				for (int r = 0; r < 16; ++r)
+				{
+					lanes[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + (k0 + r) * count + i));
+				}
+				Transpose16x16(lanes, rows);
+				for (int r = 0; r < 16; ++r)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + (i + r) * stride + k0), rows[r]);
+				}
+			}
+		}
+		return simdCount;
+	}
+#endif
+}
+
+
+size_t Compression::GetMaxCompressedSize(size_t size)
+{
+	return size + size / 255 + 16;
+}
+
+
+size_t Compression::CompressLZ(const void* source, size_t size, void* destination, size_t capacity)
+{
+	const uint8_t* in = static_cast<const uint8_t*>(source);
+	uint8_t* out = static_cast<uint8_t*>(destination);
+	uint8_t* outEnd = out + capacity;
+
+	//λ+10ʾ
+	std::vector<uint32_t> table(size_t(1) << kHashBits, 0);
+
+	size_t anchor = 0;
+	size_t position = 0;
+	size_t misses = 0;
+	//λó4GBʱ治£ɵ÷п
+	while (size >= kMinMatch && position + kMinMatch <= size && position < UINT32_MAX)
+	{
+		const uint32_t sequence = Read32(in + position);
+		const uint32_t hash = HashSequence(sequence);
+		const size_t candidate = table[hash];
+		table[hash] = static_cast<uint32_t>(position + 1);
+
+		if (candidate != 0 && position - (candidate - 1) <= kMaxOffset && Read32(in + candidate - 1) == sequence)
+		{
+			const size_t matchStart = candidate - 1;
+			size_t length = kMinMatch;
+			while (position + length < size && in[matchStart + length] == in[position + length])
+			{
+				++length;
+			}
+
+			if (!WriteSequence(out, outEnd, in + anchor, position - anchor, position - matchStart, length))
+			{
+				return 0;
+			}
+			position += length;
+			anchor = position;
+			misses = 0;
+			continue;
+		}
+
+		//ҲƥʱԽԽ󣬲ѹҲܺܿɨȥ
+		position += 1 + (misses++ >> 6);
+	}
+
+	if (!WriteSequence(out, outEnd, in + anchor, size - anchor, 0, 0))
+	{
+		return 0;
+	}
+	return static_cast<size_t>(out - static_cast<uint8_t*>(destination));
+}
+
+
+bool Compression::DecompressLZ(const void* source, size_t size, void* destination, size_t rawSize)
+{
+	const uint8_t* in = static_cast<const uint8_t*>(source);
+	const uint8_t* inEnd = in + size;
+	uint8_t* outBegin = static_cast<uint8_t*>(destination);
+	uint8_t* out = outBegin;
+	uint8_t* outEnd = outBegin + rawSize;
+
+	while (in < inEnd)
+	{
+		const uint8_t token = *in++;
+
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !ReadLength(in, inEnd, literalLength))
+		{
+			return false;
+		}
+		if (static_cast<size_t>(inEnd - in) < literalLength || static_cast<size_t>(outEnd - out) < literalLength)
+		{
+			return false;
+		}
+		if (literalLength > 0)
+		{
+			std::memcpy(out, in, literalLength);
+			in += literalLength;
+			out += literalLength;
+		}
+
+		//һֻ
+		if (in == inEnd)
+		{
+			break;
+		}
+
+		if (inEnd - in < 2)
+		{
+			return false;
+		}
+		const size_t offset = static_cast<size_t>(in[0]) | static_cast<size_t>(in[1]) << 8;
+		in += 2;
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLength(in, inEnd, matchLength))
+		{
+			return false;
+		}
+		matchLength += kMinMatch;
+
+		if (offset == 0 || offset > static_cast<size_t>(out - outBegin) || static_cast<size_t>(outEnd - out) < matchLength)
+		{
+			return false;
+		}
+		//صƥΪoffsetظģʽÿһдĲ־ͷȡoffsetıûдֽ
+		for (size_t distance = offset; matchLength > 0; distance *= 2)
+		{
+			const size_t count = matchLength < distance ? matchLength : distance;
+			std::memcpy(out, out - distance, count);
+			out += count;
+			matchLength -= count;
+		}
+	}
+	return out == outEnd;
+}
+
+
+void Compression::ShuffleBytes(const void* source, size_t size, uint32_t stride, void* destination)
+{
+	const uint8_t* in = static_cast<const uint8_t*>(source);
+	uint8_t* out = static_cast<uint8_t*>(destination);
+	if (size == 0)
+	{
+		return;
+	}
+	if (stride <= 1)
+	{
+		std::memcpy(out, in, size);
+		return;
+	}
+
+	//ֿһL2ÿֽλöɨһ
+	const size_t count = size / stride;
+#if KJ_COMPRESSION_SSE2
+	const size_t done = ShuffleSSE2(in, count, stride, out);
+#else
+	const size_t done = 0;
+#endif
+	for (size_t begin = done; begin < count; begin += kShuffleBlock)
+	{
+		const size_t end = begin + kShuffleBlock < count ? begin + kShuffleBlock : count;
+		for (uint32_t k = 0; k < stride; ++k)
+		{
+			uint8_t* lane = out + k * count;
+			for (size_t i = begin; i < end; ++i)
+			{
+				lane[i] = in[i * stride + k];
+			}
+		}
+	}
+	if (size > count * stride)
+	{
+		std::memcpy(out + count * stride, in + count * stride, size - count * stride);
+	}
+}
+
+
+void Compression::UnshuffleBytes(const void* source, size_t size, uint32_t stride, void* destination)
+{
+	const uint8_t* in = static_cast<const uint8_t*>(source);
+	uint8_t* out = static_cast<uint8_t*>(destination);
+	if (size == 0)
+	{
+		return;
+	}
+	if (stride <= 1)
+	{
+		std::memcpy(out, in, size);
+		return;
+	}
+
+	const size_t count = size / stride;
+#if KJ_COMPRESSION_SSE2
+	const size_t done = UnshuffleSSE2(in, count, stride, out);
+#else
+	const size_t done = 0;
+#endif
+	for (size_t begin = done; begin < count; begin += kShuffleBlock)
+	{
+		const size_t end = begin + kShuffleBlock < count ? begin + kShuffleBlock : count;
+		for (uint32_t k = 0; k < stride; ++k)
+		{
+			const uint8_t* lane = in + k * count;
+			for (size_t i = begin; i < end; ++i)
+			{
+				out[i * stride + k] = lane[i];
+			}
+		}
+	}
+	if (size > count * stride)
+	{
+		std::memcpy(out + count * stride, in + count * stride, size - count * stride);
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//Դļõѹ
+//LZLZ4ֽtoken4λȡ4λƥ䳤-42ֽƫƣ255ӣֻѹ죬ѹȴҪ
+//ShuffleÿԪصĵkֽŵһ𣬶/ֶ¼ѹѹܸ߲
+//ʽԼģ͹ٷLZ4
+
+
+namespace Compression
+{
+	//ѹܴСȫ
+	size_t GetMaxCompressedSize(size_t size);
+
+	//destinationҪGetMaxCompressedSize(size)ֽڣѹСŲ·0
+	size_t CompressLZ(const void* source, size_t size, void* destination, size_t capacity);
+
+	//ѹdestinationrawSizeõԭʼС𻵡ԽʱfalseдԽ
+	bool DecompressLZ(const void* source, size_t size, void* destination, size_t rawSize);
+
+	//strideֽڣdestination[k * count + i] = source[i * stride + k]һԪصβԭ
+	void ShuffleBytes(const void* source, size_t size, uint32_t stride, void* destination);
+	void UnshuffleBytes(const void* source, size_t size, uint32_t stride, void* destination);
+}
@@ -0,0 +1,227 @@
+#include "Core/FileWatcher.h"
+#include <algorithm>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+
+FileWatcher::FileWatcher(const std::filesystem::path& directory, bool recursive, bool forcePolling)
+	: m_recursive(recursive)
+{
+	std::error_code error;
+	m_directory = std::filesystem::weakly_canonical(directory, error);
+	if (error || !std::filesystem::is_directory(m_directory, error))
+	{
+		return;
+	}
+
+#if defined(__linux__)
+	if (!forcePolling && InitializeInotify())
+	{
+		m_backend = Backend::Inotify;
+		return;
+	}
+#else
+	(void)forcePolling;
+#endif
+
+	//һſգ֮ı仯
+	Scan(m_snapshot);
+	m_backend = Backend::Polling;
+}
+
+
+FileWatcher::~FileWatcher()
+{
+#if defined(__linux__)
+	if (m_inotifyFd >= 0)
+	{
+		close(m_inotifyFd);
+	}
+#endif
+}
+
+
+std::vector<std::filesystem::path> FileWatcher::PollChanges()
+{
+	std::vector<std::filesystem::path> changes;
+	switch (m_backend)
+	{
+#if defined(__linux__)
+	case Backend::Inotify:
+		changes = PollInotify();
+		break;
+#endif
+	case Backend::Polling:
+		changes = PollByScanning();
+		break;
+	default:
+		break;
+	}
+
+	//༭һγü¼ȥ
+	std::sort(changes.begin(), changes.end());
+	changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+	return changes;
+}
+
+
+void FileWatcher::Scan(std::unordered_map<std::wstring, FileStamp>& outFiles) const
+{
+	outFiles.clear();
+
+	auto addFile = [&outFiles](const std::filesystem::directory_entry& entry)
+	{
+		std::error_code error;
+		if (!entry.is_regular_file(error))
+		{
+			return;
+		}
+		FileStamp stamp;
+		stamp.WriteTime = entry.last_write_time(error);
+		stamp.Size = entry.file_size(error);
+		outFiles[entry.path().wstring()] = stamp;
+	};
+
+	//ɨ;ļɾ֮Ĵֱһٿ
+	std::error_code error;
+	const auto options = std::filesystem::directory_options::skip_permission_denied;
+	if (m_recursive)
+	{
+		for (std::filesystem::recursive_directory_iterator it(m_directory, options, error), end; !error && it != end; it.increment(error))
+		{
+			addFile(*it);
+		}
+	}
+	else
+	{
+		for (std::filesystem::directory_iterator it(m_directory, options, error), end; !error && it != end; it.increment(error))
+		{
+			addFile(*it);
+		}
+	}
+}
+
+
+std::vector<std::filesystem::path> FileWatcher::PollByScanning()
+{
+	std::unordered_map<std::wstring, FileStamp> current;
+	Scan(current);
+
+	std::vector<std::filesystem::path> changes;
+	for (const auto& [path, stamp] : current)
+	{
+		auto it = m_snapshot.find(path);
+		if (it == m_snapshot.end() || !(it->second == stamp))
+		{
+			changes.emplace_back(path);
+		}
+	}
+	for (const auto& [path, stamp] : m_snapshot)
+	{
+		if (current.find(path) == current.end())
+		{
+			changes.emplace_back(path);
+		}
+	}
+
+	m_snapshot = std::move(current);
+	return changes;
+}
+
+
+#if defined(__linux__)
+
+namespace
+{
+	constexpr uint32_t kInotifyMask = IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM;
+}
+
+
+bool FileWatcher::InitializeInotify()
+{
+	m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_inotifyFd < 0)
+	{
+		return false;
+	}
+
+	AddInotifyWatch(m_directory);
+	if (m_watchDirectories.empty())
+	{
+		close(m_inotifyFd);
+		m_inotifyFd = -1;
+		return false;
+	}
+
+	if (m_recursive)
+	{
+		std::error_code error;
+		for (std::filesystem::recursive_directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error))
+		{
+			if (it->is_directory(error))
+			{
+				AddInotifyWatch(it->path());
+			}
+		}
+	}
+	return true;
+}
+
+
+void FileWatcher::AddInotifyWatch(const std::filesystem::path& directory)
+{
+	int wd = inotify_add_watch(m_inotifyFd, directory.c_str(), kInotifyMask);
+	if (wd >= 0)
+	{
+		m_watchDirectories[wd] = directory;
+	}
+}
+
+
+std::vector<std::filesystem::path> FileWatcher::PollInotify()
+{
+	std::vector<std::filesystem::path> changes;
+
+	alignas(inotify_event) char buffer[4096];
+	while (true)
+	{
+		ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+		if (length <= 0)
+		{
+			//EAGAIN¼
+			break;
+		}
+
+		for (ssize_t offset = 0; offset < length;)
+		{
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + event->len;
+
+			auto dirIt = m_watchDirectories.find(event->wd);
+			if (dirIt == m_watchDirectories.end() || event->len == 0)
+			{
+				continue;
+			}
+
+			std::filesystem::path path = dirIt->second / event->name;
+			if (event->mask & IN_ISDIR)
+			{
+				//½Ŀ¼ҲҪ
+				if (m_recursive && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+				{
+					AddInotifyWatch(path);
+				}
+				continue;
+			}
+			changes.push_back(std::move(path));
+		}
+	}
+	return changes;
+}
+
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Ŀ¼ӣPollChangesõϴε仯½޸ġɾļ
+//Linuxinotifyòinotifyƽ̨˻ѯȽ޸ʱʹСɫĿ¼ļ٣ѯҲܱ
+//PollChangesɵ÷õһΣShaderManager߳ϵã
+//̰߳ȫģֻһ߳
+
+
+class FileWatcher
+{
+public:
+	enum class Backend
+	{
+		None,		//Ŀ¼ڣʲôҲ
+		Inotify,
+		Polling
+	};
+
+	//forcePollingΪtrueʱinotifyԺļϵͳã
+	explicit FileWatcher(const std::filesystem::path& directory, bool recursive = true, bool forcePolling = false);
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	//ر仯ļ淶ľ·ȥأ
+	std::vector<std::filesystem::path> PollChanges();
+
+	Backend GetBackend() const { return m_backend; }
+	const std::filesystem::path& GetDirectory() const { return m_directory; }
+
+private:
+	struct FileStamp
+	{
+		std::filesystem::file_time_type WriteTime;
+		uintmax_t Size = 0;
+
+		bool operator==(const FileStamp&) const = default;
+	};
+
+	//ѯɨһĿ¼һεĿձȽ
+	void Scan(std::unordered_map<std::wstring, FileStamp>& outFiles) const;
+	std::vector<std::filesystem::path> PollByScanning();
+
+#if defined(__linux__)
+	bool InitializeInotify();
+	void AddInotifyWatch(const std::filesystem::path& directory);
+	std::vector<std::filesystem::path> PollInotify();
+
+	int m_inotifyFd = -1;
+	std::unordered_map<int, std::filesystem::path> m_watchDirectories;	//inotifywatch -> Ŀ¼
+#endif
+
+	std::filesystem::path m_directory;
+	bool m_recursive;
+	Backend m_backend = Backend::None;
+	std::unordered_map<std::wstring, FileStamp> m_snapshot;	//ѯ
+};
@@ -1,5 +1,6 @@
 #include "Core/KJApp.h"
 #include "Core/KJUtil.h"
+#include "Timer/Profiler.h"
 #include <sstream>
 #include <windowsx.h>
 #include <cstdio>
@@ -17,7 +18,7 @@ KJApp::~KJApp()
 {
 	if (m_mainWindow)
 	{
-		DX12Device::GetInstance().GetMainFence().WaitForIdle();
+		DX12Device::GetInstance().Shutdown();
 	}
 }
 
@@ -55,10 +56,17 @@ int KJApp::Run()
 				m_timer.Tick();
 				m_deltaTime = m_timer.DeltaTime();
 
-				Update(m_deltaTime);
-				Draw();
+				{
+					KJ_PROFILE_SCOPE("Update");
+					Update(m_deltaTime);
+				}
+				{
+					KJ_PROFILE_SCOPE("Draw");
+					Draw();
+				}
 
 				CalculateFrameStats();
+				KJ_PROFILE_FRAME();
 			}
 			else
 			{
@@ -263,7 +271,7 @@ void KJApp::OnResizeInternal()
 		return;
 	}
 
-	device.GetMainFence().WaitForIdle();
+	device.WaitForIdle();
 	device.ResetCommandList();
 	
 	m_swapChain.Resize(m_clientWidth, m_clientHeight);
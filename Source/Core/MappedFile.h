@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+//ֻڴӳļ򿪺ļӳַռ䣬ҳ룬ȰѼGBvector
+//WindowsCreateFileMapping/MapViewOfFileƽ̨mmap
+//ӳŵʱGetDataһֱЧڶ߳ͬʱ
+
+
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	explicit MappedFile(const std::filesystem::path& path) { Open(path); }
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	//ʧܷfalseļڡûȨޣļ򿪳ɹGetDataΪnullptr
+	bool Open(const std::filesystem::path& path);
+	void Close();
+
+	bool IsOpen() const { return m_open; }
+	const uint8_t* GetData() const { return m_data; }
+	size_t GetSize() const { return m_size; }
+	std::string_view GetText() const { return std::string_view(reinterpret_cast<const char*>(m_data), m_size); }
+
+	//ʾϵͳ˳ӴԤֻʾ֧־ʲôҲ
+	void AdviseSequential() const;
+
+private:
+	const uint8_t* m_data = nullptr;
+	size_t m_size = 0;
+	bool m_open = false;
+
+#if defined(_WIN32)
+	void* m_file = nullptr;		//HANDLEͷļﲻwindows.h
+	void* m_mapping = nullptr;
+#else
+	int m_fd = -1;
+#endif
+};
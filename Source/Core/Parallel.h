@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Timer/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+//CPU˵ļ򵥲У̣߳߳ҲɻһԭӼjoin
+//롢ӡmeshletһԵãǳפ̳߳
+
+
+namespace Parallel
+{
+	//0ʾCPU1
+	inline uint32_t ResolveThreadCount(uint32_t threadCount)
+	{
+		return threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	//workerCounṭ̣߳߳jobCountjob(i)ﲻ쳣
+	//threadNameǷ﹤߳ʾ
+	template<typename Job>
+	void Run(size_t jobCount, uint32_t workerCount, const char* threadName, const Job& job)
+	{
+		workerCount = static_cast<uint32_t>(std::min<size_t>(workerCount, jobCount));
+		std::atomic<size_t> nextJob = 0;
+		auto runJobs = [&job, &nextJob, jobCount]()
+		{
+			for (size_t i = nextJob.fetch_add(1); i < jobCount; i = nextJob.fetch_add(1))
+			{
+				job(i);
+			}
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve(workerCount > 0 ? workerCount - 1 : 0);
+		for (uint32_t i = 1; i < workerCount; ++i)
+		{
+			workers.emplace_back([&runJobs, threadName]()
+			{
+				KJ_PROFILE_THREAD(threadName);
+				(void)threadName;
+				runJobs();
+			});
+		}
+		runJobs();
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+}
@@ -0,0 +1,233 @@
+#include "DX12/DX12DescriptorAllocator.h"
+#include "DX12/DX12Device.h"
+#include <cassert>
+#include <stdexcept>
+
+
+//===================================================================
+//                       DX12DescriptorAllocator
+//===================================================================
+
+bool DX12DescriptorAllocator::Initialize(D3D12_DESCRIPTOR_HEAP_TYPE type, UINT pageSize)
+{
+	if (pageSize == 0)
+	{
+		return false;
+	}
+
+	m_type = type;
+	m_pages.clear();
+	m_allocator = std::make_unique<PagedDescriptorAllocator>(pageSize);
+
+	//Ҫҳʱ
+	m_allocator->SetPageCallback([this, pageSize](UINT pageIndex)
+		{
+			auto page = std::make_unique<DX12DescriptorHeap>();
+			if (!page->Initialize(m_type, pageSize))
+			{
+				throw std::runtime_error("DX12DescriptorAllocator: failed to create descriptor heap page");
+			}
+			if (m_pages.size() <= pageIndex)
+			{
+				m_pages.resize(pageIndex + 1);
+			}
+			m_pages[pageIndex] = std::move(page);
+		});
+	return true;
+}
+
+
+DX12Descriptor DX12DescriptorAllocator::Allocate()
+{
+	if (!m_allocator)
+	{
+		throw std::logic_error("DX12DescriptorAllocator: not initialized");
+	}
+
+	UINT index = m_allocator->Allocate();
+	if (index == PagedDescriptorAllocator::kInvalidIndex)
+	{
+		throw std::runtime_error("DX12DescriptorAllocator: out of descriptors");
+	}
+
+	DX12Descriptor descriptor;
+	descriptor.Index = index;
+	descriptor.CPUHandle = m_pages[m_allocator->GetPageIndex(index)]->GetCPUHandle(m_allocator->GetOffsetInPage(index));
+	return descriptor;
+}
+
+
+void DX12DescriptorAllocator::Free(const DX12Descriptor& descriptor)
+{
+	if (m_allocator && descriptor.IsValid())
+	{
+		m_allocator->Free(descriptor.Index);
+	}
+}
+
+
+void DX12DescriptorAllocator::FreeDeferred(const DX12Descriptor& descriptor, UINT64 fenceValue)
+{
+	if (m_allocator && descriptor.IsValid())
+	{
+		m_allocator->FreeDeferred(descriptor.Index, fenceValue);
+	}
+}
+
+
+void DX12DescriptorAllocator::ReleaseCompleted(UINT64 completedFenceValue)
+{
+	if (m_allocator)
+	{
+		m_allocator->ReleaseCompleted(completedFenceValue);
+	}
+}
+
+
+//===================================================================
+//                   DX12ShaderVisibleDescriptorHeap
+//===================================================================
+
+bool DX12ShaderVisibleDescriptorHeap::Initialize(DX12Fence& fence, UINT descriptorCount, UINT persistentCount)
+{
+	if (persistentCount == 0 || persistentCount >= descriptorCount)
+	{
+		return false;
+	}
+
+	if (!m_heap.Initialize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, descriptorCount, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE))
+	{
+		return false;
+	}
+
+	m_fence = &fence;
+	m_persistentCount = persistentCount;
+	m_persistent = std::make_unique<PagedDescriptorAllocator>(persistentCount, 1);
+	m_ring = std::make_unique<RingBufferAllocator>(descriptorCount - persistentCount);
+	return true;
+}
+
+
+DX12Descriptor DX12ShaderVisibleDescriptorHeap::MakeDescriptor(UINT index) const
+{
+	DX12Descriptor descriptor;
+	descriptor.Index = index;
+	descriptor.CPUHandle = m_heap.GetCPUHandle(index);
+	descriptor.GPUHandle = m_heap.GetGPUHandle(index);
+	return descriptor;
+}
+
+
+DX12Descriptor DX12ShaderVisibleDescriptorHeap::AllocatePersistent()
+{
+	if (!m_persistent)
+	{
+		throw std::logic_error("DX12ShaderVisibleDescriptorHeap: not initialized");
+	}
+
+	UINT index = m_persistent->Allocate();
+	if (index == PagedDescriptorAllocator::kInvalidIndex)
+	{
+		throw std::runtime_error("DX12ShaderVisibleDescriptorHeap: out of persistent descriptors");
+	}
+	return MakeDescriptor(index);
+}
+
+
+void DX12ShaderVisibleDescriptorHeap::FreePersistent(const DX12Descriptor& descriptor)
+{
+	if (m_persistent && descriptor.IsValid())
+	{
+		FreePersistentIndex(descriptor.Index);
+	}
+}
+
+
+void DX12ShaderVisibleDescriptorHeap::FreePersistent(D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle)
+{
+	if (!m_persistent)
+	{
+		return;
+	}
+
+	//ǰľתһԽͳһ
+	SIZE_T offset = cpuHandle.ptr - m_heap.GetCPUHandleStart().ptr;
+	UINT index = cpuHandle.ptr < m_heap.GetCPUHandleStart().ptr ? m_persistentCount :
+		static_cast<UINT>(offset / m_heap.GetDescriptorSize());
+	FreePersistentIndex(index);
+}
+
+
+void DX12ShaderVisibleDescriptorHeap::FreePersistentIndex(UINT index)
+{
+	//÷ImGui˵ͷŻص쳣ImGui״̬Ūңֻͷ
+	if (index >= m_persistentCount || !m_persistent->IsAllocated(index))
+	{
+		OutputDebugStringA("DX12ShaderVisibleDescriptorHeap: freeing a persistent descriptor that is not allocated\n");
+		assert(false && "DX12ShaderVisibleDescriptorHeap: freeing a persistent descriptor that is not allocated");
+		return;
+	}
+	m_persistent->Free(index);
+}
+
+
+DX12Descriptor DX12ShaderVisibleDescriptorHeap::AllocateTable(UINT count)
+{
+	if (!m_ring)
+	{
+		throw std::logic_error("DX12ShaderVisibleDescriptorHeap: not initialized");
+	}
+	if (count == 0 || count > m_ring->GetCapacity())
+	{
+		throw std::invalid_argument("DX12ShaderVisibleDescriptorHeap: invalid descriptor table size");
+	}
+
+	UINT64 offset = m_ring->Allocate(count, 1);
+
+	//˾͵һ֡
+	while (offset == RingBufferAllocator::kInvalidOffset)
+	{
+		UINT64 oldestFence = m_ring->GetOldestPendingFence();
+		if (oldestFence == 0)
+		{
+			throw std::runtime_error("DX12ShaderVisibleDescriptorHeap: descriptor ring exhausted within a single frame");
+		}
+		m_fence->WaitForValue(oldestFence);
+		m_ring->ReleaseCompleted(oldestFence);
+		offset = m_ring->Allocate(count, 1);
+	}
+
+	return MakeDescriptor(m_persistentCount + static_cast<UINT>(offset));
+}
+
+
+DX12Descriptor DX12ShaderVisibleDescriptorHeap::CopyTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, UINT count)
+{
+	DX12Descriptor table = AllocateTable(count);
+
+	//ԴǲɼɢÿδСΪ1nullptrĿһΣһεÿ
+	DX12Device::GetInstance().GetDevice()->CopyDescriptors(
+		1, &table.CPUHandle, &count,
+		count, sources, nullptr,
+		D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
+	);
+	return table;
+}
+
+
+void DX12ShaderVisibleDescriptorHeap::BeginFrame()
+{
+	if (m_ring)
+	{
+		m_ring->ReleaseCompleted(m_fence->GetCompletedValue());
+	}
+}
+
+
+void DX12ShaderVisibleDescriptorHeap::EndFrame(UINT64 fenceValue)
+{
+	if (m_ring)
+	{
+		m_ring->FinishFrame(fenceValue);
+	}
+}
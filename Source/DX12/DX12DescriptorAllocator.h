@@ -0,0 +1,116 @@
+#pragma once
+
+#include <d3d12.h>
+#include <memory>
+#include <vector>
+#include "DX12/DX12DescriptorHeap.h"
+#include "DX12/DX12Fence.h"
+#include "Renderer/Core/PagedDescriptorAllocator.h"
+#include "Renderer/Core/RingBufferAllocator.h"
+
+//䣺DX12DescriptorHeapϼ˷߼䱾PagedDescriptorAllocatorRingBufferAllocator
+//DX12DescriptorAllocatorCPUɼѣҳO(1)ͷţSRV/CBV/UAVｨ
+//DX12ShaderVisibleDescriptorHeap󶨵ߵǸѣǰһγפImGui֣һΰ֡η䣬
+
+
+//һλ
+struct DX12Descriptor
+{
+	D3D12_CPU_DESCRIPTOR_HANDLE CPUHandle{};
+	D3D12_GPU_DESCRIPTOR_HANDLE GPUHandle{};   //ɼΪ0
+	UINT Index = PagedDescriptorAllocator::kInvalidIndex;
+
+	bool IsValid() const { return Index != PagedDescriptorAllocator::kInvalidIndex; }
+};
+
+
+class DX12DescriptorAllocator
+{
+public:
+	static constexpr UINT kDefaultPageSize = 256;
+
+	DX12DescriptorAllocator() = default;
+	~DX12DescriptorAllocator() = default;
+
+	DX12DescriptorAllocator(const DX12DescriptorAllocator&) = delete;
+	DX12DescriptorAllocator& operator=(const DX12DescriptorAllocator&) = delete;
+
+	bool Initialize(D3D12_DESCRIPTOR_HEAP_TYPE type, UINT pageSize = kDefaultPageSize);
+
+	//һԶҳʧ쳣
+	DX12Descriptor Allocate();
+
+	//ͷţȷGPUˣ
+	void Free(const DX12Descriptor& descriptor);
+
+	//GPUܻãfenceValueٻ
+	void FreeDeferred(const DX12Descriptor& descriptor, UINT64 fenceValue);
+
+	//ɵӳͷţÿ֡ʼʱ
+	void ReleaseCompleted(UINT64 completedFenceValue);
+
+
+	D3D12_DESCRIPTOR_HEAP_TYPE GetType() const { return m_type; }
+	UINT GetPageCount() const { return m_allocator ? m_allocator->GetPageCount() : 0; }
+	UINT GetAllocatedCount() const { return m_allocator ? m_allocator->GetAllocatedCount() : 0; }
+	bool IsInitialized() const { return m_allocator != nullptr; }
+
+private:
+	D3D12_DESCRIPTOR_HEAP_TYPE m_type{};
+	std::vector<std::unique_ptr<DX12DescriptorHeap>> m_pages;
+	std::unique_ptr<PagedDescriptorAllocator> m_allocator;
+};
+
+
+class DX12ShaderVisibleDescriptorHeap
+{
+public:
+	static constexpr UINT kDefaultDescriptorCount = 4096;
+	static constexpr UINT kDefaultPersistentCount = 256;
+
+	DX12ShaderVisibleDescriptorHeap() = default;
+	~DX12ShaderVisibleDescriptorHeap() = default;
+
+	DX12ShaderVisibleDescriptorHeap(const DX12ShaderVisibleDescriptorHeap&) = delete;
+	DX12ShaderVisibleDescriptorHeap& operator=(const DX12ShaderVisibleDescriptorHeap&) = delete;
+
+	//persistentCountפڶѵĿͷʣµĸÿ֡Ļ
+	bool Initialize(DX12Fence& fence, UINT descriptorCount = kDefaultDescriptorCount,
+		UINT persistentCount = kDefaultPersistentCount);
+
+
+	//פһֱЧֱͷţ쳣
+	//ͷŲڳפѾͷŹ쳣ImGuiĻصﲻף԰ԣд
+	DX12Descriptor AllocatePersistent();
+	void FreePersistent(const DX12Descriptor& descriptor);
+	void FreePersistent(D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle);//ֻ֪ĵطãImGuiͷŻص
+
+
+	//ǰ֡countһ֡GPUԶ
+	//˻һ֡
+	DX12Descriptor AllocateTable(UINT count);
+
+	//Ѳɼһıرʼλ
+	DX12Descriptor CopyTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, UINT count);
+
+
+	//֡࣬DX12Device
+	void BeginFrame();
+	void EndFrame(UINT64 fenceValue);
+
+
+	ID3D12DescriptorHeap* Get() const { return m_heap.Get(); }
+	UINT GetDescriptorCount() const { return m_heap.GetDescriptorCount(); }
+	UINT GetPersistentCount() const { return m_persistentCount; }
+	bool IsInitialized() const { return m_heap.IsInitialized(); }
+
+private:
+	DX12Descriptor MakeDescriptor(UINT index) const;
+	void FreePersistentIndex(UINT index);
+
+	DX12DescriptorHeap m_heap;
+	DX12Fence* m_fence = nullptr;
+	UINT m_persistentCount = 0;
+	std::unique_ptr<PagedDescriptorAllocator> m_persistent;   //һҳչ
+	std::unique_ptr<RingBufferAllocator> m_ring;              //ƫƴm_persistentCountʼ
+};
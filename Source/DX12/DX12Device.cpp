@@ -4,6 +4,15 @@
 #include <stdexcept>
 
 
+namespace
+{
+	//߿ڹĿ¼£豸˶ʱԶ
+	const wchar_t* const kPipelineLibraryPath = L"PipelineLibrary.bin";
+	const wchar_t* const kShaderDirectory = L"Source/Shaders/";
+	const wchar_t* const kShaderCacheDirectory = L"ShaderCache/";
+}
+
+
 
 DX12Device& DX12Device::GetInstance()
 {
@@ -143,6 +152,41 @@ bool DX12Device::Initialize(bool enableDebug)
 
 	m_commandList->Close();
 
+	//ÿ֡
+	if (!m_frameContext.Initialize(m_device.Get(), m_mainFence, m_commandQueue.Get()))
+	{
+		return false;
+	}
+
+	//ÿ֡ϴ
+	if (!m_uploadRing.Initialize(m_device.Get(), m_mainFence))
+	{
+		return false;
+	}
+
+	//
+	if (!m_descriptorAllocator.Initialize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV))
+	{
+		return false;
+	}
+	if (!m_shaderVisibleHeap.Initialize(m_mainFence))
+	{
+		return false;
+	}
+
+	//ɫûԤcsoFxCompileûʱ
+	m_shaderManager.SetRuntimeCompilationEnabled(true);
+	m_shaderManager.Initialize(kShaderDirectory);
+	//ֽ밴ԤݴڴϣԴûĵ´ֱӶҪעͼɫ֮ǰ
+	m_shaderManager.EnableBytecodeCache(kShaderCacheDirectory);
+
+	//PSO棬߿ҪڵһδPSO֮ǰ
+	if (!m_pipelineStateCache.Initialize(m_device.Get(), m_factory.Get(), m_shaderManager))
+	{
+		return false;
+	}
+	m_pipelineStateCache.LoadPipelineLibrary(kPipelineLibraryPath);
+
 
 
 	
@@ -207,3 +251,58 @@ void DX12Device::ResetCommandList()
 }
 
 
+void DX12Device::BeginFrame()
+{
+	if (!m_commandList)
+	{
+		return;
+	}
+	m_frameContext.BeginFrame(m_commandList.Get());
+	m_uploadRing.BeginFrame();
+	m_shaderVisibleHeap.BeginFrame();
+	m_descriptorAllocator.ReleaseCompleted(m_mainFence.GetCompletedValue());
+	m_shaderManager.ReleaseRetiredShaders(m_mainFence.GetCurrentValue(), m_mainFence.GetCompletedValue());
+}
+
+
+void DX12Device::EndFrame()
+{
+	UINT64 fenceValue = m_frameContext.EndFrame();
+	m_uploadRing.EndFrame(fenceValue);
+	m_shaderVisibleHeap.EndFrame(fenceValue);
+}
+
+
+void DX12Device::WaitForIdle()
+{
+	if (!m_device)
+	{
+		return;
+	}
+	m_mainFence.WaitForIdle();
+
+	//GPUѾˣλϵʱԴõȲλֻٷţ֡ڣPresentյWM_SIZEܶһBeginFrame
+	FrameContextRing* ring = m_frameContext.GetRing();
+	if (ring && !ring->IsInFrame())
+	{
+		ring->WaitForIdle();
+	}
+	m_descriptorAllocator.ReleaseCompleted(m_mainFence.GetCompletedValue());
+}
+
+
+void DX12Device::Shutdown()
+{
+	if (!m_device)
+	{
+		return;
+	}
+	WaitForIdle();
+
+	//̨ڱҲ´Ͳٱ
+	m_pipelineStateCache.WaitForPending();
+	m_pipelineStateCache.SavePipelineLibrary(kPipelineLibraryPath);
+	m_shaderManager.DisableHotReload();
+	//ShaderManagerʱҲ棬豸ǵҪȵ˳ʱľ̬ȴһ
+	m_shaderManager.SaveBytecodeCache();
+}
@@ -6,6 +6,11 @@
 #include <dxgi1_6.h>
 #include <wrl/client.h>
 #include "DX12/DX12Fence.h"
+#include "DX12/DX12FrameContext.h"
+#include "DX12/DX12UploadRing.h"
+#include "DX12/DX12DescriptorAllocator.h"
+#include "DX12/DX12PipelineStateCache.h"
+#include "Renderer/Core/ShaderManager.h"
 
 
 
@@ -42,8 +47,31 @@ public :
 	ID3D12CommandAllocator* GetCommandAllocator() const { return m_commandAllocator.Get(); }
 	ID3D12GraphicsCommandList* GetCommandList() const { return m_commandList.Get(); }
 
+	//һԵ¼ƣʼϴࣩ֮ҪԼGPUÿ֡¼BeginFrame/EndFrame
 	void ResetCommandList();
 
+	//֡УBeginFrameõǰ֡ķбEndFramePresent֮Χ
+	DX12FrameContext& GetFrameContext() { return m_frameContext; }
+
+	//ÿ֡ϴ̬㣩BeginFrame/EndFrame֮
+	DX12UploadRing& GetUploadRing() { return m_uploadRing; }
+
+	//CBV/SRV/UAVڲɼｨãʱ򿽵ɫɼѵÿ֡
+	DX12DescriptorAllocator& GetDescriptorAllocator() { return m_descriptorAllocator; }
+	DX12ShaderVisibleDescriptorHeap& GetShaderVisibleHeap() { return m_shaderVisibleHeap; }
+	void BeginFrame();
+	void EndFrame();
+
+	//GPUйٰѸ֡ŵӳͷȫִеĽС˳ǰã
+	void WaitForIdle();
+
+	//ɫPSO棺InitializeʱϴδĹ߿⣬Shutdownʱдȥ
+	ShaderManager& GetShaderManager() { return m_shaderManager; }
+	DX12PipelineStateCache& GetPipelineStateCache() { return m_pipelineStateCache; }
+
+	//˳ǰãGPUͻں̨PSOٱ߿
+	void Shutdown();
+
 
 
 	
@@ -58,6 +86,12 @@ private:
 	DX12Device& operator=(const DX12Device&) = delete;
 
 	DX12Fence m_mainFence;
+	DX12FrameContext m_frameContext;//m_mainFence
+	DX12UploadRing m_uploadRing;
+	DX12DescriptorAllocator m_descriptorAllocator;
+	DX12ShaderVisibleDescriptorHeap m_shaderVisibleHeap;
+	ShaderManager m_shaderManager;
+	DX12PipelineStateCache m_pipelineStateCache;//m_shaderManager
 	
 
 	Microsoft::WRL::ComPtr<ID3D12Device> m_device;
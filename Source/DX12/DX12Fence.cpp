@@ -1,4 +1,5 @@
 #include "DX12/DX12Fence.h"
+#include "Timer/Profiler.h"
 #include <stdexcept>
 
 
@@ -72,6 +73,8 @@ void DX12Fence::WaitForValue(UINT64 fenceValue)
 		return;
 	}
 
+	KJ_PROFILE_SCOPE("Fence Wait");
+
 	// ¼ȴ
 	HRESULT hr = m_fence->SetEventOnCompletion(fenceValue, m_fenceEvent);
 	if (FAILED(hr))
@@ -0,0 +1,113 @@
+#include "DX12/DX12FrameContext.h"
+#include "Timer/Profiler.h"
+#include <utility>
+
+
+uint64_t DX12FenceQueueSync::Signal()
+{
+	UINT64 fenceValue = m_fence.Increment();
+	m_fence.Signal(m_queue, fenceValue);
+	return fenceValue;
+}
+
+
+bool DX12FrameContext::Initialize(ID3D12Device* device, DX12Fence& fence, ID3D12CommandQueue* queue, UINT frameCount)
+{
+	if (!device || !queue || frameCount == 0)
+	{
+		return false;
+	}
+
+	//ÿ֡һGPUִе֡ķReset
+	m_allocators.resize(frameCount);
+	for (auto& allocator : m_allocators)
+	{
+		HRESULT hr = device->CreateCommandAllocator(
+			D3D12_COMMAND_LIST_TYPE_DIRECT,
+			IID_PPV_ARGS(&allocator)
+		);
+		if (FAILED(hr))
+		{
+			m_allocators.clear();
+			return false;
+		}
+	}
+
+	m_sync = std::make_unique<DX12FenceQueueSync>(fence, queue);
+	m_ring = std::make_unique<FrameContextRing>(*m_sync, frameCount);
+	return true;
+}
+
+
+void DX12FrameContext::BeginFrame(ID3D12GraphicsCommandList* commandList)
+{
+	if (!m_ring || !commandList)
+	{
+		return;
+	}
+
+	UINT slot = 0;
+	{
+		KJ_PROFILE_SCOPE("Frame Slot Wait");
+		slot = m_ring->BeginFrame();
+	}
+
+	ID3D12CommandAllocator* allocator = m_allocators[slot].Get();
+	allocator->Reset();
+	commandList->Reset(allocator, nullptr);
+}
+
+
+UINT64 DX12FrameContext::EndFrame()
+{
+	if (!m_ring)
+	{
+		return 0;
+	}
+	return m_ring->EndFrame();
+}
+
+
+void DX12FrameContext::AddTransientResource(Microsoft::WRL::ComPtr<ID3D12Resource> resource)
+{
+	if (!resource)
+	{
+		return;
+	}
+	//lambdaüִʱͷ
+	DeferUntilComplete([held = std::move(resource)]() {});
+}
+
+
+void DX12FrameContext::DeferUntilComplete(std::function<void()> callback)
+{
+	if (m_ring)
+	{
+		m_ring->DeferUntilComplete(std::move(callback));
+	}
+}
+
+
+void DX12FrameContext::WaitForIdle()
+{
+	if (m_ring)
+	{
+		m_ring->WaitForIdle();
+	}
+}
+
+
+ID3D12CommandAllocator* DX12FrameContext::GetCurrentAllocator() const
+{
+	if (!m_ring)
+	{
+		return nullptr;
+	}
+	return m_allocators[m_ring->GetCurrentSlot()].Get();
+}
+
+
+UINT DX12FrameContext::GetCurrentFrameIndex() const
+{
+	return m_ring ? m_ring->GetCurrentSlot() : 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "DX12/DX12Fence.h"
+#include "Renderer/Core/FrameContextRing.h"
+
+//֡е֡ģÿ֡һ֡ࣨΧֵʲôʱȣFrameContextRing
+//ǰÿ֡PresentFlushCPUҪGPU¼һֻ֡ڲλʹʱŵ
+
+
+//DX12FenceʵIFrameQueueSync
+class DX12FenceQueueSync final : public IFrameQueueSync
+{
+public:
+	DX12FenceQueueSync(DX12Fence& fence, ID3D12CommandQueue* queue) : m_fence(fence), m_queue(queue) {}
+
+	uint64_t Signal() override;
+	uint64_t GetCompletedValue() const override { return m_fence.GetCompletedValue(); }
+	void WaitForValue(uint64_t value) override { m_fence.WaitForValue(value); }
+
+private:
+	DX12Fence& m_fence;
+	ID3D12CommandQueue* m_queue = nullptr;
+};
+
+
+class DX12FrameContext
+{
+public:
+	DX12FrameContext() = default;
+	~DX12FrameContext() = default;
+
+	DX12FrameContext(const DX12FrameContext&) = delete;
+	DX12FrameContext& operator=(const DX12FrameContext&) = delete;
+
+	bool Initialize(ID3D12Device* device, DX12Fence& fence, ID3D12CommandQueue* queue,
+		UINT frameCount = FrameContextRing::kDefaultFrameCount);
+
+	//ʼһ֡λһɣб
+	void BeginFrame(ID3D12GraphicsCommandList* commandList);
+
+	//һ֡ڶϷΧֵExecuteCommandListsPresent֮󣬷һ֡Χֵ
+	UINT64 EndFrame();
+
+	//ʱԴһ֡ϴõĻȣҵǰ֡GPUͷ
+	void AddTransientResource(Microsoft::WRL::ComPtr<ID3D12Resource> resource);
+
+	//صȵǰ֡GPUִ
+	void DeferUntilComplete(std::function<void()> callback);
+
+	//֡꣨ĽС˳ǰ
+	void WaitForIdle();
+
+
+	ID3D12CommandAllocator* GetCurrentAllocator() const;
+	UINT GetCurrentFrameIndex() const;
+	UINT GetFrameCount() const { return static_cast<UINT>(m_allocators.size()); }
+	bool IsInitialized() const { return m_ring != nullptr; }
+
+	FrameContextRing* GetRing() const { return m_ring.get(); }
+
+private:
+	std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> m_allocators;
+	std::unique_ptr<DX12FenceQueueSync> m_sync;
+	std::unique_ptr<FrameContextRing> m_ring;
+};
@@ -0,0 +1,540 @@
+#include "DX12/DX12PipelineStateCache.h"
+#include "Renderer/Core/ShaderManager.h"
+#include "Renderer/Resources/D3D12VertexLayoutConverter.h"
+#include <cstdio>
+#include <stdexcept>
+
+
+namespace
+{
+	D3D12_COMPARISON_FUNC ToD3D12(PipelineCompareFunc func)
+	{
+		switch (func)
+		{
+		case PipelineCompareFunc::Never:        return D3D12_COMPARISON_FUNC_NEVER;
+		case PipelineCompareFunc::Less:         return D3D12_COMPARISON_FUNC_LESS;
+		case PipelineCompareFunc::Equal:        return D3D12_COMPARISON_FUNC_EQUAL;
+		case PipelineCompareFunc::LessEqual:    return D3D12_COMPARISON_FUNC_LESS_EQUAL;
+		case PipelineCompareFunc::Greater:      return D3D12_COMPARISON_FUNC_GREATER;
+		case PipelineCompareFunc::NotEqual:     return D3D12_COMPARISON_FUNC_NOT_EQUAL;
+		case PipelineCompareFunc::GreaterEqual: return D3D12_COMPARISON_FUNC_GREATER_EQUAL;
+		default:                                return D3D12_COMPARISON_FUNC_ALWAYS;
+		}
+	}
+
+	D3D12_PRIMITIVE_TOPOLOGY_TYPE ToD3D12(PipelineTopologyType topology)
+	{
+		switch (topology)
+		{
+		case PipelineTopologyType::Point: return D3D12_PRIMITIVE_TOPOLOGY_TYPE_POINT;
+		case PipelineTopologyType::Line:  return D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE;
+		default:                          return D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+		}
+	}
+
+	//߿֣ϣ16λʮ
+	void MakePipelineName(UINT64 hash, wchar_t (&name)[17])
+	{
+		swprintf(name, 17, L"%016llX", static_cast<unsigned long long>(hash));
+	}
+}
+
+
+DX12PipelineStateCache::~DX12PipelineStateCache()
+{
+	//̨̣ͣ߳ǻıͿ
+	m_cache.reset();
+}
+
+
+bool DX12PipelineStateCache::Initialize(ID3D12Device* device, IDXGIFactory4* factory, ShaderManager& shaderManager, UINT workerCount)
+{
+	if (!device)
+	{
+		return false;
+	}
+
+	m_device = device;
+	m_factory = factory;
+	m_shaderManager = &shaderManager;
+
+	//ϵͳûID3D12Device1Ͳù߿⣬PSOֻܽÿҪ±
+	if (SUCCEEDED(m_device.As(&m_device1)))
+	{
+		m_device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_library));
+	}
+
+	m_cache = std::make_unique<PipelineStateCache<PipelinePtr>>(
+		[this](const PipelineStateKey& key) { return CreatePipeline(key); },
+		workerCount);
+	return true;
+}
+
+
+UINT64 DX12PipelineStateCache::CreateRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc)
+{
+	Microsoft::WRL::ComPtr<ID3DBlob> serialized;
+	Microsoft::WRL::ComPtr<ID3DBlob> errors;
+	HRESULT hr = D3D12SerializeRootSignature(&desc, D3D_ROOT_SIGNATURE_VERSION_1, &serialized, &errors);
+	if (errors != nullptr)
+	{
+		OutputDebugStringA(static_cast<const char*>(errors->GetBufferPointer()));
+	}
+	if (FAILED(hr))
+	{
+		return 0;
+	}
+
+	UINT64 hash = ShaderManager::HashBytecode(serialized->GetBufferPointer(), serialized->GetBufferSize());
+
+	std::lock_guard<std::mutex> lock(m_resourceMutex);
+	if (m_rootSignatures.find(hash) != m_rootSignatures.end())
+	{
+		return hash;
+	}
+
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
+	hr = m_device->CreateRootSignature(
+		0,
+		serialized->GetBufferPointer(),
+		serialized->GetBufferSize(),
+		IID_PPV_ARGS(&rootSignature)
+	);
+	if (FAILED(hr))
+	{
+		return 0;
+	}
+
+	m_rootSignatures[hash] = rootSignature;
+	return hash;
+}
+
+
+ID3D12RootSignature* DX12PipelineStateCache::GetRootSignature(UINT64 hash) const
+{
+	std::lock_guard<std::mutex> lock(m_resourceMutex);
+	auto it = m_rootSignatures.find(hash);
+	return it != m_rootSignatures.end() ? it->second.Get() : nullptr;
+}
+
+
+bool DX12PipelineStateCache::BuildKey(const DX12GraphicsPipelineDesc& desc, PipelineStateKey& outKey)
+{
+	if (!m_shaderManager || desc.NumRenderTargets > PipelineStateKey::kMaxRenderTargets)
+	{
+		return false;
+	}
+
+	//ֽ͹ϣһȡмػ˰汾Ҳ
+	Microsoft::WRL::ComPtr<ID3DBlob> vsBlob;
+	UINT64 vsHash = 0;
+	if (!m_shaderManager->GetShaderWithHash(desc.VertexShader, vsBlob, vsHash))
+	{
+		return false;
+	}
+	Microsoft::WRL::ComPtr<ID3DBlob> psBlob;
+	UINT64 psHash = 0;
+	if (!desc.PixelShader.empty() && !m_shaderManager->GetShaderWithHash(desc.PixelShader, psBlob, psHash))
+	{
+		return false;
+	}
+
+	if (desc.Layout.IsValid() && !ValidateInputLayout(desc.VertexShader, vsHash, desc.Layout))
+	{
+		return false;
+	}
+
+	//ֽǫֻ́߳ϣ
+	{
+		std::lock_guard<std::mutex> lock(m_resourceMutex);
+		TrackBytecode(desc.VertexShader, vsHash, vsBlob);
+		if (psHash != 0)
+		{
+			TrackBytecode(desc.PixelShader, psHash, psBlob);
+		}
+	}
+
+	PipelineStateKey key;
+	key.VertexShaderHash = vsHash;
+	key.PixelShaderHash = psHash;
+	key.RootSignatureHash = desc.RootSignature;
+	key.Layout = desc.Layout;
+	key.RenderState = desc.RenderState;
+	key.NumRenderTargets = desc.NumRenderTargets;
+	for (UINT i = 0; i < desc.NumRenderTargets; ++i)
+	{
+		key.RenderTargetFormats[i] = static_cast<uint32_t>(desc.RenderTargetFormats[i]);
+	}
+	key.DepthStencilFormat = static_cast<uint32_t>(desc.DepthStencilFormat);
+	key.SampleCount = desc.SampleCount;
+	key.SampleQuality = desc.SampleQuality;
+
+	outKey = key;
+	return true;
+}
+
+
+bool DX12PipelineStateCache::ValidateInputLayout(const std::string& vertexShader, UINT64 vsHash, const VertexLayoutHandle& layout)
+{
+	UINT64 checkKey = VertexLayoutHash::HashValue64(VertexLayoutHash::OffsetBasis, vsHash);
+	checkKey = VertexLayoutHash::HashValue64(checkKey, layout.GetHash());
+	{
+		std::lock_guard<std::mutex> lock(m_resourceMutex);
+		auto it = m_inputLayoutChecks.find(checkKey);
+		if (it != m_inputLayoutChecks.end())
+		{
+			return it->second;
+		}
+	}
+
+	//ϢѾֽ뻺ˣֻǱȽϣD3DReflect
+	ShaderInputValidation validation = m_shaderManager->ValidateInputLayout(vertexShader, *layout);
+	if (!validation.Errors.empty() || !validation.Warnings.empty())
+	{
+		std::string message = "Input layout check for " + vertexShader + ":\n" + validation.ToString();
+		OutputDebugStringA(message.c_str());
+	}
+
+	std::lock_guard<std::mutex> lock(m_resourceMutex);
+	m_inputLayoutChecks[checkKey] = validation.Valid;
+	return validation.Valid;
+}
+
+
+ID3D12PipelineState* DX12PipelineStateCache::GetOrCreate(const PipelineStateKey& key)
+{
+	if (!m_cache)
+	{
+		return nullptr;
+	}
+
+	try
+	{
+		return m_cache->GetOrCreate(key).Get();
+	}
+	catch (const std::exception& e)
+	{
+		OutputDebugStringA(e.what());
+		OutputDebugStringA("\n");
+		return nullptr;
+	}
+}
+
+
+ID3D12PipelineState* DX12PipelineStateCache::GetOrCreate(const DX12GraphicsPipelineDesc& desc)
+{
+	PipelineStateKey key;
+	if (!BuildKey(desc, key))
+	{
+		return nullptr;
+	}
+	return GetOrCreate(key);
+}
+
+
+ID3D12PipelineState* DX12PipelineStateCache::TryGet(const PipelineStateKey& key)
+{
+	PipelinePtr pipeline;
+	if (!m_cache || !m_cache->TryGet(key, pipeline))
+	{
+		return nullptr;
+	}
+	//ﻹһãָǰȫ
+	return pipeline.Get();
+}
+
+
+void DX12PipelineStateCache::Prewarm(const PipelineStateKey& key)
+{
+	if (m_cache)
+	{
+		m_cache->Prewarm(key);
+	}
+}
+
+
+void DX12PipelineStateCache::WaitForPending()
+{
+	if (m_cache)
+	{
+		m_cache->WaitForPending();
+	}
+}
+
+
+PipelineCacheStats DX12PipelineStateCache::GetStats() const
+{
+	return m_cache ? m_cache->GetStats() : PipelineCacheStats{};
+}
+
+
+bool DX12PipelineStateCache::LoadPipelineLibrary(const std::wstring& path)
+{
+	if (!m_device1)
+	{
+		return false;
+	}
+
+	std::vector<uint8_t> data;
+	if (!PipelineCacheFile::Read(path, ComputeDeviceKey(), data))
+	{
+		return false;
+	}
+
+	//ļͷҲܾܾͬ汾ŵ޸ʱÿտ
+	Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> library;
+	HRESULT hr = m_device1->CreatePipelineLibrary(data.data(), data.size(), IID_PPV_ARGS(&library));
+	if (FAILED(hr))
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_libraryMutex);
+	m_library = library;		//Ȼ⣬ɿͷźٻõڴ
+	m_libraryData = std::move(data);
+	m_libraryDirty = false;
+	return true;
+}
+
+
+bool DX12PipelineStateCache::SavePipelineLibrary(const std::wstring& path)
+{
+	std::lock_guard<std::mutex> lock(m_libraryMutex);
+	if (!m_library)
+	{
+		return false;
+	}
+	if (!m_libraryDirty)
+	{
+		return true;
+	}
+
+	std::vector<uint8_t> data(m_library->GetSerializedSize());
+	HRESULT hr = m_library->Serialize(data.data(), data.size());
+	if (FAILED(hr))
+	{
+		return false;
+	}
+
+	if (!PipelineCacheFile::Write(path, ComputeDeviceKey(), data.data(), data.size()))
+	{
+		return false;
+	}
+	m_libraryDirty = false;
+	return true;
+}
+
+
+DX12PipelineStateCache::PipelinePtr DX12PipelineStateCache::CreatePipeline(const PipelineStateKey& key)
+{
+	//ãȾ߳ͬʱֽ̭ҲӰδ
+	Microsoft::WRL::ComPtr<ID3DBlob> vs = FindBytecode(key.VertexShaderHash);
+	Microsoft::WRL::ComPtr<ID3DBlob> ps = key.PixelShaderHash != 0 ? FindBytecode(key.PixelShaderHash) : nullptr;
+	ID3D12RootSignature* rootSignature = GetRootSignature(key.RootSignatureHash);
+	if (!vs || (key.PixelShaderHash != 0 && !ps))
+	{
+		throw std::runtime_error("DX12PipelineStateCache: shader bytecode not registered or replaced by a hot reload, build the key with BuildKey");
+	}
+	if (!rootSignature)
+	{
+		throw std::runtime_error("DX12PipelineStateCache: unknown root signature");
+	}
+	if (!key.Layout.IsValid())
+	{
+		throw std::runtime_error("DX12PipelineStateCache: invalid vertex layout");
+	}
+
+	//SemanticNameָפַפֲͷ
+	std::vector<D3D12_INPUT_ELEMENT_DESC> inputElements = D3D12VertexLayoutConverter::Convert(*key.Layout);
+
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
+	desc.pRootSignature = rootSignature;
+	desc.VS = { vs->GetBufferPointer(), vs->GetBufferSize() };
+	if (ps)
+	{
+		desc.PS = { ps->GetBufferPointer(), ps->GetBufferSize() };
+	}
+	desc.InputLayout = { inputElements.data(), static_cast<UINT>(inputElements.size()) };
+	FillRenderState(key.RenderState, desc);
+	desc.SampleMask = UINT_MAX;
+	desc.NumRenderTargets = key.NumRenderTargets;
+	for (UINT i = 0; i < key.NumRenderTargets; ++i)
+	{
+		desc.RTVFormats[i] = static_cast<DXGI_FORMAT>(key.RenderTargetFormats[i]);
+	}
+	desc.DSVFormat = static_cast<DXGI_FORMAT>(key.DepthStencilFormat);
+	desc.SampleDesc.Count = key.SampleCount;
+	desc.SampleDesc.Quality = key.SampleQuality;
+
+	wchar_t name[17];
+	MakePipelineName(key.ComputeHash(), name);
+
+	PipelinePtr pipeline;
+
+	//Ȳ⣬ʹȥʱһ£ϣײˣܾô
+	if (m_library)
+	{
+		std::lock_guard<std::mutex> lock(m_libraryMutex);
+		if (SUCCEEDED(m_library->LoadGraphicsPipeline(name, &desc, IID_PPV_ARGS(&pipeline))))
+		{
+			return pipeline;
+		}
+	}
+
+	//̵߳ģ߳̿ͬʱ
+	HRESULT hr = m_device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipeline));
+	if (FAILED(hr))
+	{
+		throw std::runtime_error("DX12PipelineStateCache: CreateGraphicsPipelineState failed");
+	}
+
+	if (m_library)
+	{
+		std::lock_guard<std::mutex> lock(m_libraryMutex);
+		if (SUCCEEDED(m_library->StorePipeline(name, pipeline.Get())))
+		{
+			m_libraryDirty = true;
+		}
+	}
+	return pipeline;
+}
+
+
+void DX12PipelineStateCache::FillRenderState(const PipelineRenderState& state, D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) const
+{
+	//
+	D3D12_RENDER_TARGET_BLEND_DESC blend = {};
+	blend.BlendEnable = state.Blend != PipelineBlendMode::Opaque;
+	blend.LogicOpEnable = FALSE;
+	blend.SrcBlend = D3D12_BLEND_ONE;
+	blend.DestBlend = D3D12_BLEND_ZERO;
+	blend.BlendOp = D3D12_BLEND_OP_ADD;
+	blend.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blend.DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+	blend.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blend.LogicOp = D3D12_LOGIC_OP_NOOP;
+	blend.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+
+	switch (state.Blend)
+	{
+	case PipelineBlendMode::AlphaBlend:
+		blend.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blend.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+		break;
+	case PipelineBlendMode::Additive:
+		blend.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blend.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case PipelineBlendMode::Premultiplied:
+		blend.SrcBlend = D3D12_BLEND_ONE;
+		blend.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+		break;
+	default:
+		break;
+	}
+
+	desc.BlendState.AlphaToCoverageEnable = FALSE;
+	desc.BlendState.IndependentBlendEnable = FALSE;
+	for (D3D12_RENDER_TARGET_BLEND_DESC& target : desc.BlendState.RenderTarget)
+	{
+		target = blend;
+	}
+
+	//դ
+	D3D12_RASTERIZER_DESC& raster = desc.RasterizerState;
+	raster.FillMode = state.Fill == PipelineFillMode::Wireframe ? D3D12_FILL_MODE_WIREFRAME : D3D12_FILL_MODE_SOLID;
+	switch (state.Cull)
+	{
+	case PipelineCullMode::None:  raster.CullMode = D3D12_CULL_MODE_NONE; break;
+	case PipelineCullMode::Front: raster.CullMode = D3D12_CULL_MODE_FRONT; break;
+	default:                      raster.CullMode = D3D12_CULL_MODE_BACK; break;
+	}
+	raster.FrontCounterClockwise = state.FrontCounterClockwise;
+	raster.DepthBias = D3D12_DEFAULT_DEPTH_BIAS;
+	raster.DepthBiasClamp = D3D12_DEFAULT_DEPTH_BIAS_CLAMP;
+	raster.SlopeScaledDepthBias = D3D12_DEFAULT_SLOPE_SCALED_DEPTH_BIAS;
+	raster.DepthClipEnable = TRUE;
+	raster.MultisampleEnable = FALSE;
+	raster.AntialiasedLineEnable = FALSE;
+	raster.ForcedSampleCount = 0;
+	raster.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
+
+	//ȣֻдҲҪDepthEnableȽϺALWAYS
+	D3D12_DEPTH_STENCIL_DESC& depth = desc.DepthStencilState;
+	depth.DepthEnable = state.DepthTest || state.DepthWrite;
+	depth.DepthWriteMask = state.DepthWrite ? D3D12_DEPTH_WRITE_MASK_ALL : D3D12_DEPTH_WRITE_MASK_ZERO;
+	depth.DepthFunc = state.DepthTest ? ToD3D12(state.DepthFunc) : D3D12_COMPARISON_FUNC_ALWAYS;
+	depth.StencilEnable = FALSE;
+	depth.StencilReadMask = D3D12_DEFAULT_STENCIL_READ_MASK;
+	depth.StencilWriteMask = D3D12_DEFAULT_STENCIL_WRITE_MASK;
+	const D3D12_DEPTH_STENCILOP_DESC stencilOp = { D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_COMPARISON_FUNC_ALWAYS };
+	depth.FrontFace = stencilOp;
+	depth.BackFace = stencilOp;
+
+	desc.PrimitiveTopologyType = ToD3D12(state.Topology);
+}
+
+
+Microsoft::WRL::ComPtr<ID3DBlob> DX12PipelineStateCache::FindBytecode(UINT64 hash) const
+{
+	std::lock_guard<std::mutex> lock(m_resourceMutex);
+	auto it = m_bytecodes.find(hash);
+	return it != m_bytecodes.end() ? it->second.Blob : nullptr;
+}
+
+
+void DX12PipelineStateCache::TrackBytecode(const std::string& shaderName, UINT64 hash, const Microsoft::WRL::ComPtr<ID3DBlob>& blob)
+{
+	auto [nameIt, inserted] = m_shaderBytecodes.try_emplace(shaderName, hash);
+	if (!inserted)
+	{
+		if (nameIt->second == hash)
+		{
+			return;
+		}
+
+		//ػ˰汾ֽûбþӵȻÿضһ
+		auto oldIt = m_bytecodes.find(nameIt->second);
+		if (oldIt != m_bytecodes.end() && --oldIt->second.RefCount == 0)
+		{
+			m_bytecodes.erase(oldIt);
+		}
+		nameIt->second = hash;
+	}
+
+	BytecodeEntry& entry = m_bytecodes[hash];
+	if (entry.Blob == nullptr)
+	{
+		entry.Blob = blob;
+	}
+	++entry.RefCount;
+}
+
+
+UINT64 DX12PipelineStateCache::ComputeDeviceKey() const
+{
+	//Կͺżû̬汾κһ˾ɵĹ߿ⶼ
+	UINT64 hash = VertexLayoutHash::OffsetBasis;
+	if (!m_factory)
+	{
+		return hash;
+	}
+
+	Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+	if (FAILED(m_factory->EnumAdapterByLuid(m_device->GetAdapterLuid(), IID_PPV_ARGS(&adapter))))
+	{
+		return hash;
+	}
+
+	DXGI_ADAPTER_DESC1 adapterDesc = {};
+	adapter->GetDesc1(&adapterDesc);
+	LARGE_INTEGER driverVersion = {};
+	adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion);
+
+	hash = VertexLayoutHash::HashValue(hash, adapterDesc.VendorId);
+	hash = VertexLayoutHash::HashValue(hash, adapterDesc.DeviceId);
+	hash = VertexLayoutHash::HashValue(hash, adapterDesc.SubSysId);
+	hash = VertexLayoutHash::HashValue(hash, adapterDesc.Revision);
+	hash = VertexLayoutHash::HashValue(hash, driverVersion.LowPart);
+	return VertexLayoutHash::HashValue(hash, static_cast<uint32_t>(driverVersion.HighPart));
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <d3d12.h>
+#include <dxgi1_6.h>
+#include <wrl/client.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Renderer/Core/PipelineStateCache.h"
+
+class ShaderManager;
+
+//PSO棺ͻPipelineStateCacheAPI޹أ︺ѼID3D12PipelineState
+//ʱȲID3D12PipelineLibraryоͲ±룻˳ǰSavePipelineLibraryд̣´LoadPipelineLibrary
+
+
+//һͼιߵɫShaderManagerע
+struct DX12GraphicsPipelineDesc
+{
+	std::string VertexShader;
+	std::string PixelShader;	//Ϊգֻдȣ
+	UINT64 RootSignature = 0;	//CreateRootSignatureصĹϣ
+	VertexLayoutHandle Layout;
+	PipelineRenderState RenderState;
+	UINT NumRenderTargets = 1;
+	DXGI_FORMAT RenderTargetFormats[PipelineStateKey::kMaxRenderTargets] = { DXGI_FORMAT_R8G8B8A8_UNORM };
+	DXGI_FORMAT DepthStencilFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
+	UINT SampleCount = 1;
+	UINT SampleQuality = 0;
+};
+
+
+class DX12PipelineStateCache
+{
+public:
+	using PipelinePtr = Microsoft::WRL::ComPtr<ID3D12PipelineState>;
+
+	DX12PipelineStateCache() = default;
+	~DX12PipelineStateCache();
+
+	DX12PipelineStateCache(const DX12PipelineStateCache&) = delete;
+	DX12PipelineStateCache& operator=(const DX12PipelineStateCache&) = delete;
+
+	//workerCountĄ̊́߳0ʾֻWaitForPending/GetOrCreateʱ
+	bool Initialize(ID3D12Device* device, IDXGIFactory4* factory, ShaderManager& shaderManager, UINT workerCount = 1);
+
+	//лǩݹϣֻͬһ
+	UINT64 CreateRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc);
+	ID3D12RootSignature* GetRootSignature(UINT64 hash) const;
+
+	//ɼShaderManagerһȡֽ͹ϣֽһݸ̨߳
+	//Դÿ֡ظãÿ֡BuildKey
+	//ɫʧܡ߶㲼ֺVSǩԲϷfalseÿVS+ֻһΣд
+	bool BuildKey(const DX12GraphicsPipelineDesc& desc, PipelineStateKey& outKey);
+
+	//ͬȡʧܷnullptr
+	ID3D12PipelineState* GetOrCreate(const PipelineStateKey& key);
+	ID3D12PipelineState* GetOrCreate(const DX12GraphicsPipelineDesc& desc);
+
+	//û÷nullptrں̨÷һ֡߻
+	ID3D12PipelineState* TryGet(const PipelineStateKey& key);
+
+	void Prewarm(const PipelineStateKey& key);
+	void WaitForPending();
+
+	PipelineCacheStats GetStats() const;
+
+	//ϵĹ߿⣬豸˻Զ
+	//LoadPipelineLibraryҪڵһδPSO֮ǰãSavePipelineLibraryֻ¹ʱд
+	//LoadLibrarywindows.hͬĺ꣩
+	bool LoadPipelineLibrary(const std::wstring& path);
+	bool SavePipelineLibrary(const std::wstring& path);
+	bool HasLibrary() const { return m_library != nullptr; }
+
+private:
+	//̨߳ϵ
+	PipelinePtr CreatePipeline(const PipelineStateKey& key);
+
+	void FillRenderState(const PipelineRenderState& state, D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) const;
+
+	Microsoft::WRL::ComPtr<ID3DBlob> FindBytecode(UINT64 hash) const;
+
+	//ɫڶӦֽ룬ʱm_resourceMutex
+	void TrackBytecode(const std::string& shaderName, UINT64 hash, const Microsoft::WRL::ComPtr<ID3DBlob>& blob);
+
+	//÷Ϣ鶥㲼֣VSϣֹϣ
+	bool ValidateInputLayout(const std::string& vertexShader, UINT64 vsHash, const VertexLayoutHandle& layout);
+
+	//Կ+汾Ĺϣдļͷ
+	UINT64 ComputeDeviceKey() const;
+
+	Microsoft::WRL::ComPtr<ID3D12Device> m_device;
+	Microsoft::WRL::ComPtr<ID3D12Device1> m_device1;	//߿ҪID3D12Device1òͲÿ
+	Microsoft::WRL::ComPtr<IDXGIFactory4> m_factory;
+	ShaderManager* m_shaderManager = nullptr;
+
+	//ֽ͸ǩϣ棬ֻ̨߳ű
+	//ֽ밴ɫֻ°汾ɵľͷţĴСش
+	//ɼϻûõĹ߻ΪҲֽʧܣBuildKeyУ
+	struct BytecodeEntry
+	{
+		Microsoft::WRL::ComPtr<ID3DBlob> Blob;
+		UINT RefCount = 0;
+	};
+	mutable std::mutex m_resourceMutex;
+	std::unordered_map<UINT64, BytecodeEntry> m_bytecodes;
+	std::unordered_map<std::string, UINT64> m_shaderBytecodes;	//ɫ -> õֽϣ
+	std::unordered_map<UINT64, Microsoft::WRL::ComPtr<ID3D12RootSignature>> m_rootSignatures;
+	std::unordered_map<UINT64, bool> m_inputLayoutChecks;
+
+	//߿⣬ʱҲ棬Լm_libraryDataǷлõڴ棬žͲͷţڿǰ棩
+	std::mutex m_libraryMutex;
+	std::vector<uint8_t> m_libraryData;
+	Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> m_library;
+	bool m_libraryDirty = false;
+
+	std::unique_ptr<PipelineStateCache<PipelinePtr>> m_cache;	//ʱͣ߳
+};
@@ -0,0 +1,113 @@
+#include "DX12/DX12UploadRing.h"
+#include "Core/KJUtil.h"
+#include <stdexcept>
+
+
+DX12UploadRing::~DX12UploadRing()
+{
+	if (m_buffer && m_mappedData)
+	{
+		m_buffer->Unmap(0, nullptr);
+		m_mappedData = nullptr;
+	}
+}
+
+
+bool DX12UploadRing::Initialize(ID3D12Device* device, DX12Fence& fence, UINT64 capacity)
+{
+	if (!device || capacity == 0)
+	{
+		return false;
+	}
+
+	//ϴѵԴ64KBģƫƶGPUַ
+	m_buffer = KJUtil::CreateUploadBuffer(device, capacity);
+
+	//ϴѿһֱӳţÿMap/Unmap
+	void* mappedData = nullptr;
+	D3D12_RANGE readRange = { 0, 0 };
+	HRESULT hr = m_buffer->Map(0, &readRange, &mappedData);
+	if (FAILED(hr))
+	{
+		m_buffer.Reset();
+		return false;
+	}
+
+	m_mappedData = static_cast<BYTE*>(mappedData);
+	m_gpuBase = m_buffer->GetGPUVirtualAddress();
+	m_fence = &fence;
+	m_allocator = std::make_unique<RingBufferAllocator>(capacity);
+	return true;
+}
+
+
+UploadAllocation DX12UploadRing::Allocate(UINT64 size, UINT64 alignment)
+{
+	if (!m_allocator)
+	{
+		throw std::logic_error("DX12UploadRing: not initialized");
+	}
+	if (size > m_allocator->GetCapacity())
+	{
+		throw std::runtime_error("DX12UploadRing: allocation larger than the ring");
+	}
+
+	UINT64 offset = m_allocator->Allocate(size, alignment);
+
+	//˾һ֡һ֡صGPUռ䣬ֱŵ
+	while (offset == RingBufferAllocator::kInvalidOffset)
+	{
+		UINT64 oldestFence = m_allocator->GetOldestPendingFence();
+		if (oldestFence == 0)
+		{
+			//ʣµȫǵǰ֡ԼõģҲû
+			throw std::runtime_error("DX12UploadRing: ring exhausted within a single frame, increase the capacity");
+		}
+		m_fence->WaitForValue(oldestFence);
+		m_allocator->ReleaseCompleted(oldestFence);
+		offset = m_allocator->Allocate(size, alignment);
+	}
+
+	UploadAllocation allocation;
+	allocation.CPUAddress = m_mappedData + offset;
+	allocation.GPUAddress = m_gpuBase + offset;
+	allocation.Resource = m_buffer.Get();
+	allocation.Offset = offset;
+	allocation.Size = size;
+	return allocation;
+}
+
+
+UploadAllocation DX12UploadRing::AllocateConstants(UINT byteSize)
+{
+	return Allocate(KJUtil::CalculateConstantBufferByteSize(byteSize), D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+}
+
+
+UploadAllocation DX12UploadRing::PushData(const void* data, UINT64 size, UINT64 alignment)
+{
+	UploadAllocation allocation = Allocate(size, alignment);
+	if (data)
+	{
+		std::memcpy(allocation.CPUAddress, data, static_cast<size_t>(size));
+	}
+	return allocation;
+}
+
+
+void DX12UploadRing::BeginFrame()
+{
+	if (m_allocator)
+	{
+		m_allocator->ReleaseCompleted(m_fence->GetCompletedValue());
+	}
+}
+
+
+void DX12UploadRing::EndFrame(UINT64 fenceValue)
+{
+	if (m_allocator)
+	{
+		m_allocator->FinishFrame(fenceValue);
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <cstring>
+#include <memory>
+#include "DX12/DX12Fence.h"
+#include "Renderer/Core/RingBufferAllocator.h"
+
+//ÿ֡ϴһ־ӳϴѻ壬Ͷ̬ÿ֡УÿCreateCommittedResource
+//ռ䰴֡ΧֵգDX12DeviceBeginFrame/EndFrame
+
+
+//һηĽCPUдCPUAddressGPUGPUAddress
+struct UploadAllocation
+{
+	void* CPUAddress = nullptr;
+	D3D12_GPU_VIRTUAL_ADDRESS GPUAddress = 0;
+	ID3D12Resource* Resource = nullptr;
+	UINT64 Offset = 0;
+	UINT64 Size = 0;
+};
+
+
+class DX12UploadRing
+{
+public:
+	//ĬϴСǧĳһЩ̬
+	static constexpr UINT64 kDefaultCapacity = 8ull * 1024 * 1024;
+
+	DX12UploadRing() = default;
+	~DX12UploadRing();
+
+	DX12UploadRing(const DX12UploadRing&) = delete;
+	DX12UploadRing& operator=(const DX12UploadRing&) = delete;
+
+	bool Initialize(ID3D12Device* device, DX12Fence& fence, UINT64 capacity = kDefaultCapacity);
+
+	//sizeֽڣalignment2
+	//˻һ֡ɣα쳣
+	UploadAllocation Allocate(UINT64 size, UINT64 alignment);
+
+	//壺СCalculateConstantBufferByteSize256ƫư256
+	UploadAllocation AllocateConstants(UINT byteSize);
+
+	//䲢صGPUAddressֱSetGraphicsRootConstantBufferView
+	template<typename T>
+	UploadAllocation PushConstants(const T& data)
+	{
+		UploadAllocation allocation = AllocateConstants(static_cast<UINT>(sizeof(T)));
+		std::memcpy(allocation.CPUAddress, &data, sizeof(T));
+		return allocation;
+	}
+
+	//䲢̬
+	UploadAllocation PushData(const void* data, UINT64 size, UINT64 alignment = 16);
+
+	//ࣺ֡BeginFrameGPU֡EndFrameһ֡ķǵΧֵ
+	void BeginFrame();
+	void EndFrame(UINT64 fenceValue);
+
+
+	UINT64 GetCapacity() const { return m_allocator ? m_allocator->GetCapacity() : 0; }
+	UINT64 GetUsedSize() const { return m_allocator ? m_allocator->GetUsedSize() : 0; }
+	bool IsInitialized() const { return m_buffer != nullptr; }
+	ID3D12Resource* GetResource() const { return m_buffer.Get(); }
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_buffer;
+	BYTE* m_mappedData = nullptr;
+	D3D12_GPU_VIRTUAL_ADDRESS m_gpuBase = 0;
+	DX12Fence* m_fence = nullptr;
+	std::unique_ptr<RingBufferAllocator> m_allocator;
+};
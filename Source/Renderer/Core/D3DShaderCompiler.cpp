@@ -0,0 +1,293 @@
+// D3DShaderCompiler.cpp
+#include "Renderer/Core/D3DShaderCompiler.h"
+#include "Renderer/Core/ShaderReflection.h"
+#include "Renderer/Resources/VertexLayout.h"
+#include <d3dcompiler.h>
+#include <d3d12shader.h>
+#include <wrl/client.h>
+#include <fstream>
+#include <list>
+#include <sstream>
+#include <unordered_map>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+namespace
+{
+    bool ReadFileBytes(const std::filesystem::path& path, std::string& outData)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        std::ostringstream stream;
+        stream << file.rdbuf();
+        outData = stream.str();
+        return true;
+    }
+
+    /**
+     * @brief ¼include
+     * @details ·ȰļĿ¼ʱͷ
+     */
+    class RecordingInclude final : public ID3DInclude
+    {
+    public:
+        explicit RecordingInclude(std::filesystem::path rootDirectory)
+            : m_rootDirectory(std::move(rootDirectory))
+        {
+        }
+
+        HRESULT __stdcall Open(D3D_INCLUDE_TYPE, LPCSTR fileName, LPCVOID parentData, LPCVOID* outData, UINT* outBytes) override
+        {
+            std::filesystem::path directory = m_rootDirectory;
+            auto parentIt = m_directories.find(parentData);
+            if (parentIt != m_directories.end())
+            {
+                directory = parentIt->second;
+            }
+
+            const std::filesystem::path path = (directory / fileName).lexically_normal();
+            std::string data;
+            if (!ReadFileBytes(path, data))
+            {
+                return E_FAIL;
+            }
+
+            m_buffers.push_back(std::move(data));
+            const std::string& buffer = m_buffers.back();
+            m_directories[buffer.data()] = path.parent_path();
+            Includes.push_back(path);
+
+            *outData = buffer.data();
+            *outBytes = static_cast<UINT>(buffer.size());
+            return S_OK;
+        }
+
+        HRESULT __stdcall Close(LPCVOID) override
+        {
+            return S_OK;
+        }
+
+        std::vector<std::filesystem::path> Includes;
+
+    private:
+        std::filesystem::path m_rootDirectory;
+        std::list<std::string> m_buffers;    // list֤push_backŲеĻ
+        std::unordered_map<const void*, std::filesystem::path> m_directories;
+    };
+
+    ShaderResourceKind ToResourceKind(D3D_SHADER_INPUT_TYPE type)
+    {
+        switch (type)
+        {
+        case D3D_SIT_CBUFFER:
+            return ShaderResourceKind::ConstantBuffer;
+        case D3D_SIT_SAMPLER:
+            return ShaderResourceKind::Sampler;
+        case D3D_SIT_UAV_RWTYPED:
+        case D3D_SIT_UAV_RWSTRUCTURED:
+        case D3D_SIT_UAV_RWBYTEADDRESS:
+        case D3D_SIT_UAV_APPEND_STRUCTURED:
+        case D3D_SIT_UAV_CONSUME_STRUCTURED:
+        case D3D_SIT_UAV_RWSTRUCTURED_WITH_COUNTER:
+            return ShaderResourceKind::UnorderedAccess;
+        default:
+            return ShaderResourceKind::ShaderResource;
+        }
+    }
+
+    ShaderComponentType ToComponentType(D3D_REGISTER_COMPONENT_TYPE type)
+    {
+        switch (type)
+        {
+        case D3D_REGISTER_COMPONENT_UINT32: return ShaderComponentType::UInt32;
+        case D3D_REGISTER_COMPONENT_SINT32: return ShaderComponentType::SInt32;
+        case D3D_REGISTER_COMPONENT_FLOAT32: return ShaderComponentType::Float32;
+        default: return ShaderComponentType::Unknown;
+        }
+    }
+}
+
+uint64_t D3DShaderCompiler::GetIdentity() const
+{
+    constexpr char kName[] = "D3DCompiler";
+    uint64_t hash = VertexLayoutHash::HashBytes(VertexLayoutHash::OffsetBasis, kName, sizeof(kName) - 1);
+    return VertexLayoutHash::HashValue(hash, D3D_COMPILER_VERSION);
+}
+
+ShaderPreprocessResult D3DShaderCompiler::Preprocess(const ShaderCompileRequest& request)
+{
+    ShaderPreprocessResult result;
+
+    std::string source;
+    if (!ReadFileBytes(request.SourcePath, source))
+    {
+        result.Errors = "Cannot open shader source: " + request.SourcePath.string() + "\n";
+        return result;
+    }
+
+    std::vector<D3D_SHADER_MACRO> macros;
+    macros.reserve(request.Defines.size() + 1);
+    for (const ShaderDefine& define : request.Defines)
+    {
+        macros.push_back({ define.Name.c_str(), define.Value.c_str() });
+    }
+    macros.push_back({ nullptr, nullptr });
+
+    RecordingInclude include(request.SourcePath.parent_path());
+    const std::string sourceName = request.SourcePath.string();
+    Microsoft::WRL::ComPtr<ID3DBlob> code;
+    Microsoft::WRL::ComPtr<ID3DBlob> errors;
+    HRESULT hr = D3DPreprocess(source.data(), source.size(), sourceName.c_str(), macros.data(), &include, &code, &errors);
+
+    if (errors != nullptr)
+    {
+        result.Errors.assign(static_cast<const char*>(errors->GetBufferPointer()), errors->GetBufferSize());
+    }
+    result.Includes = std::move(include.Includes);
+    if (FAILED(hr) || code == nullptr)
+    {
+        return result;
+    }
+
+    // ĩβ'\0'
+    const char* text = static_cast<const char*>(code->GetBufferPointer());
+    size_t length = code->GetBufferSize();
+    while (length > 0 && text[length - 1] == '\0')
+    {
+        --length;
+    }
+    result.Source.assign(text, length);
+    result.Success = true;
+    return result;
+}
+
+ShaderCompileResult D3DShaderCompiler::Compile(const ShaderCompileRequest& request, const std::string& preprocessedSource)
+{
+    ShaderCompileResult result;
+
+    // ѾԤʱչˣﲻٴ
+    const std::string sourceName = request.SourcePath.string();
+    Microsoft::WRL::ComPtr<ID3DBlob> byteCode;
+    Microsoft::WRL::ComPtr<ID3DBlob> errors;
+    HRESULT hr = D3DCompile(
+        preprocessedSource.data(),
+        preprocessedSource.size(),
+        sourceName.c_str(),
+        nullptr,
+        nullptr,
+        request.EntryPoint.c_str(),
+        request.Target.c_str(),
+        request.Flags,
+        0,
+        &byteCode,
+        &errors
+    );
+
+    if (errors != nullptr)
+    {
+        result.Errors.assign(static_cast<const char*>(errors->GetBufferPointer()), errors->GetBufferSize());
+    }
+    if (FAILED(hr) || byteCode == nullptr)
+    {
+        return result;
+    }
+
+    const uint8_t* data = static_cast<const uint8_t*>(byteCode->GetBufferPointer());
+    result.Bytecode.assign(data, data + byteCode->GetBufferSize());
+    result.Success = true;
+    return result;
+}
+
+bool D3DShaderCompiler::Reflect(const void* bytecode, size_t size, ShaderReflection& outReflection)
+{
+    outReflection = ShaderReflection();
+
+    Microsoft::WRL::ComPtr<ID3D12ShaderReflection> reflector;
+    if (FAILED(D3DReflect(bytecode, size, IID_PPV_ARGS(&reflector))))
+    {
+        return false;
+    }
+
+    D3D12_SHADER_DESC shaderDesc = {};
+    if (FAILED(reflector->GetDesc(&shaderDesc)))
+    {
+        return false;
+    }
+
+    // ð󶨣cbufferĲλҪ
+    outReflection.Bindings.reserve(shaderDesc.BoundResources);
+    for (UINT i = 0; i < shaderDesc.BoundResources; ++i)
+    {
+        D3D12_SHADER_INPUT_BIND_DESC bindDesc = {};
+        if (FAILED(reflector->GetResourceBindingDesc(i, &bindDesc)))
+        {
+            return false;
+        }
+        ShaderResourceBinding binding;
+        binding.Name = bindDesc.Name;
+        binding.Kind = ToResourceKind(bindDesc.Type);
+        binding.BindPoint = bindDesc.BindPoint;
+        binding.BindCount = bindDesc.BindCount;
+        binding.Space = bindDesc.Space;
+        outReflection.Bindings.push_back(std::move(binding));
+    }
+
+    for (UINT i = 0; i < shaderDesc.ConstantBuffers; ++i)
+    {
+        ID3D12ShaderReflectionConstantBuffer* buffer = reflector->GetConstantBufferByIndex(i);
+        D3D12_SHADER_BUFFER_DESC bufferDesc = {};
+        if (buffer == nullptr || FAILED(buffer->GetDesc(&bufferDesc)))
+        {
+            return false;
+        }
+        // tbufferͽṹҲֻҪcbuffer
+        if (bufferDesc.Type != D3D_CT_CBUFFER)
+        {
+            continue;
+        }
+
+        ShaderConstantBufferInfo info;
+        info.Name = bufferDesc.Name;
+        info.Size = bufferDesc.Size;
+        if (const ShaderResourceBinding* binding = outReflection.FindBinding(info.Name))
+        {
+            info.BindPoint = binding->BindPoint;
+            info.Space = binding->Space;
+        }
+
+        info.Variables.reserve(bufferDesc.Variables);
+        for (UINT v = 0; v < bufferDesc.Variables; ++v)
+        {
+            D3D12_SHADER_VARIABLE_DESC variableDesc = {};
+            ID3D12ShaderReflectionVariable* variable = buffer->GetVariableByIndex(v);
+            if (variable == nullptr || FAILED(variable->GetDesc(&variableDesc)))
+            {
+                return false;
+            }
+            info.Variables.push_back({ variableDesc.Name, variableDesc.StartOffset, variableDesc.Size });
+        }
+        outReflection.ConstantBuffers.push_back(std::move(info));
+    }
+
+    outReflection.InputParameters.reserve(shaderDesc.InputParameters);
+    for (UINT i = 0; i < shaderDesc.InputParameters; ++i)
+    {
+        D3D12_SIGNATURE_PARAMETER_DESC parameterDesc = {};
+        if (FAILED(reflector->GetInputParameterDesc(i, &parameterDesc)))
+        {
+            return false;
+        }
+        ShaderInputParameter input;
+        input.SemanticName = parameterDesc.SemanticName;
+        input.SemanticIndex = parameterDesc.SemanticIndex;
+        input.Register = parameterDesc.Register;
+        input.ComponentType = ToComponentType(parameterDesc.ComponentType);
+        input.Mask = parameterDesc.Mask;
+        input.IsSystemValue = parameterDesc.SystemValueType != D3D_NAME_UNDEFINED;
+        outReflection.InputParameters.push_back(std::move(input));
+    }
+    return true;
+}
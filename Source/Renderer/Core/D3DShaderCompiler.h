@@ -0,0 +1,22 @@
+// D3DShaderCompiler.h
+#pragma once
+#include "Renderer/Core/ShaderCompiler.h"
+
+/**
+ * @brief d3dcompilerFXCı
+ * @details PreprocessD3DPreprocessincludeڰļ¼
+ *          CompileD3DCompileԤıٶκͷļ֤ľʱԴ
+ * @note ״̬̰߳ȫ
+ */
+class D3DShaderCompiler final : public IShaderCompiler
+{
+public:
+    uint64_t GetIdentity() const override;
+    ShaderPreprocessResult Preprocess(const ShaderCompileRequest& request) override;
+    ShaderCompileResult Compile(const ShaderCompileRequest& request, const std::string& preprocessedSource) override;
+
+    /**
+     * @brief D3DReflectID3D12ShaderReflectionֻ֧FXCDXBCֽ
+     */
+    bool Reflect(const void* bytecode, size_t size, ShaderReflection& outReflection) override;
+};
@@ -0,0 +1,138 @@
+// FrameContextRing.cpp
+#include "Renderer/Core/FrameContextRing.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+// ============================================================================
+//                        SimulatedFrameQueueSync
+// ============================================================================
+
+uint64_t SimulatedFrameQueueSync::Signal()
+{
+    return ++m_signaledValue;
+}
+
+void SimulatedFrameQueueSync::WaitForValue(uint64_t value)
+{
+    if (value <= m_completedValue)
+    {
+        return;
+    }
+    if (value > m_signaledValue)
+    {
+        throw std::logic_error("SimulatedFrameQueueSync: waiting for a fence value that was never signaled");
+    }
+
+    ++m_waitCount;
+    m_completedValue = value;
+}
+
+void SimulatedFrameQueueSync::CompleteUpTo(uint64_t value)
+{
+    m_completedValue = std::max(m_completedValue, std::min(value, m_signaledValue));
+}
+
+
+// ============================================================================
+//                        FrameContextRing
+// ============================================================================
+
+FrameContextRing::FrameContextRing(IFrameQueueSync& sync, uint32_t frameCount)
+    : m_sync(sync)
+{
+    if (frameCount == 0)
+    {
+        throw std::invalid_argument("FrameContextRing: frame count must be at least 1");
+    }
+    m_slots.resize(frameCount);
+}
+
+uint32_t FrameContextRing::BeginFrame()
+{
+    if (m_inFrame)
+    {
+        throw std::logic_error("FrameContextRing: BeginFrame called twice without EndFrame");
+    }
+
+    // һ֡òλ0֮ת
+    if (m_frameNumber > 0)
+    {
+        m_currentSlot = (m_currentSlot + 1) % GetFrameCount();
+    }
+
+    // ֻвλһֻGPUʱҪ
+    Slot& slot = m_slots[m_currentSlot];
+    if (slot.FenceValue > m_sync.GetCompletedValue())
+    {
+        ++m_stallCount;
+        m_sync.WaitForValue(slot.FenceValue);
+    }
+    RunDeferred(slot);
+
+    ++m_frameNumber;
+    m_inFrame = true;
+    return m_currentSlot;
+}
+
+uint64_t FrameContextRing::EndFrame()
+{
+    if (!m_inFrame)
+    {
+        throw std::logic_error("FrameContextRing: EndFrame called without BeginFrame");
+    }
+
+    const uint64_t fenceValue = m_sync.Signal();
+    m_slots[m_currentSlot].FenceValue = fenceValue;
+    m_inFrame = false;
+    return fenceValue;
+}
+
+void FrameContextRing::DeferUntilComplete(std::function<void()> callback)
+{
+    if (callback)
+    {
+        m_slots[m_currentSlot].Deferred.push_back(std::move(callback));
+    }
+}
+
+void FrameContextRing::WaitForIdle()
+{
+    if (m_inFrame)
+    {
+        throw std::logic_error("FrameContextRing: WaitForIdle called inside a frame");
+    }
+
+    uint64_t lastValue = 0;
+    for (const Slot& slot : m_slots)
+    {
+        lastValue = std::max(lastValue, slot.FenceValue);
+    }
+    if (lastValue > m_sync.GetCompletedValue())
+    {
+        m_sync.WaitForValue(lastValue);
+    }
+
+    for (Slot& slot : m_slots)
+    {
+        RunDeferred(slot);
+    }
+}
+
+void FrameContextRing::RunDeferred(Slot& slot)
+{
+    // ȻִУصٹµĻصҲƻ
+    std::vector<std::function<void()>> callbacks;
+    callbacks.swap(slot.Deferred);
+    for (auto& callback : callbacks)
+    {
+        callback();
+    }
+
+    // ȥȶʱٷ
+    callbacks.clear();
+    if (slot.Deferred.empty())
+    {
+        slot.Deferred.swap(callbacks);
+    }
+}
@@ -0,0 +1,168 @@
+// FrameContextRing.h
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief GPUмΧĳ
+ * @details FrameContextRingֻͨGPU򽻵DX12ʵּDX12FrameContextSimulatedFrameQueueSync
+ */
+class IFrameQueueSync
+{
+public:
+    virtual ~IFrameQueueSync() = default;
+
+    /**
+     * @brief ڶĩβһΧֵ
+     */
+    virtual uint64_t Signal() = 0;
+
+    /**
+     * @brief GPUѾɵΧֵ
+     */
+    virtual uint64_t GetCompletedValue() const = 0;
+
+    /**
+     * @brief ֱvalue
+     */
+    virtual void WaitForValue(uint64_t value) = 0;
+};
+
+
+/**
+ * @brief ģĶкΧҪGPU
+ * @details Signalֵȴδ״̬CompleteUpTo/CompleteNextģGPUꣻ
+ *          WaitForValueֱֵƽvalueһεȴCPUﱻס
+ */
+class SimulatedFrameQueueSync final : public IFrameQueueSync
+{
+public:
+    uint64_t Signal() override;
+    uint64_t GetCompletedValue() const override { return m_completedValue; }
+
+    /**
+     * @brief ģȴȴһûֵ׳쳣ʵGPUϾ
+     */
+    void WaitForValue(uint64_t value) override;
+
+    /**
+     * @brief ģGPUɵvalueѷֵ
+     */
+    void CompleteUpTo(uint64_t value);
+
+    /**
+     * @brief ģGPUһδɵֵ
+     */
+    void CompleteNext() { CompleteUpTo(m_completedValue + 1); }
+
+    /**
+     * @brief ģGPUȫѷĹ
+     */
+    void CompleteAll() { m_completedValue = m_signaledValue; }
+
+    uint64_t GetSignaledValue() const { return m_signaledValue; }
+
+    /**
+     * @brief valueδɣĴ
+     */
+    uint64_t GetWaitCount() const { return m_waitCount; }
+
+private:
+    uint64_t m_signaledValue = 0;
+    uint64_t m_completedValue = 0;
+    uint64_t m_waitCount = 0;
+};
+
+
+/**
+ * @brief N֡е֡Ļ
+ * @details ÿλ¼һʹ֡ΧֵBeginFrameȡһλֻλһֹ
+ *          ûʱŵȴִйλϵӳٻصͷʱԴȣ
+ *          λɵ߰GetCurrentSlot()Լֻܽࡣ
+ * @note ̰߳ȫȾ߳ʹ
+ */
+class FrameContextRing
+{
+public:
+    /**
+     * @brief Ĭϲ֡ImGui DX12˵NumFramesInFlightһ£
+     */
+    static constexpr uint32_t kDefaultFrameCount = 3;
+
+    /**
+     * @brief 
+     * @param sync кΧҪȻ
+     * @param frameCount ֡Ϊ1
+     */
+    explicit FrameContextRing(IFrameQueueSync& sync, uint32_t frameCount = kDefaultFrameCount);
+
+    /**
+     * @brief ʱȴGPUҪĻȵWaitForIdle
+     */
+    ~FrameContextRing() = default;
+
+    FrameContextRing(const FrameContextRing&) = delete;
+    FrameContextRing& operator=(const FrameContextRing&) = delete;
+
+    /**
+     * @brief ʼµһ֡
+     * @return ֡ʹõĲλ
+     */
+    uint32_t BeginFrame();
+
+    /**
+     * @brief ֡ڶϷΧֵǵǰλ
+     * @return ֡Χֵ
+     */
+    uint64_t EndFrame();
+
+    /**
+     * @brief ѻصҵǰ֡ϣһ֡GPUɺִ
+     * @note ֡ڵʱҵһ֡
+     */
+    void DeferUntilComplete(std::function<void()> callback);
+
+    /**
+     * @brief ȴύ֡ɣִӳٻصĽС˳ǰã
+     */
+    void WaitForIdle();
+
+    uint32_t GetFrameCount() const { return static_cast<uint32_t>(m_slots.size()); }
+    uint32_t GetCurrentSlot() const { return m_currentSlot; }
+    bool IsInFrame() const { return m_inFrame; }
+
+    /**
+     * @brief Ѿʼ֡
+     */
+    uint64_t GetFrameNumber() const { return m_frameNumber; }
+
+    /**
+     * @brief BeginFrameλռöȴGPUĴ
+     */
+    uint64_t GetStallCount() const { return m_stallCount; }
+
+    /**
+     * @brief λһύΧֵ0ʾûù
+     */
+    uint64_t GetSlotFenceValue(uint32_t slot) const { return m_slots.at(slot).FenceValue; }
+
+private:
+    struct Slot
+    {
+        uint64_t FenceValue = 0;
+        std::vector<std::function<void()>> Deferred;
+    };
+
+    /**
+     * @brief ִвղλӳٻص
+     */
+    static void RunDeferred(Slot& slot);
+
+    IFrameQueueSync& m_sync;
+    std::vector<Slot> m_slots;
+    uint32_t m_currentSlot = 0;
+    uint64_t m_frameNumber = 0;
+    uint64_t m_stallCount = 0;
+    bool m_inFrame = false;
+};
@@ -0,0 +1,91 @@
+// PagedDescriptorAllocator.cpp
+#include "Renderer/Core/PagedDescriptorAllocator.h"
+#include <stdexcept>
+
+PagedDescriptorAllocator::PagedDescriptorAllocator(uint32_t pageSize, uint32_t maxPages)
+    : m_pageSize(pageSize)
+    , m_maxPages(maxPages)
+{
+    if (pageSize == 0)
+    {
+        throw std::invalid_argument("PagedDescriptorAllocator: page size must be greater than zero");
+    }
+}
+
+uint32_t PagedDescriptorAllocator::Allocate()
+{
+    if (m_freeIndices.empty() && !AddPage())
+    {
+        return kInvalidIndex;
+    }
+
+    const uint32_t index = m_freeIndices.back();
+    m_freeIndices.pop_back();
+    m_allocated[index] = true;
+    return index;
+}
+
+void PagedDescriptorAllocator::Free(uint32_t index)
+{
+    MarkFreed(index);
+    m_freeIndices.push_back(index);
+}
+
+void PagedDescriptorAllocator::FreeDeferred(uint32_t index, uint64_t fenceValue)
+{
+    if (!m_pendingFrees.empty() && fenceValue < m_pendingFrees.back().FenceValue)
+    {
+        throw std::logic_error("PagedDescriptorAllocator: fence values must be monotonically increasing");
+    }
+
+    // ̱ǣȴڼظͷҲܷ֣ҪΧɲŷŻؿջ
+    MarkFreed(index);
+    m_pendingFrees.push_back({ fenceValue, index });
+}
+
+void PagedDescriptorAllocator::ReleaseCompleted(uint64_t completedFenceValue)
+{
+    while (!m_pendingFrees.empty() && m_pendingFrees.front().FenceValue <= completedFenceValue)
+    {
+        m_freeIndices.push_back(m_pendingFrees.front().Index);
+        m_pendingFrees.pop_front();
+    }
+}
+
+bool PagedDescriptorAllocator::AddPage()
+{
+    if (m_maxPages != 0 && m_pageCount >= m_maxPages)
+    {
+        return false;
+    }
+    if (static_cast<uint64_t>(m_pageCount + 1) * m_pageSize >= kInvalidIndex)
+    {
+        return false;
+    }
+
+    const uint32_t pageIndex = m_pageCount;
+    if (m_pageCallback)
+    {
+        m_pageCallback(pageIndex);
+    }
+
+    // ѹջҳڵλȷȥ
+    const uint32_t first = pageIndex * m_pageSize;
+    m_freeIndices.reserve(m_freeIndices.size() + m_pageSize);
+    for (uint32_t i = m_pageSize; i > 0; --i)
+    {
+        m_freeIndices.push_back(first + i - 1);
+    }
+    m_allocated.resize(static_cast<size_t>(first) + m_pageSize, false);
+    ++m_pageCount;
+    return true;
+}
+
+void PagedDescriptorAllocator::MarkFreed(uint32_t index)
+{
+    if (index >= m_allocated.size() || !m_allocated[index])
+    {
+        throw std::logic_error("PagedDescriptorAllocator: freeing a descriptor that is not allocated");
+    }
+    m_allocated[index] = false;
+}
@@ -0,0 +1,101 @@
+// PagedDescriptorAllocator.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief ҳ
+ * @details ֻѣһջͷŶO(1)
+ *          ջʱµһҳͨҳصϲ㴴Ӧѣȫ = ҳ * ҳС + ҳƫơ
+ *          GPUܻõFreeDeferredҵΧֵϣReleaseCompletedʱصջ
+ *          DX12ǱߵʵּDX12DescriptorAllocatorʱҳصʲô
+ * @note ̰߳ȫ
+ */
+class PagedDescriptorAllocator
+{
+public:
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    /**
+     * @brief 
+     * @param pageSize ÿҳ0
+     * @param maxPages ҳ0ʾ
+     */
+    explicit PagedDescriptorAllocator(uint32_t pageSize, uint32_t maxPages = 0);
+
+    /**
+     * @brief ҳصҳ֮ǰãص׳쳣ʱҳ
+     */
+    void SetPageCallback(std::function<void(uint32_t pageIndex)> callback) { m_pageCallback = std::move(callback); }
+
+    /**
+     * @brief һ
+     * @return ȫﵽҳʱkInvalidIndex
+     */
+    uint32_t Allocate();
+
+    /**
+     * @brief ͷţ֤߱GPUѾʹãظͷŻ׳쳣
+     */
+    void Free(uint32_t index);
+
+    /**
+     * @brief ӳͷţfenceValueɺٷȥ
+     */
+    void FreeDeferred(uint32_t index, uint64_t fenceValue);
+
+    /**
+     * @brief ΧֵcompletedFenceValueӳͷ
+     */
+    void ReleaseCompleted(uint64_t completedFenceValue);
+
+    uint32_t GetPageIndex(uint32_t index) const { return index / m_pageSize; }
+    uint32_t GetOffsetInPage(uint32_t index) const { return index % m_pageSize; }
+
+    uint32_t GetPageSize() const { return m_pageSize; }
+    uint32_t GetPageCount() const { return m_pageCount; }
+
+    /**
+     * @brief ѷȥȴյģ
+     */
+    uint32_t GetAllocatedCount() const { return m_pageCount * m_pageSize - static_cast<uint32_t>(m_freeIndices.size()); }
+
+    /**
+     * @brief Ƿѷ״̬ȴյĲ㣩ͷǰⲿ
+     */
+    bool IsAllocated(uint32_t index) const { return index < m_allocated.size() && m_allocated[index]; }
+
+    /**
+     * @brief ȴΧյ
+     */
+    size_t GetPendingFreeCount() const { return m_pendingFrees.size(); }
+
+private:
+    struct PendingFree
+    {
+        uint64_t FenceValue;
+        uint32_t Index;
+    };
+
+    /**
+     * @brief µһҳʧܷfalse
+     */
+    bool AddPage();
+
+    /**
+     * @brief ȷʵѷ״̬Ϊͷ
+     */
+    void MarkFreed(uint32_t index);
+
+    uint32_t m_pageSize;
+    uint32_t m_maxPages;
+    uint32_t m_pageCount = 0;
+    std::vector<uint32_t> m_freeIndices;    // ջȳͷŵڻ
+    std::vector<bool> m_allocated;          // ÿǷѷ䣬ظͷ
+    std::deque<PendingFree> m_pendingFrees;
+    std::function<void(uint32_t)> m_pageCallback;
+};
@@ -0,0 +1,127 @@
+// PipelineStateCache.cpp
+#include "Renderer/Core/PipelineStateCache.h"
+#include <fstream>
+#include <system_error>
+
+namespace
+{
+    uint64_t HashRenderState(uint64_t hash, const PipelineRenderState& state)
+    {
+        // ֶλ룬ֱӹϣṹֽڣֽӰ
+        hash = VertexLayoutHash::HashValue(hash, static_cast<uint32_t>(state.Blend));
+        hash = VertexLayoutHash::HashValue(hash, static_cast<uint32_t>(state.Cull));
+        hash = VertexLayoutHash::HashValue(hash, static_cast<uint32_t>(state.Fill));
+        hash = VertexLayoutHash::HashValue(hash, state.FrontCounterClockwise ? 1u : 0u);
+        hash = VertexLayoutHash::HashValue(hash, state.DepthTest ? 1u : 0u);
+        hash = VertexLayoutHash::HashValue(hash, state.DepthWrite ? 1u : 0u);
+        hash = VertexLayoutHash::HashValue(hash, static_cast<uint32_t>(state.DepthFunc));
+        return VertexLayoutHash::HashValue(hash, static_cast<uint32_t>(state.Topology));
+    }
+
+    struct FileHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t DeviceKey;
+        uint64_t DataSize;
+        uint64_t Checksum;
+    };
+
+    uint64_t ComputeChecksum(const void* data, size_t size)
+    {
+        return VertexLayoutHash::HashBytes(VertexLayoutHash::OffsetBasis, static_cast<const char*>(data), size);
+    }
+}
+
+uint64_t PipelineStateKey::ComputeHash() const
+{
+    uint64_t hash = VertexLayoutHash::OffsetBasis;
+    hash = VertexLayoutHash::HashValue64(hash, VertexShaderHash);
+    hash = VertexLayoutHash::HashValue64(hash, PixelShaderHash);
+    hash = VertexLayoutHash::HashValue64(hash, RootSignatureHash);
+    hash = VertexLayoutHash::HashValue64(hash, Layout.GetHash());
+    hash = HashRenderState(hash, RenderState);
+    hash = VertexLayoutHash::HashValue(hash, NumRenderTargets);
+    for (uint32_t format : RenderTargetFormats)
+    {
+        hash = VertexLayoutHash::HashValue(hash, format);
+    }
+    hash = VertexLayoutHash::HashValue(hash, DepthStencilFormat);
+    hash = VertexLayoutHash::HashValue(hash, SampleCount);
+    return VertexLayoutHash::HashValue(hash, SampleQuality);
+}
+
+
+// ============================================================================
+//                        PipelineCacheFile
+// ============================================================================
+
+bool PipelineCacheFile::Write(const std::filesystem::path& path, uint64_t deviceKey, const void* data, size_t size)
+{
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        const FileHeader header = { kMagic, kVersion, deviceKey, static_cast<uint64_t>(size), ComputeChecksum(data, size) };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!file.good())
+        {
+            file.close();
+            std::error_code ignored;
+            std::filesystem::remove(tempPath, ignored);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool PipelineCacheFile::Read(const std::filesystem::path& path, uint64_t deviceKey, std::vector<uint8_t>& outData)
+{
+    outData.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    FileHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file.good() || header.Magic != kMagic || header.Version != kVersion || header.DeviceKey != deviceKey)
+    {
+        return false;
+    }
+
+    // ȺļʵʴСһ£ļĴᵼһξ޴ķ
+    std::error_code error;
+    const uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error || fileSize < sizeof(header) || fileSize - sizeof(header) != header.DataSize)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(header.DataSize));
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file.good() || ComputeChecksum(data.data(), data.size()) != header.Checksum)
+    {
+        return false;
+    }
+
+    outData = std::move(data);
+    return true;
+}
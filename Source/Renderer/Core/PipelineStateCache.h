@@ -0,0 +1,495 @@
+// PipelineStateCache.h
+#pragma once
+#include "Renderer/Resources/VertexLayoutRegistry.h"
+#include "Timer/Clock.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+//                        
+// ============================================================================
+
+enum class PipelineBlendMode : uint8_t
+{
+    Opaque,
+    AlphaBlend,       // src * a + dst * (1 - a)
+    Additive,         // src * a + dst
+    Premultiplied     // src + dst * (1 - a)
+};
+
+enum class PipelineCullMode : uint8_t
+{
+    None,
+    Front,
+    Back
+};
+
+enum class PipelineFillMode : uint8_t
+{
+    Solid,
+    Wireframe
+};
+
+enum class PipelineCompareFunc : uint8_t
+{
+    Never,
+    Less,
+    Equal,
+    LessEqual,
+    Greater,
+    NotEqual,
+    GreaterEqual,
+    Always
+};
+
+enum class PipelineTopologyType : uint8_t
+{
+    Point,
+    Line,
+    Triangle
+};
+
+/**
+ * @brief API޹صĹ̶״̬ϡդȣ
+ * @details ֻĿļĬֵӦ͸޳ȲԵͨ
+ */
+struct PipelineRenderState
+{
+    PipelineBlendMode Blend = PipelineBlendMode::Opaque;
+    PipelineCullMode Cull = PipelineCullMode::Back;
+    PipelineFillMode Fill = PipelineFillMode::Solid;
+    bool FrontCounterClockwise = false;
+    bool DepthTest = true;
+    bool DepthWrite = true;
+    PipelineCompareFunc DepthFunc = PipelineCompareFunc::Less;
+    PipelineTopologyType Topology = PipelineTopologyType::Triangle;
+
+    bool operator==(const PipelineRenderState&) const = default;
+};
+
+/**
+ * @brief ״̬ļ
+ * @details ɫֽݹϣShaderManager::GetShaderHashפ
+ *          ǩлݹϣͬڲͬõͬComputeHashԵ̻
+ * @note ʽDXGI_FORMATֵd3d12.hòȾĿλ0
+ */
+struct PipelineStateKey
+{
+    static constexpr uint32_t kMaxRenderTargets = 8;
+
+    uint64_t VertexShaderHash = 0;
+    uint64_t PixelShaderHash = 0;
+    uint64_t RootSignatureHash = 0;
+    VertexLayoutHandle Layout;
+    PipelineRenderState RenderState;
+    uint32_t NumRenderTargets = 1;
+    std::array<uint32_t, kMaxRenderTargets> RenderTargetFormats{};
+    uint32_t DepthStencilFormat = 0;
+    uint32_t SampleCount = 1;
+    uint32_t SampleQuality = 0;
+
+    /**
+     * @brief ȶ64λݹϣFNV-1aVertexLayout::GetHashͬһף
+     */
+    uint64_t ComputeHash() const;
+
+    bool operator==(const PipelineStateKey&) const = default;
+};
+
+template<>
+struct std::hash<PipelineStateKey>
+{
+    size_t operator()(const PipelineStateKey& key) const noexcept
+    {
+        return static_cast<size_t>(key.ComputeHash());
+    }
+};
+
+
+// ============================================================================
+//                        
+// ============================================================================
+
+enum class PipelineEntryState : uint8_t
+{
+    Missing,    // û
+    Pending,    // Ŷлڴ
+    Ready,
+    Failed      // 쳣Զ
+};
+
+struct PipelineCacheStats
+{
+    uint64_t Hits = 0;            // ʱѾ
+    uint64_t Misses = 0;          // ʱûУβҴ
+    uint64_t PendingHits = 0;     // ʱڴTryGetòGetOrCreateҪȻԼ
+    uint64_t Created = 0;
+    uint64_t Failed = 0;
+    int64_t TotalCreateNs = 0;
+    int64_t MaxCreateNs = 0;
+    size_t EntryCount = 0;
+    size_t PendingCount = 0;
+
+    double GetHitRate() const
+    {
+        const uint64_t lookups = Hits + Misses + PendingHits;
+        return lookups == 0 ? 0.0 : static_cast<double>(Hits) / static_cast<double>(lookups);
+    }
+};
+
+/**
+ * @brief PipelineStateKey߶̴ֺ̨֧߳
+ * @details PipelineǴͣDX12ComPtr<ID3D12PipelineState>һֵ
+ *          ʧʱ쳣쳣Ŀϣ֮GetOrCreate׳
+ *          - GetOrCreateͬûо͵Ŀڶû˶Լڽ͵
+ *          - TryGetûоͶ̨̣߳һ֡ȷfalse÷λƻߣ
+ *          - Prewarmؽ׶ΰ֪ǰŶӣͳ
+ *          workerCountΪ0ʱûк̨̣߳ŶӵWaitForPendingɵִ߳УԿȫȷ
+ * @note ̰߳ȫڹ߳ϵãԼҪ֤̰߳ȫ
+ */
+template<typename Pipeline>
+class PipelineStateCache
+{
+public:
+    using Creator = std::function<Pipeline(const PipelineStateKey&)>;
+
+    explicit PipelineStateCache(Creator creator, uint32_t workerCount = 1)
+        : m_creator(std::move(creator))
+    {
+        if (!m_creator)
+        {
+            throw std::invalid_argument("PipelineStateCache: creator must not be empty");
+        }
+
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ~PipelineStateCache()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_queueCondition.notify_all();
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    PipelineStateCache(const PipelineStateCache&) = delete;
+    PipelineStateCache& operator=(const PipelineStateCache&) = delete;
+
+    /**
+     * @brief ͬȡҪʱڵ߳ϴ
+     * @throws ׳쳣֮ÿζöף
+     */
+    Pipeline GetOrCreate(const PipelineStateKey& key)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto [it, inserted] = m_entries.try_emplace(key);
+        std::shared_ptr<Entry> entry = inserted ? (it->second = std::make_shared<Entry>()) : it->second;
+
+        if (inserted)
+        {
+            ++m_stats.Misses;
+            ++m_pendingCount;
+            entry->State = EntryState::Creating;
+            Create(key, *entry, lock);
+        }
+        else if (entry->State == EntryState::Ready)
+        {
+            ++m_stats.Hits;
+            return entry->Value;
+        }
+        else if (entry->State == EntryState::Queued)
+        {
+            // ûʼŵֱԼ߳ȡʱ
+            ++m_stats.PendingHits;
+            entry->State = EntryState::Creating;
+            Create(key, *entry, lock);
+        }
+        else if (entry->State == EntryState::Creating)
+        {
+            ++m_stats.PendingHits;
+            m_doneCondition.wait(lock, [&entry]() { return entry->State != EntryState::Creating; });
+        }
+
+        if (entry->State == EntryState::Failed)
+        {
+            std::rethrow_exception(entry->Error);
+        }
+        return entry->Value;
+    }
+
+    /**
+     * @brief ĻȡûþŶӺ̨
+     * @return ˷trueдoutŶСڴ򴴽ʧܷfalse
+     */
+    bool TryGet(const PipelineStateKey& key, Pipeline& out)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [it, inserted] = m_entries.try_emplace(key);
+        if (inserted)
+        {
+            ++m_stats.Misses;
+            Enqueue(it->first, it->second);
+            return false;
+        }
+
+        const Entry& entry = *it->second;
+        if (entry.State == EntryState::Ready)
+        {
+            ++m_stats.Hits;
+            out = entry.Value;
+            return true;
+        }
+        if (entry.State != EntryState::Failed)
+        {
+            ++m_stats.PendingHits;
+        }
+        return false;
+    }
+
+    /**
+     * @brief ǰŶӴѾеļʲôҲ
+     */
+    void Prewarm(const PipelineStateKey& key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [it, inserted] = m_entries.try_emplace(key);
+        if (inserted)
+        {
+            Enqueue(it->first, it->second);
+        }
+    }
+
+    /**
+     * @brief ŶӺڴĿɣûй߳ʱɵִ߳ж
+     */
+    void WaitForPending()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_workers.empty())
+        {
+            while (RunOneQueued(lock))
+            {
+            }
+        }
+        m_doneCondition.wait(lock, [this]() { return m_pendingCount == 0; });
+    }
+
+    PipelineEntryState GetState(const PipelineStateKey& key) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end())
+        {
+            return PipelineEntryState::Missing;
+        }
+        switch (it->second->State)
+        {
+        case EntryState::Ready:  return PipelineEntryState::Ready;
+        case EntryState::Failed: return PipelineEntryState::Failed;
+        default:                 return PipelineEntryState::Pending;
+        }
+    }
+
+    /**
+     * @brief ȴеĴȫĿͳƱ
+     * @note ڼ䲻Ҫڱ̲߳
+     */
+    void Clear()
+    {
+        WaitForPending();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+    }
+
+    /**
+     * @brief ֻʧܵĿ޺ɫ´
+     */
+    void ClearFailed()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::erase_if(m_entries, [](const auto& pair) { return pair.second->State == EntryState::Failed; });
+    }
+
+    PipelineCacheStats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        PipelineCacheStats stats = m_stats;
+        stats.EntryCount = m_entries.size();
+        stats.PendingCount = m_pendingCount;
+        return stats;
+    }
+
+    void ResetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats = PipelineCacheStats{};
+    }
+
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+private:
+    enum class EntryState : uint8_t
+    {
+        Queued,
+        Creating,
+        Ready,
+        Failed
+    };
+
+    struct Entry
+    {
+        EntryState State = EntryState::Queued;
+        Pipeline Value{};
+        std::exception_ptr Error;
+    };
+
+    struct Job
+    {
+        PipelineStateKey Key;
+        std::shared_ptr<Entry> Target;
+    };
+
+    // ºʱm_mutex
+
+    void Enqueue(const PipelineStateKey& key, std::shared_ptr<Entry>& slot)
+    {
+        slot = std::make_shared<Entry>();
+        ++m_pendingCount;
+        m_queue.push_back({ key, slot });
+        m_queueCondition.notify_one();
+    }
+
+    /**
+     * @brief ִдڼͷentryѾCreating
+     */
+    void Create(PipelineStateKey key, Entry& entry, std::unique_lock<std::mutex>& lock)
+    {
+        lock.unlock();
+        const int64_t start = SteadyClock::Now();
+        Pipeline value{};
+        std::exception_ptr error;
+        try
+        {
+            value = m_creator(key);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        const int64_t elapsed = SteadyClock::Now() - start;
+        lock.lock();
+
+        if (error)
+        {
+            entry.State = EntryState::Failed;
+            entry.Error = error;
+            ++m_stats.Failed;
+        }
+        else
+        {
+            entry.State = EntryState::Ready;
+            entry.Value = std::move(value);
+            ++m_stats.Created;
+        }
+        m_stats.TotalCreateNs += elapsed;
+        m_stats.MaxCreateNs = std::max(m_stats.MaxCreateNs, elapsed);
+        --m_pendingCount;
+        m_doneCondition.notify_all();
+    }
+
+    /**
+     * @brief Ӷȡһû˶ִУп˷false
+     */
+    bool RunOneQueued(std::unique_lock<std::mutex>& lock)
+    {
+        while (!m_queue.empty())
+        {
+            Job job = std::move(m_queue.front());
+            m_queue.pop_front();
+            // GetOrCreateߵֱ
+            if (job.Target->State != EntryState::Queued)
+            {
+                continue;
+            }
+            job.Target->State = EntryState::Creating;
+            Create(job.Key, *job.Target, lock);
+            return true;
+        }
+        return false;
+    }
+
+    void WorkerLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_queueCondition.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_stopping)
+            {
+                return;
+            }
+            RunOneQueued(lock);
+        }
+    }
+
+    Creator m_creator;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_queueCondition;   // Ҫ˳
+    std::condition_variable m_doneCondition;    // Ŀ
+    std::unordered_map<PipelineStateKey, std::shared_ptr<Entry>> m_entries;
+    std::deque<Job> m_queue;
+    size_t m_pendingCount = 0;                  // Queued + Creating
+    PipelineCacheStats m_stats;
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;         // 󣬹ʱԱѾ
+};
+
+
+// ============================================================================
+//                        ̻ļ
+// ============================================================================
+
+/**
+ * @brief ߻Ĵ
+ * @details ǲ͸ֽڣDX12ID3D12PipelineLibrary::SerializeĽһļͷ
+ *          ħ汾豸Կ汾ĹϣȡУ͡
+ *          ԿļضʱReadfalse÷ӿջ¿ʼ
+ */
+namespace PipelineCacheFile
+{
+    constexpr uint32_t kMagic = 0x43504A4Bu;   // "KJPC"
+    constexpr uint32_t kVersion = 1;
+
+    /**
+     * @brief дʱļٸ;°ļ
+     */
+    bool Write(const std::filesystem::path& path, uint64_t deviceKey, const void* data, size_t size);
+
+    /**
+     * @brief ȡУ飬ļڡ豸𻵶false
+     */
+    bool Read(const std::filesystem::path& path, uint64_t deviceKey, std::vector<uint8_t>& outData);
+}
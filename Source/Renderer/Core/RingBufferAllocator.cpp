@@ -0,0 +1,108 @@
+// RingBufferAllocator.cpp
+#include "Renderer/Core/RingBufferAllocator.h"
+#include <stdexcept>
+
+namespace
+{
+    uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+RingBufferAllocator::RingBufferAllocator(uint64_t capacity)
+    : m_capacity(capacity)
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("RingBufferAllocator: capacity must be greater than zero");
+    }
+}
+
+uint64_t RingBufferAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+    if (size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        throw std::invalid_argument("RingBufferAllocator: size must be non-zero and alignment a power of two");
+    }
+    if (m_usedSize == m_capacity || size > m_capacity)
+    {
+        return kInvalidOffset;
+    }
+
+    const uint64_t alignedHead = AlignUp(m_head, alignment);
+
+    // ͷβ棨߻ǿյģ[head, capacity)[0, tail)
+    if (m_head >= m_tail)
+    {
+        if (alignedHead + size <= m_capacity)
+        {
+            const uint64_t consumed = alignedHead + size - m_head;
+            m_head = alignedHead + size;
+            if (m_head == m_capacity)
+            {
+                m_head = 0;
+            }
+            m_usedSize += consumed;
+            m_currentFrameSize += consumed;
+            return alignedHead;
+        }
+
+        // βŲ¾ƻؿͷβʣµһθһ֡һ
+        if (size <= m_tail)
+        {
+            const uint64_t consumed = (m_capacity - m_head) + size;
+            m_head = size;
+            m_usedSize += consumed;
+            m_currentFrameSize += consumed;
+            return 0;
+        }
+        return kInvalidOffset;
+    }
+
+    // ͷβǰ棺ֻ[head, tail)
+    if (alignedHead + size <= m_tail)
+    {
+        const uint64_t consumed = alignedHead + size - m_head;
+        m_head = alignedHead + size;
+        m_usedSize += consumed;
+        m_currentFrameSize += consumed;
+        return alignedHead;
+    }
+    return kInvalidOffset;
+}
+
+void RingBufferAllocator::FinishFrame(uint64_t fenceValue)
+{
+    if (!m_pendingFrames.empty() && fenceValue < m_pendingFrames.back().FenceValue)
+    {
+        throw std::logic_error("RingBufferAllocator: fence values must be monotonically increasing");
+    }
+
+    // ֡Ҫ¼Ҳܴ˳
+    if (m_currentFrameSize == 0)
+    {
+        return;
+    }
+
+    m_pendingFrames.push_back({ fenceValue, m_head, m_currentFrameSize });
+    m_currentFrameSize = 0;
+}
+
+void RingBufferAllocator::ReleaseCompleted(uint64_t completedFenceValue)
+{
+    while (!m_pendingFrames.empty() && m_pendingFrames.front().FenceValue <= completedFenceValue)
+    {
+        const PendingFrame& frame = m_pendingFrames.front();
+        m_tail = frame.EndOffset;
+        m_usedSize -= frame.Size;
+        m_pendingFrames.pop_front();
+    }
+
+    // ȫպصͷһ֡õռ
+    if (m_usedSize == 0)
+    {
+        m_head = 0;
+        m_tail = 0;
+    }
+}
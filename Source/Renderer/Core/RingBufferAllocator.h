@@ -0,0 +1,78 @@
+// RingBufferAllocator.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+/**
+ * @brief ΧֵյĻԷ
+ * @details ֻƫƣڴ棬DX12ϴDX12UploadRingһ־ӳϴп顣
+ *          ÿ֡ķͷָУŲʱƻؿͷFinishFrameһ֡õĿռǵΧֵϣ
+ *          ReleaseCompletedGPUɺ֡ռһԻȥƻʱβһҲһ֡
+ * @note ̰߳ȫȾ߳ʹ
+ */
+class RingBufferAllocator
+{
+public:
+    static constexpr uint64_t kInvalidOffset = UINT64_MAX;
+
+    /**
+     * @brief 
+     * @param capacity ֽ0
+     */
+    explicit RingBufferAllocator(uint64_t capacity);
+
+    /**
+     * @brief 
+     * @param size ֽ0
+     * @param alignment ƫƶ룬2
+     * @return ƫƣռ䲻kInvalidOffset
+     */
+    uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+    /**
+     * @brief ǰ֮֡ǰķfenceValueɺ
+     * @note fenceValue뵥
+     */
+    void FinishFrame(uint64_t fenceValue);
+
+    /**
+     * @brief ΧֵcompletedFenceValue֡
+     */
+    void ReleaseCompleted(uint64_t completedFenceValue);
+
+    /**
+     * @brief һûյ֡ΧֵûΪ0ռ䲻ʱ
+     */
+    uint64_t GetOldestPendingFence() const { return m_pendingFrames.empty() ? 0 : m_pendingFrames.front().FenceValue; }
+
+    uint64_t GetCapacity() const { return m_capacity; }
+
+    /**
+     * @brief ռֽڣƻ˷ѵĲ֣
+     */
+    uint64_t GetUsedSize() const { return m_usedSize; }
+    uint64_t GetFreeSize() const { return m_capacity - m_usedSize; }
+
+    /**
+     * @brief ǰ֡ûFinishFrameռõֽ
+     */
+    uint64_t GetCurrentFrameSize() const { return m_currentFrameSize; }
+
+    size_t GetPendingFrameCount() const { return m_pendingFrames.size(); }
+
+private:
+    struct PendingFrame
+    {
+        uint64_t FenceValue;
+        uint64_t EndOffset;   // һ֡ʱͷָ룬պΪµβָ
+        uint64_t Size;        // һ֡ռõֽ
+    };
+
+    uint64_t m_capacity;
+    uint64_t m_head = 0;      // һη
+    uint64_t m_tail = 0;      // δݵ
+    uint64_t m_usedSize = 0;
+    uint64_t m_currentFrameSize = 0;
+    std::deque<PendingFrame> m_pendingFrames;
+};
@@ -0,0 +1,368 @@
+// ShaderBytecodeCache.cpp
+#include "Renderer/Core/ShaderBytecodeCache.h"
+#include "Renderer/Resources/VertexLayout.h"
+#include "Timer/Clock.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace
+{
+    struct IndexHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t CompilerIdentity;
+        uint64_t EntryCount;
+        uint64_t Checksum;      // ĿֵУ
+    };
+
+    struct IndexRecord
+    {
+        uint64_t Key;
+        uint64_t Size;
+        uint64_t Checksum;
+        uint64_t BytecodeSize;
+    };
+
+    uint64_t Checksum(const void* data, size_t size)
+    {
+        return VertexLayoutHash::HashBytes(VertexLayoutHash::OffsetBasis, static_cast<const char*>(data), size);
+    }
+
+    // ַϳȣֶƴֽͬ
+    uint64_t HashString(uint64_t hash, const std::string& text)
+    {
+        hash = VertexLayoutHash::HashValue(hash, static_cast<uint32_t>(text.size()));
+        return VertexLayoutHash::HashBytes(hash, text.data(), text.size());
+    }
+}
+
+ShaderBytecodeCache::ShaderBytecodeCache(std::filesystem::path directory, IShaderCompiler& compiler)
+    : m_directory(std::move(directory))
+    , m_compiler(compiler)
+{
+    std::error_code ignored;
+    std::filesystem::create_directories(m_directory, ignored);
+}
+
+bool ShaderBytecodeCache::LoadIndex()
+{
+    std::ifstream file(m_directory / kIndexFileName, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    IndexHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file.good() || header.Magic != kIndexMagic || header.Version != kIndexVersion ||
+        header.CompilerIdentity != m_compiler.GetIdentity())
+    {
+        return false;
+    }
+
+    // ȰļС˶ĿļĴᵼ¾޴ķ
+    std::error_code error;
+    const uintmax_t fileSize = std::filesystem::file_size(m_directory / kIndexFileName, error);
+    if (error || fileSize != sizeof(IndexHeader) + header.EntryCount * sizeof(IndexRecord))
+    {
+        return false;
+    }
+
+    std::vector<IndexRecord> records(static_cast<size_t>(header.EntryCount));
+    file.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(IndexRecord)));
+    if (!file.good() || Checksum(records.data(), records.size() * sizeof(IndexRecord)) != header.Checksum)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_entries.reserve(records.size());
+    for (const IndexRecord& record : records)
+    {
+        if (record.BytecodeSize > record.Size)
+        {
+            continue;
+        }
+        m_entries[record.Key] = { record.Size, record.Checksum, record.BytecodeSize, false };
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool ShaderBytecodeCache::SaveIndex()
+{
+    std::vector<IndexRecord> records;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_dirty)
+        {
+            return true;
+        }
+        records.reserve(m_entries.size());
+        for (const auto& [key, entry] : m_entries)
+        {
+            records.push_back({ key, entry.Size, entry.Checksum, entry.BytecodeSize });
+        }
+        m_dirty = false;
+    }
+
+    const size_t recordBytes = records.size() * sizeof(IndexRecord);
+    const IndexHeader header = { kIndexMagic, kIndexVersion, m_compiler.GetIdentity(),
+        static_cast<uint64_t>(records.size()), Checksum(records.data(), recordBytes) };
+
+    std::vector<uint8_t> data(sizeof(header) + recordBytes);
+    std::memcpy(data.data(), &header, sizeof(header));
+    if (recordBytes > 0)
+    {
+        std::memcpy(data.data() + sizeof(header), records.data(), recordBytes);
+    }
+
+    if (!WriteFileAtomic(m_directory / kIndexFileName, data.data(), data.size()))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dirty = true;
+        return false;
+    }
+    return true;
+}
+
+ShaderCacheResult ShaderBytecodeCache::GetOrCompile(const ShaderCompileRequest& request)
+{
+    ShaderCacheResult result;
+
+    const int64_t preprocessStart = SteadyClock::Now();
+    ShaderPreprocessResult preprocessed = m_compiler.Preprocess(request);
+    const int64_t preprocessNs = SteadyClock::Now() - preprocessStart;
+
+    result.Includes = std::move(preprocessed.Includes);
+    if (!preprocessed.Success)
+    {
+        result.Errors = std::move(preprocessed.Errors);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.PreprocessNs += preprocessNs;
+        ++m_stats.Failures;
+        return result;
+    }
+
+    result.Key = ComputeKey(request, preprocessed.Source, m_compiler.GetIdentity());
+
+    IndexEntry entry;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.PreprocessNs += preprocessNs;
+        auto it = m_entries.find(result.Key);
+        if (it != m_entries.end())
+        {
+            entry = it->second;
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        if (ReadBlob(result.Key, entry, result))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(result.Key);
+            if (it != m_entries.end())
+            {
+                it->second.Used = true;
+            }
+            ++m_stats.Hits;
+            result.Success = true;
+            result.FromCache = true;
+            return result;
+        }
+
+        // ļɾ߻ˣȥĿ±
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.erase(result.Key);
+        m_dirty = true;
+        ++m_stats.CorruptEntries;
+    }
+
+    const int64_t compileStart = SteadyClock::Now();
+    ShaderCompileResult compiled = m_compiler.Compile(request, preprocessed.Source);
+    const int64_t compileNs = SteadyClock::Now() - compileStart;
+
+    result.Errors = std::move(compiled.Errors);
+    if (!compiled.Success || compiled.Bytecode.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.CompileNs += compileNs;
+        ++m_stats.Failures;
+        return result;
+    }
+
+    result.Bytecode = std::move(compiled.Bytecode);
+    result.Success = true;
+
+    // ֻڱһΣֽͬһļֱ֮ӷл
+    const int64_t reflectStart = SteadyClock::Now();
+    result.HasReflection = m_compiler.Reflect(result.Bytecode.data(), result.Bytecode.size(), result.Reflection);
+    const int64_t reflectNs = SteadyClock::Now() - reflectStart;
+
+    std::vector<uint8_t> fileData = result.Bytecode;
+    if (result.HasReflection)
+    {
+        const std::vector<uint8_t> reflection = result.Reflection.Serialize();
+        fileData.insert(fileData.end(), reflection.begin(), reflection.end());
+    }
+    else
+    {
+        result.Reflection = ShaderReflection();
+    }
+
+    // дʧܲӰεĽֻ´λñ
+    const bool stored = WriteFileAtomic(GetBlobPath(result.Key), fileData.data(), fileData.size());
+    const uint64_t checksum = Checksum(fileData.data(), fileData.size());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.CompileNs += compileNs;
+    m_stats.ReflectNs += reflectNs;
+    ++m_stats.Misses;
+    if (stored)
+    {
+        m_entries[result.Key] = { fileData.size(), checksum, result.Bytecode.size(), true };
+        m_dirty = true;
+    }
+    return result;
+}
+
+uint64_t ShaderBytecodeCache::ComputeKey(const ShaderCompileRequest& request, const std::string& preprocessedSource, uint64_t compilerIdentity)
+{
+    uint64_t hash = VertexLayoutHash::OffsetBasis;
+    hash = VertexLayoutHash::HashValue64(hash, compilerIdentity);
+    hash = HashString(hash, request.EntryPoint);
+    hash = HashString(hash, request.Target);
+    hash = VertexLayoutHash::HashValue(hash, static_cast<uint32_t>(request.Defines.size()));
+    for (const ShaderDefine& define : request.Defines)
+    {
+        hash = HashString(hash, define.Name);
+        hash = HashString(hash, define.Value);
+    }
+    hash = VertexLayoutHash::HashValue(hash, request.Flags);
+    return HashString(hash, preprocessedSource);
+}
+
+size_t ShaderBytecodeCache::PruneUnused()
+{
+    std::vector<uint64_t> removed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            if (it->second.Used)
+            {
+                ++it;
+                continue;
+            }
+            removed.push_back(it->first);
+            it = m_entries.erase(it);
+        }
+        if (!removed.empty())
+        {
+            m_dirty = true;
+        }
+    }
+
+    std::error_code ignored;
+    for (uint64_t key : removed)
+    {
+        std::filesystem::remove(GetBlobPath(key), ignored);
+    }
+    return removed.size();
+}
+
+size_t ShaderBytecodeCache::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+ShaderCacheStats ShaderBytecodeCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+std::filesystem::path ShaderBytecodeCache::GetBlobPath(uint64_t key) const
+{
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return m_directory / name;
+}
+
+bool ShaderBytecodeCache::ReadBlob(uint64_t key, const IndexEntry& entry, ShaderCacheResult& outResult) const
+{
+    std::ifstream file(GetBlobPath(key), std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::error_code error;
+    const uintmax_t fileSize = std::filesystem::file_size(GetBlobPath(key), error);
+    if (error || fileSize != entry.Size)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(entry.Size));
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file.good() || Checksum(data.data(), data.size()) != entry.Checksum)
+    {
+        return false;
+    }
+
+    const size_t bytecodeSize = static_cast<size_t>(entry.BytecodeSize);
+    outResult.HasReflection = data.size() > bytecodeSize;
+    if (outResult.HasReflection &&
+        !ShaderReflection::Deserialize(data.data() + bytecodeSize, data.size() - bytecodeSize, outResult.Reflection))
+    {
+        outResult.HasReflection = false;
+        outResult.Reflection = ShaderReflection();
+        return false;
+    }
+
+    data.resize(bytecodeSize);
+    outResult.Bytecode = std::move(data);
+    return true;
+}
+
+bool ShaderBytecodeCache::WriteFileAtomic(const std::filesystem::path& path, const void* data, size_t size)
+{
+    // ʱļ߳ͬʱдͬһҲụาǰļ
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp" + std::to_string(m_tempCounter.fetch_add(1));
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!file.good())
+        {
+            file.close();
+            std::error_code ignored;
+            std::filesystem::remove(tempPath, ignored);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,123 @@
+// ShaderBytecodeCache.h
+#pragma once
+#include "Renderer/Core/ShaderCompiler.h"
+#include "Renderer/Core/ShaderReflection.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief һβҵĽ
+ */
+struct ShaderCacheResult
+{
+    bool Success = false;
+    bool FromCache = false;     // trueʾûеñ
+    uint64_t Key = 0;
+    std::vector<uint8_t> Bytecode;
+    std::vector<std::filesystem::path> Includes;    // Ԥʱõͷļظ
+    std::string Errors;
+    bool HasReflection = false;     // ȡϢʱΪfalse
+    ShaderReflection Reflection;
+};
+
+struct ShaderCacheStats
+{
+    uint64_t Hits = 0;
+    uint64_t Misses = 0;
+    uint64_t Failures = 0;          // Ԥʧ
+    uint64_t CorruptEntries = 0;    // еļ˻У鲻δر
+    int64_t PreprocessNs = 0;
+    int64_t CompileNs = 0;
+    int64_t ReflectNs = 0;
+};
+
+/**
+ * @brief ѰַĴֽ뻺
+ * @details  = ϣ(ԤԴ +  + Ŀ +  + ־ + )
+ *          ԴκһincludeļˣԤͱ䣬ű䣬ҪȽʱ
+ *          ÿֽлķϢһ <Ŀ¼>/<ʮ>.bin
+ *          һյļÿ32ֽڣܳȡУֽ͡볤ȣ
+ *          ʱֻʱһСļУ飬ʡͷ䣨Ԥȱ˵öࣩ
+ * @note ̰߳ȫԤͶдļ
+ */
+class ShaderBytecodeCache
+{
+public:
+    static constexpr uint32_t kIndexMagic = 0x43534A4Bu;  // "KJSC"
+    static constexpr uint32_t kIndexVersion = 2;
+    static constexpr const char* kIndexFileName = "index.bin";
+
+    /**
+     * @param directory Ŀ¼ڻᴴ
+     * @param compiler ҪȻ泤
+     */
+    ShaderBytecodeCache(std::filesystem::path directory, IShaderCompiler& compiler);
+
+    /**
+     * @brief ļڡ𻵻ݲfalseӿտʼ
+     */
+    bool LoadIndex();
+
+    /**
+     * @brief иĶддʱļٸ
+     */
+    bool SaveIndex();
+
+    /**
+     * @brief 黺棬δоͱ벢д
+     * @note ʧܲỺ棬´λٱࣨԴڸģ
+     */
+    ShaderCacheResult GetOrCompile(const ShaderCompileRequest& request);
+
+    /**
+     * @brief 㻺ComputeKeyֻԵ
+     */
+    static uint64_t ComputeKey(const ShaderCompileRequest& request, const std::string& preprocessedSource, uint64_t compilerIdentity);
+
+    /**
+     * @brief ɾLoadIndex֮һζûùĿļֹĿ¼ԽԽ
+     * @return ɾĿ
+     */
+    size_t PruneUnused();
+
+    size_t GetEntryCount() const;
+    ShaderCacheStats GetStats() const;
+    const std::filesystem::path& GetDirectory() const { return m_directory; }
+
+private:
+    struct IndexEntry
+    {
+        uint64_t Size = 0;
+        uint64_t Checksum = 0;
+        uint64_t BytecodeSize = 0;  // ʣµǷϢ
+        bool Used = false;
+    };
+
+    std::filesystem::path GetBlobPath(uint64_t key) const;
+
+    /**
+     * @brief ȡУһֽļoutResultֽͷϢ
+     */
+    bool ReadBlob(uint64_t key, const IndexEntry& entry, ShaderCacheResult& outResult) const;
+
+    /**
+     * @brief дʱļٸ߳ͬʱдͬһʱͬ˭һ
+     */
+    bool WriteFileAtomic(const std::filesystem::path& path, const void* data, size_t size);
+
+    std::filesystem::path m_directory;
+    IShaderCompiler& m_compiler;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, IndexEntry> m_entries;
+    ShaderCacheStats m_stats;
+    bool m_dirty = false;
+
+    std::atomic<uint32_t> m_tempCounter = 0;
+};
@@ -0,0 +1,83 @@
+// ShaderCompiler.h
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+struct ShaderReflection;
+
+/**
+ * @brief ꣨ӦD3D_SHADER_MACRO
+ */
+struct ShaderDefine
+{
+    std::string Name;
+    std::string Value;
+
+    bool operator==(const ShaderDefine&) const = default;
+};
+
+/**
+ * @brief һα
+ * @note FlagsǱԼı־λDX12D3DCOMPILE_*ֻ
+ */
+struct ShaderCompileRequest
+{
+    std::filesystem::path SourcePath;
+    std::string EntryPoint;
+    std::string Target;
+    std::vector<ShaderDefine> Defines;
+    uint32_t Flags = 0;
+};
+
+/**
+ * @brief Ԥչincludeͺ֮Դ룬õͷļ
+ */
+struct ShaderPreprocessResult
+{
+    bool Success = false;
+    std::string Source;
+    std::vector<std::filesystem::path> Includes;
+    std::string Errors;
+};
+
+/**
+ * @brief 
+ */
+struct ShaderCompileResult
+{
+    bool Success = false;
+    std::vector<uint8_t> Bytecode;
+    std::string Errors;     // ɹʱҲо
+};
+
+/**
+ * @brief ɫӿ
+ * @details ShaderBytecodeCacheԤõδвŵCompile
+ *          DX12D3DShaderCompiler׼òd3dcompilerFakeShaderCompilerBenchmark/FakeShaderCompiler.h
+ * @note ʵҪ̰߳ȫڶ߳ͬʱ
+ */
+class IShaderCompiler
+{
+public:
+    virtual ~IShaderCompiler() = default;
+
+    /**
+     * @brief ݣ+汾˱ɻȫ
+     */
+    virtual uint64_t GetIdentity() const = 0;
+
+    virtual ShaderPreprocessResult Preprocess(const ShaderCompileRequest& request) = 0;
+
+    /**
+     * @brief ԤԴ
+     * @param preprocessedSource PreprocessҪٴinclude
+     */
+    virtual ShaderCompileResult Compile(const ShaderCompileRequest& request, const std::string& preprocessedSource) = 0;
+
+    /**
+     * @brief CompileֽȡϢʧܷfalse
+     */
+    virtual bool Reflect(const void* bytecode, size_t size, ShaderReflection& outReflection) = 0;
+};
@@ -1,6 +1,54 @@
 #include "ShaderManager.h"
+#include "Renderer/Resources/VertexLayout.h"
+#include "Renderer/Core/D3DShaderCompiler.h"
+#include "Core/FileWatcher.h"
+#include "Timer/Clock.h"
+#include "Timer/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <iostream>
 #include <fstream>
+#include <mutex>
+#include <thread>
+
+
+namespace
+{
+	//ݵıʶ⼸һɫֽһһ
+	std::wstring MakeCompileIdentity(const ShaderInfo& info)
+	{
+		std::wstring identity = info.SourcePath + L'|' + info.CompiledPath + L'|' +
+			std::wstring(info.EntryPoint.begin(), info.EntryPoint.end()) + L'|' +
+			std::wstring(info.Target.begin(), info.Target.end()) + L'|' +
+			(info.UseRuntimeCompile ? L'1' : L'0');
+		for (const ShaderDefine& define : info.Defines)
+		{
+			identity += L'|';
+			identity += std::wstring(define.Name.begin(), define.Name.end());
+			identity += L'=';
+			identity += std::wstring(define.Value.begin(), define.Value.end());
+		}
+		return identity;
+	}
+
+	//ļԡ淶·FileWatcher·Ե
+	std::wstring NormalizePath(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		std::filesystem::path normalized = std::filesystem::weakly_canonical(path, error);
+		if (error)
+		{
+			normalized = std::filesystem::absolute(path, error).lexically_normal();
+		}
+		std::wstring key = normalized.wstring();
+#if defined(_WIN32)
+		//Windows·ִСд
+		std::transform(key.begin(), key.end(), key.begin(), [](wchar_t c) { return static_cast<wchar_t>(towlower(c)); });
+#endif
+		return key;
+	}
+}
 
 ShaderManager::ShaderManager()
 	:m_shaderDirectory(L"Shaders/")
@@ -11,6 +59,8 @@ ShaderManager::ShaderManager()
 
 ShaderManager::~ShaderManager()
 {
+	DisableHotReload();
+	SaveBytecodeCache();
 	Clear();
 }
 
@@ -33,7 +83,8 @@ void ShaderManager::RegisterShader
 	const std::wstring& sourcePath, 
 	const std::string& entryPoint, 
 	const std::string& target, 
-	bool allowRuntimeCompile)
+	bool allowRuntimeCompile,
+	const std::vector<ShaderDefine>& defines)
 {
 	ShaderInfo info;
 	info.Name = shaderName;
@@ -67,6 +118,7 @@ void ShaderManager::RegisterShader
 	info.EntryPoint = entryPoint;
 	info.Target = target;
 	info.UseRuntimeCompile = allowRuntimeCompile && m_runtimeCompileEnabled;
+	info.Defines = defines;
 
 	m_shaderInfos[shaderName] = info;
 }
@@ -94,67 +146,158 @@ void ShaderManager::RegisterCompiledShader(const std::string& shaderName, const
 
 ID3DBlob* ShaderManager::LoadShader(const std::string& shaderName)
 {
-
-	auto cacheIt = m_shaderCache.find(shaderName);
-	if (cacheIt != m_shaderCache.end())
 	{
-		return cacheIt->second.Get();
+		std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+		auto cacheIt = m_shaderCache.find(shaderName);
+		if (cacheIt != m_shaderCache.end())
+		{
+			return cacheIt->second.Get();
+		}
 	}
-	
 
 
-	auto infoIt = m_shaderInfos.find(shaderName);
-	if (infoIt == m_shaderInfos.end())
+	const ShaderInfo* info = FindShaderInfo(shaderName);
+	if (info == nullptr)
 	{
 		std::cerr << "Shader not registered: " << shaderName << std::endl;
 		return nullptr;
 	}
 
-	const ShaderInfo & info= infoIt->second;
-	ID3DBlob* byteCode = nullptr;
+	//غͱ벻߳̿ͬʱͬɫ
+	ShaderLoadExtras extras;
+	Microsoft::WRL::ComPtr<ID3DBlob> byteCode;
+	byteCode.Attach(LoadShaderFromInfo(*info, &extras));
+	if (byteCode == nullptr)
+	{
+		//ûһɹ
+		std::cerr << "Failed to load shader:" << shaderName << std::endl;
+		return nullptr;
+	}
+
+	return StoreShader(shaderName, byteCode, extras);
+}
 
+ID3DBlob* ShaderManager::LoadShaderFromInfo(const ShaderInfo& info, ShaderLoadExtras* outExtras)
+{
+	//бֽ뻺أԴΪ׼Դincludeһر࣬õڵcso
+	if (m_compiler && info.UseRuntimeCompile && !info.SourcePath.empty())
+	{
+		return CompileFromSource(info, outExtras);
+	}
+
+	ID3DBlob* byteCode = nullptr;
 	if (!info.CompiledPath.empty())
 	{
 		byteCode = LoadCompiledShader(info.CompiledPath);
-		if (byteCode != nullptr)
+		//csoɻԴ˶㣬Ҳɲ
+		if (byteCode != nullptr && outExtras != nullptr)
 		{
-			Microsoft::WRL::ComPtr<ID3DBlob> cached;
-			cached.Attach(byteCode);
-			m_shaderCache[shaderName] = cached;
-			return cached.Get();
+			outExtras->Dependencies.push_back(info.CompiledPath);
+			if (!info.SourcePath.empty())
+			{
+				outExtras->Dependencies.push_back(info.SourcePath);
+			}
 		}
 	}
 
-
 	//csoڣǿʱ룬Ǿֱ
 	if (byteCode == nullptr && info.UseRuntimeCompile && !info.SourcePath.empty())
 	{
-		byteCode = CompileShader(info.SourcePath, info.EntryPoint, info.Target, shaderName);
-		if (byteCode != nullptr)
+		byteCode = CompileShader(info.SourcePath, info.EntryPoint, info.Target, info.Name, info.Defines);
+		//D3DCompileFromFileòincludeֻܼԴļ
+		if (byteCode != nullptr && outExtras != nullptr)
+		{
+			outExtras->Dependencies.push_back(info.SourcePath);
+		}
+	}
+	return byteCode;
+}
+
+ID3DBlob* ShaderManager::StoreShader(const std::string& shaderName, const Microsoft::WRL::ComPtr<ID3DBlob>& blob,
+	const ShaderLoadExtras& extras)
+{
+	//ϣֽͬһŽȥѯʱǶԵ
+	const uint64_t hash = HashBytecode(blob->GetBufferPointer(), blob->GetBufferSize());
+	std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+	auto result = m_shaderCache.try_emplace(shaderName, blob);
+	if (result.second)
+	{
+		m_shaderHashes[shaderName] = hash;
+		SetDependencies(shaderName, extras.Dependencies);
+		if (extras.Reflection)
 		{
-			Microsoft::WRL::ComPtr<ID3DBlob> cached;
-			cached.Attach(byteCode);
-			m_shaderCache[shaderName] = cached;
-			return cached.Get();
+			m_shaderReflections[shaderName] = extras.Reflection;
 		}
 	}
+	return result.first->second.Get();
+}
 
+void ShaderManager::ReplaceShader(const std::string& shaderName, const Microsoft::WRL::ComPtr<ID3DBlob>& blob,
+	const ShaderLoadExtras& extras)
+{
+	const uint64_t hash = HashBytecode(blob->GetBufferPointer(), blob->GetBufferSize());
+	std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+	Microsoft::WRL::ComPtr<ID3DBlob>& slot = m_shaderCache[shaderName];
+	if (slot != nullptr)
+	{
+		m_retiredShaders.push_back({ slot, 0 });
+	}
+	slot = blob;
+	m_shaderHashes[shaderName] = hash;
+	SetDependencies(shaderName, extras.Dependencies);
+	//ûµķϢɾɵģ´βѯʱֽȡ
+	if (extras.Reflection)
+	{
+		m_shaderReflections[shaderName] = extras.Reflection;
+	}
+	else
+	{
+		m_shaderReflections.erase(shaderName);
+	}
+}
 
-	//ûһɹ
-	std::cerr << "Failed to load shader:" << shaderName << std::endl;
-	return nullptr;
+void ShaderManager::SetDependencies(const std::string& shaderName, const std::vector<std::filesystem::path>& dependencies)
+{
+	std::vector<std::wstring>& current = m_dependencies[shaderName];
+	for (const std::wstring& path : current)
+	{
+		auto it = m_dependents.find(path);
+		if (it != m_dependents.end())
+		{
+			it->second.erase(shaderName);
+			if (it->second.empty())
+			{
+				m_dependents.erase(it);
+			}
+		}
+	}
+
+	current.clear();
+	for (const std::filesystem::path& dependency : dependencies)
+	{
+		std::wstring path = NormalizePath(dependency);
+		m_dependents[path].insert(shaderName);
+		current.push_back(std::move(path));
+	}
 }
 
-ID3DBlob* ShaderManager::CompileShader(const std::wstring& sourcePath, const std::string& entryPoint, const std::string& target, const std::string& shaderName)
+ID3DBlob* ShaderManager::CompileShader(const std::wstring& sourcePath, const std::string& entryPoint, const std::string& target, const std::string& shaderName, const std::vector<ShaderDefine>& defines)
 {
 	UINT compileFlags = GetCompileFlags();
+
+	std::vector<D3D_SHADER_MACRO> macros;
+	for (const ShaderDefine& define : defines)
+	{
+		macros.push_back({ define.Name.c_str(), define.Value.c_str() });
+	}
+	macros.push_back({ nullptr, nullptr });
 	Microsoft::WRL::ComPtr<ID3DBlob> byteCode = nullptr;
 	Microsoft::WRL::ComPtr<ID3DBlob> errors = nullptr;
 
 	// ʼɫ
 	HRESULT hr = D3DCompileFromFile(
 		sourcePath.c_str(),           // Դļ·
-		nullptr,                      // 궨
+		macros.data(),                // 궨
 		D3D_COMPILE_STANDARD_FILE_INCLUDE,  // ļ
 		entryPoint.c_str(),           // ں
 		target.c_str(),               // ɫĿ꣨vs_5_1, ps_5_1 ȣ
@@ -231,6 +374,7 @@ ID3DBlob* ShaderManager::LoadCompiledShader(const std::wstring& csoPath)
 
 ID3DBlob* ShaderManager::GetShader(const std::string& shaderName)
 {
+	std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
 	auto it = m_shaderCache.find(shaderName);
 	if (it!= m_shaderCache.end())
 	{
@@ -239,29 +383,844 @@ ID3DBlob* ShaderManager::GetShader(const std::string& shaderName)
 	return nullptr;
 }
 
+bool ShaderManager::GetShaderWithHash(const std::string& shaderName, Microsoft::WRL::ComPtr<ID3DBlob>& outBlob, uint64_t& outHash)
+{
+	if (LoadShader(shaderName) == nullptr)
+	{
+		return false;
+	}
+
+	//LoadShader֮ؿѾһ棬ֽ͹ϣڵΪ׼
+	std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+	auto blobIt = m_shaderCache.find(shaderName);
+	auto hashIt = m_shaderHashes.find(shaderName);
+	if (blobIt == m_shaderCache.end() || hashIt == m_shaderHashes.end())
+	{
+		return false;
+	}
+	outBlob = blobIt->second;
+	outHash = hashIt->second;
+	return true;
+}
+
+uint64_t ShaderManager::GetShaderHash(const std::string& shaderName)
+{
+	Microsoft::WRL::ComPtr<ID3DBlob> blob;
+	uint64_t hash = 0;
+	return GetShaderWithHash(shaderName, blob, hash) ? hash : 0;
+}
+
+std::shared_ptr<const ShaderReflection> ShaderManager::GetShaderReflection(const std::string& shaderName)
+{
+	{
+		std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+		auto it = m_shaderReflections.find(shaderName);
+		if (it != m_shaderReflections.end())
+		{
+			return it->second;
+		}
+	}
+
+	Microsoft::WRL::ComPtr<ID3DBlob> byteCode = LoadShader(shaderName);
+	if (byteCode == nullptr)
+	{
+		return nullptr;
+	}
+
+	//մֽ뻺صĻϢѾ
+	{
+		std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+		auto it = m_shaderReflections.find(shaderName);
+		if (it != m_shaderReflections.end())
+		{
+			return it->second;
+		}
+	}
+
+	//csoصĻûֽ뻺ģȡһΣ䲻ñ״̬ûʱD3D
+	auto reflection = std::make_shared<ShaderReflection>();
+	bool reflected = false;
+	if (m_compiler)
+	{
+		reflected = m_compiler->Reflect(byteCode->GetBufferPointer(), byteCode->GetBufferSize(), *reflection);
+	}
+	else
+	{
+		D3DShaderCompiler compiler;
+		reflected = compiler.Reflect(byteCode->GetBufferPointer(), byteCode->GetBufferSize(), *reflection);
+	}
+	if (!reflected)
+	{
+		std::cerr << "Failed to reflect shader: " << shaderName << std::endl;
+		return nullptr;
+	}
+
+	std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+	//ȡڼ䱻ػ˾Ͳ棬´ΰֽȡ
+	auto cacheIt = m_shaderCache.find(shaderName);
+	if (cacheIt == m_shaderCache.end() || cacheIt->second.Get() != byteCode.Get())
+	{
+		return reflection;
+	}
+	return m_shaderReflections.try_emplace(shaderName, std::move(reflection)).first->second;
+}
+
+ShaderInputValidation ShaderManager::ValidateInputLayout(const std::string& shaderName, const VertexLayout& layout)
+{
+	std::shared_ptr<const ShaderReflection> reflection = GetShaderReflection(shaderName);
+	if (!reflection)
+	{
+		//òϢDXILֽ룩û飬
+		ShaderInputValidation result;
+		result.Warnings.push_back("no reflection data for " + shaderName + ", input layout not checked");
+		return result;
+	}
+	return ::ValidateInputLayout(*reflection, layout);
+}
+
+uint64_t ShaderManager::HashBytecode(const void* data, size_t size)
+{
+	return VertexLayoutHash::HashBytes(VertexLayoutHash::OffsetBasis, static_cast<const char*>(data), size);
+}
+
 bool ShaderManager::IsShaderLoaded(const std::string& shaderName) const
 {
+	std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
 	return m_shaderCache.find(shaderName)!=m_shaderCache.end();
 }
 
-bool ShaderManager::PreloadAllShaders()
+bool ShaderManager::PreloadAllShaders(uint32_t threadCount)
 {
-	bool allSucess = true;
+	KJ_PROFILE_SCOPE("Preload Shaders");
+
+	std::vector<std::string> names;
+	names.reserve(m_shaderInfos.size());
 	for (const auto& pair : m_shaderInfos)
 	{
-		ID3DBlob* shader = LoadShader(pair.first);
-		if (shader == nullptr)
+		names.push_back(pair.first);
+	}
+
+	LoadBatchResult result = LoadShadersParallel(names, threadCount);
+	m_preloadTimings = std::move(result.Timings);
+	if (m_preloadTimings.empty())
+	{
+		return true;
+	}
+
+	//ǰ棬
+	std::sort(m_preloadTimings.begin(), m_preloadTimings.end(),
+		[](const ShaderLoadTiming& a, const ShaderLoadTiming& b) { return a.Milliseconds > b.Milliseconds; });
+
+	char line[256];
+	snprintf(line, sizeof(line), "Shader preload: %zu shaders (%zu unique) on %u threads, %.2f ms wall, %.2f ms total\n",
+		m_preloadTimings.size(), result.UniqueCount, result.WorkerCount, result.WallMilliseconds, result.TotalMilliseconds);
+	OutputDebugStringA(line);
+	for (const ShaderLoadTiming& timing : m_preloadTimings)
+	{
+		if (timing.SharedWith.empty())
+		{
+			snprintf(line, sizeof(line), "  %-32s %8.2f ms%s\n", timing.Name.c_str(), timing.Milliseconds, timing.Success ? "" : " FAILED");
+		}
+		else
+		{
+			snprintf(line, sizeof(line), "  %-32s     same as %s\n", timing.Name.c_str(), timing.SharedWith.c_str());
+		}
+		OutputDebugStringA(line);
+	}
+
+	return result.AllSuccess;
+}
+
+ShaderManager::LoadBatchResult ShaderManager::LoadShadersParallel(const std::vector<std::string>& shaderNames, uint32_t threadCount)
+{
+	LoadBatchResult result;
+
+	//ݷ飬ͬģԴ룬ڣĿֻ꣬꣩һΣֹý
+	struct LoadJob
+	{
+		const ShaderInfo* Info = nullptr;
+		std::vector<std::string> Names;
+		Microsoft::WRL::ComPtr<ID3DBlob> ByteCode;
+		ShaderLoadExtras Extras;
+		double Milliseconds = 0.0;
+	};
+
+	std::vector<LoadJob> jobs;
+	{
+		std::unordered_map<std::wstring, size_t> jobIndices;
+		std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+		for (const std::string& name : shaderNames)
+		{
+			if (m_shaderCache.find(name) != m_shaderCache.end())
+			{
+				continue;
+			}
+			const ShaderInfo* info = FindShaderInfoLocked(name);
+			if (info == nullptr)
+			{
+				std::cerr << "Shader not registered: " << name << std::endl;
+				result.AllSuccess = false;
+				continue;
+			}
+
+			auto jobIt = jobIndices.try_emplace(MakeCompileIdentity(*info), jobs.size());
+			if (jobIt.second)
+			{
+				jobs.push_back({ info });
+			}
+			jobs[jobIt.first->second].Names.push_back(name);
+		}
+	}
+
+	result.UniqueCount = jobs.size();
+	if (jobs.empty())
+	{
+		return result;
+	}
+
+	//߳ҲɻֻҪworkerCount-1
+	uint32_t workerCount = threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+	workerCount = std::min<uint32_t>(workerCount, static_cast<uint32_t>(jobs.size()));
+	result.WorkerCount = workerCount;
+
+	std::atomic<size_t> nextJob = 0;
+	auto runJobs = [this, &jobs, &nextJob]()
+	{
+		for (size_t i = nextJob.fetch_add(1); i < jobs.size(); i = nextJob.fetch_add(1))
+		{
+			KJ_PROFILE_SCOPE("Load Shader");
+			LoadJob& job = jobs[i];
+			int64_t start = SteadyClock::Now();
+			job.ByteCode.Attach(LoadShaderFromInfo(*job.Info, &job.Extras));
+			job.Milliseconds = static_cast<double>(SteadyClock::Now() - start) / 1.0e6;
+		}
+	};
+
+	int64_t wallStart = SteadyClock::Now();
+	std::vector<std::thread> workers;
+	workers.reserve(workerCount - 1);
+	for (uint32_t i = 1; i < workerCount; ++i)
+	{
+		workers.emplace_back([&runJobs]()
+		{
+			KJ_PROFILE_THREAD("Shader Preload");
+			runJobs();
+		});
+	}
+	runJobs();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+	result.WallMilliseconds = static_cast<double>(SteadyClock::Now() - wallStart) / 1.0e6;
+
+	for (const LoadJob& job : jobs)
+	{
+		result.TotalMilliseconds += job.Milliseconds;
+		for (size_t i = 0; i < job.Names.size(); ++i)
+		{
+			ShaderLoadTiming timing;
+			timing.Name = job.Names[i];
+			timing.Milliseconds = i == 0 ? job.Milliseconds : 0.0;
+			timing.SharedWith = i == 0 ? std::string() : job.Names[0];
+			timing.Success = job.ByteCode != nullptr;
+			result.Timings.push_back(timing);
+
+			if (job.ByteCode == nullptr)
+			{
+				std::cerr << "Failed to preload shader" << job.Names[i] << std::endl;
+				result.AllSuccess = false;
+				continue;
+			}
+			StoreShader(job.Names[i], job.ByteCode, job.Extras);
+		}
+	}
+	return result;
+}
+
+const ShaderInfo* ShaderManager::FindShaderInfo(const std::string& shaderName) const
+{
+	std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+	return FindShaderInfoLocked(shaderName);
+}
+
+const ShaderInfo* ShaderManager::FindShaderInfoLocked(const std::string& shaderName) const
+{
+	//עע׶֮ٱ䣻ʱӵģڵ㲻ɾָһֱЧ
+	auto infoIt = m_shaderInfos.find(shaderName);
+	if (infoIt != m_shaderInfos.end())
+	{
+		return &infoIt->second;
+	}
+	auto variantIt = m_variantInfos.find(shaderName);
+	return variantIt != m_variantInfos.end() ? &variantIt->second : nullptr;
+}
+
+
+bool ShaderManager::RegisterShaderKeywords(const std::string& shaderName, const std::vector<std::string>& keywords)
+{
+	//ǼϺ±ģֻcsoûԴ롢߹ʱɫ˱
+	auto infoIt = m_shaderInfos.find(shaderName);
+	if (infoIt == m_shaderInfos.end())
+	{
+		std::cerr << "Can't register keywords, shader not registered: " << shaderName << std::endl;
+		return false;
+	}
+	if (!CanCompileVariants(infoIt->second))
+	{
+		std::cerr << "Can't register keywords for shader " << shaderName
+			<< ": variants need the HLSL source and runtime compilation" << std::endl;
+		return false;
+	}
+
+	if (keywords.size() > kMaxShaderKeywords)
+	{
+		std::cerr << "Too many keywords for shader " << shaderName << ", only the first " << kMaxShaderKeywords << " are used" << std::endl;
+	}
+
+	ShaderKeywordSet& keywordSet = m_keywordSets[shaderName];
+	keywordSet.Keywords.assign(keywords.begin(), keywords.begin() + std::min(keywords.size(), kMaxShaderKeywords));
+	keywordSet.ValidMask = keywordSet.Keywords.size() == 64 ? ~0ull : (1ull << keywordSet.Keywords.size()) - 1;
+	return true;
+}
+
+bool ShaderManager::GetKeywordMask(const std::string& shaderName, const std::vector<std::string>& keywords, uint64_t& outMask) const
+{
+	outMask = 0;
+	auto setIt = m_keywordSets.find(shaderName);
+	if (setIt == m_keywordSets.end())
+	{
+		return keywords.empty();
+	}
+
+	const std::vector<std::string>& declared = setIt->second.Keywords;
+	for (const std::string& keyword : keywords)
+	{
+		auto it = std::find(declared.begin(), declared.end(), keyword);
+		if (it == declared.end())
+		{
+			return false;
+		}
+		outMask |= 1ull << (it - declared.begin());
+	}
+	return true;
+}
+
+bool ShaderManager::CanCompileVariants(const ShaderInfo& info)
+{
+	return info.UseRuntimeCompile && !info.SourcePath.empty();
+}
+
+std::string ShaderManager::MakeVariantName(const std::string& shaderName, uint64_t keywordMask)
+{
+	if (keywordMask == 0)
+	{
+		return shaderName;
+	}
+	char suffix[24];
+	snprintf(suffix, sizeof(suffix), "#%llx", static_cast<unsigned long long>(keywordMask));
+	return shaderName + suffix;
+}
+
+const std::string* ShaderManager::EnsureVariant(const std::string& shaderName, uint64_t keywordMask)
+{
+	auto setIt = m_keywordSets.find(shaderName);
+	if (setIt == m_keywordSets.end())
+	{
+		if (keywordMask != 0)
+		{
+			std::cerr << "Shader has no keywords: " << shaderName << std::endl;
+			return nullptr;
+		}
+		return &shaderName;
+	}
+
+	ShaderKeywordSet& keywordSet = setIt->second;
+	if ((keywordMask & ~keywordSet.ValidMask) != 0)
+	{
+		std::cerr << "Invalid keyword mask for shader " << shaderName << ": " << keywordMask << std::endl;
+		return nullptr;
+	}
+
+	auto infoIt = m_shaderInfos.find(shaderName);
+	if (infoIt == m_shaderInfos.end())
+	{
+		std::cerr << "Shader not registered: " << shaderName << std::endl;
+		return nullptr;
+	}
+	//עؼ֮RegisterCompiledShader߹ʱעģ಻
+	if (keywordMask != 0 && !CanCompileVariants(infoIt->second))
+	{
+		std::cerr << "Shader " << shaderName << " can't compile variants: it has no HLSL source or runtime compilation is off" << std::endl;
+		return nullptr;
+	}
+
+	std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+	auto [variantIt, inserted] = keywordSet.Variants.try_emplace(keywordMask);
+	if (!inserted)
+	{
+		return &variantIt->second;
+	}
+
+	variantIt->second = MakeVariantName(shaderName, keywordMask);
+	if (keywordMask != 0)
+	{
+		//򿪵Ĺؼ׷עĺ棻ûжӦcsoֻʱ
+		ShaderInfo info = infoIt->second;
+		info.Name = variantIt->second;
+		info.CompiledPath.clear();
+		for (size_t i = 0; i < keywordSet.Keywords.size(); ++i)
+		{
+			if (keywordMask & (1ull << i))
+			{
+				info.Defines.push_back({ keywordSet.Keywords[i], "1" });
+			}
+		}
+		m_variantInfos.emplace(info.Name, std::move(info));
+	}
+
+	if (keywordSet.Variants.size() == m_variantWarningThreshold + 1)
+	{
+		std::cerr << "Shader " << shaderName << " has more than " << m_variantWarningThreshold << " live variants" << std::endl;
+	}
+	return &variantIt->second;
+}
+
+ID3DBlob* ShaderManager::GetShaderVariant(const std::string& shaderName, uint64_t keywordMask)
+{
+	m_variantRequests.fetch_add(1, std::memory_order_relaxed);
+
+	//·Ѿı壬β
+	auto setIt = m_keywordSets.find(shaderName);
+	if (setIt != m_keywordSets.end())
+	{
+		std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+		auto variantIt = setIt->second.Variants.find(keywordMask);
+		if (variantIt != setIt->second.Variants.end())
+		{
+			auto cacheIt = m_shaderCache.find(variantIt->second);
+			if (cacheIt != m_shaderCache.end())
+			{
+				m_variantHits.fetch_add(1, std::memory_order_relaxed);
+				return cacheIt->second.Get();
+			}
+		}
+	}
+
+	const std::string* variantName = EnsureVariant(shaderName, keywordMask);
+	if (variantName == nullptr)
+	{
+		m_variantFailures.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	//һõڵ߳ϱ룬ʱῨס÷Եʱ
+	KJ_PROFILE_SCOPE("Compile Shader Variant");
+	int64_t start = SteadyClock::Now();
+	ID3DBlob* byteCode = LoadShader(*variantName);
+	m_variantCompileNs.fetch_add(SteadyClock::Now() - start, std::memory_order_relaxed);
+	m_variantLazyCompiles.fetch_add(1, std::memory_order_relaxed);
+	if (byteCode == nullptr)
+	{
+		m_variantFailures.fetch_add(1, std::memory_order_relaxed);
+	}
+	return byteCode;
+}
+
+bool ShaderManager::PrewarmShaderVariants(const std::vector<std::pair<std::string, uint64_t>>& variants, uint32_t threadCount)
+{
+	KJ_PROFILE_SCOPE("Prewarm Shader Variants");
+
+	bool allSuccess = true;
+	std::vector<std::string> names;
+	names.reserve(variants.size());
+	for (const auto& [shaderName, keywordMask] : variants)
+	{
+		const std::string* variantName = EnsureVariant(shaderName, keywordMask);
+		if (variantName == nullptr)
+		{
+			m_variantFailures.fetch_add(1, std::memory_order_relaxed);
+			allSuccess = false;
+			continue;
+		}
+		names.push_back(*variantName);
+	}
+
+	LoadBatchResult result = LoadShadersParallel(names, threadCount);
+	for (const ShaderLoadTiming& timing : result.Timings)
+	{
+		if (!timing.Success)
+		{
+			m_variantFailures.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	m_variantPrewarmed.fetch_add(result.Timings.size(), std::memory_order_relaxed);
+	return allSuccess && result.AllSuccess;
+}
+
+size_t ShaderManager::GetLiveVariantCount(const std::string& shaderName) const
+{
+	auto setIt = m_keywordSets.find(shaderName);
+	if (setIt == m_keywordSets.end())
+	{
+		return 0;
+	}
+	std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+	return setIt->second.Variants.size();
+}
+
+ShaderVariantStats ShaderManager::GetVariantStats() const
+{
+	ShaderVariantStats stats;
+	{
+		std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+		for (const auto& [shaderName, keywordSet] : m_keywordSets)
 		{
-			std::cerr << "Failed to preload shader" << pair.first << std::endl;
-			allSucess = false;
+			++stats.ShadersWithKeywords;
+			stats.LiveVariants += keywordSet.Variants.size();
+			for (const auto& [keywordMask, variantName] : keywordSet.Variants)
+			{
+				if (m_shaderCache.find(variantName) != m_shaderCache.end())
+				{
+					++stats.CompiledVariants;
+				}
+			}
+
+			//2^n64ؼֵĻ
+			uint64_t possible = keywordSet.Keywords.size() >= 64 ? ~0ull : (1ull << keywordSet.Keywords.size());
+			stats.PossibleVariants = possible > ~0ull - stats.PossibleVariants ? ~0ull : stats.PossibleVariants + possible;
 		}
 	}
-	return allSucess;
+	stats.Requests = m_variantRequests.load(std::memory_order_relaxed);
+	stats.Hits = m_variantHits.load(std::memory_order_relaxed);
+	stats.LazyCompiles = m_variantLazyCompiles.load(std::memory_order_relaxed);
+	stats.Prewarmed = m_variantPrewarmed.load(std::memory_order_relaxed);
+	stats.Failures = m_variantFailures.load(std::memory_order_relaxed);
+	stats.LazyCompileMilliseconds = static_cast<double>(m_variantCompileNs.load(std::memory_order_relaxed)) / 1.0e6;
+	return stats;
 }
 
+
 void ShaderManager::Clear()
 {
+	std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
 	m_shaderCache.clear();
+	m_shaderHashes.clear();
+	m_shaderReflections.clear();
+	m_retiredShaders.clear();
+	m_dependents.clear();
+	m_dependencies.clear();
+}
+
+
+bool ShaderManager::EnableBytecodeCache(const std::wstring& cacheDirectory)
+{
+	if (!m_compiler)
+	{
+		m_compiler = std::make_unique<D3DShaderCompiler>();
+	}
+	m_bytecodeCache = std::make_unique<ShaderBytecodeCache>(cacheDirectory, *m_compiler);
+
+	//ڻ߱˶ӿջ濪ʼʧ
+	m_bytecodeCache->LoadIndex();
+	return true;
+}
+
+bool ShaderManager::SaveBytecodeCache(bool pruneUnused)
+{
+	if (!m_bytecodeCache)
+	{
+		return false;
+	}
+	if (pruneUnused)
+	{
+		m_bytecodeCache->PruneUnused();
+	}
+	return m_bytecodeCache->SaveIndex();
+}
+
+ID3DBlob* ShaderManager::CompileFromSource(const ShaderInfo& info, ShaderLoadExtras* outExtras)
+{
+	ShaderCompileRequest request;
+	request.SourcePath = info.SourcePath;
+	request.EntryPoint = info.EntryPoint;
+	request.Target = info.Target;
+	request.Defines = info.Defines;
+	request.Flags = GetCompileFlags();
+
+	ShaderCacheResult result;
+	if (m_bytecodeCache)
+	{
+		result = m_bytecodeCache->GetOrCompile(request);
+	}
+	else
+	{
+		//û̻棨ֻأֱӱ
+		ShaderPreprocessResult preprocessed = m_compiler->Preprocess(request);
+		result.Includes = std::move(preprocessed.Includes);
+		result.Errors = std::move(preprocessed.Errors);
+		if (preprocessed.Success)
+		{
+			ShaderCompileResult compiled = m_compiler->Compile(request, preprocessed.Source);
+			result.Errors += compiled.Errors;
+			result.Bytecode = std::move(compiled.Bytecode);
+			result.Success = compiled.Success && !result.Bytecode.empty();
+		}
+	}
+
+	if (!result.Errors.empty())
+	{
+		OutputDebugStringA(result.Errors.c_str());
+		std::cerr << "Shader compilation errors for" << info.Name << ":" << std::endl;
+		std::cerr << result.Errors << std::endl;
+	}
+
+	//ʧҲ޺include֮Ҫܴر
+	if (outExtras != nullptr)
+	{
+		outExtras->Dependencies.push_back(info.SourcePath);
+		outExtras->Dependencies.insert(outExtras->Dependencies.end(), result.Includes.begin(), result.Includes.end());
+		if (result.Success && result.HasReflection)
+		{
+			outExtras->Reflection = std::make_shared<const ShaderReflection>(std::move(result.Reflection));
+		}
+	}
+	if (!result.Success)
+	{
+		return nullptr;
+	}
+
+	Microsoft::WRL::ComPtr<ID3DBlob> blob;
+	HRESULT hr = D3DCreateBlob(result.Bytecode.size(), &blob);
+	if (FAILED(hr))
+	{
+		return nullptr;
+	}
+	memcpy(blob->GetBufferPointer(), result.Bytecode.data(), result.Bytecode.size());
+	return blob.Detach();
+}
+
+
+bool ShaderManager::EnableHotReload(std::chrono::milliseconds pollInterval, bool forcePolling)
+{
+	if (IsHotReloadEnabled())
+	{
+		return true;
+	}
+	if (!m_runtimeCompileEnabled)
+	{
+		return false;
+	}
+
+	//Ҫõinclude߱ӿ
+	if (!m_compiler)
+	{
+		m_compiler = std::make_unique<D3DShaderCompiler>();
+	}
+
+	m_watcher = std::make_unique<FileWatcher>(m_shaderDirectory, true, forcePolling);
+	if (m_watcher->GetBackend() == FileWatcher::Backend::None)
+	{
+		std::wcerr << L"Shader hot reload: cannot watch " << m_shaderDirectory << std::endl;
+		m_watcher.reset();
+		return false;
+	}
+
+	RefreshDependencies();
+
+	m_hotReloadInterval = pollInterval;
+	m_hotReloadStop = false;
+	m_hotReloadThread = std::thread(&ShaderManager::HotReloadLoop, this);
+	return true;
+}
+
+void ShaderManager::DisableHotReload()
+{
+	if (!m_hotReloadThread.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_hotReloadMutex);
+		m_hotReloadStop = true;
+	}
+	m_hotReloadCondition.notify_all();
+	m_hotReloadThread.join();
+	m_watcher.reset();
+}
+
+void ShaderManager::HotReloadLoop()
+{
+	KJ_PROFILE_THREAD("Shader Hot Reload");
+
+	//༭ʱּд꣨ضϡд롢յ仯һСһ֣һ
+	const std::chrono::milliseconds settleTime(50);
+
+	std::unique_lock<std::mutex> lock(m_hotReloadMutex);
+	while (!m_hotReloadCondition.wait_for(lock, m_hotReloadInterval, [this]() { return m_hotReloadStop; }))
+	{
+		lock.unlock();
+		std::vector<std::filesystem::path> changes = m_watcher->PollChanges();
+		lock.lock();
+		if (changes.empty())
+		{
+			continue;
+		}
+
+		if (m_hotReloadCondition.wait_for(lock, settleTime, [this]() { return m_hotReloadStop; }))
+		{
+			break;
+		}
+
+		lock.unlock();
+		std::vector<std::filesystem::path> more = m_watcher->PollChanges();
+		changes.insert(changes.end(), more.begin(), more.end());
+		ProcessFileChanges(changes);
+		lock.lock();
+	}
+}
+
+size_t ShaderManager::ProcessFileChanges(const std::vector<std::filesystem::path>& changedFiles)
+{
+	//ҳӰɫ
+	std::vector<std::string> affected;
+	{
+		std::unordered_set<std::string> names;
+		std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+		for (const std::filesystem::path& file : changedFiles)
+		{
+			auto it = m_dependents.find(NormalizePath(file));
+			if (it != m_dependents.end())
+			{
+				names.insert(it->second.begin(), it->second.end());
+			}
+		}
+		affected.assign(names.begin(), names.end());
+	}
+	if (affected.empty())
+	{
+		return 0;
+	}
+
+	KJ_PROFILE_SCOPE("Hot Reload Shaders");
+
+	//ԤһֻͬһΣҲһ
+	struct ReloadResult
+	{
+		Microsoft::WRL::ComPtr<ID3DBlob> ByteCode;
+		ShaderLoadExtras Extras;
+	};
+	std::unordered_map<std::wstring, ReloadResult> compiled;
+	size_t replacedCount = 0;
+	for (const std::string& name : affected)
+	{
+		const ShaderInfo* info = FindShaderInfo(name);
+		if (info == nullptr)
+		{
+			continue;
+		}
+
+		auto [resultIt, inserted] = compiled.try_emplace(MakeCompileIdentity(*info));
+		ReloadResult& result = resultIt->second;
+		if (inserted)
+		{
+			result.ByteCode.Attach(LoadShaderFromInfo(*info, &result.Extras));
+		}
+
+		if (result.ByteCode == nullptr)
+		{
+			std::cerr << "Shader hot reload failed, keeping previous version: " << name << std::endl;
+			//£޺¼ӵincludeҲܴر
+			if (!result.Extras.Dependencies.empty())
+			{
+				std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+				SetDependencies(name, result.Extras.Dependencies);
+			}
+			continue;
+		}
+
+		ReplaceShader(name, result.ByteCode, result.Extras);
+		++replacedCount;
+
+		std::string message = "Shader reloaded: " + name + "\n";
+		OutputDebugStringA(message.c_str());
+	}
+
+	if (replacedCount > 0)
+	{
+		m_generation.fetch_add(1, std::memory_order_release);
+	}
+	return replacedCount;
+}
+
+
+void ShaderManager::ReleaseRetiredShaders(uint64_t submittedFenceValue, uint64_t completedFenceValue)
+{
+	std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+	if (m_retiredShaders.empty())
+	{
+		return;
+	}
+
+	//滻ϴε֮ùɰ汾֡Ѿύһ֡
+	for (RetiredShader& retired : m_retiredShaders)
+	{
+		if (retired.FenceValue == 0)
+		{
+			retired.FenceValue = submittedFenceValue;
+		}
+	}
+	m_retiredShaders.erase(std::remove_if(m_retiredShaders.begin(), m_retiredShaders.end(),
+		[completedFenceValue](const RetiredShader& retired) { return retired.FenceValue <= completedFenceValue; }),
+		m_retiredShaders.end());
+}
+
+size_t ShaderManager::GetRetiredShaderCount() const
+{
+	std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+	return m_retiredShaders.size();
+}
+
+void ShaderManager::RefreshDependencies()
+{
+	//ֻԴļɫincludeɲ
+	std::vector<std::string> names;
+	{
+		std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+		for (const auto& [name, blob] : m_shaderCache)
+		{
+			names.push_back(name);
+		}
+	}
+
+	for (const std::string& name : names)
+	{
+		const ShaderInfo* info = FindShaderInfo(name);
+		if (info == nullptr || info->SourcePath.empty())
+		{
+			continue;
+		}
+
+		ShaderCompileRequest request;
+		request.SourcePath = info->SourcePath;
+		request.EntryPoint = info->EntryPoint;
+		request.Target = info->Target;
+		request.Defines = info->Defines;
+		request.Flags = GetCompileFlags();
+		ShaderPreprocessResult preprocessed = m_compiler->Preprocess(request);
+
+		std::vector<std::filesystem::path> dependencies;
+		dependencies.push_back(info->SourcePath);
+		dependencies.insert(dependencies.end(), preprocessed.Includes.begin(), preprocessed.Includes.end());
+		if (!info->UseRuntimeCompile && !info->CompiledPath.empty())
+		{
+			dependencies.push_back(info->CompiledPath);
+		}
+
+		std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+		SetDependencies(name, dependencies);
+	}
 }
 
 
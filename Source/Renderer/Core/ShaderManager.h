@@ -3,8 +3,24 @@
 #include <d3d12.h>
 #include <d3dcompiler.h>
 #include <wrl/client.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "Renderer/Core/ShaderBytecodeCache.h"
+#include "Renderer/Core/ShaderReflection.h"
+
+class FileWatcher;
 
 
 
@@ -16,7 +32,33 @@ struct ShaderInfo
     std::string EntryPoint;     
     std::string Target;         
     bool UseRuntimeCompile;     
+    std::vector<ShaderDefine> Defines;
+};
+//һԤÿɫĺʱ
+struct ShaderLoadTiming
+{
+    std::string Name;
+    double Milliseconds = 0.0;      //ȥعñ˽ļ0
+    std::string SharedWith;         //ĸɫȫһԴ롢ڡĿꡢ꣩ձʾԼص
+    bool Success = false;
+};
+
+//ɫͳƣűը
+struct ShaderVariantStats
+{
+    uint32_t ShadersWithKeywords = 0;
+    uint64_t LiveVariants = 0;          //ģؼϣ
+    uint64_t CompiledVariants = 0;      //ڻ
+    uint64_t PossibleVariants = 0;      //֮ͣʱ
+    uint64_t Requests = 0;
+    uint64_t Hits = 0;
+    uint64_t LazyCompiles = 0;          //һõʱڵ߳ϱĴ
+    uint64_t Prewarmed = 0;
+    uint64_t Failures = 0;
+    double LazyCompileMilliseconds = 0.0;   //뿨ס̵߳ʱ䣬̫͸ðЩӽԤ
 };
+
+//̰߳ȫءѯԤؿ̵߳ãעᣨRegister*InitializeҪڼغͿ֮ǰͬһ߳
 class ShaderManager
 {
 public:
@@ -32,7 +74,8 @@ public:
         const std::wstring& sourcePath,
         const std::string& entryPoint,
         const std::string& target,
-        bool allowRuntimeCompile = true
+        bool allowRuntimeCompile = true,
+        const std::vector<ShaderDefine>& defines = {}
     );
 
 
@@ -51,7 +94,8 @@ public:
         const std::wstring& sourcePath,
         const std::string& entryPoint,
         const std::string& target,
-        const std::string& shaderName = ""
+        const std::string& shaderName = "",
+        const std::vector<ShaderDefine>& defines = {}
     );
 
     //ļѾõ
@@ -62,15 +106,85 @@ public:
     ID3DBlob* GetShader(const std::string& shaderName);
 
 
+    //ֽݹϣPSOûػȼأʧܷ0
+    uint64_t GetShaderHash(const std::string& shaderName);
+
+    //ֽĹϣͬһμȡ滻ǰ󲻻õһһɣûػȼأʧܷfalse
+    //صãػClear֮ҲһֱЧ
+    bool GetShaderWithHash(const std::string& shaderName, Microsoft::WRL::ComPtr<ID3DBlob>& outBlob, uint64_t& outHash);
+
+    //ϢcbufferԱƫơԴ󶨡ǩûػȼأȡؿ
+    //ֽ뻺ʱֽһӴ̶һβѯʱȡһΣ滻Զµ
+    std::shared_ptr<const ShaderReflection> GetShaderReflection(const std::string& shaderName);
+
+    //鶥㲼ܲιɫһVSǩPSO֮ǰ
+    ShaderInputValidation ValidateInputLayout(const std::string& shaderName, const VertexLayout& layout);
+
+    //FNV-1aVertexLayoutĹϣͬһ
+    static uint64_t HashBytecode(const void* data, size_t size);
+
+
     //
     bool IsShaderLoaded(const std::string& shaderName) const;
 
-    //Ԥ
-    bool PreloadAllShaders();
+    //Ԥȫעɫ̳߳ϲб/أֻͬһ
+    //threadCountΪ0ʱCPUÿɫĺʱGetPreloadTimings
+    bool PreloadAllShaders(uint32_t threadCount = 0);
+    const std::vector<ShaderLoadTiming>& GetPreloadTimings() const { return m_preloadTimings; }
+
+    //壺ɫһؼ֣64λȡ壬iλӦkeywords[i]
+    //򿪵ĹؼΪ"1"׷ӵעĺ棻Ϊ0ɫ
+    //һõʱű룬֮󰴣ɫ룩棻"ɫ#ʮ"ͨɫһPSO
+    //ûcsoֻʱ룻RegisterShaderKeywordsעᣬҪRegisterShader֮󡢼֮ǰ
+    //ɫûעᡢֻcsoRegisterCompiledShaderûʱʱfalse
+    static constexpr size_t kMaxShaderKeywords = 64;
+    bool RegisterShaderKeywords(const std::string& shaderName, const std::vector<std::string>& keywords);
+
+    //ؼ룬вʶĹؼַfalse
+    bool GetKeywordMask(const std::string& shaderName, const std::vector<std::string>& keywords, uint64_t& outMask) const;
+    static std::string MakeVariantName(const std::string& shaderName, uint64_t keywordMask);
 
-    //建
+    //ȡ壬ûڵ߳ϱ룻ûλnullptr
+    ID3DBlob* GetShaderVariant(const std::string& shaderName, uint64_t keywordMask);
+
+    //Ԥȣбһ֪õı壬뿨֡Էŵ߳ϵ
+    bool PrewarmShaderVariants(const std::vector<std::pair<std::string, uint64_t>>& variants, uint32_t threadCount = 0);
+
+    size_t GetLiveVariantCount(const std::string& shaderName) const;
+    ShaderVariantStats GetVariantStats() const;
+
+    //ɫıʱһ
+    void SetVariantWarningThreshold(uint32_t threshold) { m_variantWarningThreshold = threshold; }
+
+    //建棨עϢ֮õ±룩
     void Clear();
 
+    //ֽ뻺棺ԤԴ++Ŀ++־ԴincludeûͲٱ
+    //֮ʱɫԴΪ׼ٶԱ߿ܹڵcso
+    bool EnableBytecodeCache(const std::wstring& cacheDirectory);
+    bool SaveBytecodeCache(bool pruneUnused = false);
+    ShaderBytecodeCache* GetBytecodeCache() const { return m_bytecodeCache.get(); }
+
+    //ĬD3DShaderCompilerҪEnableBytecodeCacheͼ֮ǰ
+    void SetCompiler(std::unique_ptr<IShaderCompiler> compiler) { m_compiler = std::move(compiler); }
+
+    //أ̨̼߳ɫĿ¼ԴincludeļֻرӰɫúԭ滻
+    //滻GetGenerationһɫĵطPSO棩ִ˾ȡֽ͹ϣ
+    //ʧܱɰ汾滻ľֽù֡GPUͷţReleaseRetiredShadersָ벻Ҫ֡
+    //֮ǰصɫҲᲹinclude
+    bool EnableHotReload(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(200), bool forcePolling = false);
+    void DisableHotReload();
+    bool IsHotReloadEnabled() const { return m_hotReloadThread.joinable(); }
+    uint64_t GetGeneration() const { return m_generation.load(std::memory_order_acquire); }
+
+    //һ仯ļرǵɫ滻˼̵߳ãҲֱӵã
+    size_t ProcessFileChanges(const std::vector<std::filesystem::path>& changedFiles);
+
+    //ÿ֡ʼʱãϴε滻ֽsubmittedFenceValueһõ֡
+    //completedFenceValue˾ͷ
+    void ReleaseRetiredShaders(uint64_t submittedFenceValue, uint64_t completedFenceValue);
+    size_t GetRetiredShaderCount() const;
+
     //ʱ
     void SetRuntimeCompilationEnabled(bool enabled) { m_runtimeCompileEnabled = enabled; }
     bool IsRuntimeCompilationEnabled() const {
@@ -80,13 +194,108 @@ public:
 
 private:
 
+    //һɫмصĽ
+    struct LoadBatchResult
+    {
+        bool AllSuccess = true;
+        size_t UniqueCount = 0;
+        uint32_t WorkerCount = 0;
+        double WallMilliseconds = 0.0;
+        double TotalMilliseconds = 0.0;
+        std::vector<ShaderLoadTiming> Timings;
+    };
+
+    //̳߳ϼػûڻɫֻͬһ
+    LoadBatchResult LoadShadersParallel(const std::vector<std::string>& shaderNames, uint32_t threadCount);
+
+    //עĻ߱ϢҲnullptrLocked汾ʱm_cacheMutex
+    const ShaderInfo* FindShaderInfo(const std::string& shaderName) const;
+    const ShaderInfo* FindShaderInfoLocked(const std::string& shaderName) const;
+
+    //һμıǼעϢرЧɫ಻˱巵nullptr
+    const std::string* EnsureVariant(const std::string& shaderName, uint64_t keywordMask);
+    //忿ԴӺʱ±룬ҪHLSLԴ벢ҿʱ
+    static bool CanCompileVariants(const ShaderInfo& info);
+
     //
     bool ReadFileToBlob(const std::wstring & filePath, ID3DBlob * *ppBlob);
 
     UINT GetCompileFlags() const;
 
+    //ʱ˳õĶļԴļincludecsoصcsoԴļֽ뻺ʱзϢһβѯʱȡ
+    struct ShaderLoadExtras
+    {
+        std::vector<std::filesystem::path> Dependencies;
+        std::shared_ptr<const ShaderReflection> Reflection;
+    };
+
+    //m_compilerԴ루ֽ뻺߻棩ʧܷnullptr
+    ID3DBlob* CompileFromSource(const ShaderInfo& info, ShaderLoadExtras* outExtras);
+
+    //עϢػ룬m_shaderCacheڹ߳ϵ
+    ID3DBlob* LoadShaderFromInfo(const ShaderInfo& info, ShaderLoadExtras* outExtras = nullptr);
+
+    //Ž棻߳ȷͬľȵǷݣػָ
+    ID3DBlob* StoreShader(const std::string& shaderName, const Microsoft::WRL::ComPtr<ID3DBlob>& blob,
+        const ShaderLoadExtras& extras = {});
+
+    //滻ɵķŽm_retiredShaders
+    void ReplaceShader(const std::string& shaderName, const Microsoft::WRL::ComPtr<ID3DBlob>& blob,
+        const ShaderLoadExtras& extras);
+
+    //¼ʱm_cacheMutex
+    void SetDependencies(const std::string& shaderName, const std::vector<std::filesystem::path>& dependencies);
+
+    //ʱѾصɫinclude֮ǰûбӿڣֻԴļcso
+    void RefreshDependencies();
+
+    void HotReloadLoop();
+
     std::unordered_map<std::string, ShaderInfo> m_shaderInfos;
+    //m_shaderCachem_shaderHashesm_shaderReflectionsm_cacheMutexغͱ뱾
+    mutable std::shared_mutex m_cacheMutex;
     std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3DBlob>> m_shaderCache;
+    std::unordered_map<std::string, uint64_t> m_shaderHashes;
+    struct RetiredShader
+    {
+        Microsoft::WRL::ComPtr<ID3DBlob> Blob;
+        uint64_t FenceValue = 0;    //0ʾû֡
+    };
+    std::vector<RetiredShader> m_retiredShaders;
+    std::unordered_map<std::string, std::shared_ptr<const ShaderReflection>> m_shaderReflections;
+    //淶ļ· -> õɫԼҪɾɵģҲm_cacheMutex
+    std::unordered_map<std::wstring, std::unordered_set<std::string>> m_dependents;
+    std::unordered_map<std::string, std::vector<std::wstring>> m_dependencies;
+    std::vector<ShaderLoadTiming> m_preloadTimings;
+
+    //壺m_keywordSetsע׶ζ£Variantsm_variantInfosm_cacheMutex
+    struct ShaderKeywordSet
+    {
+        std::vector<std::string> Keywords;
+        uint64_t ValidMask = 0;
+        std::unordered_map<uint64_t, std::string> Variants;    // -> 
+    };
+    std::unordered_map<std::string, ShaderKeywordSet> m_keywordSets;
+    std::unordered_map<std::string, ShaderInfo> m_variantInfos;
+    uint32_t m_variantWarningThreshold = 64;
+    std::atomic<uint64_t> m_variantRequests = 0;
+    std::atomic<uint64_t> m_variantHits = 0;
+    std::atomic<uint64_t> m_variantLazyCompiles = 0;
+    std::atomic<uint64_t> m_variantPrewarmed = 0;
+    std::atomic<uint64_t> m_variantFailures = 0;
+    std::atomic<int64_t> m_variantCompileNs = 0;
+
+    std::unique_ptr<IShaderCompiler> m_compiler;
+    std::unique_ptr<ShaderBytecodeCache> m_bytecodeCache;
+
+    //
+    std::unique_ptr<FileWatcher> m_watcher;     //ֻ߳
+    std::thread m_hotReloadThread;
+    std::mutex m_hotReloadMutex;
+    std::condition_variable m_hotReloadCondition;
+    bool m_hotReloadStop = false;
+    std::chrono::milliseconds m_hotReloadInterval{ 200 };
+    std::atomic<uint64_t> m_generation = 0;
 
 
     std::wstring m_shaderDirectory;
@@ -0,0 +1,403 @@
+// ShaderReflection.cpp
+#include "Renderer/Core/ShaderReflection.h"
+#include "Renderer/Resources/VertexLayout.h"
+
+namespace
+{
+    bool EqualsIgnoreCase(std::string_view a, std::string_view b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            char x = a[i];
+            char y = b[i];
+            if (x >= 'a' && x <= 'z') x = static_cast<char>(x - 'a' + 'A');
+            if (y >= 'a' && y <= 'z') y = static_cast<char>(y - 'a' + 'A');
+            if (x != y)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief ʽɫķ
+     */
+    void GetFormatShaderType(VertexFormat format, uint32_t& outComponents, ShaderComponentType& outType)
+    {
+        switch (format)
+        {
+        case VertexFormat::Float1: outComponents = 1; outType = ShaderComponentType::Float32; return;
+        case VertexFormat::Float2: outComponents = 2; outType = ShaderComponentType::Float32; return;
+        case VertexFormat::Float3: outComponents = 3; outType = ShaderComponentType::Float32; return;
+        case VertexFormat::Float4: outComponents = 4; outType = ShaderComponentType::Float32; return;
+        case VertexFormat::UInt1: outComponents = 1; outType = ShaderComponentType::UInt32; return;
+        case VertexFormat::UInt2: outComponents = 2; outType = ShaderComponentType::UInt32; return;
+        case VertexFormat::UInt3: outComponents = 3; outType = ShaderComponentType::UInt32; return;
+        case VertexFormat::UInt4: outComponents = 4; outType = ShaderComponentType::UInt32; return;
+        case VertexFormat::Int1: outComponents = 1; outType = ShaderComponentType::SInt32; return;
+        case VertexFormat::Int2: outComponents = 2; outType = ShaderComponentType::SInt32; return;
+        case VertexFormat::Int3: outComponents = 3; outType = ShaderComponentType::SInt32; return;
+        case VertexFormat::Int4: outComponents = 4; outType = ShaderComponentType::SInt32; return;
+        case VertexFormat::Half2: outComponents = 2; outType = ShaderComponentType::Float32; return;
+        case VertexFormat::Half4: outComponents = 4; outType = ShaderComponentType::Float32; return;
+        case VertexFormat::UByte4_Norm: outComponents = 4; outType = ShaderComponentType::Float32; return;
+        case VertexFormat::UByte4: outComponents = 4; outType = ShaderComponentType::UInt32; return;
+        case VertexFormat::Short2_Norm: outComponents = 2; outType = ShaderComponentType::Float32; return;
+        case VertexFormat::Short4_Norm: outComponents = 4; outType = ShaderComponentType::Float32; return;
+        default: outComponents = 0; outType = ShaderComponentType::Unknown; return;
+        }
+    }
+
+    const char* ToString(ShaderComponentType type)
+    {
+        switch (type)
+        {
+        case ShaderComponentType::UInt32: return "uint";
+        case ShaderComponentType::SInt32: return "int";
+        case ShaderComponentType::Float32: return "float";
+        default: return "unknown";
+        }
+    }
+
+    std::string FormatSemantic(const std::string& name, uint32_t index)
+    {
+        return name + std::to_string(index);
+    }
+
+    /**
+     * @brief Сд
+     */
+    class BinaryWriter
+    {
+    public:
+        void WriteU32(uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                m_data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+            }
+        }
+
+        void WriteString(const std::string& text)
+        {
+            WriteU32(static_cast<uint32_t>(text.size()));
+            m_data.insert(m_data.end(), text.begin(), text.end());
+        }
+
+        std::vector<uint8_t>& GetData() { return m_data; }
+
+    private:
+        std::vector<uint8_t> m_data;
+    };
+
+    /**
+     * @brief С˶ȡԽһֱʧ
+     */
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const void* data, size_t size)
+            : m_data(static_cast<const uint8_t*>(data))
+            , m_size(size)
+        {
+        }
+
+        bool ReadU32(uint32_t& outValue)
+        {
+            if (m_size - m_offset < 4)
+            {
+                return false;
+            }
+            outValue = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                outValue |= static_cast<uint32_t>(m_data[m_offset + i]) << (i * 8);
+            }
+            m_offset += 4;
+            return true;
+        }
+
+        bool ReadString(std::string& outText)
+        {
+            uint32_t length = 0;
+            if (!ReadU32(length) || m_size - m_offset < length)
+            {
+                return false;
+            }
+            outText.assign(reinterpret_cast<const char*>(m_data + m_offset), length);
+            m_offset += length;
+            return true;
+        }
+
+        /**
+         * @brief 鳤ȣÿԪminElementSizeֽڣĴᵼ¾޴ķ
+         */
+        bool ReadCount(size_t minElementSize, uint32_t& outCount)
+        {
+            return ReadU32(outCount) && static_cast<uint64_t>(outCount) * minElementSize <= m_size - m_offset;
+        }
+
+        bool AtEnd() const { return m_offset == m_size; }
+
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_offset = 0;
+    };
+}
+
+const ShaderVariableInfo* ShaderConstantBufferInfo::FindVariable(std::string_view name) const
+{
+    for (const ShaderVariableInfo& variable : Variables)
+    {
+        if (variable.Name == name)
+        {
+            return &variable;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t ShaderInputParameter::GetComponentCount() const
+{
+    // ĵλfloat30b0111ȡλ
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (Mask & (1u << i))
+        {
+            count = i + 1;
+        }
+    }
+    return count;
+}
+
+const ShaderConstantBufferInfo* ShaderReflection::FindConstantBuffer(std::string_view name) const
+{
+    for (const ShaderConstantBufferInfo& buffer : ConstantBuffers)
+    {
+        if (buffer.Name == name)
+        {
+            return &buffer;
+        }
+    }
+    return nullptr;
+}
+
+const ShaderResourceBinding* ShaderReflection::FindBinding(std::string_view name) const
+{
+    for (const ShaderResourceBinding& binding : Bindings)
+    {
+        if (binding.Name == name)
+        {
+            return &binding;
+        }
+    }
+    return nullptr;
+}
+
+const ShaderInputParameter* ShaderReflection::FindInput(std::string_view semanticName, uint32_t semanticIndex) const
+{
+    for (const ShaderInputParameter& input : InputParameters)
+    {
+        if (input.SemanticIndex == semanticIndex && EqualsIgnoreCase(input.SemanticName, semanticName))
+        {
+            return &input;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<uint8_t> ShaderReflection::Serialize() const
+{
+    BinaryWriter writer;
+    writer.WriteU32(kMagic);
+    writer.WriteU32(kVersion);
+
+    writer.WriteU32(static_cast<uint32_t>(ConstantBuffers.size()));
+    for (const ShaderConstantBufferInfo& buffer : ConstantBuffers)
+    {
+        writer.WriteString(buffer.Name);
+        writer.WriteU32(buffer.BindPoint);
+        writer.WriteU32(buffer.Space);
+        writer.WriteU32(buffer.Size);
+        writer.WriteU32(static_cast<uint32_t>(buffer.Variables.size()));
+        for (const ShaderVariableInfo& variable : buffer.Variables)
+        {
+            writer.WriteString(variable.Name);
+            writer.WriteU32(variable.Offset);
+            writer.WriteU32(variable.Size);
+        }
+    }
+
+    writer.WriteU32(static_cast<uint32_t>(Bindings.size()));
+    for (const ShaderResourceBinding& binding : Bindings)
+    {
+        writer.WriteString(binding.Name);
+        writer.WriteU32(static_cast<uint32_t>(binding.Kind));
+        writer.WriteU32(binding.BindPoint);
+        writer.WriteU32(binding.BindCount);
+        writer.WriteU32(binding.Space);
+    }
+
+    writer.WriteU32(static_cast<uint32_t>(InputParameters.size()));
+    for (const ShaderInputParameter& input : InputParameters)
+    {
+        writer.WriteString(input.SemanticName);
+        writer.WriteU32(input.SemanticIndex);
+        writer.WriteU32(input.Register);
+        writer.WriteU32(static_cast<uint32_t>(input.ComponentType));
+        writer.WriteU32(input.Mask);
+        writer.WriteU32(input.IsSystemValue ? 1u : 0u);
+    }
+    return std::move(writer.GetData());
+}
+
+bool ShaderReflection::Deserialize(const void* data, size_t size, ShaderReflection& outReflection)
+{
+    outReflection = ShaderReflection();
+    BinaryReader reader(data, size);
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (!reader.ReadU32(magic) || !reader.ReadU32(version) || magic != kMagic || version != kVersion)
+    {
+        return false;
+    }
+
+    // ÿԪСַֽĳ4ֽڼϺĶֶ
+    uint32_t count = 0;
+    if (!reader.ReadCount(20, count))
+    {
+        return false;
+    }
+    outReflection.ConstantBuffers.resize(count);
+    for (ShaderConstantBufferInfo& buffer : outReflection.ConstantBuffers)
+    {
+        uint32_t variableCount = 0;
+        if (!reader.ReadString(buffer.Name) || !reader.ReadU32(buffer.BindPoint) || !reader.ReadU32(buffer.Space) ||
+            !reader.ReadU32(buffer.Size) || !reader.ReadCount(12, variableCount))
+        {
+            return false;
+        }
+        buffer.Variables.resize(variableCount);
+        for (ShaderVariableInfo& variable : buffer.Variables)
+        {
+            if (!reader.ReadString(variable.Name) || !reader.ReadU32(variable.Offset) || !reader.ReadU32(variable.Size))
+            {
+                return false;
+            }
+        }
+    }
+
+    if (!reader.ReadCount(20, count))
+    {
+        return false;
+    }
+    outReflection.Bindings.resize(count);
+    for (ShaderResourceBinding& binding : outReflection.Bindings)
+    {
+        uint32_t kind = 0;
+        if (!reader.ReadString(binding.Name) || !reader.ReadU32(kind) || !reader.ReadU32(binding.BindPoint) ||
+            !reader.ReadU32(binding.BindCount) || !reader.ReadU32(binding.Space) ||
+            kind > static_cast<uint32_t>(ShaderResourceKind::Sampler))
+        {
+            return false;
+        }
+        binding.Kind = static_cast<ShaderResourceKind>(kind);
+    }
+
+    if (!reader.ReadCount(24, count))
+    {
+        return false;
+    }
+    outReflection.InputParameters.resize(count);
+    for (ShaderInputParameter& input : outReflection.InputParameters)
+    {
+        uint32_t type = 0;
+        uint32_t mask = 0;
+        uint32_t systemValue = 0;
+        if (!reader.ReadString(input.SemanticName) || !reader.ReadU32(input.SemanticIndex) || !reader.ReadU32(input.Register) ||
+            !reader.ReadU32(type) || !reader.ReadU32(mask) || !reader.ReadU32(systemValue) ||
+            type > static_cast<uint32_t>(ShaderComponentType::Float32) || mask > 0xFu)
+        {
+            return false;
+        }
+        input.ComponentType = static_cast<ShaderComponentType>(type);
+        input.Mask = static_cast<uint8_t>(mask);
+        input.IsSystemValue = systemValue != 0;
+    }
+    return reader.AtEnd();
+}
+
+std::string ShaderInputValidation::ToString() const
+{
+    std::string text;
+    for (const std::string& error : Errors)
+    {
+        text += "error: " + error + "\n";
+    }
+    for (const std::string& warning : Warnings)
+    {
+        text += "warning: " + warning + "\n";
+    }
+    return text;
+}
+
+ShaderInputValidation ValidateInputLayout(const ShaderReflection& reflection, const VertexLayout& layout)
+{
+    ShaderInputValidation result;
+    for (const ShaderInputParameter& input : reflection.InputParameters)
+    {
+        if (input.IsSystemValue)
+        {
+            continue;
+        }
+
+        const VertexElement* element = nullptr;
+        for (const VertexElement& candidate : layout.GetElements())
+        {
+            if (candidate.SemanticIndex == input.SemanticIndex && EqualsIgnoreCase(candidate.SemanticName, input.SemanticName))
+            {
+                element = &candidate;
+                break;
+            }
+        }
+
+        const std::string semantic = FormatSemantic(input.SemanticName, input.SemanticIndex);
+        if (element == nullptr)
+        {
+            result.Errors.push_back("shader input " + semantic + " is not provided by the vertex layout");
+            continue;
+        }
+
+        uint32_t components = 0;
+        ShaderComponentType type = ShaderComponentType::Unknown;
+        GetFormatShaderType(element->Format, components, type);
+        if (type == ShaderComponentType::Unknown)
+        {
+            result.Errors.push_back("vertex layout element " + semantic + " has an unknown format");
+            continue;
+        }
+        if (input.ComponentType != ShaderComponentType::Unknown && input.ComponentType != type)
+        {
+            result.Errors.push_back("shader input " + semantic + " is " + ToString(input.ComponentType) +
+                " but the vertex layout provides " + ToString(type));
+        }
+
+        const uint32_t required = input.GetComponentCount();
+        if (components < required)
+        {
+            result.Warnings.push_back("shader input " + semantic + " reads " + std::to_string(required) +
+                " components but the vertex layout provides " + std::to_string(components));
+        }
+    }
+
+    result.Valid = result.Errors.empty();
+    return result;
+}
@@ -0,0 +1,153 @@
+// ShaderReflection.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class VertexLayout;
+
+/**
+ * @brief һԱ
+ */
+struct ShaderVariableInfo
+{
+    std::string Name;
+    uint32_t Offset = 0;    // Իͷֽƫ
+    uint32_t Size = 0;
+
+    bool operator==(const ShaderVariableInfo&) const = default;
+};
+
+/**
+ * @brief һcbufferĲ
+ */
+struct ShaderConstantBufferInfo
+{
+    std::string Name;
+    uint32_t BindPoint = 0;     // register(bN)N
+    uint32_t Space = 0;
+    uint32_t Size = 0;          // ĴСѰ16ֽڶ룩
+    std::vector<ShaderVariableInfo> Variables;
+
+    /**
+     * @brief ҳԱҲnullptr
+     */
+    const ShaderVariableInfo* FindVariable(std::string_view name) const;
+
+    bool operator==(const ShaderConstantBufferInfo&) const = default;
+};
+
+/**
+ * @brief Դ󶨵࣬͸ǩΧһһӦ
+ */
+enum class ShaderResourceKind : uint8_t
+{
+    ConstantBuffer = 0,     // CBV
+    ShaderResource,         // SRVtbufferṹ/ֽڵַ塢ٽṹ
+    UnorderedAccess,        // UAV
+    Sampler
+};
+
+/**
+ * @brief һԴ󶨣cbufferҲ棩
+ */
+struct ShaderResourceBinding
+{
+    std::string Name;
+    ShaderResourceKind Kind = ShaderResourceKind::ShaderResource;
+    uint32_t BindPoint = 0;
+    uint32_t BindCount = 1;     // С޽Ϊ0
+    uint32_t Space = 0;
+
+    bool operator==(const ShaderResourceBinding&) const = default;
+};
+
+/**
+ * @brief ǩ
+ */
+enum class ShaderComponentType : uint8_t
+{
+    Unknown = 0,
+    UInt32,
+    SInt32,
+    Float32
+};
+
+/**
+ * @brief ǩһɫǶԣ
+ */
+struct ShaderInputParameter
+{
+    std::string SemanticName;
+    uint32_t SemanticIndex = 0;
+    uint32_t Register = 0;
+    ShaderComponentType ComponentType = ShaderComponentType::Unknown;
+    uint8_t Mask = 0;               // ķxyzwӦ4λ
+    bool IsSystemValue = false;     // SV_VertexID֮࣬Ӷ㻺
+
+    /**
+     * @brief ķfloat33
+     */
+    uint32_t GetComponentCount() const;
+
+    bool operator==(const ShaderInputParameter&) const = default;
+};
+
+/**
+ * @brief ɫķϢcbufferԱƫơԴ󶨡ǩ
+ * @details ȡһΣֽһShaderBytecodeCacheֱ֮ӷл
+ *          ·ϲٵD3DReflectC++ֲ߰ƫƣдHLSLĽṹ
+ */
+struct ShaderReflection
+{
+    static constexpr uint32_t kMagic = 0x464A524Bu;     // "KRJF"
+    static constexpr uint32_t kVersion = 1;
+
+    std::vector<ShaderConstantBufferInfo> ConstantBuffers;
+    std::vector<ShaderResourceBinding> Bindings;
+    std::vector<ShaderInputParameter> InputParameters;
+
+    const ShaderConstantBufferInfo* FindConstantBuffer(std::string_view name) const;
+    const ShaderResourceBinding* FindBinding(std::string_view name) const;
+
+    /**
+     * @brief ִСдHLSLĹ
+     */
+    const ShaderInputParameter* FindInput(std::string_view semanticName, uint32_t semanticIndex = 0) const;
+
+    /**
+     * @brief лɽյĶƣСˣַȣ
+     */
+    std::vector<uint8_t> Serialize() const;
+
+    /**
+     * @brief лݽضϡħ汾ԷfalseoutReflection֤
+     */
+    static bool Deserialize(const void* data, size_t size, ShaderReflection& outReflection);
+
+    bool operator==(const ShaderReflection&) const = default;
+};
+
+/**
+ * @brief ǩͶ㲼ֵУ
+ */
+struct ShaderInputValidation
+{
+    bool Valid = true;
+    std::vector<std::string> Errors;    // ȱ塢/ͲPSOһʧܻ߶
+    std::vector<std::string> Warnings;  // ָķɫ٣ȱķĬֵ
+
+    /**
+     * @brief ;ƴɶı־
+     */
+    std::string ToString() const;
+};
+
+/**
+ * @brief 鶥㲼ܲιɫǩ
+ * @details ÿϵͳֵ붼ҪڲҵͬͬԪأҪһ£/뾫/һ㸡㣩
+ *          Ԫزһֳüɫ
+ */
+ShaderInputValidation ValidateInputLayout(const ShaderReflection& reflection, const VertexLayout& layout);
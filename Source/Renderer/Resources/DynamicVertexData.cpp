@@ -16,6 +16,7 @@ DynamicVertexData::DynamicVertexData()
 
 DynamicVertexData::DynamicVertexData(const VertexLayout& layout, size_t vertexCount)
     : m_layout(layout)
+    , m_layoutHandle(VertexLayoutRegistry::Intern(layout))
     , m_vertexCount(vertexCount)
 {
     if (m_layout.IsValid() && vertexCount > 0)
@@ -27,6 +28,7 @@ DynamicVertexData::DynamicVertexData(const VertexLayout& layout, size_t vertexCo
 
 DynamicVertexData::DynamicVertexData(const VertexLayout& layout, const void* data, size_t vertexCount)
     : m_layout(layout)
+    , m_layoutHandle(VertexLayoutRegistry::Intern(layout))
     , m_vertexCount(vertexCount)
 {
     if (m_layout.IsValid() && vertexCount > 0 && data)
@@ -40,6 +42,7 @@ DynamicVertexData::DynamicVertexData(const VertexLayout& layout, const void* dat
 template<typename VertexType>
 DynamicVertexData::DynamicVertexData(const VertexType* vertices, size_t count)
     : m_layout(VertexType::GetLayout())
+    , m_layoutHandle(VertexLayoutRegistry::Get<VertexType>())
     , m_vertexCount(count)
 {
     if (count > 0 && vertices)
@@ -52,9 +55,12 @@ DynamicVertexData::DynamicVertexData(const VertexType* vertices, size_t count)
 
 DynamicVertexData::DynamicVertexData(DynamicVertexData&& other) noexcept
     : m_layout(std::move(other.m_layout))
+    , m_layoutHandle(other.m_layoutHandle)
     , m_data(std::move(other.m_data))
     , m_vertexCount(other.m_vertexCount)
 {
+    // ߺԴ󲼾ΪգҲҪʧЧȻIsLayoutCompatibleΪԭĲ
+    other.m_layoutHandle = VertexLayoutHandle();
     other.m_vertexCount = 0;
 }
 
@@ -63,8 +69,10 @@ DynamicVertexData& DynamicVertexData::operator=(DynamicVertexData&& other) noexc
     if (this != &other)
     {
         m_layout = std::move(other.m_layout);
+        m_layoutHandle = other.m_layoutHandle;
         m_data = std::move(other.m_data);
         m_vertexCount = other.m_vertexCount;
+        other.m_layoutHandle = VertexLayoutHandle();
         other.m_vertexCount = 0;
     }
     return *this;
@@ -72,6 +80,7 @@ DynamicVertexData& DynamicVertexData::operator=(DynamicVertexData&& other) noexc
 
 DynamicVertexData::DynamicVertexData(const DynamicVertexData& other)
     : m_layout(other.m_layout)
+    , m_layoutHandle(other.m_layoutHandle)
     , m_data(other.m_data)
     , m_vertexCount(other.m_vertexCount)
 {
@@ -82,6 +91,7 @@ DynamicVertexData& DynamicVertexData::operator=(const DynamicVertexData& other)
     if (this != &other)
     {
         m_layout = other.m_layout;
+        m_layoutHandle = other.m_layoutHandle;
         m_data = other.m_data;
         m_vertexCount = other.m_vertexCount;
     }
@@ -96,6 +106,7 @@ DynamicVertexData& DynamicVertexData::operator=(const DynamicVertexData& other)
 void DynamicVertexData::Resize(const VertexLayout& layout, size_t vertexCount)
 {
     m_layout = layout;
+    m_layoutHandle = VertexLayoutRegistry::Intern(layout);
     m_vertexCount = vertexCount;
 
     if (m_layout.IsValid() && vertexCount > 0)
@@ -143,6 +154,7 @@ void DynamicVertexData::ShrinkToFit()
 void DynamicVertexData::Clear()
 {
     m_layout.Clear();
+    m_layoutHandle = VertexLayoutHandle();
     m_data.clear();
     m_vertexCount = 0;
 }
@@ -364,6 +376,237 @@ void DynamicVertexData::RemoveVertices(size_t startIndex, size_t count)
 }
 
 
+// =======================================================================
+//                        ༭
+// =======================================================================
+
+DynamicVertexData::EditSession DynamicVertexData::BeginEdit()
+{
+    return EditSession(*this);
+}
+
+DynamicVertexData::EditSession::EditSession(DynamicVertexData& target)
+    : m_target(&target)
+    , m_baseVertexCount(target.m_vertexCount)
+    , m_baseLayout(target.m_layoutHandle)
+{
+}
+
+void DynamicVertexData::EditSession::Insert(size_t index, const void* vertexData, size_t count)
+{
+    if (index > m_baseVertexCount)
+    {
+        throw std::out_of_range("Insert index out of range");
+    }
+
+    if (!m_target->m_layout.IsValid())
+    {
+        throw std::runtime_error("Cannot insert vertex: layout is invalid");
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    uint32_t stride = m_target->m_layout.GetStride();
+    size_t stagingStart = m_staging.size() / stride;
+
+    // vector::resize¼ҲǾ̯O(1)
+    m_staging.resize(m_staging.size() + count * stride);
+    uint8_t* dst = m_staging.data() + stagingStart * stride;
+    if (vertexData)
+    {
+        std::memcpy(dst, vertexData, count * stride);
+    }
+    else
+    {
+        std::memset(dst, 0, count * stride);
+    }
+
+    m_inserts.push_back({ index, stagingStart, count });
+    m_insertedCount += count;
+}
+
+void DynamicVertexData::EditSession::Append(const void* vertexData, size_t count)
+{
+    Insert(m_baseVertexCount, vertexData, count);
+}
+
+void DynamicVertexData::EditSession::Remove(size_t startIndex, size_t count)
+{
+    if (startIndex >= m_baseVertexCount || count > m_baseVertexCount - startIndex)
+    {
+        throw std::out_of_range("Remove range out of range");
+    }
+
+    if (count > 0)
+    {
+        m_removals.push_back({ startIndex, startIndex + count });
+    }
+}
+
+size_t DynamicVertexData::EditSession::GetResultVertexCount() const
+{
+    std::vector<PendingRemoval> removals = m_removals;
+    return m_baseVertexCount - NormalizeRemovals(removals) + m_insertedCount;
+}
+
+size_t DynamicVertexData::EditSession::NormalizeRemovals(std::vector<PendingRemoval>& removals)
+{
+    if (removals.empty())
+    {
+        return 0;
+    }
+
+    std::sort(removals.begin(), removals.end(),
+        [](const PendingRemoval& a, const PendingRemoval& b) { return a.Start < b.Start; });
+
+    size_t merged = 0;
+    for (size_t i = 1; i < removals.size(); ++i)
+    {
+        if (removals[i].Start <= removals[merged].End)
+        {
+            removals[merged].End = std::max(removals[merged].End, removals[i].End);
+        }
+        else
+        {
+            removals[++merged] = removals[i];
+        }
+    }
+    removals.resize(merged + 1);
+
+    size_t removedCount = 0;
+    for (const PendingRemoval& removal : removals)
+    {
+        removedCount += removal.End - removal.Start;
+    }
+    return removedCount;
+}
+
+void DynamicVertexData::EditSession::Commit()
+{
+    DynamicVertexData& target = *m_target;
+    if (target.m_vertexCount != m_baseVertexCount || target.m_layoutHandle != m_baseLayout)
+    {
+        throw std::logic_error("Vertex data was modified outside of the edit session");
+    }
+
+    if (!HasPendingChanges())
+    {
+        return;
+    }
+
+    // ͬһλõĲ뱣ֵ˳
+    std::stable_sort(m_inserts.begin(), m_inserts.end(),
+        [](const PendingInsert& a, const PendingInsert& b) { return a.Index < b.Index; });
+
+    const size_t removedCount = NormalizeRemovals(m_removals);
+    const size_t resultCount = m_baseVertexCount - removedCount + m_insertedCount;
+    const size_t stride = target.m_layout.GetStride();
+    const bool appendOnly = m_inserts.empty() || m_inserts.front().Index == m_baseVertexCount;
+
+    const uint8_t* staging = m_staging.data();
+
+    if (resultCount == 0)
+    {
+        // ȫɾֺ
+        target.m_data.clear();
+    }
+    else if (appendOnly)
+    {
+        // ֻɾ׷ӣԭǰѹٰ׷ӵĶӵĩβ
+        uint8_t* data = target.m_data.data();
+        size_t writeIndex = m_removals.empty() ? m_baseVertexCount : m_removals.front().Start;
+        for (size_t i = 0; i < m_removals.size(); ++i)
+        {
+            size_t keepStart = m_removals[i].End;
+            size_t keepEnd = (i + 1 < m_removals.size()) ? m_removals[i + 1].Start : m_baseVertexCount;
+            if (keepEnd > keepStart)
+            {
+                std::memmove(data + writeIndex * stride, data + keepStart * stride, (keepEnd - keepStart) * stride);
+                writeIndex += keepEnd - keepStart;
+            }
+        }
+
+        target.EnsureCapacity(resultCount);
+        target.m_data.resize(resultCount * stride);
+        for (const PendingInsert& insert : m_inserts)
+        {
+            std::memcpy(target.m_data.data() + writeIndex * stride,
+                staging + insert.StagingStart * stride, insert.Count * stride);
+            writeIndex += insert.Count;
+        }
+    }
+    else
+    {
+        // м룺һαд»ԭʼݺͲݰ˳򽻴
+        size_t capacity = resultCount > target.GetCapacity() ? target.ComputeGrowth(resultCount) : target.GetCapacity();
+        std::vector<uint8_t> result;
+        result.reserve(capacity * stride);
+        result.resize(resultCount * stride);
+
+        const uint8_t* src = target.m_data.data();
+        uint8_t* dst = result.data();
+        size_t removalIndex = 0;
+
+        // ԭʼ[from, to)δɾĲ
+        auto copyKept = [&](size_t from, size_t to)
+        {
+            while (from < to)
+            {
+                while (removalIndex < m_removals.size() && m_removals[removalIndex].End <= from)
+                {
+                    ++removalIndex;
+                }
+
+                if (removalIndex < m_removals.size() && m_removals[removalIndex].Start <= from)
+                {
+                    from = std::min(m_removals[removalIndex].End, to);
+                    continue;
+                }
+
+                size_t runEnd = to;
+                if (removalIndex < m_removals.size())
+                {
+                    runEnd = std::min(runEnd, m_removals[removalIndex].Start);
+                }
+
+                std::memcpy(dst, src + from * stride, (runEnd - from) * stride);
+                dst += (runEnd - from) * stride;
+                from = runEnd;
+            }
+        };
+
+        size_t cursor = 0;
+        for (const PendingInsert& insert : m_inserts)
+        {
+            copyKept(cursor, insert.Index);
+            cursor = insert.Index;
+
+            std::memcpy(dst, staging + insert.StagingStart * stride, insert.Count * stride);
+            dst += insert.Count * stride;
+        }
+        copyKept(cursor, m_baseVertexCount);
+
+        target.m_data.swap(result);
+    }
+
+    target.m_vertexCount = resultCount;
+
+    Discard();
+    m_baseVertexCount = resultCount;
+}
+
+void DynamicVertexData::EditSession::Discard()
+{
+    m_inserts.clear();
+    m_removals.clear();
+    m_staging.clear();
+    m_insertedCount = 0;
+}
+
+
 // =======================================================================
 //                        Էʣͨã
 // =======================================================================
@@ -373,21 +616,14 @@ void DynamicVertexData::SetVertexAttribute(size_t vertexIndex, const std::string
 {
     ValidateIndex(vertexIndex);
 
-    const VertexElement* element = FindElement(semanticName, semanticIndex);
-    if (!element)
+    VertexAttributeHandle handle = FindAttribute(semanticName, semanticIndex);
+    if (!handle.IsValid())
     {
         throw std::runtime_error("Vertex attribute not found: " + semanticName +
             "[" + std::to_string(semanticIndex) + "]");
     }
 
-    if (!data)
-    {
-        throw std::invalid_argument("data cannot be null");
-    }
-
-    void* attrPtr = GetAttributePtr(vertexIndex, *element);
-    uint32_t attrSize = GetVertexFormatSize(element->Format);
-    std::memcpy(attrPtr, data, attrSize);
+    SetVertexAttribute(vertexIndex, handle, data);
 }
 
 void DynamicVertexData::GetVertexAttribute(size_t vertexIndex, const std::string& semanticName,
@@ -395,21 +631,14 @@ void DynamicVertexData::GetVertexAttribute(size_t vertexIndex, const std::string
 {
     ValidateIndex(vertexIndex);
 
-    const VertexElement* element = FindElement(semanticName, semanticIndex);
-    if (!element)
+    VertexAttributeHandle handle = FindAttribute(semanticName, semanticIndex);
+    if (!handle.IsValid())
     {
         throw std::runtime_error("Vertex attribute not found: " + semanticName +
             "[" + std::to_string(semanticIndex) + "]");
     }
 
-    if (!outData)
-    {
-        throw std::invalid_argument("outData cannot be null");
-    }
-
-    const void* attrPtr = GetAttributePtr(vertexIndex, *element);
-    uint32_t attrSize = GetVertexFormatSize(element->Format);
-    std::memcpy(outData, attrPtr, attrSize);
+    GetVertexAttribute(vertexIndex, handle, outData);
 }
 
 template<typename T>
@@ -427,6 +656,61 @@ T DynamicVertexData::GetAttribute(size_t vertexIndex, const std::string& semanti
 }
 
 
+// =======================================================================
+//                        Ծͼ
+// =======================================================================
+
+VertexAttributeHandle DynamicVertexData::FindAttribute(const std::string& semanticName, uint32_t semanticIndex) const
+{
+    VertexAttributeHandle handle;
+
+    const VertexElement* element = FindElement(semanticName, semanticIndex);
+    if (element)
+    {
+        handle.Offset = element->Offset;
+        handle.Size = GetVertexFormatSize(element->Format);
+        handle.Format = element->Format;
+    }
+    return handle;
+}
+
+void DynamicVertexData::SetVertexAttribute(size_t vertexIndex, const VertexAttributeHandle& handle, const void* data)
+{
+    ValidateIndex(vertexIndex);
+
+    if (!handle.IsValid())
+    {
+        throw std::invalid_argument("Invalid vertex attribute handle");
+    }
+
+    if (!data)
+    {
+        throw std::invalid_argument("data cannot be null");
+    }
+
+    uint8_t* attrPtr = m_data.data() + (vertexIndex * m_layout.GetStride()) + handle.Offset;
+    std::memcpy(attrPtr, data, handle.Size);
+}
+
+void DynamicVertexData::GetVertexAttribute(size_t vertexIndex, const VertexAttributeHandle& handle, void* outData) const
+{
+    ValidateIndex(vertexIndex);
+
+    if (!handle.IsValid())
+    {
+        throw std::invalid_argument("Invalid vertex attribute handle");
+    }
+
+    if (!outData)
+    {
+        throw std::invalid_argument("outData cannot be null");
+    }
+
+    const uint8_t* attrPtr = m_data.data() + (vertexIndex * m_layout.GetStride()) + handle.Offset;
+    std::memcpy(outData, attrPtr, handle.Size);
+}
+
+
 // =======================================================================
 //                        Է
 // =======================================================================
@@ -531,7 +815,7 @@ void DynamicVertexData::SetDataRange(size_t startVertex, size_t count, const voi
 void DynamicVertexData::CopyFrom(const DynamicVertexData& other, size_t srcStart,
     size_t dstStart, size_t count)
 {
-    if (!IsLayoutCompatible(other.m_layout))
+    if (!IsLayoutCompatible(other.m_layoutHandle))
     {
         throw std::runtime_error("Layouts are not compatible");
     }
@@ -572,8 +856,7 @@ std::vector<VertexType> DynamicVertexData::ToVertexArray() const
     }
 
     // 鲼Ƿƥ
-    VertexLayout vertexLayout = VertexType::GetLayout();
-    if (m_layout != vertexLayout)
+    if (m_layoutHandle != VertexLayoutRegistry::Get<VertexType>())
     {
         throw std::runtime_error("Layout mismatch: cannot convert to VertexType");
     }
@@ -622,6 +905,31 @@ const void* DynamicVertexData::GetAttributePtr(size_t vertexIndex, const VertexE
     return vertexPtr + element.Offset;
 }
 
+VertexAttributeHandle DynamicVertexData::ResolveAttribute(const std::string& semanticName, uint32_t semanticIndex,
+    size_t expectedSize) const
+{
+    VertexAttributeHandle handle = FindAttribute(semanticName, semanticIndex);
+    if (!handle.IsValid())
+    {
+        throw std::runtime_error("Vertex attribute not found: " + semanticName +
+            "[" + std::to_string(semanticIndex) + "]");
+    }
+
+    if (handle.Size != expectedSize)
+    {
+        throw std::runtime_error("Vertex attribute size mismatch: " + semanticName +
+            "[" + std::to_string(semanticIndex) + "] is " + std::to_string(handle.Size) +
+            " bytes, view type is " + std::to_string(expectedSize) + " bytes");
+    }
+
+    return handle;
+}
+
+VertexDataView DynamicVertexData::GetView() const
+{
+    return VertexDataView(m_layout, m_data.data(), m_vertexCount);
+}
+
 void DynamicVertexData::ValidateIndex(size_t index) const
 {
     if (index >= m_vertexCount)
@@ -635,7 +943,68 @@ void DynamicVertexData::EnsureCapacity(size_t requiredCount)
 {
     if (requiredCount > GetCapacity())
     {
-        size_t newCapacity = std::max(requiredCount, GetCapacity() * 2);
-        Reserve(newCapacity);
+        Reserve(ComputeGrowth(requiredCount));
+    }
+}
+
+size_t DynamicVertexData::ComputeGrowth(size_t requiredCount) const
+{
+    // ׷ӵľ̯ΪO(1)
+    size_t capacity = GetCapacity();
+    return std::max({ requiredCount, capacity * 2, kMinGrowCount });
+}
+
+
+// =======================================================================
+//                        ֻͼ
+// =======================================================================
+
+VertexAttributeHandle VertexDataView::FindAttribute(const std::string& semanticName, uint32_t semanticIndex) const
+{
+    VertexAttributeHandle handle;
+    if (m_layout == nullptr)
+    {
+        return handle;
     }
-}
\ No newline at end of file
+
+    for (const VertexElement& element : m_layout->GetElements())
+    {
+        if (element.SemanticName == semanticName && element.SemanticIndex == semanticIndex)
+        {
+            handle.Offset = element.Offset;
+            handle.Size = GetVertexFormatSize(element.Format);
+            handle.Format = element.Format;
+            break;
+        }
+    }
+    return handle;
+}
+
+VertexAttributeHandle VertexDataView::ResolveAttribute(const std::string& semanticName, uint32_t semanticIndex,
+    size_t expectedSize) const
+{
+    VertexAttributeHandle handle = FindAttribute(semanticName, semanticIndex);
+    if (!handle.IsValid())
+    {
+        throw std::runtime_error("Vertex attribute not found: " + semanticName +
+            "[" + std::to_string(semanticIndex) + "]");
+    }
+
+    if (handle.Size != expectedSize)
+    {
+        throw std::runtime_error("Vertex attribute size mismatch: " + semanticName +
+            "[" + std::to_string(semanticIndex) + "] is " + std::to_string(handle.Size) +
+            " bytes, view type is " + std::to_string(expectedSize) + " bytes");
+    }
+
+    return handle;
+}
+
+DynamicVertexData VertexDataView::ToVertexData() const
+{
+    if (!IsValid())
+    {
+        return DynamicVertexData();
+    }
+    return DynamicVertexData(*m_layout, m_data, m_vertexCount);
+}
@@ -1,12 +1,97 @@
 // DynamicVertexData.h
 #pragma once
 #include "Renderer/Resources/VertexLayout.h"
+#include "Renderer/Resources/VertexLayoutRegistry.h"
 #include "Renderer/Resources/VertexFormat.h"
 #include <vector>
 #include <cstdint>
 #include <cstring>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+
+/**
+ * @brief Ծ
+ * @details (, )һεõƫƺ͸ʽ֮ʲҪԪ
+ */
+struct VertexAttributeHandle
+{
+    uint32_t Offset = 0;                           // ڶеƫ
+    uint32_t Size = 0;                             // ֽڴС
+    VertexFormat Format = VertexFormat::Unknown;   // Ըʽ
+
+    bool IsValid() const { return Size > 0; }
+};
+
+/**
+ * @brief ͼ - ̶ƫƺͲĳһ
+ * @details ʺڽѭдԣַҲڴ
+ * @note TΪconstʱΪֻͼ·Append/Insert/ResizeȣͼʧЧҪ»ȡ
+ */
+template<typename T>
+class AttributeView
+{
+    using ByteType = std::conditional_t<std::is_const_v<T>, const uint8_t, uint8_t>;
+    using ValueType = std::remove_const_t<T>;
+
+    static_assert(std::is_trivially_copyable_v<ValueType>, "AttributeView requires a trivially copyable type");
+
+public:
+    AttributeView() = default;
+
+    AttributeView(ByteType* base, uint32_t stride, size_t count)
+        : m_base(base)
+        , m_stride(stride)
+        , m_count(count)
+    {
+    }
+
+    /**
+     * @brief ͼǷЧ
+     */
+    bool IsValid() const { return m_base != nullptr; }
+
+    /**
+     * @brief ȡ
+     */
+    size_t GetCount() const { return m_count; }
+
+    /**
+     * @brief ȡֽڣ
+     */
+    uint32_t GetStride() const { return m_stride; }
+
+    /**
+     * @brief ȡԣ
+     */
+    ValueType Get(size_t index) const
+    {
+        ValueType value;
+        std::memcpy(&value, m_base + index * m_stride, sizeof(ValueType));
+        return value;
+    }
+
+    /**
+     * @brief дԣ
+     */
+    void Set(size_t index, const ValueType& value) const
+    {
+        static_assert(!std::is_const_v<T>, "Cannot write through a read-only AttributeView");
+        std::memcpy(m_base + index * m_stride, &value, sizeof(ValueType));
+    }
+
+    /**
+     * @brief ȡԵԭʼָֽ
+     */
+    ByteType* GetRawPtr(size_t index) const { return m_base + index * m_stride; }
+
+private:
+    ByteType* m_base = nullptr;
+    uint32_t m_stride = 0;
+    size_t m_count = 0;
+};
+
+class VertexDataView;
 
 /**
  * @brief ̬ݹ
@@ -130,11 +215,21 @@ public:
      */
     bool IsValidVertexIndex(size_t index) const { return index < m_vertexCount; }
 
+    /**
+     * @brief ȡפĲ־
+     */
+    VertexLayoutHandle GetLayoutHandle() const { return m_layoutHandle; }
+
     /**
      * @brief 鲼ǷݣԪͬ
      */
     bool IsLayoutCompatible(const VertexLayout& other) const;
 
+    /**
+     * @brief 鲼ǷݣȽפO(1)
+     */
+    bool IsLayoutCompatible(VertexLayoutHandle other) const { return m_layoutHandle == other; }
+
 
     // =======================================================================
     //                        ݷ
@@ -150,6 +245,11 @@ public:
      */
     void* GetData() { return m_data.data(); }
 
+    /**
+     * @brief ȡֻͼ·ʧЧ
+     */
+    VertexDataView GetView() const;
+
     /**
      * @brief ȡָָ루ֻ
      */
@@ -200,6 +300,16 @@ public:
      */
     void RemoveVertices(size_t startIndex, size_t count);
 
+    /**
+     * @brief ༭ỰEditSession
+     */
+    class EditSession;
+
+    /**
+     * @brief ʼ༭/ɾ/׷ȼ¼Commitʱһ
+     */
+    EditSession BeginEdit();
+
 
     // =======================================================================
     //                        Էʣͨã
@@ -230,6 +340,49 @@ public:
     T GetAttribute(size_t vertexIndex, const std::string& semanticName) const;
 
 
+    // =======================================================================
+    //                        Ծͼ
+    // =======================================================================
+
+    /**
+     * @brief ԾҲʱЧ
+     * @details ֲֻ֣ʱһֱ
+     */
+    VertexAttributeHandle FindAttribute(const std::string& semanticName, uint32_t semanticIndex = 0) const;
+
+    /**
+     * @brief ͨöض
+     */
+    void SetVertexAttribute(size_t vertexIndex, const VertexAttributeHandle& handle, const void* data);
+
+    /**
+     * @brief ͨȡض
+     */
+    void GetVertexAttribute(size_t vertexIndex, const VertexAttributeHandle& handle, void* outData) const;
+
+    /**
+     * @brief ȡͼд
+     * @details sizeof(T)ԸʽĴС׳쳣
+     */
+    template<typename T>
+    AttributeView<T> GetAttributeView(const std::string& semanticName, uint32_t semanticIndex = 0);
+
+    /**
+     * @brief ȡͼֻ
+     */
+    template<typename T>
+    AttributeView<const T> GetAttributeView(const std::string& semanticName, uint32_t semanticIndex = 0) const;
+
+    /**
+     * @brief ͨͻȡͼVertexComponents::Position
+     */
+    template<typename Component>
+    AttributeView<Component> GetAttributeView();
+
+    template<typename Component>
+    AttributeView<const Component> GetAttributeView() const;
+
+
     // =======================================================================
     //                        Է
     // =======================================================================
@@ -337,6 +490,12 @@ private:
      */
     const void* GetAttributePtr(size_t vertexIndex, const VertexElement& element) const;
 
+    /**
+     * @brief ԾҲСƥʱ׳쳣
+     */
+    VertexAttributeHandle ResolveAttribute(const std::string& semanticName, uint32_t semanticIndex,
+        size_t expectedSize) const;
+
     /**
      * @brief ֤׳쳣
      */
@@ -347,12 +506,209 @@ private:
      */
     void EnsureCapacity(size_t requiredCount);
 
+    /**
+     * @brief ԼkMinGrowCount㣩
+     */
+    size_t ComputeGrowth(size_t requiredCount) const;
+
+    static constexpr size_t kMinGrowCount = 64;
+
 
     // =======================================================================
     //                        Ա
     // =======================================================================
 
     VertexLayout m_layout;           // 㲼
+    VertexLayoutHandle m_layoutHandle;  // פĲ־m_layout£
     std::vector<uint8_t> m_data;     // ԭʼֽ
     size_t m_vertexCount = 0;        // ǰ
-};
\ No newline at end of file
+};
+
+/**
+ * @brief ݵ༭Ự
+ * @details ָỰʼʱԭʼţӰ죺
+ *          - Insert(i)뵽ԭʼi֮ǰiԭʼʱ׷ӣͬһλð˳
+ *          - Removeɾԭʼ㣬صķΧϲ
+ *          CommitʱһαΪO(n + k log k)InsertVertex/RemoveVertexO(n^2)
+ * @note Ựڼ䲻Ҫֱ޸ĿݣCommitʱ⵽򲼾ֱ仯׳쳣δύĻỰʱֱӶ
+ */
+class DynamicVertexData::EditSession
+{
+public:
+    explicit EditSession(DynamicVertexData& target);
+
+    EditSession(EditSession&& other) noexcept = default;
+    EditSession& operator=(EditSession&& other) noexcept = default;
+    EditSession(const EditSession&) = delete;
+    EditSession& operator=(const EditSession&) = delete;
+
+    /**
+     * @brief ԭʼindex֮ǰcount㣨vertexDataΪʱ0
+     */
+    void Insert(size_t index, const void* vertexData, size_t count = 1);
+
+    /**
+     * @brief ĩβ׷count
+     */
+    void Append(const void* vertexData, size_t count = 1);
+
+    /**
+     * @brief ɾԭʼstartIndexʼcount
+     */
+    void Remove(size_t startIndex, size_t count = 1);
+
+    /**
+     * @brief Ӧ޸ģ֮ỰΪգԼ¼µ޸
+     */
+    void Commit();
+
+    /**
+     * @brief δύ޸
+     */
+    void Discard();
+
+    /**
+     * @brief Ƿδύ޸
+     */
+    bool HasPendingChanges() const { return !m_inserts.empty() || !m_removals.empty(); }
+
+    /**
+     * @brief ȡύĶ
+     */
+    size_t GetResultVertexCount() const;
+
+private:
+    /**
+     * @brief һβ루ݴm_stagingУ
+     */
+    struct PendingInsert
+    {
+        size_t Index;           // ԭʼ
+        size_t StagingStart;    // ݴеʼ
+        size_t Count;
+    };
+
+    /**
+     * @brief ɾΧ[Start, End)
+     */
+    struct PendingRemoval
+    {
+        size_t Start;
+        size_t End;
+    };
+
+    /**
+     * @brief ɾΧ򲢺ϲص֣ɾĶ
+     */
+    static size_t NormalizeRemovals(std::vector<PendingRemoval>& removals);
+
+    DynamicVertexData* m_target = nullptr;
+    size_t m_baseVertexCount = 0;           // ỰʼʱĶ
+    VertexLayoutHandle m_baseLayout;        // ỰʼʱĲ
+    std::vector<PendingInsert> m_inserts;
+    std::vector<PendingRemoval> m_removals;
+    std::vector<uint8_t> m_staging;         // Ķ
+    size_t m_insertedCount = 0;
+};
+
+/**
+ * @brief ڴֻ
+ * @details ֺɱ𴦳УDynamicVertexDataڴӳļȣ
+ *          ϴVertexKernelsʱȿDynamicVertexData
+ * @note ֻͷźͼʧЧIsValid()ΪfalseʱܵGetLayout()
+ */
+class VertexDataView
+{
+public:
+    VertexDataView() = default;
+
+    VertexDataView(const VertexLayout& layout, const void* data, size_t vertexCount)
+        : m_layout(&layout)
+        , m_data(static_cast<const uint8_t*>(data))
+        , m_vertexCount(vertexCount)
+    {
+    }
+
+    bool IsValid() const { return m_layout != nullptr && m_layout->IsValid() && m_data != nullptr && m_vertexCount > 0; }
+    const VertexLayout& GetLayout() const { return *m_layout; }
+    const void* GetData() const { return m_data; }
+    size_t GetVertexCount() const { return m_vertexCount; }
+    uint32_t GetStride() const { return m_layout != nullptr ? m_layout->GetStride() : 0; }
+    size_t GetDataSize() const { return m_vertexCount * GetStride(); }
+
+    /**
+     * @brief ȡԭʼָ루
+     */
+    const void* GetVertexDataPtr(size_t index) const { return m_data + index * GetStride(); }
+
+    /**
+     * @brief ԾҲʱЧ
+     */
+    VertexAttributeHandle FindAttribute(const std::string& semanticName, uint32_t semanticIndex = 0) const;
+
+    /**
+     * @brief ȡͼԲڻСƥʱ׳쳣
+     */
+    template<typename T>
+    AttributeView<const T> GetAttributeView(const std::string& semanticName, uint32_t semanticIndex = 0) const;
+
+    /**
+     * @brief DynamicVertexData
+     */
+    DynamicVertexData ToVertexData() const;
+
+private:
+    VertexAttributeHandle ResolveAttribute(const std::string& semanticName, uint32_t semanticIndex,
+        size_t expectedSize) const;
+
+    const VertexLayout* m_layout = nullptr;
+    const uint8_t* m_data = nullptr;
+    size_t m_vertexCount = 0;
+};
+
+template<typename T>
+AttributeView<const T> VertexDataView::GetAttributeView(const std::string& semanticName, uint32_t semanticIndex) const
+{
+    VertexAttributeHandle handle = ResolveAttribute(semanticName, semanticIndex, sizeof(T));
+    return AttributeView<const T>(m_data + handle.Offset, GetStride(), m_vertexCount);
+}
+
+// =======================================================================
+//                        ͼģʵ֣
+// =======================================================================
+
+template<typename T>
+AttributeView<T> DynamicVertexData::GetAttributeView(const std::string& semanticName, uint32_t semanticIndex)
+{
+    VertexAttributeHandle handle = ResolveAttribute(semanticName, semanticIndex, sizeof(T));
+    return AttributeView<T>(m_data.data() + handle.Offset, m_layout.GetStride(), m_vertexCount);
+}
+
+template<typename T>
+AttributeView<const T> DynamicVertexData::GetAttributeView(const std::string& semanticName, uint32_t semanticIndex) const
+{
+    VertexAttributeHandle handle = ResolveAttribute(semanticName, semanticIndex, sizeof(T));
+    return AttributeView<const T>(m_data.data() + handle.Offset, m_layout.GetStride(), m_vertexCount);
+}
+
+template<typename Component>
+AttributeView<Component> DynamicVertexData::GetAttributeView()
+{
+    uint32_t semanticIndex = 0;
+    if constexpr (requires { Component::SemanticIndex; })
+    {
+        semanticIndex = Component::SemanticIndex;
+    }
+    return GetAttributeView<Component>(Component::SemanticName, semanticIndex);
+}
+
+template<typename Component>
+AttributeView<const Component> DynamicVertexData::GetAttributeView() const
+{
+    uint32_t semanticIndex = 0;
+    if constexpr (requires { Component::SemanticIndex; })
+    {
+        semanticIndex = Component::SemanticIndex;
+    }
+    return GetAttributeView<Component>(Component::SemanticName, semanticIndex);
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+// DynamicVertexStreams.cpp
+#include "Renderer/Resources/DynamicVertexStreams.h"
+#include "Renderer/Resources/VertexFormat.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // ̶СĿ粽ñmemcpyչͨload/store
+    template<uint32_t Size>
+    void CopyStridedFixed(uint8_t* dst, size_t dstStride, const uint8_t* src, size_t srcStride, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(dst, src, Size);
+            dst += dstStride;
+            src += srcStride;
+        }
+    }
+
+    void CopyStrided(uint8_t* dst, size_t dstStride, const uint8_t* src, size_t srcStride,
+        uint32_t size, size_t count)
+    {
+        switch (size)
+        {
+        case 4:  CopyStridedFixed<4>(dst, dstStride, src, srcStride, count); return;
+        case 8:  CopyStridedFixed<8>(dst, dstStride, src, srcStride, count); return;
+        case 12: CopyStridedFixed<12>(dst, dstStride, src, srcStride, count); return;
+        case 16: CopyStridedFixed<16>(dst, dstStride, src, srcStride, count); return;
+        default:
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::memcpy(dst, src, size);
+                dst += dstStride;
+                src += srcStride;
+            }
+            return;
+        }
+    }
+}
+
+// =======================================================================
+//                        ת
+// =======================================================================
+
+DynamicVertexStreams::DynamicVertexStreams()
+    : m_vertexCount(0)
+{
+}
+
+DynamicVertexStreams::DynamicVertexStreams(const DynamicVertexData& interleaved)
+{
+    FromInterleaved(interleaved);
+}
+
+void DynamicVertexStreams::FromInterleaved(const DynamicVertexData& interleaved)
+{
+    const VertexLayout& layout = interleaved.GetLayout();
+
+    m_layout = layout;
+    m_vertexCount = interleaved.GetVertexCount();
+    m_streams.resize(layout.GetElementCount());
+
+    const uint8_t* src = static_cast<const uint8_t*>(interleaved.GetData());
+    uint32_t stride = layout.GetStride();
+
+    for (uint32_t i = 0; i < layout.GetElementCount(); ++i)
+    {
+        Stream& stream = m_streams[i];
+        stream.Element = layout.GetElement(i);
+        stream.Size = GetVertexFormatSize(stream.Element.Format);
+        stream.Data.resize(stream.Size * m_vertexCount);
+
+        if (m_vertexCount > 0 && src)
+        {
+            CopyStrided(stream.Data.data(), stream.Size, src + stream.Element.Offset, stride,
+                stream.Size, m_vertexCount);
+        }
+    }
+}
+
+DynamicVertexData DynamicVertexStreams::ToInterleaved() const
+{
+    DynamicVertexData result;
+    ToInterleaved(result);
+    return result;
+}
+
+void DynamicVertexStreams::ToInterleaved(DynamicVertexData& outInterleaved) const
+{
+    outInterleaved.Resize(m_layout, m_vertexCount);
+    if (!outInterleaved.IsValid())
+    {
+        return;
+    }
+
+    uint8_t* dst = static_cast<uint8_t*>(outInterleaved.GetData());
+    uint32_t stride = m_layout.GetStride();
+
+    // ֽڲκ㱣֤ȷ
+    std::memset(dst, 0, outInterleaved.GetDataSize());
+
+    for (const Stream& stream : m_streams)
+    {
+        CopyStrided(dst + stream.Element.Offset, stride, stream.Data.data(), stream.Size,
+            stream.Size, m_vertexCount);
+    }
+}
+
+void DynamicVertexStreams::Clear()
+{
+    m_layout.Clear();
+    m_streams.clear();
+    m_vertexCount = 0;
+}
+
+
+// =======================================================================
+//                        ѯӿ
+// =======================================================================
+
+int32_t DynamicVertexStreams::FindStream(const std::string& semanticName, uint32_t semanticIndex) const
+{
+    for (size_t i = 0; i < m_streams.size(); ++i)
+    {
+        const VertexElement& element = m_streams[i].Element;
+        if (element.SemanticName == semanticName && element.SemanticIndex == semanticIndex)
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+const VertexElement& DynamicVertexStreams::GetStreamElement(uint32_t streamIndex) const
+{
+    ValidateStreamIndex(streamIndex);
+    return m_streams[streamIndex].Element;
+}
+
+uint32_t DynamicVertexStreams::GetStreamStride(uint32_t streamIndex) const
+{
+    ValidateStreamIndex(streamIndex);
+    return m_streams[streamIndex].Size;
+}
+
+
+// =======================================================================
+//                        ݷ
+// =======================================================================
+
+const void* DynamicVertexStreams::GetStreamData(uint32_t streamIndex) const
+{
+    ValidateStreamIndex(streamIndex);
+    return m_streams[streamIndex].Data.data();
+}
+
+void* DynamicVertexStreams::GetStreamData(uint32_t streamIndex)
+{
+    ValidateStreamIndex(streamIndex);
+    return m_streams[streamIndex].Data.data();
+}
+
+
+// =======================================================================
+//                        
+// =======================================================================
+
+const DynamicVertexStreams::Stream& DynamicVertexStreams::ResolveStream(const std::string& semanticName,
+    uint32_t semanticIndex, size_t expectedSize) const
+{
+    int32_t streamIndex = FindStream(semanticName, semanticIndex);
+    if (streamIndex < 0)
+    {
+        throw std::runtime_error("Vertex stream not found: " + semanticName +
+            "[" + std::to_string(semanticIndex) + "]");
+    }
+
+    const Stream& stream = m_streams[streamIndex];
+    if (stream.Size != expectedSize)
+    {
+        throw std::runtime_error("Vertex stream size mismatch: " + semanticName +
+            "[" + std::to_string(semanticIndex) + "] is " + std::to_string(stream.Size) +
+            " bytes, view type is " + std::to_string(expectedSize) + " bytes");
+    }
+
+    return stream;
+}
+
+void DynamicVertexStreams::ValidateStreamIndex(uint32_t streamIndex) const
+{
+    if (streamIndex >= m_streams.size())
+    {
+        throw std::out_of_range("Vertex stream index out of range: " + std::to_string(streamIndex) +
+            " (count: " + std::to_string(m_streams.size()) + ")");
+    }
+}
@@ -0,0 +1,196 @@
+// DynamicVertexStreams.h
+#pragma once
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/VertexLayout.h"
+#include <vector>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief ṹ飨SoAʽĶ
+ * @details ÿԪصһеֻPOSITION/NORMALȸԵ任
+ *          CPUƤ決ֻҪдӦ
+ * @note DynamicVertexDataĽֿתԪֽ֮ڲ棬תʱ
+ */
+class DynamicVertexStreams
+{
+public:
+    // =======================================================================
+    //                        ת
+    // =======================================================================
+
+    /**
+     * @brief ĬϹ죨ݣ
+     */
+    DynamicVertexStreams();
+
+    /**
+     * @brief ӽݹ
+     */
+    explicit DynamicVertexStreams(const DynamicVertexData& interleaved);
+
+    /**
+     * @brief ӽݲֳḲݣ
+     */
+    void FromInterleaved(const DynamicVertexData& interleaved);
+
+    /**
+     * @brief ϲΪ
+     */
+    DynamicVertexData ToInterleaved() const;
+
+    /**
+     * @brief ϲеĽݣڴ棩
+     */
+    void ToInterleaved(DynamicVertexData& outInterleaved) const;
+
+    /**
+     * @brief 
+     */
+    void Clear();
+
+
+    // =======================================================================
+    //                        ѯӿ
+    // =======================================================================
+
+    /**
+     * @brief ǷЧ
+     */
+    bool IsValid() const { return m_layout.IsValid() && m_vertexCount > 0; }
+
+    /**
+     * @brief ȡ
+     */
+    size_t GetVertexCount() const { return m_vertexCount; }
+
+    /**
+     * @brief ȡӦĽֻ֣
+     */
+    const VertexLayout& GetLayout() const { return m_layout; }
+
+    /**
+     * @brief ȡڲеԪ
+     */
+    uint32_t GetStreamCount() const { return static_cast<uint32_t>(m_streams.size()); }
+
+    /**
+     * @brief ԶӦҲ-1
+     */
+    int32_t FindStream(const std::string& semanticName, uint32_t semanticIndex = 0) const;
+
+    /**
+     * @brief ȡӦĶԪ
+     */
+    const VertexElement& GetStreamElement(uint32_t streamIndex) const;
+
+    /**
+     * @brief ȡĲԴСֽڣ
+     */
+    uint32_t GetStreamStride(uint32_t streamIndex) const;
+
+
+    // =======================================================================
+    //                        ݷ
+    // =======================================================================
+
+    /**
+     * @brief ȡԭʼָ루ֻ
+     */
+    const void* GetStreamData(uint32_t streamIndex) const;
+
+    /**
+     * @brief ȡԭʼָ루д
+     */
+    void* GetStreamData(uint32_t streamIndex);
+
+    /**
+     * @brief ȡͼд
+     * @details sizeof(T)ԸʽĴС׳쳣
+     */
+    template<typename T>
+    AttributeView<T> GetStreamView(const std::string& semanticName, uint32_t semanticIndex = 0);
+
+    /**
+     * @brief ȡͼֻ
+     */
+    template<typename T>
+    AttributeView<const T> GetStreamView(const std::string& semanticName, uint32_t semanticIndex = 0) const;
+
+    /**
+     * @brief ͨͻȡͼVertexComponents::Position
+     */
+    template<typename Component>
+    AttributeView<Component> GetStreamView();
+
+    template<typename Component>
+    AttributeView<const Component> GetStreamView() const;
+
+private:
+    /**
+     * @brief 
+     */
+    struct Stream
+    {
+        VertexElement Element;          // ӦĽԪ
+        uint32_t Size = 0;              // ԴСҲĲ
+        std::vector<uint8_t> Data;      // е
+    };
+
+    /**
+     * @brief ҲСƥʱ׳쳣
+     */
+    const Stream& ResolveStream(const std::string& semanticName, uint32_t semanticIndex,
+        size_t expectedSize) const;
+
+    /**
+     * @brief ֤׳쳣
+     */
+    void ValidateStreamIndex(uint32_t streamIndex) const;
+
+
+    VertexLayout m_layout;              // ӦĽ
+    std::vector<Stream> m_streams;      // ÿԪһ
+    size_t m_vertexCount = 0;           // 
+};
+
+
+// =======================================================================
+//                        ͼģʵ֣
+// =======================================================================
+
+template<typename T>
+AttributeView<T> DynamicVertexStreams::GetStreamView(const std::string& semanticName, uint32_t semanticIndex)
+{
+    Stream& stream = const_cast<Stream&>(ResolveStream(semanticName, semanticIndex, sizeof(T)));
+    return AttributeView<T>(stream.Data.data(), stream.Size, m_vertexCount);
+}
+
+template<typename T>
+AttributeView<const T> DynamicVertexStreams::GetStreamView(const std::string& semanticName, uint32_t semanticIndex) const
+{
+    const Stream& stream = ResolveStream(semanticName, semanticIndex, sizeof(T));
+    return AttributeView<const T>(stream.Data.data(), stream.Size, m_vertexCount);
+}
+
+template<typename Component>
+AttributeView<Component> DynamicVertexStreams::GetStreamView()
+{
+    uint32_t semanticIndex = 0;
+    if constexpr (requires { Component::SemanticIndex; })
+    {
+        semanticIndex = Component::SemanticIndex;
+    }
+    return GetStreamView<Component>(Component::SemanticName, semanticIndex);
+}
+
+template<typename Component>
+AttributeView<const Component> DynamicVertexStreams::GetStreamView() const
+{
+    uint32_t semanticIndex = 0;
+    if constexpr (requires { Component::SemanticIndex; })
+    {
+        semanticIndex = Component::SemanticIndex;
+    }
+    return GetStreamView<Component>(Component::SemanticName, semanticIndex);
+}
@@ -0,0 +1,22 @@
+// MeshAdjacency.cpp
+#include "Renderer/Resources/MeshAdjacency.h"
+#include <numeric>
+
+TriangleAdjacency TriangleAdjacency::Build(const uint32_t* indices, size_t triangleCount, size_t vertexCount)
+{
+    TriangleAdjacency adjacency;
+    adjacency.Offsets.assign(vertexCount + 1, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        ++adjacency.Offsets[indices[i] + 1];
+    }
+    std::partial_sum(adjacency.Offsets.begin(), adjacency.Offsets.end(), adjacency.Offsets.begin());
+
+    std::vector<uint32_t> cursor(adjacency.Offsets.begin(), adjacency.Offsets.end() - 1);
+    adjacency.Triangles.resize(triangleCount * 3);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        adjacency.Triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+    return adjacency;
+}
@@ -0,0 +1,21 @@
+// MeshAdjacency.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief  -> ΣCSRţ
+ * @details vTriangles[Offsets[v], Offsets[v + 1])ظֵĶ㣨˻ΣΡ
+ *          MeshOptimizerTipsifyMeshletBuilderΣһ
+ */
+struct TriangleAdjacency
+{
+    std::vector<uint32_t> Offsets;      // vertexCount + 1
+    std::vector<uint32_t> Triangles;
+
+    /**
+     * @note Χ÷Ҫ֤
+     */
+    static TriangleAdjacency Build(const uint32_t* indices, size_t triangleCount, size_t vertexCount);
+};
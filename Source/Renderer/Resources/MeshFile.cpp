@@ -0,0 +1,908 @@
+// MeshFile.cpp
+#include "Renderer/Resources/MeshFile.h"
+#include "Core/Compression.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+namespace
+{
+    // D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT
+    constexpr uint32_t kMaxVertexStreams = 32;
+
+    enum class SectionType : uint32_t
+    {
+        Layout = 1,         // һVertexLayoutIndexΪţ
+        VertexStream = 2,   // һĽ
+        Indices = 3,
+        Submeshes = 4,
+        // ѡmeshletɴû汾
+        Meshlets = 5,
+        MeshletBounds = 6,
+        MeshletVertices = 7,
+        MeshletTriangles = 8,
+    };
+
+    enum class SectionCompression : uint32_t
+    {
+        None = 0,
+        ShuffleLZ = 1,      // ShuffleStrideֽںLZѹ
+    };
+
+    /**
+     * @brief ļͷ̸ʽֻں׷ֶβ汾
+     */
+    struct FileHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t HeaderSize;        // sizeof(FileHeader)αں
+        uint32_t SectionCount;
+        uint64_t FileSize;          // ֽضϵļ
+        uint64_t VertexCount;
+        uint64_t IndexCount;
+        uint32_t IndexFormat;       // MeshIndexFormat
+        uint32_t StreamCount;
+        uint32_t SubmeshCount;
+        uint32_t Reserved;
+        float BoundsMin[3];
+        float BoundsMax[3];
+    };
+    static_assert(sizeof(FileHeader) == 80, "MeshFile header layout changed");
+
+    struct SectionEntry
+    {
+        uint32_t Type;              // SectionType
+        uint32_t Index;             // ţΪ0
+        uint32_t Compression;       // SectionCompression
+        uint32_t ShuffleStride;
+        uint64_t Offset;            // ļͷkSectionAlignment
+        uint64_t StoredSize;
+        uint64_t RawSize;
+    };
+    static_assert(sizeof(SectionEntry) == 40, "MeshFile section entry layout changed");
+
+    struct SubmeshRecord
+    {
+        uint32_t IndexStart;
+        uint32_t IndexCount;
+        int32_t BaseVertex;
+        uint32_t MaterialIndex;
+        float BoundsMin[3];
+        float BoundsMax[3];
+    };
+    static_assert(sizeof(SubmeshRecord) == 40, "MeshFile submesh record layout changed");
+
+    VertexKernels::BoundingBox EmptyBounds()
+    {
+        return { { 1.0f, 1.0f, 1.0f }, { -1.0f, -1.0f, -1.0f } };
+    }
+
+    size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // =======================================================================
+    //                        л
+    // =======================================================================
+
+    void AppendU32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    bool ReadU32(const uint8_t*& p, const uint8_t* end, uint32_t& outValue)
+    {
+        if (end - p < 4)
+        {
+            return false;
+        }
+        outValue = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            outValue |= static_cast<uint32_t>(p[i]) << (i * 8);
+        }
+        p += 4;
+        return true;
+    }
+
+    /**
+     * @brief ԪȻÿԪأ+ַʽƫơ
+     */
+    std::vector<uint8_t> SerializeLayout(const VertexLayout& layout)
+    {
+        std::vector<uint8_t> out;
+        AppendU32(out, layout.GetStride());
+        AppendU32(out, layout.GetElementCount());
+        for (const VertexElement& element : layout.GetElements())
+        {
+            AppendU32(out, static_cast<uint32_t>(element.SemanticName.size()));
+            out.insert(out.end(), element.SemanticName.begin(), element.SemanticName.end());
+            AppendU32(out, element.SemanticIndex);
+            AppendU32(out, static_cast<uint32_t>(element.Format));
+            AppendU32(out, element.Offset);
+            AppendU32(out, element.Slot);
+        }
+        return out;
+    }
+
+    bool DeserializeLayout(const uint8_t* data, size_t size, VertexLayout& outLayout)
+    {
+        const uint8_t* p = data;
+        const uint8_t* end = data + size;
+        uint32_t stride = 0;
+        uint32_t elementCount = 0;
+        if (!ReadU32(p, end, stride) || !ReadU32(p, end, elementCount) || stride == 0 || elementCount == 0)
+        {
+            return false;
+        }
+
+        VertexLayout layout;
+        for (uint32_t i = 0; i < elementCount; ++i)
+        {
+            uint32_t nameLength = 0;
+            if (!ReadU32(p, end, nameLength) || static_cast<size_t>(end - p) < nameLength)
+            {
+                return false;
+            }
+            std::string name(reinterpret_cast<const char*>(p), nameLength);
+            p += nameLength;
+
+            uint32_t semanticIndex = 0;
+            uint32_t format = 0;
+            uint32_t offset = 0;
+            uint32_t slot = 0;
+            if (!ReadU32(p, end, semanticIndex) || !ReadU32(p, end, format) || !ReadU32(p, end, offset) || !ReadU32(p, end, slot))
+            {
+                return false;
+            }
+            const uint32_t formatSize = format <= 0xFF ? GetVertexFormatSize(static_cast<VertexFormat>(format)) : 0;
+            if (name.empty() || formatSize == 0 || offset > stride || stride - offset < formatSize)
+            {
+                return false;
+            }
+            layout.AddElement(name, static_cast<VertexFormat>(format), offset, semanticIndex, slot);
+        }
+        layout.SetStride(stride);
+        outLayout = std::move(layout);
+        return p == end;
+    }
+
+    // =======================================================================
+    //                        д
+    // =======================================================================
+
+    /**
+     * @brief дĶΣDataָ÷ݻStorage
+     */
+    struct PendingSection
+    {
+        SectionEntry Entry = {};
+        const uint8_t* Data = nullptr;
+        std::vector<uint8_t> Storage;
+    };
+
+    void AddSection(std::vector<PendingSection>& sections, SectionType type, uint32_t index,
+        const void* data, size_t size, uint32_t shuffleStride, bool compress, double minGain)
+    {
+        PendingSection section;
+        section.Entry.Type = static_cast<uint32_t>(type);
+        section.Entry.Index = index;
+        section.Entry.Compression = static_cast<uint32_t>(SectionCompression::None);
+        section.Entry.RawSize = size;
+        section.Entry.StoredSize = size;
+        section.Data = static_cast<const uint8_t*>(data);
+
+        if (compress && size > 0)
+        {
+            std::vector<uint8_t> shuffled(size);
+            Compression::ShuffleBytes(data, size, shuffleStride, shuffled.data());
+
+            std::vector<uint8_t> compressed(Compression::GetMaxCompressedSize(size));
+            size_t compressedSize = Compression::CompressLZ(shuffled.data(), size, compressed.data(), compressed.size());
+            if (compressedSize != 0 && static_cast<double>(compressedSize) <= static_cast<double>(size) * (1.0 - minGain))
+            {
+                compressed.resize(compressedSize);
+                section.Storage = std::move(compressed);
+                section.Data = section.Storage.data();
+                section.Entry.Compression = static_cast<uint32_t>(SectionCompression::ShuffleLZ);
+                section.Entry.ShuffleStride = shuffleStride;
+                section.Entry.StoredSize = compressedSize;
+            }
+        }
+        sections.push_back(std::move(section));
+    }
+
+    void AddOwnedSection(std::vector<PendingSection>& sections, SectionType type, uint32_t index, std::vector<uint8_t> data)
+    {
+        PendingSection section;
+        section.Entry.Type = static_cast<uint32_t>(type);
+        section.Entry.Index = index;
+        section.Entry.Compression = static_cast<uint32_t>(SectionCompression::None);
+        section.Entry.RawSize = data.size();
+        section.Entry.StoredSize = data.size();
+        section.Storage = std::move(data);
+        section.Data = section.Storage.data();
+        sections.push_back(std::move(section));
+    }
+
+    /**
+     * @brief Float3POSITIONҲ-1
+     */
+    int32_t FindPositionStream(const std::vector<VertexDataView>& streams, uint32_t& outOffset)
+    {
+        for (size_t i = 0; i < streams.size(); ++i)
+        {
+            VertexAttributeHandle handle = streams[i].FindAttribute("POSITION", 0);
+            if (handle.IsValid() && handle.Format == VertexFormat::Float3)
+            {
+                outOffset = handle.Offset;
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    void GrowBounds(VertexKernels::BoundingBox& bounds, const float position[3])
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            bounds.Min[axis] = std::min(bounds.Min[axis], position[axis]);
+            bounds.Max[axis] = std::max(bounds.Max[axis], position[axis]);
+        }
+    }
+
+    /**
+     * @brief meshletķΧͶţдͼʱҪ
+     * @return ʱԭûⷵؿַ
+     */
+    std::string ValidateMeshlets(const MeshletDataView& meshlets, size_t vertexCount)
+    {
+        for (size_t i = 0; i < meshlets.MeshletCount; ++i)
+        {
+            const Meshlet& meshlet = meshlets.Meshlets[i];
+            if (meshlet.VertexCount > 256 ||
+                static_cast<uint64_t>(meshlet.VertexOffset) + meshlet.VertexCount > meshlets.VertexIndexCount ||
+                static_cast<uint64_t>(meshlet.TriangleOffset) + static_cast<uint64_t>(meshlet.TriangleCount) * 3 > meshlets.TriangleIndexCount)
+            {
+                return "meshlet " + std::to_string(i) + " is outside the meshlet index buffers";
+            }
+            for (uint32_t v = 0; v < meshlet.VertexCount; ++v)
+            {
+                if (meshlets.VertexIndices[meshlet.VertexOffset + v] >= vertexCount)
+                {
+                    return "meshlet " + std::to_string(i) + " references a vertex out of range";
+                }
+            }
+            for (uint32_t t = 0; t < meshlet.TriangleCount * 3; ++t)
+            {
+                if (meshlets.TriangleIndices[meshlet.TriangleOffset + t] >= meshlet.VertexCount)
+                {
+                    return "meshlet " + std::to_string(i) + " has a triangle index out of range";
+                }
+            }
+        }
+        return std::string();
+    }
+
+    std::atomic<uint32_t> g_tempCounter = 0;
+}
+
+
+// =======================================================================
+//                        д
+// =======================================================================
+
+std::vector<uint8_t> MeshFile::Serialize(const MeshFileSource& source, const MeshWriteOptions& options)
+{
+    if (source.VertexStreams.empty() || source.VertexStreams.size() > kMaxVertexStreams)
+    {
+        throw std::invalid_argument("MeshFile: mesh needs 1 to 32 vertex streams");
+    }
+    const size_t vertexCount = source.VertexStreams[0].GetVertexCount();
+    for (const VertexDataView& stream : source.VertexStreams)
+    {
+        if (!stream.IsValid())
+        {
+            throw std::invalid_argument("MeshFile: vertex stream is empty or has an invalid layout");
+        }
+        if (stream.GetVertexCount() != vertexCount)
+        {
+            throw std::invalid_argument("MeshFile: all vertex streams must have the same vertex count");
+        }
+    }
+    if (source.IndexCount > 0 && source.Indices == nullptr)
+    {
+        throw std::invalid_argument("MeshFile: index count is set but indices are null");
+    }
+    if (source.IndexCount > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::invalid_argument("MeshFile: too many indices");
+    }
+    const MeshletDataView& meshlets = source.Meshlets;
+    if (!meshlets.IsEmpty())
+    {
+        if (meshlets.Meshlets == nullptr || meshlets.Bounds == nullptr ||
+            (meshlets.VertexIndexCount > 0 && meshlets.VertexIndices == nullptr) ||
+            (meshlets.TriangleIndexCount > 0 && meshlets.TriangleIndices == nullptr))
+        {
+            throw std::invalid_argument("MeshFile: meshlet counts are set but the data is null");
+        }
+        const std::string error = ValidateMeshlets(meshlets, vertexCount);
+        if (!error.empty())
+        {
+            throw std::invalid_argument("MeshFile: " + error);
+        }
+    }
+
+    // ûʱ壨ȫ㣩һ
+    std::vector<MeshSubmesh> submeshes = source.Submeshes;
+    if (submeshes.empty())
+    {
+        MeshSubmesh whole;
+        whole.IndexCount = static_cast<uint32_t>(source.IndexCount);
+        submeshes.push_back(whole);
+    }
+
+    for (const MeshSubmesh& submesh : submeshes)
+    {
+        if (static_cast<size_t>(submesh.IndexStart) + submesh.IndexCount > source.IndexCount)
+        {
+            throw std::invalid_argument("MeshFile: submesh index range is outside the index buffer");
+        }
+        for (uint32_t i = 0; i < submesh.IndexCount; ++i)
+        {
+            const uint32_t index = source.Indices[submesh.IndexStart + i];
+            const int64_t vertex = static_cast<int64_t>(index) + submesh.BaseVertex;
+            if (vertex < 0 || static_cast<size_t>(vertex) >= vertexCount)
+            {
+                throw std::invalid_argument("MeshFile: index " + std::to_string(index) + " is out of range (" +
+                    std::to_string(vertexCount) + " vertices)");
+            }
+        }
+    }
+
+    // 16λҪ壬õҲдļ
+    uint32_t maxIndex = 0;
+    for (size_t i = 0; i < source.IndexCount; ++i)
+    {
+        maxIndex = std::max(maxIndex, source.Indices[i]);
+    }
+
+    // Χ
+    VertexKernels::BoundingBox bounds = EmptyBounds();
+    uint32_t positionOffset = 0;
+    const int32_t positionStream = FindPositionStream(source.VertexStreams, positionOffset);
+    if (positionStream >= 0)
+    {
+        const VertexDataView& stream = source.VertexStreams[positionStream];
+        const uint8_t* positions = static_cast<const uint8_t*>(stream.GetData()) + positionOffset;
+        bounds = VertexKernels::ComputeBounds(positions, stream.GetStride(), vertexCount);
+        for (MeshSubmesh& submesh : submeshes)
+        {
+            submesh.Bounds = EmptyBounds();
+            for (uint32_t i = 0; i < submesh.IndexCount; ++i)
+            {
+                const size_t vertex = static_cast<size_t>(static_cast<int64_t>(source.Indices[submesh.IndexStart + i]) + submesh.BaseVertex);
+                float position[3];
+                std::memcpy(position, positions + vertex * stream.GetStride(), sizeof(position));
+                GrowBounds(submesh.Bounds, position);
+            }
+        }
+    }
+    else
+    {
+        for (MeshSubmesh& submesh : submeshes)
+        {
+            submesh.Bounds = EmptyBounds();
+        }
+    }
+
+    // 
+    std::vector<PendingSection> sections;
+    for (uint32_t i = 0; i < source.VertexStreams.size(); ++i)
+    {
+        const VertexDataView& stream = source.VertexStreams[i];
+        AddOwnedSection(sections, SectionType::Layout, i, SerializeLayout(stream.GetLayout()));
+        AddSection(sections, SectionType::VertexStream, i, stream.GetData(), stream.GetDataSize(),
+            stream.GetStride(), options.CompressVertices, options.MinCompressionGain);
+    }
+
+    MeshIndexFormat indexFormat = MeshIndexFormat::None;
+    if (source.IndexCount > 0)
+    {
+        indexFormat = options.AllowIndex16 && maxIndex <= 0xFFFFu ? MeshIndexFormat::UInt16 : MeshIndexFormat::UInt32;
+        if (indexFormat == MeshIndexFormat::UInt16)
+        {
+            std::vector<uint8_t> narrow(source.IndexCount * sizeof(uint16_t));
+            for (size_t i = 0; i < source.IndexCount; ++i)
+            {
+                const uint16_t index = static_cast<uint16_t>(source.Indices[i]);
+                std::memcpy(narrow.data() + i * sizeof(uint16_t), &index, sizeof(uint16_t));
+            }
+            AddSection(sections, SectionType::Indices, 0, narrow.data(), narrow.size(), sizeof(uint16_t),
+                options.CompressIndices, options.MinCompressionGain);
+            if (sections.back().Storage.empty())
+            {
+                sections.back().Storage = std::move(narrow);
+                sections.back().Data = sections.back().Storage.data();
+            }
+        }
+        else
+        {
+            AddSection(sections, SectionType::Indices, 0, source.Indices, source.IndexCount * sizeof(uint32_t),
+                sizeof(uint32_t), options.CompressIndices, options.MinCompressionGain);
+        }
+    }
+
+    std::vector<uint8_t> submeshData(submeshes.size() * sizeof(SubmeshRecord));
+    for (size_t i = 0; i < submeshes.size(); ++i)
+    {
+        const MeshSubmesh& submesh = submeshes[i];
+        SubmeshRecord record = {};
+        record.IndexStart = submesh.IndexStart;
+        record.IndexCount = submesh.IndexCount;
+        record.BaseVertex = submesh.BaseVertex;
+        record.MaterialIndex = submesh.MaterialIndex;
+        std::memcpy(record.BoundsMin, submesh.Bounds.Min, sizeof(record.BoundsMin));
+        std::memcpy(record.BoundsMax, submesh.Bounds.Max, sizeof(record.BoundsMax));
+        std::memcpy(submeshData.data() + i * sizeof(SubmeshRecord), &record, sizeof(record));
+    }
+    AddOwnedSection(sections, SectionType::Submeshes, 0, std::move(submeshData));
+
+    if (!meshlets.IsEmpty())
+    {
+        AddSection(sections, SectionType::Meshlets, 0, meshlets.Meshlets, meshlets.MeshletCount * sizeof(Meshlet),
+            sizeof(Meshlet), false, options.MinCompressionGain);
+        AddSection(sections, SectionType::MeshletBounds, 0, meshlets.Bounds, meshlets.MeshletCount * sizeof(MeshletBounds),
+            sizeof(MeshletBounds), false, options.MinCompressionGain);
+        AddSection(sections, SectionType::MeshletVertices, 0, meshlets.VertexIndices, meshlets.VertexIndexCount * sizeof(uint32_t),
+            sizeof(uint32_t), options.CompressIndices, options.MinCompressionGain);
+        AddSection(sections, SectionType::MeshletTriangles, 0, meshlets.TriangleIndices, meshlets.TriangleIndexCount,
+            1, options.CompressIndices, options.MinCompressionGain);
+    }
+
+    // Ųͷαĸ
+    size_t offset = AlignUp(sizeof(FileHeader) + sections.size() * sizeof(SectionEntry), kSectionAlignment);
+    for (PendingSection& section : sections)
+    {
+        section.Entry.Offset = offset;
+        offset = AlignUp(offset + section.Entry.StoredSize, kSectionAlignment);
+    }
+    const size_t fileSize = offset;
+
+    FileHeader header = {};
+    header.Magic = kMagic;
+    header.Version = kVersion;
+    header.HeaderSize = sizeof(FileHeader);
+    header.SectionCount = static_cast<uint32_t>(sections.size());
+    header.FileSize = fileSize;
+    header.VertexCount = vertexCount;
+    header.IndexCount = source.IndexCount;
+    header.IndexFormat = static_cast<uint32_t>(indexFormat);
+    header.StreamCount = static_cast<uint32_t>(source.VertexStreams.size());
+    header.SubmeshCount = static_cast<uint32_t>(submeshes.size());
+    std::memcpy(header.BoundsMin, bounds.Min, sizeof(header.BoundsMin));
+    std::memcpy(header.BoundsMax, bounds.Max, sizeof(header.BoundsMax));
+
+    std::vector<uint8_t> out(fileSize, 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        const PendingSection& section = sections[i];
+        std::memcpy(out.data() + sizeof(FileHeader) + i * sizeof(SectionEntry), &section.Entry, sizeof(SectionEntry));
+        if (section.Entry.StoredSize > 0)
+        {
+            std::memcpy(out.data() + section.Entry.Offset, section.Data, section.Entry.StoredSize);
+        }
+    }
+    return out;
+}
+
+
+bool MeshFile::Write(const std::filesystem::path& path, const MeshFileSource& source,
+    const MeshWriteOptions& options, std::string* outError)
+{
+    std::vector<uint8_t> data;
+    try
+    {
+        data = Serialize(source, options);
+    }
+    catch (const std::exception& exception)
+    {
+        if (outError)
+        {
+            *outError = exception.what();
+        }
+        return false;
+    }
+
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp" + std::to_string(g_tempCounter.fetch_add(1));
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file.good())
+        {
+            file.close();
+            std::error_code error;
+            std::filesystem::remove(tempPath, error);
+            if (outError)
+            {
+                *outError = "Cannot write mesh file: " + tempPath.string();
+            }
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(tempPath, error);
+        if (outError)
+        {
+            *outError = "Cannot replace mesh file: " + path.string();
+        }
+        return false;
+    }
+    return true;
+}
+
+
+// =======================================================================
+//                        ȡ
+// =======================================================================
+
+bool MeshFile::Open(const std::filesystem::path& path, std::string* outError)
+{
+    Close();
+
+    std::string error;
+    if (!m_file.Open(path))
+    {
+        error = "Cannot open mesh file: " + path.string();
+    }
+    else if (Parse(m_file.GetData(), m_file.GetSize(), error))
+    {
+        m_open = true;
+        return true;
+    }
+
+    Close();
+    if (outError)
+    {
+        *outError = error;
+    }
+    return false;
+}
+
+
+bool MeshFile::OpenMemory(const void* data, size_t size, std::string* outError)
+{
+    Close();
+
+    std::string error;
+    if (Parse(static_cast<const uint8_t*>(data), size, error))
+    {
+        m_open = true;
+        return true;
+    }
+
+    Close();
+    if (outError)
+    {
+        *outError = error;
+    }
+    return false;
+}
+
+
+void MeshFile::Close()
+{
+    m_file.Close();
+    m_open = false;
+    m_vertexCount = 0;
+    m_layouts.clear();
+    m_streamData.clear();
+    m_indexFormat = MeshIndexFormat::None;
+    m_indexCount = 0;
+    m_indexData = nullptr;
+    m_bounds = EmptyBounds();
+    m_submeshes.clear();
+    m_meshlets = MeshletDataView();
+    m_decompressed.clear();
+}
+
+
+bool MeshFile::Parse(const uint8_t* data, size_t size, std::string& outError)
+{
+    FileHeader header;
+    if (data == nullptr || size < sizeof(FileHeader))
+    {
+        outError = "Mesh file is too small";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.Magic != kMagic)
+    {
+        outError = "Not a mesh file";
+        return false;
+    }
+    if (header.Version != kVersion)
+    {
+        outError = "Unsupported mesh file version " + std::to_string(header.Version);
+        return false;
+    }
+    if (header.HeaderSize < sizeof(FileHeader) || header.HeaderSize > size || header.FileSize != size)
+    {
+        outError = "Mesh file is truncated or has a corrupt header";
+        return false;
+    }
+    if (header.StreamCount == 0 || header.StreamCount > kMaxVertexStreams ||
+        header.IndexFormat > static_cast<uint32_t>(MeshIndexFormat::UInt32) ||
+        (header.IndexCount > 0) != (header.IndexFormat != static_cast<uint32_t>(MeshIndexFormat::None)))
+    {
+        outError = "Mesh file header is invalid";
+        return false;
+    }
+    if (header.SectionCount > (size - header.HeaderSize) / sizeof(SectionEntry))
+    {
+        outError = "Mesh file section table is truncated";
+        return false;
+    }
+
+    m_vertexCount = static_cast<size_t>(header.VertexCount);
+    m_indexFormat = static_cast<MeshIndexFormat>(header.IndexFormat);
+    m_indexCount = static_cast<size_t>(header.IndexCount);
+    std::memcpy(m_bounds.Min, header.BoundsMin, sizeof(m_bounds.Min));
+    std::memcpy(m_bounds.Max, header.BoundsMax, sizeof(m_bounds.Max));
+    m_layouts.assign(header.StreamCount, VertexLayout());
+    m_streamData.assign(header.StreamCount, nullptr);
+    std::vector<uint64_t> streamSizes(header.StreamCount, 0);
+    size_t meshletBoundsCount = 0;
+
+    const uint8_t* table = data + header.HeaderSize;
+    for (uint32_t i = 0; i < header.SectionCount; ++i)
+    {
+        SectionEntry entry;
+        std::memcpy(&entry, table + i * sizeof(SectionEntry), sizeof(entry));
+        if (entry.Offset > size || entry.StoredSize > size - entry.Offset)
+        {
+            outError = "Mesh file section " + std::to_string(i) + " is outside the file";
+            return false;
+        }
+
+        // δѹĶֱָļڴ
+        const uint8_t* sectionData = data + entry.Offset;
+        switch (static_cast<SectionCompression>(entry.Compression))
+        {
+        case SectionCompression::None:
+            if (entry.RawSize != entry.StoredSize)
+            {
+                outError = "Mesh file section " + std::to_string(i) + " has inconsistent sizes";
+                return false;
+            }
+            break;
+        case SectionCompression::ShuffleLZ:
+        {
+            //ԭʼСļȺѹݵޱһ£ֹ𻵵ļǷ޴ڴ棨LZÿֽչԼ255
+            if (entry.RawSize / 256 > entry.StoredSize)
+            {
+                outError = "Mesh file section " + std::to_string(i) + " has an implausible size";
+                return false;
+            }
+            std::vector<uint8_t> shuffled(static_cast<size_t>(entry.RawSize));
+            if (!Compression::DecompressLZ(sectionData, static_cast<size_t>(entry.StoredSize), shuffled.data(), shuffled.size()))
+            {
+                outError = "Mesh file section " + std::to_string(i) + " is corrupt";
+                return false;
+            }
+            std::vector<uint8_t> raw(shuffled.size());
+            Compression::UnshuffleBytes(shuffled.data(), shuffled.size(), entry.ShuffleStride, raw.data());
+            m_decompressed.push_back(std::move(raw));
+            sectionData = m_decompressed.back().data();
+            break;
+        }
+        default:
+            outError = "Mesh file section " + std::to_string(i) + " uses an unknown compression";
+            return false;
+        }
+
+        switch (static_cast<SectionType>(entry.Type))
+        {
+        case SectionType::Layout:
+            if (entry.Index >= header.StreamCount || !DeserializeLayout(sectionData, static_cast<size_t>(entry.RawSize), m_layouts[entry.Index]))
+            {
+                outError = "Mesh file has an invalid vertex layout";
+                return false;
+            }
+            break;
+        case SectionType::VertexStream:
+            if (entry.Index >= header.StreamCount)
+            {
+                outError = "Mesh file has an invalid vertex stream";
+                return false;
+            }
+            m_streamData[entry.Index] = sectionData;
+            streamSizes[entry.Index] = entry.RawSize;
+            break;
+        case SectionType::Indices:
+            if (m_indexFormat == MeshIndexFormat::None || entry.RawSize % GetMeshIndexSize(m_indexFormat) != 0 ||
+                entry.RawSize / GetMeshIndexSize(m_indexFormat) != header.IndexCount)
+            {
+                outError = "Mesh file index buffer size does not match the header";
+                return false;
+            }
+            m_indexData = sectionData;
+            break;
+        case SectionType::Submeshes:
+        {
+            if (entry.RawSize % sizeof(SubmeshRecord) != 0 || entry.RawSize / sizeof(SubmeshRecord) != header.SubmeshCount)
+            {
+                outError = "Mesh file submesh table size does not match the header";
+                return false;
+            }
+            m_submeshes.resize(header.SubmeshCount);
+            for (uint32_t s = 0; s < header.SubmeshCount; ++s)
+            {
+                SubmeshRecord record;
+                std::memcpy(&record, sectionData + s * sizeof(SubmeshRecord), sizeof(record));
+                if (static_cast<uint64_t>(record.IndexStart) + record.IndexCount > header.IndexCount)
+                {
+                    outError = "Mesh file submesh range is outside the index buffer";
+                    return false;
+                }
+                MeshSubmesh& submesh = m_submeshes[s];
+                submesh.IndexStart = record.IndexStart;
+                submesh.IndexCount = record.IndexCount;
+                submesh.BaseVertex = record.BaseVertex;
+                submesh.MaterialIndex = record.MaterialIndex;
+                std::memcpy(submesh.Bounds.Min, record.BoundsMin, sizeof(record.BoundsMin));
+                std::memcpy(submesh.Bounds.Max, record.BoundsMax, sizeof(record.BoundsMax));
+            }
+            break;
+        }
+        case SectionType::Meshlets:
+            if (entry.RawSize % sizeof(Meshlet) != 0)
+            {
+                outError = "Mesh file meshlet table has an invalid size";
+                return false;
+            }
+            m_meshlets.Meshlets = reinterpret_cast<const Meshlet*>(sectionData);
+            m_meshlets.MeshletCount = static_cast<size_t>(entry.RawSize / sizeof(Meshlet));
+            break;
+        case SectionType::MeshletBounds:
+            if (entry.RawSize % sizeof(MeshletBounds) != 0)
+            {
+                outError = "Mesh file meshlet bounds have an invalid size";
+                return false;
+            }
+            m_meshlets.Bounds = reinterpret_cast<const MeshletBounds*>(sectionData);
+            meshletBoundsCount = static_cast<size_t>(entry.RawSize / sizeof(MeshletBounds));
+            break;
+        case SectionType::MeshletVertices:
+            if (entry.RawSize % sizeof(uint32_t) != 0)
+            {
+                outError = "Mesh file meshlet vertex indices have an invalid size";
+                return false;
+            }
+            m_meshlets.VertexIndices = reinterpret_cast<const uint32_t*>(sectionData);
+            m_meshlets.VertexIndexCount = static_cast<size_t>(entry.RawSize / sizeof(uint32_t));
+            break;
+        case SectionType::MeshletTriangles:
+            m_meshlets.TriangleIndices = sectionData;
+            m_meshlets.TriangleIndexCount = static_cast<size_t>(entry.RawSize);
+            break;
+        default:
+            // °汾ӵĶͣɴ벻ʶ
+            break;
+        }
+    }
+
+    // ÿҪвֺʹСԵϵ
+    for (uint32_t i = 0; i < header.StreamCount; ++i)
+    {
+        if (!m_layouts[i].IsValid() || m_streamData[i] == nullptr ||
+            streamSizes[i] % m_layouts[i].GetStride() != 0 || streamSizes[i] / m_layouts[i].GetStride() != header.VertexCount)
+        {
+            outError = "Mesh file vertex stream " + std::to_string(i) + " is missing or has the wrong size";
+            return false;
+        }
+    }
+    if (m_indexCount > 0 && m_indexData == nullptr)
+    {
+        outError = "Mesh file is missing its index buffer";
+        return false;
+    }
+
+    // һ飨ԣȱҳȺܱˣļûƻGetIndexĵ÷Խ
+    if (m_indexCount > 0)
+    {
+        MeshSubmesh whole;
+        whole.IndexCount = static_cast<uint32_t>(m_indexCount);
+        const MeshSubmesh* submeshes = m_submeshes.empty() ? &whole : m_submeshes.data();
+        const size_t submeshCount = m_submeshes.empty() ? 1 : m_submeshes.size();
+        for (size_t s = 0; s < submeshCount; ++s)
+        {
+            const MeshSubmesh& submesh = submeshes[s];
+            for (uint32_t i = 0; i < submesh.IndexCount; ++i)
+            {
+                const int64_t vertex = static_cast<int64_t>(GetIndex(submesh.IndexStart + i)) + submesh.BaseVertex;
+                if (vertex < 0 || static_cast<uint64_t>(vertex) >= m_vertexCount)
+                {
+                    outError = "Mesh file index " + std::to_string(submesh.IndexStart + i) + " is out of range";
+                    return false;
+                }
+            }
+        }
+    }
+
+    // meshletĸҪôҪôû
+    if (m_meshlets.Meshlets != nullptr || m_meshlets.Bounds != nullptr ||
+        m_meshlets.VertexIndices != nullptr || m_meshlets.TriangleIndices != nullptr)
+    {
+        if (m_meshlets.Meshlets == nullptr || m_meshlets.Bounds == nullptr || m_meshlets.VertexIndices == nullptr ||
+            m_meshlets.TriangleIndices == nullptr || meshletBoundsCount != m_meshlets.MeshletCount)
+        {
+            outError = "Mesh file meshlet data is incomplete";
+            return false;
+        }
+        const std::string error = ValidateMeshlets(m_meshlets, m_vertexCount);
+        if (!error.empty())
+        {
+            outError = "Mesh file " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+VertexDataView MeshFile::GetVertexStream(uint32_t streamIndex) const
+{
+    if (streamIndex >= m_layouts.size())
+    {
+        return VertexDataView();
+    }
+    return VertexDataView(m_layouts[streamIndex], m_streamData[streamIndex], m_vertexCount);
+}
+
+
+uint32_t MeshFile::GetIndex(size_t index) const
+{
+    const uint8_t* data = static_cast<const uint8_t*>(m_indexData);
+    if (m_indexFormat == MeshIndexFormat::UInt16)
+    {
+        uint16_t value;
+        std::memcpy(&value, data + index * sizeof(uint16_t), sizeof(value));
+        return value;
+    }
+    uint32_t value;
+    std::memcpy(&value, data + index * sizeof(uint32_t), sizeof(value));
+    return value;
+}
+
+
+std::vector<uint32_t> MeshFile::CopyIndices() const
+{
+    std::vector<uint32_t> indices(m_indexCount);
+    if (m_indexFormat == MeshIndexFormat::UInt32)
+    {
+        std::memcpy(indices.data(), m_indexData, m_indexCount * sizeof(uint32_t));
+        return indices;
+    }
+    for (size_t i = 0; i < m_indexCount; ++i)
+    {
+        indices[i] = GetIndex(i);
+    }
+    return indices;
+}
@@ -0,0 +1,178 @@
+// MeshFile.h
+#pragma once
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/MeshletBuilder.h"
+#include "Renderer/Resources/VertexKernels.h"
+#include "Renderer/Resources/VertexLayout.h"
+#include "Core/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @brief ʽ
+ */
+enum class MeshIndexFormat : uint8_t
+{
+    None = 0,   // û
+    UInt16,
+    UInt32
+};
+
+/**
+ * @brief ʽֽڴС
+ */
+constexpr uint32_t GetMeshIndexSize(MeshIndexFormat format)
+{
+    switch (format)
+    {
+        case MeshIndexFormat::UInt16: return 2;
+        case MeshIndexFormat::UInt32: return 4;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief һDrawIndexedInstancedĲ
+ */
+struct MeshSubmesh
+{
+    uint32_t IndexStart = 0;
+    uint32_t IndexCount = 0;
+    int32_t BaseVertex = 0;
+    uint32_t MaterialIndex = 0;
+    VertexKernels::BoundingBox Bounds = { { 1.0f, 1.0f, 1.0f }, { -1.0f, -1.0f, -1.0f } };  // дʱ㣬ձʾûFloat3λ
+};
+
+/**
+ * @brief дļ
+ */
+struct MeshFileSource
+{
+    std::vector<VertexDataView> VertexStreams;  // ÿһ㻺壨Ӧۣͬ
+    const uint32_t* Indices = nullptr;
+    size_t IndexCount = 0;
+    std::vector<MeshSubmesh> Submeshes;         // ΪʱһBoundsдʱ
+    MeshletDataView Meshlets;                   // ѡMeshletBuilderĶɵmeshlet
+};
+
+/**
+ * @brief дѡ
+ */
+struct MeshWriteOptions
+{
+    bool CompressVertices = false;      // ֽںLZѹʱҪѹöβ㿽
+    bool CompressIndices = false;
+    bool AllowIndex16 = true;           // С65536ʱ16λ
+    double MinCompressionGain = 0.1;    // ѹСôŴѹ棬ԭ汣㿽
+};
+
+/**
+ * @brief ļ.kjmesh
+ * @details ļͷ + α + kSectionAlignmentĶΣÿĲ֡񣬿ѡmeshlet
+ *          OpenֻӳļУͷͶαδѹĶ//meshletֱָӳڴ棬غʱֻʣȱҳ
+ * @note СˣݰԭţֻС˻϶ѹOpenʱѹԼڴ
+ */
+class MeshFile
+{
+public:
+    static constexpr uint32_t kMagic = 0x48534D4Bu;    // "KMSH"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kSectionAlignment = 64;
+
+    MeshFile() = default;
+    MeshFile(MeshFile&&) noexcept = default;
+    MeshFile& operator=(MeshFile&&) noexcept = default;
+    MeshFile(const MeshFile&) = delete;
+    MeshFile& operator=(const MeshFile&) = delete;
+
+    // =======================================================================
+    //                        д
+    // =======================================================================
+
+    /**
+     * @brief лڴ棬벻ϷͬԽ硢Խȣʱ׳쳣
+     */
+    static std::vector<uint8_t> Serialize(const MeshFileSource& source, const MeshWriteOptions& options = {});
+
+    /**
+     * @brief дļдʱļٸдһ벻»ļ
+     */
+    static bool Write(const std::filesystem::path& path, const MeshFileSource& source,
+        const MeshWriteOptions& options = {}, std::string* outError = nullptr);
+
+    // =======================================================================
+    //                        ȡ
+    // =======================================================================
+
+    /**
+     * @brief ӳ䲢Уļ
+     */
+    bool Open(const std::filesystem::path& path, std::string* outError = nullptr);
+
+    /**
+     * @brief ڴȡMeshFileʹڼЧ4ֽڶ룩
+     */
+    bool OpenMemory(const void* data, size_t size, std::string* outError = nullptr);
+
+    void Close();
+    bool IsOpen() const { return m_open; }
+
+    /**
+     * @brief Ƿݶֱָļڴ棨ûѹΣ
+     */
+    bool IsZeroCopy() const { return m_decompressed.empty(); }
+
+    size_t GetVertexCount() const { return m_vertexCount; }
+    uint32_t GetVertexStreamCount() const { return static_cast<uint32_t>(m_layouts.size()); }
+
+    /**
+     * @brief ֻͼMeshFileرջʧЧ
+     */
+    VertexDataView GetVertexStream(uint32_t streamIndex) const;
+
+    MeshIndexFormat GetIndexFormat() const { return m_indexFormat; }
+    size_t GetIndexCount() const { return m_indexCount; }
+    const void* GetIndexData() const { return m_indexData; }
+    size_t GetIndexDataSize() const { return m_indexCount * GetMeshIndexSize(m_indexFormat); }
+
+    /**
+     * @brief ȡһ鷶Χ
+     */
+    uint32_t GetIndex(size_t index) const;
+
+    /**
+     * @brief չ32λ
+     */
+    std::vector<uint32_t> CopyIndices() const;
+
+    const VertexKernels::BoundingBox& GetBounds() const { return m_bounds; }
+    const std::vector<MeshSubmesh>& GetSubmeshes() const { return m_submeshes; }
+
+    /**
+     * @brief һmeshletûʱΪͼMeshFileرջʧЧ
+     */
+    const MeshletDataView& GetMeshlets() const { return m_meshlets; }
+
+private:
+    bool Parse(const uint8_t* data, size_t size, std::string& outError);
+
+    MappedFile m_file;
+    bool m_open = false;
+
+    size_t m_vertexCount = 0;
+    std::vector<VertexLayout> m_layouts;
+    std::vector<const uint8_t*> m_streamData;
+
+    MeshIndexFormat m_indexFormat = MeshIndexFormat::None;
+    size_t m_indexCount = 0;
+    const void* m_indexData = nullptr;
+
+    VertexKernels::BoundingBox m_bounds = { { 1.0f, 1.0f, 1.0f }, { -1.0f, -1.0f, -1.0f } };
+    std::vector<MeshSubmesh> m_submeshes;
+    MeshletDataView m_meshlets;
+
+    std::vector<std::vector<uint8_t>> m_decompressed;  // ѹνѹڴ
+};
@@ -0,0 +1,471 @@
+// MeshOptimizer.cpp
+#include "Renderer/Resources/MeshOptimizer.h"
+#include "Renderer/Resources/MeshAdjacency.h"
+#include "Timer/Clock.h"
+#include "Timer/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    constexpr uint32_t kNoVertex = std::numeric_limits<uint32_t>::max();
+
+    void ValidateIndices(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+    {
+        if (indexCount > 0 && indices == nullptr)
+        {
+            throw std::invalid_argument("MeshOptimizer: index count is set but indices are null");
+        }
+        if (vertexCount >= kNoVertex)
+        {
+            throw std::invalid_argument("MeshOptimizer: too many vertices for 32-bit indices");
+        }
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            if (indices[i] >= vertexCount)
+            {
+                throw std::invalid_argument("MeshOptimizer: index " + std::to_string(indices[i]) + " is out of range (" +
+                    std::to_string(vertexCount) + " vertices)");
+            }
+        }
+    }
+
+    /**
+     * @brief FIFOģ⣺ÿδʱһcacheSizeδ֮ھͻڻ
+     * @details ʱcacheSize + 1ʼʱΪ0ĶһʼͲڻ
+     */
+    class FifoCache
+    {
+    public:
+        FifoCache(size_t vertexCount, uint32_t cacheSize)
+            : m_timestamps(vertexCount, 0)
+            , m_cacheSize(cacheSize)
+            , m_time(cacheSize + 1)
+        {
+        }
+
+        bool Contains(uint32_t vertex) const { return m_time - m_timestamps[vertex] <= m_cacheSize; }
+
+        /**
+         * @brief ʶ㣬δʱŽ沢true
+         */
+        bool Access(uint32_t vertex)
+        {
+            if (Contains(vertex))
+            {
+                return false;
+            }
+            m_timestamps[vertex] = m_time++;
+            return true;
+        }
+
+        /**
+         * @brief ջ棨֮ж㶼У
+         */
+        void Flush() { m_time += m_cacheSize + 1; }
+
+        uint32_t GetAge(uint32_t vertex) const { return m_time - m_timestamps[vertex]; }
+
+    private:
+        std::vector<uint32_t> m_timestamps;
+        uint32_t m_cacheSize;
+        uint32_t m_time;
+    };
+
+    struct Float3
+    {
+        float X, Y, Z;
+    };
+
+    inline Float3 Subtract(const Float3& a, const Float3& b) { return { a.X - b.X, a.Y - b.Y, a.Z - b.Z }; }
+    inline Float3 Cross(const Float3& a, const Float3& b)
+    {
+        return { a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X };
+    }
+    inline float Dot(const Float3& a, const Float3& b) { return a.X * b.X + a.Y * b.Y + a.Z * b.Z; }
+
+    /**
+     * @brief õĴأʼκ
+     */
+    struct OverdrawCluster
+    {
+        size_t FirstTriangle = 0;
+        size_t TriangleCount = 0;
+        float SortKey = 0.0f;
+    };
+}
+
+
+// =======================================================================
+//                        ģ
+// =======================================================================
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+    uint32_t cacheSize)
+{
+    ValidateIndices(indices, indexCount, vertexCount);
+
+    VertexCacheStats stats;
+    stats.TriangleCount = indexCount / 3;
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<bool> referenced(vertexCount, false);
+    for (size_t i = 0; i < stats.TriangleCount * 3; ++i)
+    {
+        const uint32_t vertex = indices[i];
+        stats.TransformCount += cache.Access(vertex) ? 1 : 0;
+        if (!referenced[vertex])
+        {
+            referenced[vertex] = true;
+            ++stats.VertexCount;
+        }
+    }
+
+    stats.ACMR = stats.TriangleCount > 0 ? static_cast<double>(stats.TransformCount) / static_cast<double>(stats.TriangleCount) : 0.0;
+    stats.ATVR = stats.VertexCount > 0 ? static_cast<double>(stats.TransformCount) / static_cast<double>(stats.VertexCount) : 0.0;
+    return stats;
+}
+
+
+// =======================================================================
+//                        Tipsify
+// =======================================================================
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+    uint32_t cacheSize)
+{
+    KJ_PROFILE_SCOPE("Optimize Vertex Cache");
+    ValidateIndices(indices, indexCount, vertexCount);
+
+    const size_t triangleCount = indexCount / 3;
+    std::vector<uint32_t> result;
+    result.reserve(indexCount);
+    if (triangleCount == 0)
+    {
+        result.assign(indices, indices + indexCount);
+        return result;
+    }
+
+    const TriangleAdjacency adjacency = TriangleAdjacency::Build(indices, triangleCount, vertexCount);
+
+    // ÿ㻹û
+    std::vector<uint32_t> liveCounts(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        liveCounts[v] = adjacency.Offsets[v + 1] - adjacency.Offsets[v];
+    }
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEnds;         // Ķ㣬Ͷ·ʱһػܻڵĶ
+    std::vector<uint32_t> candidates;
+    FifoCache cache(vertexCount, cacheSize);
+
+    uint32_t fanning = indices[0];
+    size_t cursor = 0;                      // ˳һεĶ
+    while (fanning != kNoVertex)
+    {
+        candidates.clear();
+        for (uint32_t a = adjacency.Offsets[fanning]; a < adjacency.Offsets[fanning + 1]; ++a)
+        {
+            const uint32_t triangle = adjacency.Triangles[a];
+            if (emitted[triangle])
+            {
+                continue;
+            }
+            emitted[triangle] = 1;
+            for (int k = 0; k < 3; ++k)
+            {
+                const uint32_t vertex = indices[triangle * 3 + k];
+                result.push_back(vertex);
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                --liveCounts[vertex];
+                cache.Access(vertex);
+            }
+        }
+
+        // һģʣµκڻĶУڻõǸ
+        uint32_t best = kNoVertex;
+        int64_t bestPriority = -1;
+        for (uint32_t vertex : candidates)
+        {
+            if (liveCounts[vertex] == 0)
+            {
+                continue;
+            }
+            int64_t priority = 0;
+            const uint32_t age = cache.GetAge(vertex);
+            if (static_cast<uint64_t>(age) + 2ull * liveCounts[vertex] <= cacheSize)
+            {
+                priority = age;
+            }
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                best = vertex;
+            }
+        }
+
+        if (best == kNoVertex)
+        {
+            while (!deadEnds.empty() && best == kNoVertex)
+            {
+                const uint32_t vertex = deadEnds.back();
+                deadEnds.pop_back();
+                if (liveCounts[vertex] > 0)
+                {
+                    best = vertex;
+                }
+            }
+            for (; best == kNoVertex && cursor < vertexCount; ++cursor)
+            {
+                if (liveCounts[cursor] > 0)
+                {
+                    best = static_cast<uint32_t>(cursor);
+                }
+            }
+        }
+        fanning = best;
+    }
+
+    result.insert(result.end(), indices + triangleCount * 3, indices + indexCount);
+    return result;
+}
+
+
+// =======================================================================
+//                        
+// =======================================================================
+
+size_t MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const VertexDataView& vertices,
+    uint32_t cacheSize, float threshold)
+{
+    KJ_PROFILE_SCOPE("Optimize Overdraw");
+
+    const size_t vertexCount = vertices.GetVertexCount();
+    ValidateIndices(indices.data(), indices.size(), vertexCount);
+
+    const VertexAttributeHandle position = vertices.FindAttribute("POSITION");
+    if (!position.IsValid() || position.Format != VertexFormat::Float3)
+    {
+        throw std::runtime_error("MeshOptimizer: overdraw optimization needs a Float3 POSITION");
+    }
+    const uint32_t stride = vertices.GetStride();
+    const uint8_t* positionData = static_cast<const uint8_t*>(vertices.GetData()) + position.Offset;
+    auto loadPosition = [positionData, stride](uint32_t vertex)
+    {
+        Float3 value;
+        std::memcpy(&value, positionData + static_cast<size_t>(vertex) * stride, sizeof(value));
+        return value;
+    };
+
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+    {
+        return 0;
+    }
+
+    // Ӳ߽磺㶼ûеΣѾգпʧС
+    // 0Ǳ߽磬ظ˻ΡӺļ㣩ʱһȫδ֮ǰλᶪ
+    std::vector<size_t> hardBoundaries;
+    {
+        FifoCache cache(vertexCount, cacheSize);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            int misses = 0;
+            for (int k = 0; k < 3; ++k)
+            {
+                misses += cache.Access(indices[t * 3 + k]) ? 1 : 0;
+            }
+            if (t == 0 || misses == 3)
+            {
+                hardBoundaries.push_back(t);
+            }
+        }
+    }
+    hardBoundaries.push_back(triangleCount);
+
+    // ߽磺ÿӲشͷģ⣬ۼACMRthresholdʱһθнӽԭ
+    std::vector<OverdrawCluster> clusters;
+    FifoCache cache(vertexCount, cacheSize);
+    for (size_t h = 0; h + 1 < hardBoundaries.size(); ++h)
+    {
+        const size_t begin = hardBoundaries[h];
+        const size_t end = hardBoundaries[h + 1];
+
+        cache.Flush();
+        size_t clusterMisses = 0;
+        for (size_t t = begin; t < end; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                clusterMisses += cache.Access(indices[t * 3 + k]) ? 1 : 0;
+            }
+        }
+        const double limit = static_cast<double>(threshold) * static_cast<double>(clusterMisses) / static_cast<double>(end - begin);
+
+        cache.Flush();
+        size_t start = begin;
+        size_t misses = 0;
+        for (size_t t = begin; t < end; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                misses += cache.Access(indices[t * 3 + k]) ? 1 : 0;
+            }
+            if (t + 1 < end && static_cast<double>(misses) <= limit * static_cast<double>(t + 1 - start))
+            {
+                clusters.push_back({ start, t + 1 - start, 0.0f });
+                start = t + 1;
+                misses = 0;
+                cache.Flush();
+            }
+        }
+        clusters.push_back({ start, end - start, 0.0f });
+    }
+
+    // ȨĴĺͷߣ = ( - )ط
+    std::vector<Float3> centroids(clusters.size());
+    std::vector<Float3> normals(clusters.size());
+    Float3 meshCentroid = { 0.0f, 0.0f, 0.0f };
+    double meshArea = 0.0;
+    double meshSum[3] = { 0.0, 0.0, 0.0 };
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        double sum[3] = { 0.0, 0.0, 0.0 };
+        double normal[3] = { 0.0, 0.0, 0.0 };
+        double area = 0.0;
+        for (size_t t = clusters[c].FirstTriangle; t < clusters[c].FirstTriangle + clusters[c].TriangleCount; ++t)
+        {
+            const Float3 p0 = loadPosition(indices[t * 3 + 0]);
+            const Float3 p1 = loadPosition(indices[t * 3 + 1]);
+            const Float3 p2 = loadPosition(indices[t * 3 + 2]);
+            const Float3 cross = Cross(Subtract(p1, p0), Subtract(p2, p0));
+            const double triangleArea = std::sqrt(static_cast<double>(Dot(cross, cross)));
+            sum[0] += (p0.X + p1.X + p2.X) / 3.0 * triangleArea;
+            sum[1] += (p0.Y + p1.Y + p2.Y) / 3.0 * triangleArea;
+            sum[2] += (p0.Z + p1.Z + p2.Z) / 3.0 * triangleArea;
+            normal[0] += cross.X;
+            normal[1] += cross.Y;
+            normal[2] += cross.Z;
+            area += triangleArea;
+        }
+        meshSum[0] += sum[0];
+        meshSum[1] += sum[1];
+        meshSum[2] += sum[2];
+        meshArea += area;
+
+        const double inverseArea = area > 0.0 ? 1.0 / area : 0.0;
+        centroids[c] = { static_cast<float>(sum[0] * inverseArea), static_cast<float>(sum[1] * inverseArea), static_cast<float>(sum[2] * inverseArea) };
+        const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        const double inverseLength = length > 0.0 ? 1.0 / length : 0.0;
+        normals[c] = { static_cast<float>(normal[0] * inverseLength), static_cast<float>(normal[1] * inverseLength), static_cast<float>(normal[2] * inverseLength) };
+    }
+    if (meshArea > 0.0)
+    {
+        meshCentroid = { static_cast<float>(meshSum[0] / meshArea), static_cast<float>(meshSum[1] / meshArea), static_cast<float>(meshSum[2] / meshArea) };
+    }
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        clusters[c].SortKey = Dot(Subtract(centroids[c], meshCentroid), normals[c]);
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(),
+        [](const OverdrawCluster& a, const OverdrawCluster& b) { return a.SortKey > b.SortKey; });
+
+    std::vector<uint32_t> reordered;
+    reordered.reserve(indices.size());
+    for (const OverdrawCluster& cluster : clusters)
+    {
+        reordered.insert(reordered.end(), indices.begin() + cluster.FirstTriangle * 3,
+            indices.begin() + (cluster.FirstTriangle + cluster.TriangleCount) * 3);
+    }
+    reordered.insert(reordered.end(), indices.begin() + triangleCount * 3, indices.end());
+    indices.swap(reordered);
+    return clusters.size();
+}
+
+
+// =======================================================================
+//                        ȡ
+// =======================================================================
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(DynamicVertexData& vertices, std::vector<uint32_t>& indices)
+{
+    KJ_PROFILE_SCOPE("Optimize Vertex Fetch");
+
+    const size_t vertexCount = vertices.GetVertexCount();
+    ValidateIndices(indices.data(), indices.size(), vertexCount);
+
+    std::vector<uint32_t> remap(vertexCount, kNoVertex);
+    uint32_t nextVertex = 0;
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == kNoVertex)
+        {
+            remap[index] = nextVertex++;
+        }
+        index = remap[index];
+    }
+
+    if (nextVertex == 0)
+    {
+        vertices.Clear();
+        return remap;
+    }
+
+    const uint32_t stride = vertices.GetStride();
+    DynamicVertexData reordered(vertices.GetLayout(), nextVertex);
+    const uint8_t* source = static_cast<const uint8_t*>(vertices.GetData());
+    uint8_t* destination = static_cast<uint8_t*>(reordered.GetData());
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        if (remap[v] != kNoVertex)
+        {
+            std::memcpy(destination + static_cast<size_t>(remap[v]) * stride, source + v * stride, stride);
+        }
+    }
+    vertices = std::move(reordered);
+    return remap;
+}
+
+
+// =======================================================================
+//                        
+// =======================================================================
+
+MeshOptimizeReport MeshOptimizer::Optimize(DynamicVertexData& vertices, std::vector<uint32_t>& indices,
+    const MeshOptimizeOptions& options)
+{
+    KJ_PROFILE_SCOPE("Optimize Mesh");
+    const int64_t start = SteadyClock::Now();
+
+    MeshOptimizeReport report;
+    const size_t vertexCount = vertices.GetVertexCount();
+    report.Before = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount, options.CacheSize);
+
+    indices = OptimizeVertexCache(indices.data(), indices.size(), vertexCount, options.CacheSize);
+
+    if (options.OptimizeOverdraw)
+    {
+        const VertexAttributeHandle position = vertices.FindAttribute("POSITION");
+        if (position.IsValid() && position.Format == VertexFormat::Float3)
+        {
+            report.ClusterCount = OptimizeOverdraw(indices, vertices.GetView(), options.CacheSize, options.OverdrawThreshold);
+        }
+    }
+
+    if (options.OptimizeVertexFetch)
+    {
+        OptimizeVertexFetch(vertices, indices);
+        report.RemovedVertexCount = vertexCount - vertices.GetVertexCount();
+    }
+
+    report.After = AnalyzeVertexCache(indices.data(), indices.size(), vertices.GetVertexCount(), options.CacheSize);
+    report.Milliseconds = static_cast<double>(SteadyClock::Now() - start) / 1.0e6;
+    return report;
+}
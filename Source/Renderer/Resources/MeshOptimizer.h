@@ -0,0 +1,89 @@
+// MeshOptimizer.h
+#pragma once
+#include "Renderer/Resources/DynamicVertexData.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 任ģͳ
+ */
+struct VertexCacheStats
+{
+    size_t TriangleCount = 0;
+    size_t VertexCount = 0;         // õĶ
+    size_t TransformCount = 0;      // δдɫô
+    double ACMR = 0.0;              // ÿƽ任Ķ0.5~3ԽСԽã
+    double ATVR = 0.0;              // 任 / 1ޣ
+};
+
+/**
+ * @brief Żѡ
+ */
+struct MeshOptimizeOptions
+{
+    uint32_t CacheSize = 16;            // ģFIFOСҲTipsifyĿ껺С
+    bool OptimizeOverdraw = true;       // ڻŻĻϰص˳
+    float OverdrawThreshold = 1.05f;    // ؿԲACMRԭô౶
+    bool OptimizeVertexFetch = true;    // 㰴һαõ˳ţûõĶ
+};
+
+/**
+ * @brief Ż
+ */
+struct MeshOptimizeReport
+{
+    VertexCacheStats Before;
+    VertexCacheStats After;
+    size_t ClusterCount = 0;            // ĴûʱΪ0
+    size_t RemovedVertexCount = 0;      // Ŷʱδö
+    double Milliseconds = 0.0;
+};
+
+/**
+ * @brief бŻ
+ * @details ˳TipsifyŻ -> ƴ -> ȡš
+ *          ͳFIFOģ⣬ҪGPU֤Ч
+ * @note ֻб3ıʱĲԭĩβ
+ */
+class MeshOptimizer
+{
+public:
+    /**
+     * @brief ִѡĸ͵ظд
+     * @details ʱҪFloat3POSITIONûʱò
+     */
+    static MeshOptimizeReport Optimize(DynamicVertexData& vertices, std::vector<uint32_t>& indices,
+        const MeshOptimizeOptions& options = {});
+
+    /**
+     * @brief TipsifySanderȣ2007ΧĶΣѡڻСʣζĶ
+     * @return źμϲ
+     */
+    static std::vector<uint32_t> OptimizeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+        uint32_t cacheSize = 16);
+
+    /**
+     * @brief ٹ
+     * @details ڻģ㶼δдгӲ߽磬ACMRthresholdǰϸ֣
+     *          ذ( - )طߴӴСţĴȻ󻭵ĴظױȲ޳
+     * @return 
+     */
+    static size_t OptimizeOverdraw(std::vector<uint32_t>& indices, const VertexDataView& vertices,
+        uint32_t cacheSize = 16, float threshold = 1.05f);
+
+    /**
+     * @brief 㰴һαõ˳ţ֮дûõĶ㱻
+     * @return ɶ -> ¶㣬ĶΪUINT32_MAX
+     */
+    static std::vector<uint32_t> OptimizeVertexFetch(DynamicVertexData& vertices, std::vector<uint32_t>& indices);
+
+    /**
+     * @brief FIFOģͳACMRATVR
+     */
+    static VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+        uint32_t cacheSize = 16);
+
+private:
+    MeshOptimizer() = delete;  // ̬
+};
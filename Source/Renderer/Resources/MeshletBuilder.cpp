@@ -0,0 +1,795 @@
+// MeshletBuilder.cpp
+#include "Renderer/Resources/MeshletBuilder.h"
+#include "Renderer/Resources/MeshAdjacency.h"
+#include "Timer/Clock.h"
+#include "Timer/Profiler.h"
+#include "Core/Parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // meshletڶ8λD3D12 mesh shader
+    constexpr uint32_t kMaxMeshletVertices = 256;
+    constexpr uint32_t kMaxMeshletTriangles = 256;
+
+    constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+    constexpr uint16_t kNoLocalIndex = std::numeric_limits<uint16_t>::max();
+
+    // ÿmeshlet
+    constexpr size_t kBoundsBatchSize = 256;
+    constexpr size_t kCullBatchSize = 1024;
+
+    // kdҶŵ
+    constexpr uint32_t kLeafSize = 8;
+
+    struct Float3
+    {
+        float X, Y, Z;
+    };
+
+    inline Float3 Add(const Float3& a, const Float3& b) { return { a.X + b.X, a.Y + b.Y, a.Z + b.Z }; }
+    inline Float3 Subtract(const Float3& a, const Float3& b) { return { a.X - b.X, a.Y - b.Y, a.Z - b.Z }; }
+    inline Float3 Scale(const Float3& a, float s) { return { a.X * s, a.Y * s, a.Z * s }; }
+    inline Float3 Cross(const Float3& a, const Float3& b)
+    {
+        return { a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X };
+    }
+    inline float Dot(const Float3& a, const Float3& b) { return a.X * b.X + a.Y * b.Y + a.Z * b.Z; }
+    inline float Component(const Float3& a, uint32_t axis) { return axis == 0 ? a.X : (axis == 1 ? a.Y : a.Z); }
+
+    /**
+     * @brief 粽ŵFloat3λ
+     */
+    class PositionReader
+    {
+    public:
+        explicit PositionReader(const VertexDataView& vertices)
+        {
+            const VertexAttributeHandle position = vertices.FindAttribute("POSITION");
+            if (!position.IsValid() || position.Format != VertexFormat::Float3)
+            {
+                throw std::runtime_error("MeshletBuilder: meshlets need a Float3 POSITION");
+            }
+            m_data = static_cast<const uint8_t*>(vertices.GetData()) + position.Offset;
+            m_stride = vertices.GetStride();
+        }
+
+        Float3 operator[](uint32_t vertex) const
+        {
+            Float3 value;
+            std::memcpy(&value, m_data + static_cast<size_t>(vertex) * m_stride, sizeof(value));
+            return value;
+        }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        size_t m_stride = 0;
+    };
+
+    void ValidateIndices(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+    {
+        if (indexCount > 0 && indices == nullptr)
+        {
+            throw std::invalid_argument("MeshletBuilder: index count is set but indices are null");
+        }
+        if (indexCount / 3 > std::numeric_limits<uint32_t>::max() / 3)
+        {
+            throw std::invalid_argument("MeshletBuilder: too many triangles");
+        }
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            if (indices[i] >= vertexCount)
+            {
+                throw std::invalid_argument("MeshletBuilder: index " + std::to_string(indices[i]) + " is out of range (" +
+                    std::to_string(vertexCount) + " vertices)");
+            }
+        }
+    }
+
+    // ѾŽmeshlet
+    constexpr uint32_t kEmitted = kNone - 1;
+
+    /**
+     * @brief ʱõݷһ𣬴˳ÿһֻһλδ
+     */
+    struct TriangleRecord
+    {
+        uint32_t Vertices[3];
+        uint32_t State;         // kEmittedѡmeshletţkNoneʾ
+        Float3 Centroid;
+        uint32_t Padding;
+    };
+    static_assert(sizeof(TriangleRecord) == 32, "TriangleRecord should fill half a cache line");
+
+    /**
+     * @brief ĵkdһĻûõ
+     * @details ùɵ÷kEmittedѯʱҶѾÿվͰɿղϴ
+     *          ֮Ĳѯÿͨһ㲻ɨһȫΡ
+     *          ŷһ𣬰ڵΧееһ˻֣ƫһʱ˻λʱ
+     */
+    class CentroidTree
+    {
+    public:
+        explicit CentroidTree(const std::vector<TriangleRecord>& triangles)
+            : m_entries(triangles.size())
+            , m_triangles(triangles)
+        {
+            if (triangles.empty())
+            {
+                return;
+            }
+            Float3 minimum = triangles[0].Centroid;
+            Float3 maximum = minimum;
+            for (size_t i = 0; i < triangles.size(); ++i)
+            {
+                const Float3& p = triangles[i].Centroid;
+                m_entries[i].Position = p;
+                m_entries[i].Item = static_cast<uint32_t>(i);
+                minimum = { std::min(minimum.X, p.X), std::min(minimum.Y, p.Y), std::min(minimum.Z, p.Z) };
+                maximum = { std::max(maximum.X, p.X), std::max(maximum.Y, p.Y), std::max(maximum.Z, p.Z) };
+            }
+            m_nodes.reserve(triangles.size() / kLeafSize * 4 + 1);
+            Build(0, static_cast<uint32_t>(triangles.size()), kNone, minimum, maximum);
+        }
+
+        /**
+         * @brief Ļûõĵ㣬ȫʱkNone
+         */
+        uint32_t FindNearest(const Float3& point)
+        {
+            uint32_t best = kNone;
+            float bestDistance = std::numeric_limits<float>::max();
+            if (!m_nodes.empty())
+            {
+                Search(0, point, best, bestDistance);
+            }
+            return best;
+        }
+
+    private:
+        struct Entry
+        {
+            Float3 Position;
+            uint32_t Item;
+        };
+
+        struct Node
+        {
+            uint32_t Begin = 0;
+            uint32_t Count = 0;
+            uint32_t Parent = kNone;
+            uint32_t Left = kNone;      // ҶΪkNone
+            uint32_t Right = kNone;
+            uint32_t Axis = 0;
+            float Split = 0.0f;         //  <= Split <= 
+            bool Empty = false;         // ĵ㶼
+        };
+
+        uint32_t Build(uint32_t begin, uint32_t count, uint32_t parent, const Float3& minimum, const Float3& maximum)
+        {
+            const uint32_t index = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+            m_nodes[index].Begin = begin;
+            m_nodes[index].Count = count;
+            m_nodes[index].Parent = parent;
+            if (count <= kLeafSize)
+            {
+                return index;
+            }
+
+            const Float3 extent = Subtract(maximum, minimum);
+            const uint32_t axis = extent.X >= extent.Y && extent.X >= extent.Z ? 0 : (extent.Y >= extent.Z ? 1 : 2);
+            float split = (Component(minimum, axis) + Component(maximum, axis)) * 0.5f;
+            const auto first = m_entries.begin() + begin;
+            const auto last = first + count;
+            uint32_t middle = begin + static_cast<uint32_t>(std::partition(first, last,
+                [axis, split](const Entry& entry) { return Component(entry.Position, axis) < split; }) - first);
+            if (middle == begin || middle == begin + count)
+            {
+                middle = begin + count / 2;
+                std::nth_element(first, m_entries.begin() + middle, last,
+                    [axis](const Entry& a, const Entry& b) { return Component(a.Position, axis) < Component(b.Position, axis); });
+                split = Component(m_entries[middle].Position, axis);
+            }
+
+            Float3 leftMaximum = maximum;
+            Float3 rightMinimum = minimum;
+            (axis == 0 ? leftMaximum.X : (axis == 1 ? leftMaximum.Y : leftMaximum.Z)) = split;
+            (axis == 0 ? rightMinimum.X : (axis == 1 ? rightMinimum.Y : rightMinimum.Z)) = split;
+
+            m_nodes[index].Axis = axis;
+            m_nodes[index].Split = split;
+            const uint32_t left = Build(begin, middle - begin, index, minimum, leftMaximum);
+            const uint32_t right = Build(middle, begin + count - middle, index, rightMinimum, maximum);
+            m_nodes[index].Left = left;
+            m_nodes[index].Right = right;
+            return index;
+        }
+
+        void MarkEmpty(uint32_t nodeIndex)
+        {
+            m_nodes[nodeIndex].Empty = true;
+            for (uint32_t parent = m_nodes[nodeIndex].Parent; parent != kNone; parent = m_nodes[parent].Parent)
+            {
+                if (!m_nodes[m_nodes[parent].Left].Empty || !m_nodes[m_nodes[parent].Right].Empty)
+                {
+                    break;
+                }
+                m_nodes[parent].Empty = true;
+            }
+        }
+
+        void Search(uint32_t nodeIndex, const Float3& point, uint32_t& best, float& bestDistance)
+        {
+            const Node& node = m_nodes[nodeIndex];
+            if (node.Empty)
+            {
+                return;
+            }
+            if (node.Left == kNone)
+            {
+                bool empty = true;
+                for (uint32_t i = node.Begin; i < node.Begin + node.Count; ++i)
+                {
+                    const Entry& entry = m_entries[i];
+                    if (m_triangles[entry.Item].State == kEmitted)
+                    {
+                        continue;
+                    }
+                    empty = false;
+                    const Float3 delta = Subtract(entry.Position, point);
+                    const float distance = Dot(delta, delta);
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        best = entry.Item;
+                    }
+                }
+                if (empty)
+                {
+                    MarkEmpty(nodeIndex);
+                }
+                return;
+            }
+
+            const float delta = Component(point, node.Axis) - node.Split;
+            const uint32_t nearChild = delta < 0.0f ? node.Left : node.Right;
+            const uint32_t farChild = delta < 0.0f ? node.Right : node.Left;
+            Search(nearChild, point, best, bestDistance);
+            if (delta * delta < bestDistance)
+            {
+                Search(farChild, point, best, bestDistance);
+            }
+        }
+
+        std::vector<Entry> m_entries;
+        const std::vector<TriangleRecord>& m_triangles;
+        std::vector<Node> m_nodes;
+    };
+
+    /**
+     * @brief еmeshletĺѡΣmeshlet㡢ûõΣ
+     * @details εĶĿÿѡֻɨС飻¶ڶmeshletʱ
+     */
+    struct MeshletCandidate
+    {
+        uint32_t Triangle;
+        uint32_t Vertices[3];
+        Float3 Centroid;
+        uint32_t NewVertices;
+    };
+
+    MeshletBounds ComputeMeshletBounds(const PositionReader& positions, const MeshletDataView& meshlets, size_t meshletIndex)
+    {
+        const Meshlet& meshlet = meshlets.Meshlets[meshletIndex];
+        const uint32_t* vertices = meshlets.VertexIndices + meshlet.VertexOffset;
+        const uint8_t* triangles = meshlets.TriangleIndices + meshlet.TriangleOffset;
+
+        MeshletBounds bounds;
+        if (meshlet.VertexCount == 0)
+        {
+            return bounds;
+        }
+
+        // ΧRitterһԶaaԶbabΪֱ
+        auto farthestFrom = [&](const Float3& origin)
+        {
+            Float3 farthest = origin;
+            float farthestDistance = -1.0f;
+            for (uint32_t i = 0; i < meshlet.VertexCount; ++i)
+            {
+                const Float3 p = positions[vertices[i]];
+                const Float3 delta = Subtract(p, origin);
+                const float distance = Dot(delta, delta);
+                if (distance > farthestDistance)
+                {
+                    farthestDistance = distance;
+                    farthest = p;
+                }
+            }
+            return farthest;
+        };
+        const Float3 a = farthestFrom(positions[vertices[0]]);
+        const Float3 b = farthestFrom(a);
+        Float3 center = Scale(Add(a, b), 0.5f);
+        const Float3 diameter = Subtract(b, a);
+        float radius = std::sqrt(Dot(diameter, diameter)) * 0.5f;
+        for (uint32_t i = 0; i < meshlet.VertexCount; ++i)
+        {
+            const Float3 delta = Subtract(positions[vertices[i]], center);
+            const float distance = std::sqrt(Dot(delta, delta));
+            if (distance > radius)
+            {
+                const float newRadius = (radius + distance) * 0.5f;
+                center = Add(center, Scale(delta, (newRadius - radius) / distance));
+                radius = newRadius;
+            }
+        }
+        std::memcpy(bounds.Center, &center, sizeof(bounds.Center));
+        bounds.Radius = radius;
+        std::memcpy(bounds.ConeApex, &center, sizeof(bounds.ConeApex));
+
+        // ׶ȡλ֮͵ķƫǳ90ʱ׶޳
+        std::array<Float3, kMaxMeshletTriangles> normals;
+        std::array<Float3, kMaxMeshletTriangles> corners;
+        uint32_t normalCount = 0;
+        Float3 normalSum = { 0.0f, 0.0f, 0.0f };
+        for (uint32_t t = 0; t < meshlet.TriangleCount && normalCount < kMaxMeshletTriangles; ++t)
+        {
+            const Float3 p0 = positions[vertices[triangles[t * 3 + 0]]];
+            const Float3 p1 = positions[vertices[triangles[t * 3 + 1]]];
+            const Float3 p2 = positions[vertices[triangles[t * 3 + 2]]];
+            const Float3 normal = Cross(Subtract(p1, p0), Subtract(p2, p0));
+            const float length = std::sqrt(Dot(normal, normal));
+            if (!(length > 0.0f))
+            {
+                continue;  // ˻βɼӰ׶
+            }
+            normals[normalCount] = Scale(normal, 1.0f / length);
+            corners[normalCount] = p0;
+            normalSum = Add(normalSum, normals[normalCount]);
+            ++normalCount;
+        }
+
+        const float axisLength = std::sqrt(Dot(normalSum, normalSum));
+        if (normalCount == 0 || !(axisLength > 0.0f))
+        {
+            return bounds;
+        }
+        const Float3 axis = Scale(normalSum, 1.0f / axisLength);
+        float minDot = 1.0f;
+        for (uint32_t i = 0; i < normalCount; ++i)
+        {
+            minDot = std::min(minDot, Dot(normals[i], axis));
+        }
+        std::memcpy(bounds.ConeAxis, &axis, sizeof(bounds.ConeAxis));
+        if (minDot <= 0.0f)
+        {
+            return bounds;
+        }
+
+        // ׶˵ƽı棬׶⿴ķжŶmeshlet
+        float maxOffset = 0.0f;
+        for (uint32_t i = 0; i < normalCount; ++i)
+        {
+            const float offset = Dot(Subtract(center, corners[i]), normals[i]) / Dot(axis, normals[i]);
+            maxOffset = std::max(maxOffset, offset);
+        }
+        const Float3 apex = Subtract(center, Scale(axis, maxOffset));
+        std::memcpy(bounds.ConeApex, &apex, sizeof(bounds.ConeApex));
+        bounds.ConeCutoff = std::sqrt(std::max(0.0f, 1.0f - minDot * minDot));
+        return bounds;
+    }
+}
+
+
+// =======================================================================
+//                        MeshletData
+// =======================================================================
+
+void MeshletData::Clear()
+{
+    Meshlets.clear();
+    Bounds.clear();
+    VertexIndices.clear();
+    TriangleIndices.clear();
+}
+
+
+MeshletDataView MeshletData::GetView() const
+{
+    MeshletDataView view;
+    view.Meshlets = Meshlets.data();
+    view.Bounds = Bounds.data();
+    view.MeshletCount = Meshlets.size();
+    view.VertexIndices = VertexIndices.data();
+    view.VertexIndexCount = VertexIndices.size();
+    view.TriangleIndices = TriangleIndices.data();
+    view.TriangleIndexCount = TriangleIndices.size();
+    return view;
+}
+
+
+MeshletData MeshletData::FromView(const MeshletDataView& view)
+{
+    MeshletData data;
+    if (view.MeshletCount > 0)
+    {
+        data.Meshlets.assign(view.Meshlets, view.Meshlets + view.MeshletCount);
+        data.Bounds.assign(view.Bounds, view.Bounds + view.MeshletCount);
+        data.VertexIndices.assign(view.VertexIndices, view.VertexIndices + view.VertexIndexCount);
+        data.TriangleIndices.assign(view.TriangleIndices, view.TriangleIndices + view.TriangleIndexCount);
+    }
+    return data;
+}
+
+
+// =======================================================================
+//                        
+// =======================================================================
+
+MeshletBuildReport MeshletBuilder::Build(const VertexDataView& vertices, const uint32_t* indices, size_t indexCount,
+    MeshletData& outMeshlets, const MeshletBuildOptions& options)
+{
+    KJ_PROFILE_SCOPE("Build Meshlets");
+    const int64_t start = SteadyClock::Now();
+
+    if (options.MaxVertices < 3 || options.MaxVertices > kMaxMeshletVertices ||
+        options.MaxTriangles == 0 || options.MaxTriangles > kMaxMeshletTriangles)
+    {
+        throw std::invalid_argument("MeshletBuilder: MaxVertices must be 3 to 256 and MaxTriangles 1 to 256");
+    }
+
+    MeshletBuildReport report;
+    outMeshlets.Clear();
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0)
+    {
+        return report;
+    }
+    const PositionReader positions(vertices);
+    const size_t vertexCount = vertices.GetVertexCount();
+    ValidateIndices(indices, triangleCount * 3, vertexCount);
+
+    std::vector<TriangleRecord> triangles(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        TriangleRecord& record = triangles[t];
+        std::memcpy(record.Vertices, indices + t * 3, sizeof(record.Vertices));
+        record.State = kNone;
+        record.Centroid = Scale(Add(Add(positions[record.Vertices[0]], positions[record.Vertices[1]]), positions[record.Vertices[2]]),
+            1.0f / 3.0f);
+        record.Padding = 0;
+    }
+
+    const TriangleAdjacency adjacency = TriangleAdjacency::Build(indices, triangleCount, vertexCount);
+    CentroidTree tree(triangles);
+    std::vector<uint16_t> localIndex(vertexCount, kNoLocalIndex);
+
+    outMeshlets.Meshlets.reserve(triangleCount / options.MaxTriangles + 1);
+    outMeshlets.TriangleIndices.reserve(triangleCount * 3);
+    outMeshlets.VertexIndices.reserve(vertexCount + vertexCount / 2);
+
+    // ǰmeshlet
+    Meshlet current;
+    std::vector<MeshletCandidate> candidates;
+    Float3 centroidSum = { 0.0f, 0.0f, 0.0f };
+    Float3 seedPoint = triangles[0].Centroid;
+
+    auto countNewVertices = [&localIndex](const uint32_t* triangle)
+    {
+        const uint32_t a = triangle[0], b = triangle[1], c = triangle[2];
+        return uint32_t(localIndex[a] == kNoLocalIndex) +
+            uint32_t(localIndex[b] == kNoLocalIndex && b != a) +
+            uint32_t(localIndex[c] == kNoLocalIndex && c != a && c != b);
+    };
+
+    auto addVertex = [&](uint32_t vertex)
+    {
+        localIndex[vertex] = static_cast<uint16_t>(current.VertexCount++);
+        outMeshlets.VertexIndices.push_back(vertex);
+
+        for (MeshletCandidate& candidate : candidates)
+        {
+            if (candidate.Vertices[0] == vertex || candidate.Vertices[1] == vertex || candidate.Vertices[2] == vertex)
+            {
+                --candidate.NewVertices;
+            }
+        }
+
+        const uint32_t meshletIndex = static_cast<uint32_t>(outMeshlets.Meshlets.size());
+        for (uint32_t j = adjacency.Offsets[vertex]; j < adjacency.Offsets[vertex + 1]; ++j)
+        {
+            const uint32_t triangle = adjacency.Triangles[j];
+            TriangleRecord& record = triangles[triangle];
+            if (record.State == kEmitted || record.State == meshletIndex)
+            {
+                continue;
+            }
+            record.State = meshletIndex;
+            MeshletCandidate candidate;
+            candidate.Triangle = triangle;
+            std::memcpy(candidate.Vertices, record.Vertices, sizeof(candidate.Vertices));
+            candidate.Centroid = record.Centroid;
+            candidate.NewVertices = countNewVertices(candidate.Vertices);
+            candidates.push_back(candidate);
+        }
+    };
+
+    auto addTriangle = [&](uint32_t triangleIndex)
+    {
+        TriangleRecord& record = triangles[triangleIndex];
+        record.State = kEmitted;
+        for (int k = 0; k < 3; ++k)
+        {
+            const uint32_t vertex = record.Vertices[k];
+            if (localIndex[vertex] == kNoLocalIndex)
+            {
+                addVertex(vertex);
+            }
+            outMeshlets.TriangleIndices.push_back(static_cast<uint8_t>(localIndex[vertex]));
+        }
+        ++current.TriangleCount;
+        centroidSum = Add(centroidSum, record.Centroid);
+    };
+
+    auto finishMeshlet = [&]()
+    {
+        for (uint32_t i = 0; i < current.VertexCount; ++i)
+        {
+            localIndex[outMeshlets.VertexIndices[current.VertexOffset + i]] = kNoLocalIndex;
+        }
+        seedPoint = Scale(centroidSum, 1.0f / static_cast<float>(current.TriangleCount));
+        outMeshlets.Meshlets.push_back(current);
+        candidates.clear();
+
+        current = Meshlet();
+        current.VertexOffset = static_cast<uint32_t>(outMeshlets.VertexIndices.size());
+        current.TriangleOffset = static_cast<uint32_t>(outMeshlets.TriangleIndices.size());
+        centroidSum = { 0.0f, 0.0f, 0.0f };
+    };
+
+    {
+        KJ_PROFILE_SCOPE("Grow Meshlets");
+        for (size_t remaining = triangleCount; remaining > 0;)
+        {
+            const Float3 center = current.TriangleCount > 0
+                ? Scale(centroidSum, 1.0f / static_cast<float>(current.TriangleCount)) : seedPoint;
+
+            // ѡ¶٣
+            size_t bestSlot = kNone;
+            uint32_t bestNewVertices = kNone;
+            float bestDistance = std::numeric_limits<float>::max();
+            for (size_t i = 0; i < candidates.size(); ++i)
+            {
+                const MeshletCandidate& candidate = candidates[i];
+                if (current.VertexCount + candidate.NewVertices > options.MaxVertices || candidate.NewVertices > bestNewVertices)
+                {
+                    continue;
+                }
+                const Float3 delta = Subtract(candidate.Centroid, center);
+                const float distance = Dot(delta, delta);
+                if (candidate.NewVertices < bestNewVertices || distance < bestDistance)
+                {
+                    bestSlot = i;
+                    bestNewVertices = candidate.NewVertices;
+                    bestDistance = distance;
+                }
+            }
+
+            uint32_t best = kNone;
+            if (bestSlot != kNone)
+            {
+                best = candidates[bestSlot].Triangle;
+                candidates[bestSlot] = candidates.back();
+                candidates.pop_back();
+            }
+            else
+            {
+                // ڵĶŲ£ͨmeshletѾ룺meshletһӸʼ
+                const bool closeMeshlet = !candidates.empty() || (current.TriangleCount > 0 &&
+                    (current.TriangleCount * 2 >= options.MaxTriangles || current.VertexCount + 3 > options.MaxVertices));
+                if (closeMeshlet)
+                {
+                    finishMeshlet();
+                    continue;
+                }
+                best = tree.FindNearest(center);
+            }
+
+            addTriangle(best);
+            --remaining;
+            if (current.TriangleCount == options.MaxTriangles)
+            {
+                finishMeshlet();
+            }
+        }
+        if (current.TriangleCount > 0)
+        {
+            finishMeshlet();
+        }
+    }
+
+    // Χ
+    const size_t meshletCount = outMeshlets.Meshlets.size();
+    outMeshlets.Bounds.resize(meshletCount);
+    const size_t batchCount = (meshletCount + kBoundsBatchSize - 1) / kBoundsBatchSize;
+    const uint32_t threadCount = Parallel::ResolveThreadCount(options.ThreadCount);
+    {
+        KJ_PROFILE_SCOPE("Meshlet Bounds");
+        const MeshletDataView view = outMeshlets.GetView();
+        Parallel::Run(batchCount, threadCount, "Meshlet", [&](size_t batch)
+        {
+            const size_t end = std::min(meshletCount, (batch + 1) * kBoundsBatchSize);
+            for (size_t i = batch * kBoundsBatchSize; i < end; ++i)
+            {
+                outMeshlets.Bounds[i] = ComputeMeshletBounds(positions, view, i);
+            }
+        });
+    }
+
+    report.MeshletCount = meshletCount;
+    report.TriangleCount = triangleCount;
+    report.AverageVertexCount = static_cast<double>(outMeshlets.VertexIndices.size()) / static_cast<double>(meshletCount);
+    report.AverageTriangleCount = static_cast<double>(triangleCount) / static_cast<double>(meshletCount);
+    report.ThreadCount = static_cast<uint32_t>(std::min<size_t>(threadCount, batchCount));
+    report.Milliseconds = static_cast<double>(SteadyClock::Now() - start) / 1.0e6;
+    return report;
+}
+
+
+MeshletBounds MeshletBuilder::ComputeBounds(const VertexDataView& vertices, const MeshletDataView& meshlets, size_t meshletIndex)
+{
+    if (meshletIndex >= meshlets.MeshletCount)
+    {
+        throw std::out_of_range("MeshletBuilder: meshlet index out of range");
+    }
+    return ComputeMeshletBounds(PositionReader(vertices), meshlets, meshletIndex);
+}
+
+
+// =======================================================================
+//                        ޳
+// =======================================================================
+
+void MeshletCuller::ExtractFrustumPlanes(const VertexKernels::Matrix4x4& viewProjection, float outPlanes[6][4])
+{
+    // Լ²üvеĵclip.x = vc0 ...-w <= x,y <= w0 <= z <= w
+    const auto& m = viewProjection.m;
+    auto column = [&m](int c, float* out)
+    {
+        for (int r = 0; r < 4; ++r)
+        {
+            out[r] = m[r][c];
+        }
+    };
+    float c0[4], c1[4], c2[4], c3[4];
+    column(0, c0);
+    column(1, c1);
+    column(2, c2);
+    column(3, c3);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        outPlanes[0][i] = c3[i] + c0[i];    // 
+        outPlanes[1][i] = c3[i] - c0[i];    // 
+        outPlanes[2][i] = c3[i] + c1[i];    // 
+        outPlanes[3][i] = c3[i] - c1[i];    // 
+        outPlanes[4][i] = c2[i];            // 
+        outPlanes[5][i] = c3[i] - c2[i];    // Զ
+    }
+    for (int p = 0; p < 6; ++p)
+    {
+        const float length = std::sqrt(outPlanes[p][0] * outPlanes[p][0] + outPlanes[p][1] * outPlanes[p][1] +
+            outPlanes[p][2] * outPlanes[p][2]);
+        if (length > 0.0f)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                outPlanes[p][i] /= length;
+            }
+        }
+    }
+}
+
+
+bool MeshletCuller::IsOutsideFrustum(const MeshletBounds& bounds, const float planes[6][4])
+{
+    for (int p = 0; p < 6; ++p)
+    {
+        const float distance = planes[p][0] * bounds.Center[0] + planes[p][1] * bounds.Center[1] +
+            planes[p][2] * bounds.Center[2] + planes[p][3];
+        if (distance < -bounds.Radius)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool MeshletCuller::IsBackfacing(const MeshletBounds& bounds, const float cameraPosition[3])
+{
+    if (bounds.ConeCutoff >= 1.0f)
+    {
+        return false;
+    }
+    const float dx = bounds.ConeApex[0] - cameraPosition[0];
+    const float dy = bounds.ConeApex[1] - cameraPosition[1];
+    const float dz = bounds.ConeApex[2] - cameraPosition[2];
+    const float projection = dx * bounds.ConeAxis[0] + dy * bounds.ConeAxis[1] + dz * bounds.ConeAxis[2];
+    return projection > bounds.ConeCutoff * std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+
+MeshletCullResult MeshletCuller::Cull(const MeshletDataView& meshlets, const MeshletCullParams& params)
+{
+    KJ_PROFILE_SCOPE("Cull Meshlets");
+    const int64_t start = SteadyClock::Now();
+
+    const size_t meshletCount = meshlets.MeshletCount;
+    if (meshletCount > 0 && (meshlets.Meshlets == nullptr || meshlets.Bounds == nullptr))
+    {
+        throw std::invalid_argument("MeshletCuller: meshlet count is set but meshlets or bounds are null");
+    }
+
+    // ÿռ˳ƴ߳޹
+    struct BatchResult
+    {
+        std::vector<uint32_t> Visible;
+        size_t TriangleCount = 0;
+        size_t FrustumCulled = 0;
+        size_t ConeCulled = 0;
+    };
+    const size_t batchCount = (meshletCount + kCullBatchSize - 1) / kCullBatchSize;
+    std::vector<BatchResult> batches(batchCount);
+    const uint32_t threadCount = Parallel::ResolveThreadCount(params.ThreadCount);
+    Parallel::Run(batchCount, threadCount, "Meshlet", [&](size_t batch)
+    {
+        BatchResult& out = batches[batch];
+        const size_t begin = batch * kCullBatchSize;
+        const size_t end = std::min(meshletCount, begin + kCullBatchSize);
+        out.Visible.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i)
+        {
+            const MeshletBounds& bounds = meshlets.Bounds[i];
+            if (params.FrustumCulling && IsOutsideFrustum(bounds, params.FrustumPlanes))
+            {
+                ++out.FrustumCulled;
+                continue;
+            }
+            if (params.ConeCulling && IsBackfacing(bounds, params.CameraPosition))
+            {
+                ++out.ConeCulled;
+                continue;
+            }
+            out.Visible.push_back(static_cast<uint32_t>(i));
+            out.TriangleCount += meshlets.Meshlets[i].TriangleCount;
+        }
+    });
+
+    MeshletCullResult result;
+    size_t visibleCount = 0;
+    for (const BatchResult& batch : batches)
+    {
+        visibleCount += batch.Visible.size();
+    }
+    result.VisibleMeshlets.reserve(visibleCount);
+    for (const BatchResult& batch : batches)
+    {
+        result.VisibleMeshlets.insert(result.VisibleMeshlets.end(), batch.Visible.begin(), batch.Visible.end());
+        result.VisibleTriangleCount += batch.TriangleCount;
+        result.FrustumCulledCount += batch.FrustumCulled;
+        result.ConeCulledCount += batch.ConeCulled;
+    }
+    result.ThreadCount = static_cast<uint32_t>(std::min<size_t>(threadCount, batchCount));
+    result.Milliseconds = static_cast<double>(SteadyClock::Now() - start) / 1.0e6;
+    return result;
+}
+
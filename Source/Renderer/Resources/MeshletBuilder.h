@@ -0,0 +1,181 @@
+// MeshletBuilder.h
+#pragma once
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/VertexKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief һmeshlet̸ʽļļ¼ͬ
+ */
+struct Meshlet
+{
+    uint32_t VertexOffset = 0;      // VertexIndicesеʼλ
+    uint32_t VertexCount = 0;
+    uint32_t TriangleOffset = 0;    // TriangleIndicesеʼλã * 3
+    uint32_t TriangleCount = 0;
+};
+static_assert(sizeof(Meshlet) == 16, "Meshlet layout changed");
+
+/**
+ * @brief meshlet޳ݣ̸ʽ
+ * @details Χ׶޳׶ڱ޳
+ *          dot(normalize(ConeApex - λ), ConeAxis) > ConeCutoff ʱζ
+ * @note ߰cross(v1 - v0, v2 - v0)㣬ϵ˳ʱ棨D3DĬϣĳⷽ
+ *       γ̫ɢʱConeCutoffΪ1׶Զ
+ */
+struct MeshletBounds
+{
+    float Center[3] = {};
+    float Radius = 0.0f;
+    float ConeApex[3] = {};
+    float ConeCutoff = 1.0f;        // ƫǵ
+    float ConeAxis[3] = {};
+    float Reserved = 0.0f;
+};
+static_assert(sizeof(MeshletBounds) == 48, "MeshletBounds layout changed");
+
+/**
+ * @brief ڴmeshletݣָMeshletDataӳļ
+ */
+struct MeshletDataView
+{
+    const Meshlet* Meshlets = nullptr;
+    const MeshletBounds* Bounds = nullptr;     // MeshletsһһӦ
+    size_t MeshletCount = 0;
+    const uint32_t* VertexIndices = nullptr;   // meshletڶ -> 񶥵
+    size_t VertexIndexCount = 0;
+    const uint8_t* TriangleIndices = nullptr;  // ÿ3meshletڶ
+    size_t TriangleIndexCount = 0;
+
+    bool IsEmpty() const { return MeshletCount == 0; }
+};
+
+/**
+ * @brief meshlet
+ */
+struct MeshletData
+{
+    std::vector<Meshlet> Meshlets;
+    std::vector<MeshletBounds> Bounds;
+    std::vector<uint32_t> VertexIndices;
+    std::vector<uint8_t> TriangleIndices;
+
+    bool IsEmpty() const { return Meshlets.empty(); }
+    void Clear();
+
+    MeshletDataView GetView() const;
+
+    /**
+     * @brief ͼ
+     */
+    static MeshletData FromView(const MeshletDataView& view);
+};
+
+/**
+ * @brief meshletѡ
+ */
+struct MeshletBuildOptions
+{
+    uint32_t MaxVertices = 64;      // 256meshletڶ8λ
+    uint32_t MaxTriangles = 124;    // 25664/124ǳõmesh shader
+    uint32_t ThreadCount = 0;       // Χݵ߳0ʾӲ߳
+};
+
+/**
+ * @brief meshletͳ
+ */
+struct MeshletBuildReport
+{
+    size_t MeshletCount = 0;
+    size_t TriangleCount = 0;
+    double AverageVertexCount = 0.0;
+    double AverageTriangleCount = 0.0;
+    uint32_t ThreadCount = 0;
+    double Milliseconds = 0.0;
+};
+
+/**
+ * @brief бmeshlet
+ * @details ̰ȼ벻¶㡢¶㡢meshletΣ
+ *          ˾ͽǰmeshletûΣͨ꣩ʱ
+ *          ĵkdδϣǰmeshletһʱΪһmeshlet㣬
+ *          meshletڿռϽաڵmeshletҲһ𡣰Χͷ׶meshletм
+ * @note ֻб3ıʱԶĲ
+ */
+class MeshletBuilder
+{
+public:
+    /**
+     * @brief meshletдoutMeshletsԭݱ滻
+     * @details ҪFloat3POSITIONѡΧԽûλʱ׳쳣
+     */
+    static MeshletBuildReport Build(const VertexDataView& vertices, const uint32_t* indices, size_t indexCount,
+        MeshletData& outMeshlets, const MeshletBuildOptions& options = {});
+
+    /**
+     * @brief ¼һmeshletİΧͷ׶
+     */
+    static MeshletBounds ComputeBounds(const VertexDataView& vertices, const MeshletDataView& meshlets, size_t meshletIndex);
+
+private:
+    MeshletBuilder() = delete;  // ̬
+};
+
+/**
+ * @brief ޳meshletΧͬһռ䣬һռ䣩
+ */
+struct MeshletCullParams
+{
+    float FrustumPlanes[6][4] = {};     // ax + by + cz + d >= 0 ڲ࣬ѹһ
+    float CameraPosition[3] = {};
+    bool FrustumCulling = true;
+    bool ConeCulling = true;
+    uint32_t ThreadCount = 0;           // 0ʾӲ߳
+};
+
+/**
+ * @brief ޳
+ */
+struct MeshletCullResult
+{
+    std::vector<uint32_t> VisibleMeshlets;  // meshlet򣬺߳޹
+    size_t VisibleTriangleCount = 0;
+    size_t FrustumCulledCount = 0;
+    size_t ConeCulledCount = 0;             // ׶ڵ׶жȫ
+    uint32_t ThreadCount = 0;
+    double Milliseconds = 0.0;
+};
+
+/**
+ * @brief CPUϵmeshlet޳׶ + ׶ΪGPU޳Ĳοʵֺͻ׼
+ */
+class MeshletCuller
+{
+public:
+    /**
+     * @brief ͼͶӰȡ׶ƽ棨ԼD3Düռ0 <= z <= w
+     * @details world * view * projectionʱƽռ䣬ֱ޳ռmeshlet
+     * @note ǾŵworldռİΧ뾶׼
+     */
+    static void ExtractFrustumPlanes(const VertexKernels::Matrix4x4& viewProjection, float outPlanes[6][4]);
+
+    /**
+     * @brief ߳޳meshlet
+     */
+    static MeshletCullResult Cull(const MeshletDataView& meshlets, const MeshletCullParams& params);
+
+    /**
+     * @brief meshletİΧǷ׶
+     */
+    static bool IsOutsideFrustum(const MeshletBounds& bounds, const float planes[6][4]);
+
+    /**
+     * @brief meshletǷcameraPositionȫ
+     */
+    static bool IsBackfacing(const MeshletBounds& bounds, const float cameraPosition[3]);
+
+private:
+    MeshletCuller() = delete;  // ̬
+};
@@ -0,0 +1,1085 @@
+// ObjImporter.cpp
+#include "Renderer/Resources/ObjImporter.h"
+#include "Renderer/Resources/Vertex.h"
+#include "Core/MappedFile.h"
+#include "Core/Parallel.h"
+#include "Timer/Clock.h"
+#include "Timer/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <limits>
+
+namespace
+{
+    constexpr int32_t kMissingIndex = std::numeric_limits<int32_t>::min();  // ûдvt/vn
+    constexpr uint32_t kNoIndex = std::numeric_limits<uint32_t>::max();
+
+    // 涥±
+    constexpr uint8_t kRelativePosition = 1;
+    constexpr uint8_t kRelativeTexCoord = 2;
+    constexpr uint8_t kRelativeNormal = 4;
+
+    // 䶥ʱÿĶ
+    constexpr size_t kFillBatchSize = 64 * 1024;
+
+    // 10^0..10^22doubleȷʾβ2^53ʱһγ˳ȷĽ
+    constexpr double kPow10[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    double ElapsedMilliseconds(int64_t start)
+    {
+        return static_cast<double>(SteadyClock::Now() - start) / 1.0e6;
+    }
+
+    // =======================================================================
+    //                        ʷ
+    // =======================================================================
+
+    inline bool IsDigit(char c)
+    {
+        return static_cast<unsigned char>(c - '0') < 10;
+    }
+
+    // '\r'հ״CRLFļԴ
+    inline bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline const char* SkipSpaces(const char* p, const char* end)
+    {
+        while (p < end && IsSpace(*p))
+        {
+            ++p;
+        }
+        return p;
+    }
+
+    /**
+     * @brief ʮƸʧܷnullptr
+     * @details ȡ19λЧֽuint64βָڡ22ʱһξȷĳ˳˻std::pow
+     *          תfloatstrtof1ulplocaleӰ
+     */
+    const char* ParseFloat(const char* p, const char* end, float& out)
+    {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            negative = *p == '-';
+            ++p;
+        }
+
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        bool anyDigit = false;
+        for (; p < end && IsDigit(*p); ++p)
+        {
+            anyDigit = true;
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                digits += mantissa != 0;
+            }
+            else
+            {
+                ++exponent;
+            }
+        }
+        if (p < end && *p == '.')
+        {
+            for (++p; p < end && IsDigit(*p); ++p)
+            {
+                anyDigit = true;
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    digits += mantissa != 0;
+                    --exponent;
+                }
+            }
+        }
+        if (!anyDigit)
+        {
+            return nullptr;
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E'))
+        {
+            const char* q = p + 1;
+            bool exponentNegative = false;
+            if (q < end && (*q == '-' || *q == '+'))
+            {
+                exponentNegative = *q == '-';
+                ++q;
+            }
+            if (q == end || !IsDigit(*q))
+            {
+                return nullptr;
+            }
+            int value = 0;
+            for (; q < end && IsDigit(*q); ++q)
+            {
+                if (value < 100000)
+                {
+                    value = value * 10 + (*q - '0');
+                }
+            }
+            exponent += exponentNegative ? -value : value;
+            p = q;
+        }
+
+        double value = 0.0;
+        if (mantissa != 0)
+        {
+            value = static_cast<double>(mantissa);
+            if (exponent >= -22 && exponent <= 22 && mantissa <= (1ull << 53))
+            {
+                value = exponent < 0 ? value / kPow10[-exponent] : value * kPow10[exponent];
+            }
+            else
+            {
+                value *= std::pow(10.0, exponent);
+            }
+        }
+        out = static_cast<float>(negative ? -value : value);
+        return p;
+    }
+
+    /**
+     * @brief ʧܷnullptr
+     */
+    const char* ParseInteger(const char* p, const char* end, int64_t& out)
+    {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            negative = *p == '-';
+            ++p;
+        }
+        if (p == end || !IsDigit(*p))
+        {
+            return nullptr;
+        }
+        int64_t value = 0;
+        for (; p < end && IsDigit(*p); ++p)
+        {
+            if (value < (int64_t(1) << 40))
+            {
+                value = value * 10 + (*p - '0');
+            }
+        }
+        out = negative ? -value : value;
+        return p;
+    }
+
+    /**
+     * @brief һʣµĸmaxCountĺ
+     * @return ݷ-1
+     */
+    int ParseFloats(const char* p, const char* end, float* out, int maxCount)
+    {
+        int count = 0;
+        while (true)
+        {
+            p = SkipSpaces(p, end);
+            if (p == end || *p == '#' || count == maxCount)
+            {
+                return count;
+            }
+            const char* next = ParseFloat(p, end, out[count]);
+            if (next == nullptr || (next != end && !IsSpace(*next)))
+            {
+                return -1;
+            }
+            ++count;
+            p = next;
+        }
+    }
+
+    // =======================================================================
+    //                        ֿ
+    // =======================================================================
+
+    /**
+     * @brief һĽ±궼ǿڵ
+     */
+    struct ObjChunk
+    {
+        const char* Begin = nullptr;
+        const char* End = nullptr;
+
+        std::vector<float> Positions;           // xyz
+        std::vector<float> Colors;              // rgbֶɫŷ䣬֮Positionsȳ
+        std::vector<float> TexCoords;           // uv
+        std::vector<float> Normals;             // xyz
+        std::vector<int32_t> Corners;           // ǻÿǵ(v, vt, vn)0ʼȱʡΪkMissingIndex
+        std::vector<uint8_t> RelativeFlags;     // ÿһֽڣָ±ŷ
+        std::vector<uint32_t> TriangleLines;    // ÿԵĿкţϲʱ±Խ籨
+        bool HasRelativeIndices = false;
+
+        size_t LineCount = 0;
+        size_t PolygonCount = 0;
+
+        std::string Error;
+        size_t ErrorLine = 0;                   // кţ0ʼ
+    };
+
+    /**
+     * @brief ʱõʱ
+     */
+    struct FaceScratch
+    {
+        std::vector<int32_t> Corners;
+        std::vector<uint8_t> Flags;
+    };
+
+    /**
+     * @brief OBJ±ת±꣺1ʼԵǰѶָǰĿ飩
+     */
+    bool ResolveLocalIndex(int64_t value, size_t definedCount, int32_t& outIndex, bool& outRelative)
+    {
+        if (value > 0)
+        {
+            if (value > std::numeric_limits<int32_t>::max())
+            {
+                return false;
+            }
+            outIndex = static_cast<int32_t>(value - 1);
+            outRelative = false;
+            return true;
+        }
+        if (value < 0)
+        {
+            int64_t local = static_cast<int64_t>(definedCount) + value;
+            if (local <= std::numeric_limits<int32_t>::min())
+            {
+                return false;
+            }
+            outIndex = static_cast<int32_t>(local);
+            outRelative = true;
+            return true;
+        }
+        return false;
+    }
+
+    const char* ParseFace(ObjChunk& chunk, const char* p, const char* end, FaceScratch& scratch)
+    {
+        scratch.Corners.clear();
+        scratch.Flags.clear();
+        uint8_t faceFlags = 0;
+
+        const size_t definedCounts[3] = { chunk.Positions.size() / 3, chunk.TexCoords.size() / 2, chunk.Normals.size() / 3 };
+        static constexpr uint8_t kRelativeBits[3] = { kRelativePosition, kRelativeTexCoord, kRelativeNormal };
+
+        while (true)
+        {
+            p = SkipSpaces(p, end);
+            if (p == end || *p == '#')
+            {
+                break;
+            }
+
+            // vv/vtv//vnv/vt/vn
+            int32_t corner[3] = { kMissingIndex, kMissingIndex, kMissingIndex };
+            uint8_t flags = 0;
+            for (int component = 0; component < 3; ++component)
+            {
+                if (component > 0)
+                {
+                    if (p == end || *p != '/')
+                    {
+                        break;
+                    }
+                    ++p;
+                    // v//vnvtΪ
+                    if (component == 1 && p < end && *p == '/')
+                    {
+                        continue;
+                    }
+                }
+
+                int64_t value = 0;
+                p = ParseInteger(p, end, value);
+                if (p == nullptr)
+                {
+                    return "Malformed face vertex";
+                }
+                bool relative = false;
+                if (!ResolveLocalIndex(value, definedCounts[component], corner[component], relative))
+                {
+                    return "Invalid face index (OBJ indices start at 1)";
+                }
+                flags |= relative ? kRelativeBits[component] : 0;
+            }
+            if (p != end && !IsSpace(*p))
+            {
+                return "Malformed face vertex";
+            }
+
+            scratch.Corners.insert(scratch.Corners.end(), corner, corner + 3);
+            scratch.Flags.push_back(flags);
+            faceFlags |= flags;
+        }
+
+        const size_t cornerCount = scratch.Flags.size();
+        if (cornerCount < 3)
+        {
+            return "Face needs at least 3 vertices";
+        }
+
+        if (faceFlags != 0 && !chunk.HasRelativeIndices)
+        {
+            chunk.RelativeFlags.resize(chunk.Corners.size() / 3, 0);
+            chunk.HasRelativeIndices = true;
+        }
+
+        // ǻ
+        for (size_t i = 1; i + 1 < cornerCount; ++i)
+        {
+            for (size_t corner : { size_t(0), i, i + 1 })
+            {
+                chunk.Corners.insert(chunk.Corners.end(), scratch.Corners.begin() + corner * 3, scratch.Corners.begin() + corner * 3 + 3);
+                if (chunk.HasRelativeIndices)
+                {
+                    chunk.RelativeFlags.push_back(scratch.Flags[corner]);
+                }
+            }
+        }
+        chunk.TriangleLines.insert(chunk.TriangleLines.end(), cornerCount - 2, static_cast<uint32_t>(chunk.LineCount));
+        ++chunk.PolygonCount;
+        return nullptr;
+    }
+
+    /**
+     * @brief һУp׿հףendβʧܷشϢ
+     */
+    const char* ParseLine(ObjChunk& chunk, const char* p, const char* end, FaceScratch& scratch)
+    {
+        static constexpr const char* kInvalidNumber = "Invalid floating-point number";
+
+        if (p == end || *p == '#')
+        {
+            return nullptr;
+        }
+
+        auto isKeyword = [p, end](size_t length)
+        {
+            return p + length == end || IsSpace(p[length]);
+        };
+
+        if (*p == 'v')
+        {
+            float values[6];
+            if (isKeyword(1))
+            {
+                // v x y z [w]  v x y z r g b
+                int count = ParseFloats(p + 1, end, values, 6);
+                if (count < 0)
+                {
+                    return kInvalidNumber;
+                }
+                if (count < 3)
+                {
+                    return "Vertex position needs 3 components";
+                }
+                const size_t previousCount = chunk.Positions.size() / 3;
+                chunk.Positions.insert(chunk.Positions.end(), values, values + 3);
+                if (count == 6)
+                {
+                    if (chunk.Colors.empty())
+                    {
+                        chunk.Colors.resize(previousCount * 3, 1.0f);
+                    }
+                    chunk.Colors.insert(chunk.Colors.end(), values + 3, values + 6);
+                }
+                else if (!chunk.Colors.empty())
+                {
+                    chunk.Colors.insert(chunk.Colors.end(), { 1.0f, 1.0f, 1.0f });
+                }
+                return nullptr;
+            }
+            if (p + 1 < end && p[1] == 't' && isKeyword(2))
+            {
+                // vt u [v [w]]
+                values[1] = 0.0f;
+                int count = ParseFloats(p + 2, end, values, 2);
+                if (count < 0)
+                {
+                    return kInvalidNumber;
+                }
+                if (count < 1)
+                {
+                    return "Texture coordinate needs at least 1 component";
+                }
+                chunk.TexCoords.insert(chunk.TexCoords.end(), values, values + 2);
+                return nullptr;
+            }
+            if (p + 1 < end && p[1] == 'n' && isKeyword(2))
+            {
+                int count = ParseFloats(p + 2, end, values, 3);
+                if (count < 0)
+                {
+                    return kInvalidNumber;
+                }
+                if (count < 3)
+                {
+                    return "Normal needs 3 components";
+                }
+                chunk.Normals.insert(chunk.Normals.end(), values, values + 3);
+                return nullptr;
+            }
+            return nullptr;
+        }
+
+        if (*p == 'f' && isKeyword(1))
+        {
+            return ParseFace(chunk, p + 1, end, scratch);
+        }
+        return nullptr;
+    }
+
+    void ParseChunk(ObjChunk& chunk)
+    {
+        KJ_PROFILE_SCOPE("Parse OBJ Chunk");
+
+        FaceScratch scratch;
+        const char* p = chunk.Begin;
+        const char* end = chunk.End;
+        while (p < end)
+        {
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (lineEnd == nullptr)
+            {
+                lineEnd = end;
+            }
+
+            const char* error = ParseLine(chunk, SkipSpaces(p, lineEnd), lineEnd, scratch);
+            if (error != nullptr)
+            {
+                chunk.Error = error;
+                chunk.ErrorLine = chunk.LineCount;
+                return;
+            }
+            ++chunk.LineCount;
+            p = lineEnd < end ? lineEnd + 1 : end;
+        }
+    }
+
+    /**
+     * @brief жп
+     */
+    std::vector<ObjChunk> SplitChunks(const char* data, size_t size, uint32_t threadCount, size_t minChunkSize)
+    {
+        size_t chunkCount = size / std::max<size_t>(minChunkSize, 1);
+        chunkCount = std::clamp<size_t>(chunkCount, 1, static_cast<size_t>(threadCount) * 4);
+
+        std::vector<ObjChunk> chunks;
+        chunks.reserve(chunkCount);
+        const char* end = data + size;
+        const char* begin = data;
+        for (size_t i = 1; i <= chunkCount && begin < end; ++i)
+        {
+            const char* chunkEnd = end;
+            if (i < chunkCount)
+            {
+                const char* target = std::max(begin, data + size / chunkCount * i);
+                const char* newline = static_cast<const char*>(std::memchr(target, '\n', static_cast<size_t>(end - target)));
+                chunkEnd = newline != nullptr ? newline + 1 : end;
+            }
+
+            ObjChunk chunk;
+            chunk.Begin = begin;
+            chunk.End = chunkEnd;
+            chunks.push_back(std::move(chunk));
+            begin = chunkEnd;
+        }
+        return chunks;
+    }
+
+    // =======================================================================
+    //                        ϲ
+    // =======================================================================
+
+    /**
+     * @brief ϲȫ
+     */
+    struct ObjStreams
+    {
+        std::vector<float> Positions;
+        std::vector<float> Colors;      // ձʾļûжɫ
+        std::vector<float> TexCoords;
+        std::vector<float> Normals;
+        std::vector<uint32_t> Corners;  // ÿ(v, vt, vn)ȱʡΪkNoIndex
+        size_t CornerCount = 0;
+
+        size_t PositionCount() const { return Positions.size() / 3; }
+        size_t TexCoordCount() const { return TexCoords.size() / 2; }
+        size_t NormalCount() const { return Normals.size() / 3; }
+    };
+
+    /**
+     * @brief ĳһvtvnڸʹжֱܷv
+     */
+    struct SharedIndexUsage
+    {
+        bool Present = false;       // нд
+        bool Missing = false;       // нûд
+        bool Mismatch = false;      // нд±vͬ
+
+        void Merge(const SharedIndexUsage& other)
+        {
+            Present |= other.Present;
+            Missing |= other.Missing;
+            Mismatch |= other.Mismatch;
+        }
+
+        bool IsShared() const { return !Mismatch && !(Present && Missing); }
+    };
+
+    struct ChunkMergeInfo
+    {
+        size_t PositionBase = 0;
+        size_t TexCoordBase = 0;
+        size_t NormalBase = 0;
+        size_t CornerBase = 0;
+        size_t LineBase = 0;            // ǰʱѿкŻļк
+        SharedIndexUsage TexCoordUsage;
+        SharedIndexUsage NormalUsage;
+    };
+
+    /**
+     * @brief һ鿽ȫ鲢±껻ȫֵģͷſڴ
+     */
+    void MergeChunk(ObjChunk& chunk, ChunkMergeInfo& info, ObjStreams& streams)
+    {
+        KJ_PROFILE_SCOPE("Merge OBJ Chunk");
+
+        std::copy(chunk.Positions.begin(), chunk.Positions.end(), streams.Positions.begin() + info.PositionBase * 3);
+        std::copy(chunk.TexCoords.begin(), chunk.TexCoords.end(), streams.TexCoords.begin() + info.TexCoordBase * 2);
+        std::copy(chunk.Normals.begin(), chunk.Normals.end(), streams.Normals.begin() + info.NormalBase * 3);
+        if (!streams.Colors.empty())
+        {
+            float* colors = streams.Colors.data() + info.PositionBase * 3;
+            if (chunk.Colors.empty())
+            {
+                std::fill(colors, colors + chunk.Positions.size(), 1.0f);
+            }
+            else
+            {
+                std::copy(chunk.Colors.begin(), chunk.Colors.end(), colors);
+            }
+        }
+
+        const size_t bases[3] = { info.PositionBase, info.TexCoordBase, info.NormalBase };
+        const size_t totals[3] = { streams.PositionCount(), streams.TexCoordCount(), streams.NormalCount() };
+        static constexpr uint8_t kRelativeBits[3] = { kRelativePosition, kRelativeTexCoord, kRelativeNormal };
+        static constexpr const char* kStreamNames[3] = { "position", "texture coordinate", "normal" };
+
+        const size_t cornerCount = chunk.Corners.size() / 3;
+        const bool hasRelative = chunk.HasRelativeIndices;
+        uint32_t* out = streams.Corners.data() + info.CornerBase * 3;
+        for (size_t corner = 0; corner < cornerCount; ++corner)
+        {
+            const uint8_t flags = hasRelative ? chunk.RelativeFlags[corner] : 0;
+            for (int component = 0; component < 3; ++component)
+            {
+                const int32_t local = chunk.Corners[corner * 3 + component];
+                if (local == kMissingIndex)
+                {
+                    out[corner * 3 + component] = kNoIndex;
+                    continue;
+                }
+
+                int64_t global = local;
+                if (flags & kRelativeBits[component])
+                {
+                    global += static_cast<int64_t>(bases[component]);
+                }
+                if (global < 0 || static_cast<size_t>(global) >= totals[component])
+                {
+                    chunk.Error = std::string("Face references ") + kStreamNames[component] + " " +
+                        std::to_string(global + 1) + " but the file defines " + std::to_string(totals[component]);
+                    chunk.ErrorLine = chunk.TriangleLines[corner / 3];
+                    return;
+                }
+                out[corner * 3 + component] = static_cast<uint32_t>(global);
+            }
+
+            const uint32_t* resolved = out + corner * 3;
+            SharedIndexUsage* usages[2] = { &info.TexCoordUsage, &info.NormalUsage };
+            for (int component = 1; component < 3; ++component)
+            {
+                SharedIndexUsage& usage = *usages[component - 1];
+                if (resolved[component] == kNoIndex)
+                {
+                    usage.Missing = true;
+                }
+                else
+                {
+                    usage.Present = true;
+                    usage.Mismatch |= resolved[component] != resolved[0];
+                }
+            }
+        }
+
+        chunk.Positions = {};
+        chunk.Colors = {};
+        chunk.TexCoords = {};
+        chunk.Normals = {};
+        chunk.Corners = {};
+        chunk.RelativeFlags = {};
+        chunk.TriangleLines = {};
+    }
+
+    inline uint64_t HashCorner(const uint32_t* corner)
+    {
+        uint64_t hash = static_cast<uint64_t>(corner[0]) * 0x9E3779B97F4A7C15ull;
+        hash ^= static_cast<uint64_t>(corner[1]) * 0xC2B2AE3D27D4EB4Full;
+        hash ^= static_cast<uint64_t>(corner[2]) * 0x165667B19E3779F9ull;
+        hash ^= hash >> 32;
+        hash *= 0xD6E8FEB86659FD93ull;
+        return hash ^ (hash >> 32);
+    }
+
+    /**
+     * @brief (v, vt, vn)ȥأ㰴һγֵ˳
+     * @details Ѱַֻ涥ţoutKeysȽϣسһʱؽ
+     */
+    void WeldCorners(const ObjStreams& streams, std::vector<uint32_t>& outKeys, std::vector<uint32_t>& outIndices)
+    {
+        KJ_PROFILE_SCOPE("Weld OBJ Corners");
+
+        size_t capacity = 1024;
+        while (capacity < streams.PositionCount() * 2)
+        {
+            capacity <<= 1;
+        }
+        std::vector<uint32_t> table(capacity, kNoIndex);
+        size_t mask = capacity - 1;
+
+        outKeys.clear();
+        outKeys.reserve(streams.PositionCount() * 3);
+        outIndices.resize(streams.CornerCount);
+
+        const uint32_t* corners = streams.Corners.data();
+        for (size_t i = 0; i < streams.CornerCount; ++i)
+        {
+            const uint32_t* key = corners + i * 3;
+            size_t slot = static_cast<size_t>(HashCorner(key)) & mask;
+            while (true)
+            {
+                const uint32_t vertex = table[slot];
+                if (vertex == kNoIndex)
+                {
+                    const uint32_t newVertex = static_cast<uint32_t>(outKeys.size() / 3);
+                    table[slot] = newVertex;
+                    outKeys.insert(outKeys.end(), key, key + 3);
+                    outIndices[i] = newVertex;
+                    break;
+                }
+                if (std::memcmp(outKeys.data() + static_cast<size_t>(vertex) * 3, key, sizeof(uint32_t) * 3) == 0)
+                {
+                    outIndices[i] = vertex;
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
+
+            if (outKeys.size() / 3 * 2 > capacity)
+            {
+                capacity <<= 1;
+                mask = capacity - 1;
+                table.assign(capacity, kNoIndex);
+                const size_t vertexCount = outKeys.size() / 3;
+                for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+                {
+                    size_t rehashSlot = static_cast<size_t>(HashCorner(outKeys.data() + vertex * 3)) & mask;
+                    while (table[rehashSlot] != kNoIndex)
+                    {
+                        rehashSlot = (rehashSlot + 1) & mask;
+                    }
+                    table[rehashSlot] = static_cast<uint32_t>(vertex);
+                }
+            }
+        }
+    }
+
+    // =======================================================================
+    //                        װ
+    // =======================================================================
+
+    enum class ObjAttribute
+    {
+        None,
+        Position,
+        TexCoord,
+        Normal,
+        Color,
+    };
+
+    /**
+     * @brief һԪشȡֵ
+     */
+    struct FillElement
+    {
+        ObjAttribute Source = ObjAttribute::None;
+        uint32_t Offset = 0;
+        uint32_t ComponentCount = 0;
+    };
+
+    uint32_t GetFloatComponentCount(VertexFormat format)
+    {
+        switch (format)
+        {
+        case VertexFormat::Float1: return 1;
+        case VertexFormat::Float2: return 2;
+        case VertexFormat::Float3: return 3;
+        case VertexFormat::Float4: return 4;
+        default: return 0;
+        }
+    }
+
+    ObjAttribute GetAttributeSource(const VertexElement& element)
+    {
+        if (element.SemanticIndex != 0)
+        {
+            return ObjAttribute::None;
+        }
+        if (element.SemanticName == "POSITION") return ObjAttribute::Position;
+        if (element.SemanticName == "TEXCOORD") return ObjAttribute::TexCoord;
+        if (element.SemanticName == "NORMAL") return ObjAttribute::Normal;
+        if (element.SemanticName == "COLOR") return ObjAttribute::Color;
+        return ObjAttribute::None;
+    }
+
+    /**
+     * @brief Ŀ겼ֶӦȫfloat֣Ŀ걾ȫfloatʱԭ
+     * @details NORMAL/TANGENT/BINORMALFloat3Short4_NormʱFloat4ఴĿ
+     *          VertexQuantizerѡ/뾫/UNORM8
+     */
+    VertexLayout BuildFloatLayout(const VertexLayout& target)
+    {
+        bool allFloat = true;
+        for (const VertexElement& element : target.GetElements())
+        {
+            allFloat &= GetFloatComponentCount(element.Format) != 0;
+        }
+        if (allFloat)
+        {
+            return target;
+        }
+
+        VertexLayout layout;
+        uint32_t offset = 0;
+        for (const VertexElement& element : target.GetElements())
+        {
+            VertexFormat format = element.Format;
+            switch (element.Format)
+            {
+            case VertexFormat::Half2:
+                format = VertexFormat::Float2;
+                break;
+            case VertexFormat::Short2_Norm:
+                format = element.SemanticName == "POSITION" || element.SemanticName == "TEXCOORD" ?
+                    VertexFormat::Float2 : VertexFormat::Float3;
+                break;
+            case VertexFormat::Half4:
+            case VertexFormat::UByte4_Norm:
+            case VertexFormat::Short4_Norm:
+                format = VertexFormat::Float4;
+                break;
+            default:
+                break;
+            }
+            layout.AddElement(element.SemanticName, format, offset, element.SemanticIndex, element.Slot);
+            offset += GetVertexFormatSize(format);
+        }
+        layout.SetStride(offset);
+        return layout;
+    }
+
+    /**
+     * @brief 䶥
+     * @param keys ÿ(v, vt, vn)Ϊnullptrʱiǵiλã±Ŀ·
+     */
+    void FillVertices(DynamicVertexData& vertices, const ObjStreams& streams, const uint32_t* keys,
+        bool sharedTexCoords, bool sharedNormals, bool flipV, uint32_t threadCount)
+    {
+        const VertexLayout& layout = vertices.GetLayout();
+        std::vector<FillElement> elements;
+        for (const VertexElement& element : layout.GetElements())
+        {
+            FillElement fill;
+            fill.Source = GetAttributeSource(element);
+            fill.Offset = element.Offset;
+            fill.ComponentCount = GetFloatComponentCount(element.Format);
+            elements.push_back(fill);
+        }
+
+        const size_t vertexCount = vertices.GetVertexCount();
+        const size_t stride = vertices.GetStride();
+        uint8_t* base = static_cast<uint8_t*>(vertices.GetData());
+        const size_t texCoordCount = streams.TexCoordCount();
+        const size_t normalCount = streams.NormalCount();
+        const bool hasColors = !streams.Colors.empty();
+
+        const size_t batchCount = (vertexCount + kFillBatchSize - 1) / kFillBatchSize;
+        Parallel::Run(batchCount, threadCount, "OBJ Import", [&](size_t batch)
+        {
+            KJ_PROFILE_SCOPE("Fill OBJ Vertices");
+            const size_t begin = batch * kFillBatchSize;
+            const size_t end = std::min(vertexCount, begin + kFillBatchSize);
+            for (size_t i = begin; i < end; ++i)
+            {
+                uint32_t v = static_cast<uint32_t>(i);
+                uint32_t vt = sharedTexCoords && i < texCoordCount ? v : kNoIndex;
+                uint32_t vn = sharedNormals && i < normalCount ? v : kNoIndex;
+                if (keys != nullptr)
+                {
+                    v = keys[i * 3];
+                    vt = keys[i * 3 + 1];
+                    vn = keys[i * 3 + 2];
+                }
+
+                uint8_t* vertex = base + i * stride;
+                for (const FillElement& element : elements)
+                {
+                    // ûݵķװĹ(0, 0, 0, 1)ɫȱʡΪɫ
+                    float value[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+                    switch (element.Source)
+                    {
+                    case ObjAttribute::Position:
+                        std::memcpy(value, streams.Positions.data() + static_cast<size_t>(v) * 3, sizeof(float) * 3);
+                        break;
+                    case ObjAttribute::Color:
+                        if (hasColors)
+                        {
+                            std::memcpy(value, streams.Colors.data() + static_cast<size_t>(v) * 3, sizeof(float) * 3);
+                        }
+                        else
+                        {
+                            value[0] = value[1] = value[2] = 1.0f;
+                        }
+                        break;
+                    case ObjAttribute::TexCoord:
+                        if (vt != kNoIndex)
+                        {
+                            value[0] = streams.TexCoords[static_cast<size_t>(vt) * 2];
+                            value[1] = streams.TexCoords[static_cast<size_t>(vt) * 2 + 1];
+                            if (flipV)
+                            {
+                                value[1] = 1.0f - value[1];
+                            }
+                        }
+                        break;
+                    case ObjAttribute::Normal:
+                        if (vn != kNoIndex)
+                        {
+                            std::memcpy(value, streams.Normals.data() + static_cast<size_t>(vn) * 3, sizeof(float) * 3);
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                    std::memcpy(vertex + element.Offset, value, sizeof(float) * element.ComponentCount);
+                }
+            }
+        });
+    }
+
+    ObjImportResult Fail(ObjImportResult& result, std::string error)
+    {
+        result.Success = false;
+        result.Error = std::move(error);
+        result.Vertices = DynamicVertexData();
+        result.Indices.clear();
+        return std::move(result);
+    }
+}
+
+
+double ObjImportStats::GetThroughputMBps() const
+{
+    if (TotalMilliseconds <= 0.0)
+    {
+        return 0.0;
+    }
+    return static_cast<double>(FileBytes) / (1024.0 * 1024.0) / (TotalMilliseconds / 1000.0);
+}
+
+
+ObjImportResult ObjImporter::ImportFile(const std::filesystem::path& path, const ObjImportOptions& options)
+{
+    int64_t start = SteadyClock::Now();
+
+    MappedFile file;
+    if (!file.Open(path))
+    {
+        ObjImportResult result;
+        return Fail(result, "Cannot open OBJ file: " + path.string());
+    }
+    file.AdviseSequential();
+    const double mapMilliseconds = ElapsedMilliseconds(start);
+
+    ObjImportResult result = ImportMemory(reinterpret_cast<const char*>(file.GetData()), file.GetSize(), options);
+    result.Stats.MapMilliseconds = mapMilliseconds;
+    result.Stats.TotalMilliseconds = ElapsedMilliseconds(start);
+    if (!result.Success)
+    {
+        result.Error = path.string() + ": " + result.Error;
+    }
+    return result;
+}
+
+
+ObjImportResult ObjImporter::ImportMemory(const char* data, size_t size, const ObjImportOptions& options)
+{
+    KJ_PROFILE_SCOPE("Import OBJ");
+
+    ObjImportResult result;
+    ObjImportStats& stats = result.Stats;
+    stats.FileBytes = size;
+    int64_t start = SteadyClock::Now();
+
+    const VertexLayout target = options.Layout.IsValid() ? options.Layout : VertexLayoutOf<SPositionNormalTexVertex>.ToLayout();
+    const uint32_t threadCount = Parallel::ResolveThreadCount(options.ThreadCount);
+
+    // 1. ֿ鲢н
+    int64_t phaseStart = SteadyClock::Now();
+    std::vector<ObjChunk> chunks = SplitChunks(data, size, threadCount, options.MinChunkSize);
+    stats.ChunkCount = static_cast<uint32_t>(chunks.size());
+    stats.ThreadCount = static_cast<uint32_t>(std::min<size_t>(threadCount, std::max<size_t>(chunks.size(), 1)));
+    Parallel::Run(chunks.size(), threadCount, "OBJ Import", [&chunks](size_t i) { ParseChunk(chunks[i]); });
+    stats.ParseMilliseconds = ElapsedMilliseconds(phaseStart);
+
+    // 2. ǰ׺ͣǰĽ
+    phaseStart = SteadyClock::Now();
+    std::vector<ChunkMergeInfo> mergeInfos(chunks.size());
+    size_t positionCount = 0;
+    size_t texCoordCount = 0;
+    size_t normalCount = 0;
+    size_t cornerCount = 0;
+    bool hasColors = false;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        const ObjChunk& chunk = chunks[i];
+        if (!chunk.Error.empty())
+        {
+            return Fail(result, "line " + std::to_string(stats.LineCount + chunk.ErrorLine + 1) + ": " + chunk.Error);
+        }
+        mergeInfos[i].PositionBase = positionCount;
+        mergeInfos[i].TexCoordBase = texCoordCount;
+        mergeInfos[i].NormalBase = normalCount;
+        mergeInfos[i].CornerBase = cornerCount;
+        mergeInfos[i].LineBase = stats.LineCount;
+        positionCount += chunk.Positions.size() / 3;
+        texCoordCount += chunk.TexCoords.size() / 2;
+        normalCount += chunk.Normals.size() / 3;
+        cornerCount += chunk.Corners.size() / 3;
+        hasColors |= !chunk.Colors.empty();
+        stats.LineCount += chunk.LineCount;
+        stats.PolygonCount += chunk.PolygonCount;
+    }
+
+    if (positionCount == 0)
+    {
+        return Fail(result, "OBJ contains no vertex positions");
+    }
+    if (positionCount >= kNoIndex || cornerCount >= kNoIndex)
+    {
+        return Fail(result, "OBJ is too large for 32-bit indices");
+    }
+
+    ObjStreams streams;
+    streams.Positions.resize(positionCount * 3);
+    streams.Colors.resize(hasColors ? positionCount * 3 : 0);
+    streams.TexCoords.resize(texCoordCount * 2);
+    streams.Normals.resize(normalCount * 3);
+    streams.Corners.resize(cornerCount * 3);
+    streams.CornerCount = cornerCount;
+
+    Parallel::Run(chunks.size(), threadCount, "OBJ Import", [&](size_t i) { MergeChunk(chunks[i], mergeInfos[i], streams); });
+
+    SharedIndexUsage texCoordUsage;
+    SharedIndexUsage normalUsage;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        if (!chunks[i].Error.empty())
+        {
+            return Fail(result, "line " + std::to_string(mergeInfos[i].LineBase + chunks[i].ErrorLine + 1) + ": " + chunks[i].Error);
+        }
+        texCoordUsage.Merge(mergeInfos[i].TexCoordUsage);
+        normalUsage.Merge(mergeInfos[i].NormalUsage);
+    }
+    chunks.clear();
+
+    stats.PositionCount = positionCount;
+    stats.TexCoordCount = texCoordCount;
+    stats.NormalCount = normalCount;
+    stats.TriangleCount = cornerCount / 3;
+
+    // 3. vtvnvʱֱv±꣬(v, vt, vn)ȥ
+    std::vector<uint32_t> vertexKeys;
+    stats.SharedIndexFastPath = texCoordUsage.IsShared() && normalUsage.IsShared();
+    if (stats.SharedIndexFastPath)
+    {
+        result.Indices.resize(cornerCount);
+        for (size_t i = 0; i < cornerCount; ++i)
+        {
+            result.Indices[i] = streams.Corners[i * 3];
+        }
+        stats.VertexCount = positionCount;
+    }
+    else
+    {
+        WeldCorners(streams, vertexKeys, result.Indices);
+        stats.VertexCount = vertexKeys.size() / 3;
+    }
+    streams.Corners = {};
+    stats.MergeMilliseconds = ElapsedMilliseconds(phaseStart);
+
+    // 4. 䣬floatʽ
+    phaseStart = SteadyClock::Now();
+    const VertexLayout floatLayout = BuildFloatLayout(target);
+    DynamicVertexData vertices(floatLayout, stats.VertexCount);
+    uint32_t elementBytes = 0;
+    for (const VertexElement& element : floatLayout.GetElements())
+    {
+        elementBytes += GetVertexFormatSize(element.Format);
+    }
+    if (elementBytes < floatLayout.GetStride())
+    {
+        // Ԫֽ֮㣬֤ȷ
+        std::memset(vertices.GetData(), 0, vertices.GetDataSize());
+    }
+    FillVertices(vertices, streams, vertexKeys.empty() ? nullptr : vertexKeys.data(),
+        stats.SharedIndexFastPath && texCoordUsage.Present, stats.SharedIndexFastPath && normalUsage.Present,
+        options.FlipTexCoordV, threadCount);
+
+    if (floatLayout == target)
+    {
+        result.Vertices = std::move(vertices);
+    }
+    else
+    {
+        try
+        {
+            result.Vertices = VertexQuantizer::Quantize(vertices, target, &result.Quantization);
+        }
+        catch (const std::exception& exception)
+        {
+            return Fail(result, exception.what());
+        }
+    }
+    stats.BuildMilliseconds = ElapsedMilliseconds(phaseStart);
+    stats.TotalMilliseconds = ElapsedMilliseconds(start);
+
+    result.Success = true;
+    return result;
+}
@@ -0,0 +1,89 @@
+// ObjImporter.h
+#pragma once
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/VertexLayout.h"
+#include "Renderer/Resources/VertexQuantizer.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @brief OBJѡ
+ */
+struct ObjImportOptions
+{
+    VertexLayout Layout;                // ֣ЧʱSPositionNormalTexVertexfloatʽȰfloatװٽVertexQuantizer
+    uint32_t ThreadCount = 0;           // 0ʾӲ߳
+    size_t MinChunkSize = 1u << 20;     // ÿôֽڣСļֵò
+    bool FlipTexCoordV = true;          // OBJvϣD3Dv
+};
+
+/**
+ * @brief ͳ
+ */
+struct ObjImportStats
+{
+    size_t FileBytes = 0;
+    size_t LineCount = 0;
+    size_t PositionCount = 0;           // v
+    size_t TexCoordCount = 0;           // vt
+    size_t NormalCount = 0;             // vn
+    size_t PolygonCount = 0;            // fǻ֮ǰ
+    size_t TriangleCount = 0;
+    size_t VertexCount = 0;             // v/vt/vnȥغ
+    bool SharedIndexFastPath = false;   // vtvn±궼vûУֱλõ㣬ȥ
+
+    uint32_t ThreadCount = 0;
+    uint32_t ChunkCount = 0;
+
+    double MapMilliseconds = 0.0;       // 򿪲ӳļ
+    double ParseMilliseconds = 0.0;     // ֿ鲢н
+    double MergeMilliseconds = 0.0;     // ϲ顢±ꡢȥ
+    double BuildMilliseconds = 0.0;     // 䶥㣨
+    double TotalMilliseconds = 0.0;
+
+    /**
+     * @brief ļֽ / ܺʱλMB/s1MB = 2^20ֽڣ
+     */
+    double GetThroughputMBps() const;
+};
+
+/**
+ * @brief 
+ */
+struct ObjImportResult
+{
+    bool Success = false;
+    std::string Error;                  // ʧԭ򣬽к
+
+    DynamicVertexData Vertices;
+    std::vector<uint32_t> Indices;      // б
+    ObjImportStats Stats;
+    VertexQuantizationReport Quantization;  // ֺfloatʽʱЧλĽ
+};
+
+/**
+ * @brief ߳OBJ
+ * @details ļڴӳжп飬鲢нԼ飨ԼĽiostream/strtodlocale
+ *          ٰǰ׺ͺϲѸ±껻ɾ±ꡢ(v, vt, vn)ȥأĿ겼
+ * @note ֧vɴrgbɫvtvnfǻؼ֣ogsusemtlmtlliblpȣԣ
+ *       ֧βбС߿·ʱûõλҲɶ
+ */
+class ObjImporter
+{
+public:
+    /**
+     * @brief ļ
+     */
+    static ObjImportResult ImportFile(const std::filesystem::path& path, const ObjImportOptions& options = {});
+
+    /**
+     * @brief ڴ浼루ڵڼЧ
+     */
+    static ObjImportResult ImportMemory(const char* data, size_t size, const ObjImportOptions& options = {});
+
+private:
+    ObjImporter() = delete;  // ̬
+};
@@ -3,9 +3,27 @@
 #include "Renderer/Resources/VertexComponents.h"
 #include "Renderer/Resources/VertexLayout.h"
 #include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief ȡûSemanticIndexԱʱΪ0
+ */
+template<typename Component>
+constexpr uint32_t GetComponentSemanticIndex()
+{
+    if constexpr (requires { Component::SemanticIndex; })
+    {
+        return Component::SemanticIndex;
+    }
+    else
+    {
+        return 0;
+    }
+}
 
 /**
  * @brief ģ - ʹ϶嶥
+ * @details ڱбɣGetStaticLayoutƫȡoffsetof
  */
 template<typename... Components>
 struct SVertex;
@@ -16,23 +34,51 @@ struct SVertex<Component>
 {
     Component component;
 
-    static VertexLayout GetLayout()
+    static constexpr size_t ComponentCount = 1;
+
+    /**
+     * @brief ڲ
+     */
+    static constexpr StaticVertexLayout<ComponentCount> GetStaticLayout()
     {
-        VertexLayout layout;
-        layout.AddElement(
-            Component::SemanticName,
-            Component::Format,
-            offsetof(SVertex, component),
-            Component::SemanticIndex
-        );
-        layout.CalculateStride();
+        StaticVertexLayout<ComponentCount> layout;
+        FillElements(layout.Elements, 0, 0);
+        layout.Stride = sizeof(SVertex);
+        layout.Hash = layout.ComputeHash();
         return layout;
     }
 
+    /**
+     * @brief ʱ֣ҪظʹʱVertexLayoutRegistry::Get<T>()
+     */
+    static VertexLayout GetLayout()
+    {
+        return GetStaticLayout().ToLayout();
+    }
+
     static constexpr uint32_t GetStride()
     {
         return sizeof(SVertex);
     }
+
+private:
+    template<typename...> friend struct SVertex;
+
+    template<size_t N>
+    static constexpr void FillElements(std::array<StaticVertexElement, N>& elements, size_t index, uint32_t baseOffset)
+    {
+        static_assert(sizeof(Component) == Component::Size, "Component size does not match its declared Size");
+        static_assert(GetVertexFormatSize(Component::Format) == Component::Size,
+            "Component format size does not match its declared Size");
+
+        elements[index] = {
+            Component::SemanticName,
+            GetComponentSemanticIndex<Component>(),
+            Component::Format,
+            baseOffset + static_cast<uint32_t>(offsetof(SVertex, component)),
+            0
+        };
+    }
 };
 
 // ػ2ݹ
@@ -42,58 +88,66 @@ struct SVertex<First, Rest...>
     First first;
     SVertex<Rest...> rest;
 
-    static VertexLayout GetLayout()
+    static constexpr size_t ComponentCount = 1 + sizeof...(Rest);
+
+    /**
+     * @brief ڲ
+     */
+    static constexpr StaticVertexLayout<ComponentCount> GetStaticLayout()
     {
-        VertexLayout layout;
-        BuildLayoutRecursive<First, Rest...>(layout, 0);
-        layout.CalculateStride();
+        static_assert(std::is_standard_layout_v<SVertex>, "SVertex must be standard-layout for offsetof");
+
+        StaticVertexLayout<ComponentCount> layout;
+        FillElements(layout.Elements, 0, 0);
+        layout.Stride = sizeof(SVertex);
+        layout.Hash = layout.ComputeHash();
         return layout;
     }
 
+    /**
+     * @brief ʱ֣ҪظʹʱVertexLayoutRegistry::Get<T>()
+     */
+    static VertexLayout GetLayout()
+    {
+        return GetStaticLayout().ToLayout();
+    }
+
     static constexpr uint32_t GetStride()
     {
         return sizeof(SVertex);
     }
 
 private:
-    template<typename T>
-    static void BuildLayoutRecursive(VertexLayout& layout, uint32_t currentOffset)
-    {
-        uint32_t semanticIndex = 0;
-        if constexpr (requires { T::SemanticIndex; })
-        {
-            semanticIndex = T::SemanticIndex;
-        }
-
-        layout.AddElement(
-            T::SemanticName,
-            T::Format,
-            currentOffset,
-            semanticIndex
-        );
-    }
+    template<typename...> friend struct SVertex;
 
-    template<typename T, typename U, typename... Args>
-    static void BuildLayoutRecursive(VertexLayout& layout, uint32_t currentOffset)
+    template<size_t N>
+    static constexpr void FillElements(std::array<StaticVertexElement, N>& elements, size_t index, uint32_t baseOffset)
     {
-        uint32_t semanticIndex = 0;
-        if constexpr (requires { T::SemanticIndex; })
-        {
-            semanticIndex = T::SemanticIndex;
-        }
-
-        layout.AddElement(
-            T::SemanticName,
-            T::Format,
-            currentOffset,
-            semanticIndex
-        );
-
-        // ݹ鴦һ
-        BuildLayoutRecursive<U, Args...>(layout, currentOffset + T::Size);
+        static_assert(sizeof(First) == First::Size, "Component size does not match its declared Size");
+        static_assert(GetVertexFormatSize(First::Format) == First::Size,
+            "Component format size does not match its declared Size");
+
+        elements[index] = {
+            First::SemanticName,
+            GetComponentSemanticIndex<First>(),
+            First::Format,
+            baseOffset + static_cast<uint32_t>(offsetof(SVertex, first)),
+            0
+        };
+
+        // ݹ鴦һƫۼǶ׳Աʵλ
+        SVertex<Rest...>::FillElements(elements, index + 1,
+            baseOffset + static_cast<uint32_t>(offsetof(SVertex, rest)));
     }
 };
 
+/**
+ * @brief ͵ıڲ
+ * @example static_assert(VertexLayoutOf<SPositionColorVertex>.Stride == 28);
+ */
+template<typename VertexType>
+inline constexpr auto VertexLayoutOf = VertexType::GetStaticLayout();
+
 // öͶ
 using SPositionColorVertex = SVertex<
     VertexComponents::Position,
@@ -126,4 +180,12 @@ using SPositionColorNormalTexVertex = SVertex<
     VertexComponents::Color,
     VertexComponents::Normal,
     VertexComponents::TexCoord
->;
\ No newline at end of file
+>;
+
+// У飺밴4ֽڶԪĩβһ£VertexLayout::CalculateStrideĽ֮ͬû
+static_assert(VertexLayoutOf<SPositionColorVertex>.Stride == 28);
+static_assert(VertexLayoutOf<SPositionNormalTexVertex>.Stride == 32);
+static_assert(VertexLayoutOf<SPositionNormalTexTangentVertex>.Stride == 44);
+static_assert(VertexLayoutOf<SPositionNormalTexTangentBinormalVertex>.Stride == 56);
+static_assert(VertexLayoutOf<SPositionColorNormalTexVertex>.Stride == 48);
+static_assert(VertexLayoutOf<SPositionNormalTexTangentBinormalVertex>.FindElement("BINORMAL")->Offset == 44);
\ No newline at end of file
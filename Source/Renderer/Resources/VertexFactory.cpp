@@ -1 +1,153 @@
-#include "VertexFactory.h"
+// VertexFactory.cpp
+#include "Renderer/Resources/VertexFactory.h"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+// =======================================================================
+//                        ͱ
+// =======================================================================
+
+uint32_t VertexTypeIndex::Allocate()
+{
+    static std::atomic<uint32_t> s_nextIndex{ 0 };
+    return s_nextIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+// =======================================================================
+//                        ע״̬
+// =======================================================================
+
+struct SVertexFactoryRegistry::State
+{
+    std::mutex Mutex;                                       // ֻעᣨд
+    std::atomic<const Snapshot*> Current{ nullptr };        // ߿Ŀ
+    std::vector<std::unique_ptr<const Snapshot>> Published; // пգ߿ܻʹãͷţ
+    bool Sealed = false;
+
+    State()
+    {
+        Published.push_back(std::make_unique<const Snapshot>());
+        Current.store(Published.back().get(), std::memory_order_release);
+    }
+};
+
+SVertexFactoryRegistry::State& SVertexFactoryRegistry::GetState()
+{
+    static State state;
+    return state;
+}
+
+const SVertexFactoryRegistry::Snapshot* SVertexFactoryRegistry::AcquireSnapshot()
+{
+    return GetState().Current.load(std::memory_order_acquire);
+}
+
+void SVertexFactoryRegistry::RegisterFactory(uint32_t typeIndex, SVertexFactoryBase* factory)
+{
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.Mutex);
+
+    if (state.Sealed)
+    {
+        throw std::logic_error(std::string("Vertex factory registry is sealed, cannot register: ") +
+            factory->GetTypeName());
+    }
+
+    const Snapshot* current = state.Current.load(std::memory_order_relaxed);
+    if (typeIndex < current->ByTypeIndex.size() && current->ByTypeIndex[typeIndex])
+    {
+        return;
+    }
+
+    // Ƶǰ޸ģɿձֲ
+    auto next = std::make_unique<Snapshot>(*current);
+    if (next->ByTypeIndex.size() <= typeIndex)
+    {
+        next->ByTypeIndex.resize(typeIndex + 1, nullptr);
+    }
+    next->ByTypeIndex[typeIndex] = factory;
+    next->ByTypeId[factory->GetTypeId()] = factory;
+    next->Factories.push_back(factory);
+
+    state.Published.push_back(std::move(next));
+    state.Current.store(state.Published.back().get(), std::memory_order_release);
+}
+
+
+// =======================================================================
+//                        ѯ
+// =======================================================================
+
+SVertexFactoryBase* SVertexFactoryRegistry::Get(const char* typeId)
+{
+    if (!typeId)
+    {
+        return nullptr;
+    }
+
+    const Snapshot* snapshot = AcquireSnapshot();
+    auto it = snapshot->ByTypeId.find(std::string_view(typeId));
+    return (it != snapshot->ByTypeId.end()) ? it->second : nullptr;
+}
+
+const VertexLayout& SVertexFactoryRegistry::GetLayout(const char* typeId)
+{
+    auto* factory = Get(typeId);
+    if (factory)
+    {
+        return factory->GetLayout();
+    }
+    throw std::runtime_error("Vertex type not found: " + std::string(typeId ? typeId : "null"));
+}
+
+size_t SVertexFactoryRegistry::GetRegisteredCount()
+{
+    return AcquireSnapshot()->Factories.size();
+}
+
+
+// =======================================================================
+//                        ע׶
+// =======================================================================
+
+void SVertexFactoryRegistry::RegisterAll()
+{
+    // 
+    Register<SPositionColorVertex>();
+    Register<SPositionNormalTexVertex>();
+    Register<SPositionNormalTexTangentVertex>();
+    Register<SPositionNormalTexTangentBinormalVertex>();
+    Register<SPositionColorNormalTexVertex>();
+
+    // TODO: 㣬õʱ
+}
+
+void SVertexFactoryRegistry::Clear()
+{
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.Mutex);
+
+    if (state.Sealed)
+    {
+        throw std::logic_error("Vertex factory registry is sealed, cannot clear");
+    }
+
+    state.Published.push_back(std::make_unique<const Snapshot>());
+    state.Current.store(state.Published.back().get(), std::memory_order_release);
+}
+
+void SVertexFactoryRegistry::Seal()
+{
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    state.Sealed = true;
+}
+
+bool SVertexFactoryRegistry::IsSealed()
+{
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    return state.Sealed;
+}
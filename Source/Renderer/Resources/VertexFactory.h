@@ -2,7 +2,10 @@
 #pragma once
 #include "Renderer/Resources/Vertex.h"
 #include "Renderer/Resources/VertexLayout.h"
+#include "Renderer/Resources/VertexLayoutRegistry.h"
 #include <unordered_map>
+#include <vector>
+#include <string_view>
 #include <memory>
 #include <string>
 #include <typeinfo>
@@ -19,9 +22,14 @@ public:
     virtual ~SVertexFactoryBase() = default;
 
     /**
-     * @brief ȡ㲼
+     * @brief ȡ㲼֣פĹ淶ʵ
+     */
+    virtual const VertexLayout& GetLayout() const = 0;
+
+    /**
+     * @brief ȡפĲ־
      */
-    virtual VertexLayout GetLayout() const = 0;
+    virtual VertexLayoutHandle GetLayoutHandle() const = 0;
 
     /**
      * @brief ȡ㲽
@@ -51,10 +59,17 @@ public:
     /**
      * @brief ȡ㲼
      */
-    VertexLayout GetLayout() const override
+    const VertexLayout& GetLayout() const override
     {
-        static VertexLayout cachedLayout = VertexType::GetLayout();
-        return cachedLayout;
+        return VertexLayoutRegistry::Get<VertexType>().Get();
+    }
+
+    /**
+     * @brief ȡפĲ־
+     */
+    VertexLayoutHandle GetLayoutHandle() const override
+    {
+        return VertexLayoutRegistry::Get<VertexType>();
     }
 
     /**
@@ -93,75 +108,71 @@ public:
 };
 
 
+/**
+ * @brief ͵ĳܱ
+ * @details ÿ͵һʹʱһΣֻ֮Ƕȡھ̬עֱ飬ַϣ
+ */
+namespace VertexTypeIndex
+{
+    /**
+     * @brief һţڲʹã
+     */
+    uint32_t Allocate();
+
+    template<typename VertexType>
+    uint32_t Get()
+    {
+        static const uint32_t index = Allocate();
+        return index;
+    }
+}
+
+
 /**
  * @brief 㹤ע
  * @details עĶ֧ͣʱ
  * @note ҪлļصҪʱҵĳ
+ *       ̰߳ȫעڻ½УÿעᷢһµֻգѯֻԭӶȡǰգ
+ *       עἯ׶ΣRegisterAll/DEFINE_VERTEX_TYPESeal()ע׶κע׳쳣
+ *       ɿڳǰͷţѯõָʼЧ
  */
 class SVertexFactoryRegistry
 {
 public:
     /**
-     * @brief עᶥ
+     * @brief עᶥͣظעʱй
      */
     template<typename VertexType>
     static void Register()
     {
-        const char* typeId = typeid(VertexType).name();
-        GetFactories()[typeId] = std::make_unique<SVertexFactory<VertexType>>();
+        RegisterFactory(VertexTypeIndex::Get<VertexType>(), &SVertexFactory<VertexType>::Get());
     }
 
     /**
-     * @brief ȡ㹤ͨͣ
+     * @brief ȡ㹤ͨͣ
      */
     template<typename VertexType>
     static SVertexFactoryBase* Get()
     {
-        const char* typeId = typeid(VertexType).name();
-        auto it = GetFactories().find(typeId);
-        return (it != GetFactories().end()) ? it->second.get() : nullptr;
+        const Snapshot* snapshot = AcquireSnapshot();
+        uint32_t index = VertexTypeIndex::Get<VertexType>();
+        return index < snapshot->ByTypeIndex.size() ? snapshot->ByTypeIndex[index] : nullptr;
     }
 
     /**
      * @brief ȡ㹤ͨIDַ
      */
-    static SVertexFactoryBase* Get(const char* typeId)
-    {
-        if (!typeId)
-        {
-            return nullptr;
-        }
-        auto it = GetFactories().find(typeId);
-        return (it != GetFactories().end()) ? it->second.get() : nullptr;
-    }
+    static SVertexFactoryBase* Get(const char* typeId);
 
     /**
      * @brief ͨIDַȡ
      */
-    static VertexLayout GetLayout(const char* typeId)
-    {
-        auto* factory = Get(typeId);
-        if (factory)
-        {
-            return factory->GetLayout();
-        }
-        throw std::runtime_error("Vertex type not found: " + std::string(typeId ? typeId : "null"));
-    }
+    static const VertexLayout& GetLayout(const char* typeId);
 
     /**
      * @brief עгö
      */
-    static void RegisterAll()
-    {
-        // 
-        Register<SPositionColorVertex>();
-        Register<SPositionNormalTexVertex>();
-        Register<SPositionNormalTexTangentVertex>();
-        Register<SPositionNormalTexTangentBinormalVertex>();
-        Register<SPositionColorNormalTexVertex>();
-
-        // TODO: 㣬õʱ
-    }
+    static void RegisterAll();
 
     /**
      * @brief 鶥Ƿע
@@ -169,47 +180,67 @@ public:
     template<typename VertexType>
     static bool IsRegistered()
     {
-        const char* typeId = typeid(VertexType).name();
-        return GetFactories().find(typeId) != GetFactories().end();
+        return Get<VertexType>() != nullptr;
     }
 
     /**
      * @brief ȡעĹ
      */
-    static size_t GetRegisteredCount()
-    {
-        return GetFactories().size();
-    }
+    static size_t GetRegisteredCount();
 
     /**
-     * @brief ע
+     * @brief עᣨȡõĹָȻЧ
      */
-    static void Clear()
-    {
-        GetFactories().clear();
-    }
+    static void Clear();
+
+    /**
+     * @brief ע׶Σ֮Register/Clear׳쳣
+     */
+    static void Seal();
 
     /**
-     * @brief עĹ
+     * @brief ע׶Ƿѽ
+     */
+    static bool IsSealed();
+
+    /**
+     * @brief עĹǵʱĿգ
      */
     template<typename Func>
     static void ForEach(Func func)
     {
-        for (const auto& pair : GetFactories())
+        for (SVertexFactoryBase* factory : AcquireSnapshot()->Factories)
         {
-            func(pair.second.get());
+            func(factory);
         }
     }
 
 private:
     /**
-     * @brief ȡӳ
+     * @brief ֻգ޸
      */
-    static std::unordered_map<std::string, std::unique_ptr<SVertexFactoryBase>>& GetFactories()
+    struct Snapshot
     {
-        static std::unordered_map<std::string, std::unique_ptr<SVertexFactoryBase>> factories;
-        return factories;
-    }
+        std::vector<SVertexFactoryBase*> ByTypeIndex;                          // VertexTypeIndexδעΪnullptr
+        std::unordered_map<std::string_view, SVertexFactoryBase*> ByTypeId;    // ָtypeidƣ̬洢
+        std::vector<SVertexFactoryBase*> Factories;                            // ע˳
+    };
+
+    /**
+     * @brief עڲ״̬VertexFactory.cpp
+     */
+    struct State;
+    static State& GetState();
+
+    /**
+     * @brief ȡǰգacquireԭӶȡ
+     */
+    static const Snapshot* AcquireSnapshot();
+
+    /**
+     * @brief 빤¿
+     */
+    static void RegisterFactory(uint32_t typeIndex, SVertexFactoryBase* factory);
 };
 
 
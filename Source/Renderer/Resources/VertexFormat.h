@@ -41,7 +41,7 @@ enum class VertexFormat : uint8_t
 /**
  * @brief 获取格式的字节大小
  */
-inline uint32_t GetVertexFormatSize(VertexFormat format)
+constexpr uint32_t GetVertexFormatSize(VertexFormat format)
 {
     switch (format)
     {
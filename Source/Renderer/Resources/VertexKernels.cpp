@@ -0,0 +1,917 @@
+// VertexKernels.cpp
+#include "Renderer/Resources/VertexKernels.h"
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/DynamicVertexStreams.h"
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define KJ_VERTEX_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define KJ_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define KJ_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#endif
+#else
+#define KJ_VERTEX_KERNELS_X86 0
+#endif
+
+using VertexKernels::Matrix4x4;
+using VertexKernels::BoundingBox;
+using VertexKernels::SimdLevel;
+
+namespace
+{
+    // =======================================================================
+    //                        ʵ
+    // =======================================================================
+
+    inline float* FloatPtr(uint8_t* base, size_t index, size_t stride)
+    {
+        return reinterpret_cast<float*>(base + index * stride);
+    }
+
+    inline const float* FloatPtr(const uint8_t* base, size_t index, size_t stride)
+    {
+        return reinterpret_cast<const float*>(base + index * stride);
+    }
+
+    void TransformPositionsScalar(uint8_t* data, size_t stride, size_t count, const Matrix4x4& mat)
+    {
+        const auto& m = mat.m;
+        for (size_t i = 0; i < count; ++i)
+        {
+            float* p = FloatPtr(data, i, stride);
+            float x = p[0], y = p[1], z = p[2];
+            p[0] = x * m[0][0] + y * m[1][0] + z * m[2][0] + m[3][0];
+            p[1] = x * m[0][1] + y * m[1][1] + z * m[2][1] + m[3][1];
+            p[2] = x * m[0][2] + y * m[1][2] + z * m[2][2] + m[3][2];
+        }
+    }
+
+    void TransformDirectionsScalar(uint8_t* data, size_t stride, size_t count, const Matrix4x4& mat, bool renormalize)
+    {
+        const auto& m = mat.m;
+        for (size_t i = 0; i < count; ++i)
+        {
+            float* p = FloatPtr(data, i, stride);
+            float x = p[0], y = p[1], z = p[2];
+            float rx = x * m[0][0] + y * m[1][0] + z * m[2][0];
+            float ry = x * m[0][1] + y * m[1][1] + z * m[2][1];
+            float rz = x * m[0][2] + y * m[1][2] + z * m[2][2];
+
+            if (renormalize)
+            {
+                float lenSq = rx * rx + ry * ry + rz * rz;
+                if (lenSq > 0.0f)
+                {
+                    float invLen = 1.0f / std::sqrt(lenSq);
+                    rx *= invLen;
+                    ry *= invLen;
+                    rz *= invLen;
+                }
+            }
+
+            p[0] = rx;
+            p[1] = ry;
+            p[2] = rz;
+        }
+    }
+
+    void NormalizeScalar(uint8_t* data, size_t stride, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            float* p = FloatPtr(data, i, stride);
+            float lenSq = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+            if (lenSq > 0.0f)
+            {
+                float invLen = 1.0f / std::sqrt(lenSq);
+                p[0] *= invLen;
+                p[1] *= invLen;
+                p[2] *= invLen;
+            }
+        }
+    }
+
+    void ComputeBoundsScalar(const uint8_t* data, size_t stride, size_t count, BoundingBox& box)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float* p = FloatPtr(data, i, stride);
+            for (int c = 0; c < 3; ++c)
+            {
+                box.Min[c] = p[c] < box.Min[c] ? p[c] : box.Min[c];
+                box.Max[c] = p[c] > box.Max[c] ? p[c] : box.Max[c];
+            }
+        }
+    }
+
+
+    // ʽתD3DĹSNORMΪround(clamp(v, -1, 1) * 32767)UNORMΪround(clamp(v, 0, 1) * 255)NaNת0
+    // NaNȽȫΪfalseԭתδΪ
+    inline float Clamp(float v, float lo, float hi)
+    {
+        if (v != v)
+        {
+            return 0.0f;
+        }
+        return v < lo ? lo : (v > hi ? hi : v);
+    }
+
+    uint16_t FloatToHalfScalar(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = (bits >> 16) & 0x8000u;
+        uint32_t absBits = bits & 0x7FFFFFFFu;
+
+        if (absBits >= 0x7F800000u)
+        {
+            // Inf/NaN
+            return static_cast<uint16_t>(sign | (absBits > 0x7F800000u ? 0x7E00u : 0x7C00u));
+        }
+        if (absBits >= 0x477FF000u)
+        {
+            // 뾫ȷΧ>=65520
+            return static_cast<uint16_t>(sign | 0x7C00u);
+        }
+        if (absBits < 0x38800000u)
+        {
+            // 뾫ȷǹ2^-24Ϊλ
+            float absValue;
+            std::memcpy(&absValue, &absBits, sizeof(absValue));
+            return static_cast<uint16_t>(sign | static_cast<uint32_t>(std::nearbyint(absValue * 16777216.0f)));
+        }
+
+        // ָƫƴ127Ϊ15βż
+        uint32_t rounded = absBits + 0xC8000FFFu + ((absBits >> 13) & 1u);
+        return static_cast<uint16_t>(sign | (rounded >> 13));
+    }
+
+    float HalfToFloatScalar(uint16_t half)
+    {
+        uint32_t sign = (static_cast<uint32_t>(half) & 0x8000u) << 16;
+        uint32_t exponent = (half >> 10) & 0x1Fu;
+        uint32_t mantissa = half & 0x3FFu;
+
+        if (exponent == 0)
+        {
+            float value = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+            return sign ? -value : value;
+        }
+
+        uint32_t bits = exponent == 31
+            ? (sign | 0x7F800000u | (mantissa << 13))
+            : (sign | ((exponent + 112) << 23) | (mantissa << 13));
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void FloatToHalfArrayScalar(const float* src, uint16_t* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[i] = FloatToHalfScalar(src[i]);
+        }
+    }
+
+    void FloatToSnorm16Scalar(const float* src, int16_t* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[i] = static_cast<int16_t>(std::nearbyint(Clamp(src[i], -1.0f, 1.0f) * 32767.0f));
+        }
+    }
+
+    void FloatToUnorm8Scalar(const float* src, uint8_t* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[i] = static_cast<uint8_t>(std::nearbyint(Clamp(src[i], 0.0f, 1.0f) * 255.0f));
+        }
+    }
+
+
+#if KJ_VERTEX_KERNELS_X86
+    // =======================================================================
+    //                        SSE2ʵ֣ÿһ㣩
+    // =======================================================================
+
+    // ֻд12ֽڣԽһĩβ
+    inline __m128 LoadFloat3(const float* p)
+    {
+        __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+        __m128 z = _mm_load_ss(p + 2);
+        return _mm_movelh_ps(xy, z);
+    }
+
+    inline void StoreFloat3(float* p, __m128 v)
+    {
+        _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+
+    inline __m128 NormalizeFloat3(__m128 v)
+    {
+        __m128 sq = _mm_mul_ps(v, v);
+        __m128 sum = _mm_add_ps(sq, _mm_movehl_ps(sq, sq));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+        if (_mm_cvtss_f32(sum) <= 0.0f)
+        {
+            return v;
+        }
+        return _mm_div_ps(v, _mm_sqrt_ps(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 0, 0, 0))));
+    }
+
+    void TransformPositionsSSE(uint8_t* data, size_t stride, size_t count, const Matrix4x4& mat)
+    {
+        const __m128 r0 = _mm_loadu_ps(mat.m[0]);
+        const __m128 r1 = _mm_loadu_ps(mat.m[1]);
+        const __m128 r2 = _mm_loadu_ps(mat.m[2]);
+        const __m128 r3 = _mm_loadu_ps(mat.m[3]);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float* p = FloatPtr(data, i, stride);
+            __m128 v = LoadFloat3(p);
+            __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, r0), _mm_mul_ps(y, r1)),
+                _mm_add_ps(_mm_mul_ps(z, r2), r3));
+            StoreFloat3(p, r);
+        }
+    }
+
+    void TransformDirectionsSSE(uint8_t* data, size_t stride, size_t count, const Matrix4x4& mat, bool renormalize)
+    {
+        const __m128 r0 = _mm_loadu_ps(mat.m[0]);
+        const __m128 r1 = _mm_loadu_ps(mat.m[1]);
+        const __m128 r2 = _mm_loadu_ps(mat.m[2]);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float* p = FloatPtr(data, i, stride);
+            __m128 v = LoadFloat3(p);
+            __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, r0), _mm_mul_ps(y, r1)), _mm_mul_ps(z, r2));
+            if (renormalize)
+            {
+                // ķ볤ȼ
+                r = _mm_movelh_ps(r, _mm_unpackhi_ps(r, _mm_setzero_ps()));
+                r = NormalizeFloat3(r);
+            }
+            StoreFloat3(p, r);
+        }
+    }
+
+    void NormalizeSSE(uint8_t* data, size_t stride, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            float* p = FloatPtr(data, i, stride);
+            StoreFloat3(p, NormalizeFloat3(LoadFloat3(p)));
+        }
+    }
+
+    void ComputeBoundsSSE(const uint8_t* data, size_t stride, size_t count, BoundingBox& box)
+    {
+        __m128 vMin = _mm_set_ps(0.0f, box.Min[2], box.Min[1], box.Min[0]);
+        __m128 vMax = _mm_set_ps(0.0f, box.Max[2], box.Max[1], box.Max[0]);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            __m128 v = LoadFloat3(FloatPtr(data, i, stride));
+            vMin = _mm_min_ps(vMin, v);
+            vMax = _mm_max_ps(vMax, v);
+        }
+
+        float outMin[4], outMax[4];
+        _mm_storeu_ps(outMin, vMin);
+        _mm_storeu_ps(outMax, vMax);
+        std::memcpy(box.Min, outMin, sizeof(box.Min));
+        std::memcpy(box.Max, outMax, sizeof(box.Max));
+    }
+
+
+    void FloatToSnorm16SSE(const float* src, int16_t* dst, size_t count)
+    {
+        const __m128 lo = _mm_set1_ps(-1.0f);
+        const __m128 hi = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(32767.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            // maxpsNaNصڶ-1ȰNaN0ͱһ
+            __m128 a = _mm_loadu_ps(src + i);
+            __m128 b = _mm_loadu_ps(src + i + 4);
+            a = _mm_and_ps(a, _mm_cmpord_ps(a, a));
+            b = _mm_and_ps(b, _mm_cmpord_ps(b, b));
+            a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(a, lo), hi), scale);
+            b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(b, lo), hi), scale);
+            __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+
+        FloatToSnorm16Scalar(src + i, dst + i, count - i);
+    }
+
+    void FloatToUnorm8SSE(const float* src, uint8_t* dst, size_t count)
+    {
+        const __m128 lo = _mm_setzero_ps();
+        const __m128 hi = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(255.0f);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i v[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                __m128 f = _mm_loadu_ps(src + i + k * 4);
+                f = _mm_and_ps(f, _mm_cmpord_ps(f, f));
+                f = _mm_mul_ps(_mm_min_ps(_mm_max_ps(f, lo), hi), scale);
+                v[k] = _mm_cvtps_epi32(f);
+            }
+            __m128i packed = _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+
+        FloatToUnorm8Scalar(src + i, dst + i, count - i);
+    }
+
+
+    // =======================================================================
+    //                        AVX2ʵ֣ÿ㣬FMA
+    // =======================================================================
+
+    KJ_TARGET_AVX2 inline __m256 LoadFloat3x2(const float* p0, const float* p1)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(LoadFloat3(p0)), LoadFloat3(p1), 1);
+    }
+
+    KJ_TARGET_AVX2 inline void StoreFloat3x2(float* p0, float* p1, __m256 v)
+    {
+        StoreFloat3(p0, _mm256_castps256_ps128(v));
+        StoreFloat3(p1, _mm256_extractf128_ps(v, 1));
+    }
+
+    KJ_TARGET_AVX2 inline __m256 NormalizeFloat3x2(__m256 v)
+    {
+        // ķΪ0ˮƽӼ
+        __m256 sq = _mm256_mul_ps(v, v);
+        __m256 sum = _mm256_hadd_ps(sq, sq);
+        sum = _mm256_hadd_ps(sum, sum);
+        __m256 len = _mm256_sqrt_ps(sum);
+        __m256 nonZero = _mm256_cmp_ps(sum, _mm256_setzero_ps(), _CMP_GT_OQ);
+        __m256 normalized = _mm256_div_ps(v, len);
+        return _mm256_blendv_ps(v, normalized, nonZero);
+    }
+
+    KJ_TARGET_AVX2 void TransformPositionsAVX2(uint8_t* data, size_t stride, size_t count, const Matrix4x4& mat)
+    {
+        const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat.m[0]));
+        const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat.m[1]));
+        const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat.m[2]));
+        const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat.m[3]));
+
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            float* p0 = FloatPtr(data, i, stride);
+            float* p1 = FloatPtr(data, i + 1, stride);
+            __m256 v = LoadFloat3x2(p0, p1);
+            __m256 r = _mm256_fmadd_ps(_mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)), r0,
+                _mm256_fmadd_ps(_mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r1,
+                    _mm256_fmadd_ps(_mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r2, r3)));
+            StoreFloat3x2(p0, p1, r);
+        }
+
+        if (i < count)
+        {
+            TransformPositionsSSE(data + i * stride, stride, count - i, mat);
+        }
+    }
+
+    KJ_TARGET_AVX2 void TransformDirectionsAVX2(uint8_t* data, size_t stride, size_t count, const Matrix4x4& mat, bool renormalize)
+    {
+        // 㣬ĵķΪ0һ
+        const __m256 mask = _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0));
+        const __m256 r0 = _mm256_and_ps(_mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat.m[0])), mask);
+        const __m256 r1 = _mm256_and_ps(_mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat.m[1])), mask);
+        const __m256 r2 = _mm256_and_ps(_mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat.m[2])), mask);
+
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            float* p0 = FloatPtr(data, i, stride);
+            float* p1 = FloatPtr(data, i + 1, stride);
+            __m256 v = LoadFloat3x2(p0, p1);
+            __m256 r = _mm256_fmadd_ps(_mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)), r0,
+                _mm256_fmadd_ps(_mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r1,
+                    _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r2)));
+            if (renormalize)
+            {
+                r = NormalizeFloat3x2(r);
+            }
+            StoreFloat3x2(p0, p1, r);
+        }
+
+        if (i < count)
+        {
+            TransformDirectionsSSE(data + i * stride, stride, count - i, mat, renormalize);
+        }
+    }
+
+    KJ_TARGET_AVX2 void NormalizeAVX2(uint8_t* data, size_t stride, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            float* p0 = FloatPtr(data, i, stride);
+            float* p1 = FloatPtr(data, i + 1, stride);
+            StoreFloat3x2(p0, p1, NormalizeFloat3x2(LoadFloat3x2(p0, p1)));
+        }
+
+        if (i < count)
+        {
+            NormalizeSSE(data + i * stride, stride, count - i);
+        }
+    }
+
+    KJ_TARGET_AVX2 void ComputeBoundsAVX2(const uint8_t* data, size_t stride, size_t count, BoundingBox& box)
+    {
+        __m256 vMin = _mm256_set1_ps(FLT_MAX);
+        __m256 vMax = _mm256_set1_ps(-FLT_MAX);
+
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m256 v = LoadFloat3x2(FloatPtr(data, i, stride), FloatPtr(data, i + 1, stride));
+            vMin = _mm256_min_ps(vMin, v);
+            vMax = _mm256_max_ps(vMax, v);
+        }
+
+        __m128 min4 = _mm_min_ps(_mm256_castps256_ps128(vMin), _mm256_extractf128_ps(vMin, 1));
+        __m128 max4 = _mm_max_ps(_mm256_castps256_ps128(vMax), _mm256_extractf128_ps(vMax, 1));
+
+        float outMin[4], outMax[4];
+        _mm_storeu_ps(outMin, min4);
+        _mm_storeu_ps(outMax, max4);
+        for (int c = 0; c < 3; ++c)
+        {
+            box.Min[c] = outMin[c] < box.Min[c] ? outMin[c] : box.Min[c];
+            box.Max[c] = outMax[c] > box.Max[c] ? outMax[c] : box.Max[c];
+        }
+
+        if (i < count)
+        {
+            ComputeBoundsSSE(data + i * stride, stride, count - i, box);
+        }
+    }
+
+
+    KJ_TARGET_AVX2 void FloatToHalfF16C(const float* src, uint16_t* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+        }
+
+        FloatToHalfArrayScalar(src + i, dst + i, count - i);
+    }
+
+
+    // =======================================================================
+    //                        CPU
+    // =======================================================================
+
+    void CpuId(int leaf, int subLeaf, int regs[4])
+    {
+#if defined(_MSC_VER)
+        __cpuidex(regs, leaf, subLeaf);
+#else
+        unsigned int a = 0, b = 0, c = 0, d = 0;
+        __cpuid_count(leaf, subLeaf, a, b, c, d);
+        regs[0] = static_cast<int>(a);
+        regs[1] = static_cast<int>(b);
+        regs[2] = static_cast<int>(c);
+        regs[3] = static_cast<int>(d);
+#endif
+    }
+
+    uint64_t ReadXCR0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned int eax = 0, edx = 0;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+    }
+
+    SimdLevel DetectSimdLevel()
+    {
+        int regs[4] = {};
+        CpuId(0, 0, regs);
+        int maxLeaf = regs[0];
+
+        CpuId(1, 0, regs);
+        bool hasSSE2 = (regs[3] & (1 << 26)) != 0;
+        bool hasFMA = (regs[2] & (1 << 12)) != 0;
+        bool hasOSXSAVE = (regs[2] & (1 << 27)) != 0;
+        bool hasAVX = (regs[2] & (1 << 28)) != 0;
+        bool hasF16C = (regs[2] & (1 << 29)) != 0;
+
+        bool hasAVX2 = false;
+        if (maxLeaf >= 7)
+        {
+            CpuId(7, 0, regs);
+            hasAVX2 = (regs[1] & (1 << 5)) != 0;
+        }
+
+        // ϵͳҪYMMĴ״̬
+        bool osSupportsAVX = hasOSXSAVE && (ReadXCR0() & 0x6) == 0x6;
+
+        if (hasAVX && hasAVX2 && hasFMA && hasF16C && osSupportsAVX)
+        {
+            return SimdLevel::AVX2;
+        }
+        return hasSSE2 ? SimdLevel::SSE2 : SimdLevel::Scalar;
+    }
+#else
+    SimdLevel DetectSimdLevel()
+    {
+        return SimdLevel::Scalar;
+    }
+#endif
+
+
+    // =======================================================================
+    //                        ַ
+    // =======================================================================
+
+    SimdLevel SupportedLevel()
+    {
+        static const SimdLevel supported = DetectSimdLevel();
+        return supported;
+    }
+
+    std::atomic<int> s_forcedLevel{ -1 };   // -1ʾʹü
+
+    BoundingBox EmptyBox()
+    {
+        return { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+    }
+
+    /**
+     * @brief һԣ3float
+     */
+    struct StridedAttribute
+    {
+        uint8_t* Data = nullptr;
+        size_t Stride = 0;
+    };
+
+    bool IsFloatVector(const VertexElement& element)
+    {
+        return element.Format == VertexFormat::Float3 || element.Format == VertexFormat::Float4;
+    }
+
+    /**
+     * @brief 3x3ʽС0˵任
+     */
+    float Determinant3x3(const Matrix4x4& matrix)
+    {
+        const auto& m = matrix.m;
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) +
+               m[0][1] * (m[1][2] * m[2][0] - m[1][0] * m[2][2]) +
+               m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    }
+
+    /**
+     * @brief wȡwǸߵԣ
+     */
+    void FlipTangentHandedness(const StridedAttribute& attr, size_t count)
+    {
+        uint8_t* w = attr.Data + sizeof(float) * 3;
+        for (size_t i = 0; i < count; ++i, w += attr.Stride)
+        {
+            float value;
+            std::memcpy(&value, w, sizeof(value));
+            value = -value;
+            std::memcpy(w, &value, sizeof(value));
+        }
+    }
+
+    /**
+     * @brief 任һ
+     */
+    void TransformAttribute(const VertexElement& element, const StridedAttribute& attr, size_t count,
+        const Matrix4x4& matrix, const Matrix4x4& normalMatrix)
+    {
+        if (!IsFloatVector(element) || element.SemanticIndex != 0)
+        {
+            return;
+        }
+
+        if (element.SemanticName == "POSITION")
+        {
+            TransformPositions(attr.Data, attr.Stride, count, matrix);
+        }
+        else if (element.SemanticName == "NORMAL")
+        {
+            TransformDirections(attr.Data, attr.Stride, count, normalMatrix, true);
+        }
+        else if (element.SemanticName == "TANGENT" || element.SemanticName == "BINORMAL")
+        {
+            TransformDirections(attr.Data, attr.Stride, count, matrix, true);
+
+            //  = cross(N, T) * w ķˣwȡͼŶ
+            if (element.SemanticName == "TANGENT" && element.Format == VertexFormat::Float4 && Determinant3x3(matrix) < 0.0f)
+            {
+                FlipTangentHandedness(attr, count);
+            }
+        }
+    }
+}
+
+VertexKernels::SimdLevel VertexKernels::GetSimdLevel()
+{
+    int forced = s_forcedLevel.load(std::memory_order_relaxed);
+    return forced < 0 ? SupportedLevel() : static_cast<SimdLevel>(forced);
+}
+
+VertexKernels::SimdLevel VertexKernels::GetSupportedSimdLevel()
+{
+    return SupportedLevel();
+}
+
+void VertexKernels::SetSimdLevel(SimdLevel level)
+{
+    if (level > SupportedLevel())
+    {
+        level = SupportedLevel();
+    }
+    s_forcedLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+
+// =======================================================================
+//                        粽ϵں
+// =======================================================================
+
+void VertexKernels::TransformPositions(void* data, size_t stride, size_t count, const Matrix4x4& matrix)
+{
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    if (!bytes || count == 0)
+    {
+        return;
+    }
+
+    switch (GetSimdLevel())
+    {
+#if KJ_VERTEX_KERNELS_X86
+    case SimdLevel::AVX2: TransformPositionsAVX2(bytes, stride, count, matrix); return;
+    case SimdLevel::SSE2: TransformPositionsSSE(bytes, stride, count, matrix); return;
+#endif
+    default: TransformPositionsScalar(bytes, stride, count, matrix); return;
+    }
+}
+
+void VertexKernels::TransformDirections(void* data, size_t stride, size_t count, const Matrix4x4& matrix, bool renormalize)
+{
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    if (!bytes || count == 0)
+    {
+        return;
+    }
+
+    switch (GetSimdLevel())
+    {
+#if KJ_VERTEX_KERNELS_X86
+    case SimdLevel::AVX2: TransformDirectionsAVX2(bytes, stride, count, matrix, renormalize); return;
+    case SimdLevel::SSE2: TransformDirectionsSSE(bytes, stride, count, matrix, renormalize); return;
+#endif
+    default: TransformDirectionsScalar(bytes, stride, count, matrix, renormalize); return;
+    }
+}
+
+void VertexKernels::Normalize(void* data, size_t stride, size_t count)
+{
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    if (!bytes || count == 0)
+    {
+        return;
+    }
+
+    switch (GetSimdLevel())
+    {
+#if KJ_VERTEX_KERNELS_X86
+    case SimdLevel::AVX2: NormalizeAVX2(bytes, stride, count); return;
+    case SimdLevel::SSE2: NormalizeSSE(bytes, stride, count); return;
+#endif
+    default: NormalizeScalar(bytes, stride, count); return;
+    }
+}
+
+VertexKernels::BoundingBox VertexKernels::ComputeBounds(const void* data, size_t stride, size_t count)
+{
+    BoundingBox box = EmptyBox();
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (!bytes || count == 0)
+    {
+        return box;
+    }
+
+    switch (GetSimdLevel())
+    {
+#if KJ_VERTEX_KERNELS_X86
+    case SimdLevel::AVX2: ComputeBoundsAVX2(bytes, stride, count, box); break;
+    case SimdLevel::SSE2: ComputeBoundsSSE(bytes, stride, count, box); break;
+#endif
+    default: ComputeBoundsScalar(bytes, stride, count, box); break;
+    }
+    return box;
+}
+
+
+// =======================================================================
+//                        ʽת
+// =======================================================================
+
+void VertexKernels::FloatToHalf(const float* src, uint16_t* dst, size_t count)
+{
+    switch (GetSimdLevel())
+    {
+#if KJ_VERTEX_KERNELS_X86
+    case SimdLevel::AVX2: FloatToHalfF16C(src, dst, count); return;
+#endif
+    default: FloatToHalfArrayScalar(src, dst, count); return;
+    }
+}
+
+void VertexKernels::HalfToFloat(const uint16_t* src, float* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        dst[i] = HalfToFloatScalar(src[i]);
+    }
+}
+
+void VertexKernels::FloatToSnorm16(const float* src, int16_t* dst, size_t count)
+{
+    switch (GetSimdLevel())
+    {
+#if KJ_VERTEX_KERNELS_X86
+    case SimdLevel::AVX2:
+    case SimdLevel::SSE2: FloatToSnorm16SSE(src, dst, count); return;
+#endif
+    default: FloatToSnorm16Scalar(src, dst, count); return;
+    }
+}
+
+void VertexKernels::FloatToUnorm8(const float* src, uint8_t* dst, size_t count)
+{
+    switch (GetSimdLevel())
+    {
+#if KJ_VERTEX_KERNELS_X86
+    case SimdLevel::AVX2:
+    case SimdLevel::SSE2: FloatToUnorm8SSE(src, dst, count); return;
+#endif
+    default: FloatToUnorm8Scalar(src, dst, count); return;
+    }
+}
+
+
+// =======================================================================
+//                        ߺ
+// =======================================================================
+
+bool VertexKernels::InverseTranspose(const Matrix4x4& matrix, Matrix4x4& outMatrix)
+{
+    const auto& m = matrix.m;
+
+    // 3x3ʽ
+    float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    float c10 = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+    float c11 = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+    float c12 = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+    float c20 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    float c21 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    float c22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+    float det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+    if (std::fabs(det) < 1e-20f)
+    {
+        return false;
+    }
+
+    // ת = ʽ / ʽ
+    float invDet = 1.0f / det;
+    outMatrix = Matrix4x4::Identity();
+    outMatrix.m[0][0] = c00 * invDet; outMatrix.m[0][1] = c01 * invDet; outMatrix.m[0][2] = c02 * invDet;
+    outMatrix.m[1][0] = c10 * invDet; outMatrix.m[1][1] = c11 * invDet; outMatrix.m[1][2] = c12 * invDet;
+    outMatrix.m[2][0] = c20 * invDet; outMatrix.m[2][1] = c21 * invDet; outMatrix.m[2][2] = c22 * invDet;
+    return true;
+}
+
+
+// =======================================================================
+//                        ݱݽӿ
+// =======================================================================
+
+void VertexKernels::TransformVertexData(DynamicVertexData& vertexData, const Matrix4x4& matrix)
+{
+    if (!vertexData.IsValid())
+    {
+        return;
+    }
+
+    Matrix4x4 normalMatrix;
+    if (!InverseTranspose(matrix, normalMatrix))
+    {
+        normalMatrix = matrix;
+    }
+
+    const VertexLayout& layout = vertexData.GetLayout();
+    uint8_t* base = static_cast<uint8_t*>(vertexData.GetData());
+
+    for (const VertexElement& element : layout.GetElements())
+    {
+        StridedAttribute attr;
+        attr.Data = base + element.Offset;
+        attr.Stride = layout.GetStride();
+        TransformAttribute(element, attr, vertexData.GetVertexCount(), matrix, normalMatrix);
+    }
+}
+
+void VertexKernels::TransformVertexData(DynamicVertexStreams& vertexStreams, const Matrix4x4& matrix)
+{
+    if (!vertexStreams.IsValid())
+    {
+        return;
+    }
+
+    Matrix4x4 normalMatrix;
+    if (!InverseTranspose(matrix, normalMatrix))
+    {
+        normalMatrix = matrix;
+    }
+
+    for (uint32_t i = 0; i < vertexStreams.GetStreamCount(); ++i)
+    {
+        StridedAttribute attr;
+        attr.Data = static_cast<uint8_t*>(vertexStreams.GetStreamData(i));
+        attr.Stride = vertexStreams.GetStreamStride(i);
+        TransformAttribute(vertexStreams.GetStreamElement(i), attr, vertexStreams.GetVertexCount(),
+            matrix, normalMatrix);
+    }
+}
+
+VertexKernels::BoundingBox VertexKernels::ComputeBounds(const DynamicVertexData& vertexData)
+{
+    if (!vertexData.IsValid())
+    {
+        return EmptyBox();
+    }
+
+    VertexAttributeHandle handle = vertexData.FindAttribute("POSITION", 0);
+    if (!handle.IsValid() || handle.Size < sizeof(float) * 3)
+    {
+        return EmptyBox();
+    }
+
+    const uint8_t* base = static_cast<const uint8_t*>(vertexData.GetData());
+    return ComputeBounds(base + handle.Offset, vertexData.GetStride(), vertexData.GetVertexCount());
+}
+
+VertexKernels::BoundingBox VertexKernels::ComputeBounds(const DynamicVertexStreams& vertexStreams)
+{
+    int32_t streamIndex = vertexStreams.FindStream("POSITION", 0);
+    if (streamIndex < 0 || vertexStreams.GetStreamStride(streamIndex) < sizeof(float) * 3)
+    {
+        return EmptyBox();
+    }
+
+    return ComputeBounds(vertexStreams.GetStreamData(streamIndex), vertexStreams.GetStreamStride(streamIndex),
+        vertexStreams.GetVertexCount());
+}
@@ -0,0 +1,153 @@
+// VertexKernels.h
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+class DynamicVertexData;
+class DynamicVertexStreams;
+
+/**
+ * @brief ں
+ * @details ֱڿ粽Ķ任ͰΧм㣬ʱCPUѡAVX2/SSE/ʵ
+ * @note Լv * MHLSLmul(float4(pos, 1), gWorld)DirectXMathһ
+ */
+namespace VertexKernels
+{
+    /**
+     * @brief 4x4
+     */
+    struct Matrix4x4
+    {
+        float m[4][4];
+
+        static Matrix4x4 Identity()
+        {
+            return { { { 1.0f, 0.0f, 0.0f, 0.0f },
+                       { 0.0f, 1.0f, 0.0f, 0.0f },
+                       { 0.0f, 0.0f, 1.0f, 0.0f },
+                       { 0.0f, 0.0f, 0.0f, 1.0f } } };
+        }
+    };
+
+    /**
+     * @brief Χ
+     */
+    struct BoundingBox
+    {
+        float Min[3];
+        float Max[3];
+
+        /**
+         * @brief ǷΪգûκζ㣩
+         */
+        bool IsEmpty() const { return Min[0] > Max[0]; }
+    };
+
+    /**
+     * @brief SIMDָȼ
+     */
+    enum class SimdLevel : uint8_t
+    {
+        Scalar = 0,
+        SSE2,
+        AVX2,       // AVX2 + FMA + F16C
+    };
+
+    /**
+     * @brief ȡǰʹõָȼ״εʱCPU
+     */
+    SimdLevel GetSimdLevel();
+
+    /**
+     * @brief ȡCPUֵָ֧ȼ
+     */
+    SimdLevel GetSupportedSimdLevel();
+
+    /**
+     * @brief ǿʹĳһȼᱻƵCPUֵ֧ߵȼҪڶԱȺ͵
+     */
+    void SetSimdLevel(SimdLevel level);
+
+
+    // =======================================================================
+    //                        粽ϵں
+    // =======================================================================
+    // dataָһĸԣstrideΪڶֽٰ֮3float
+
+    /**
+     * @brief 任λã任ԾУ
+     */
+    void TransformPositions(void* data, size_t stride, size_t count, const Matrix4x4& matrix);
+
+    /**
+     * @brief 任ֻþ3x3ѡ˳¹һ
+     * @details Ӧתþߺ͸ֱӴ任
+     */
+    void TransformDirections(void* data, size_t stride, size_t count, const Matrix4x4& matrix, bool renormalize);
+
+    /**
+     * @brief һΪ0ıֲ䣩
+     */
+    void Normalize(void* data, size_t stride, size_t count);
+
+    /**
+     * @brief λõİΧ
+     */
+    BoundingBox ComputeBounds(const void* data, size_t stride, size_t count);
+
+
+    // =======================================================================
+    //                        ʽת
+    // =======================================================================
+    // ֮תD3DR16_FLOAT/R16_SNORM/R8_UNORMһ
+
+    /**
+     * @brief floatת뾫ȣż룩
+     */
+    void FloatToHalf(const float* src, uint16_t* dst, size_t count);
+
+    /**
+     * @brief 뾫תfloat
+     */
+    void HalfToFloat(const uint16_t* src, float* dst, size_t count);
+
+    /**
+     * @brief floatת16λSNORMƵ[-1, 1]NaNת0
+     */
+    void FloatToSnorm16(const float* src, int16_t* dst, size_t count);
+
+    /**
+     * @brief floatת8λUNORMƵ[0, 1]NaNת0
+     */
+    void FloatToUnorm8(const float* src, uint8_t* dst, size_t count);
+
+
+    // =======================================================================
+    //                        ߺ
+    // =======================================================================
+
+    /**
+     * @brief 3x3תãƽ㣩󲻿ʱfalse
+     */
+    bool InverseTranspose(const Matrix4x4& matrix, Matrix4x4& outMatrix);
+
+
+    // =======================================================================
+    //                        ݱݽӿ
+    // =======================================================================
+
+    /**
+     * @brief 任ݶ
+     * @details POSITIONmatrixNORMALתãTANGENT/BINORMALmatrix任¹һ
+     *          matrixʽΪʱFloat4ߵwȡ
+     * @note ֻFloat3/Float4ʽԪأʽѹʽ
+     */
+    void TransformVertexData(DynamicVertexData& vertexData, const Matrix4x4& matrix);
+    void TransformVertexData(DynamicVertexStreams& vertexStreams, const Matrix4x4& matrix);
+
+    /**
+     * @brief 㶥POSITIONİΧУûPOSITIONʱؿհΧУ
+     */
+    BoundingBox ComputeBounds(const DynamicVertexData& vertexData);
+    BoundingBox ComputeBounds(const DynamicVertexStreams& vertexStreams);
+}
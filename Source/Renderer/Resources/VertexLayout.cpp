@@ -4,6 +4,7 @@
 
 VertexLayout::VertexLayout() : m_stride(0)
 {
+    UpdateHash();
 }
 
 VertexLayout::~VertexLayout()
@@ -26,6 +27,7 @@ void VertexLayout::AddElement(
     element.Slot = slot;
 
     m_elements.push_back(element);
+    UpdateHash();
 }
 
 const VertexElement& VertexLayout::GetElement(uint32_t index) const
@@ -43,6 +45,7 @@ void VertexLayout::CalculateStride()
     if (m_elements.empty())
     {
         m_stride = 0;
+        UpdateHash();
         return;
     }
 
@@ -61,10 +64,16 @@ void VertexLayout::CalculateStride()
 
     // 뵽4ֽڱ߽
     m_stride = (maxEndOffset + 3) & ~3;
+    UpdateHash();
 }
 
 bool VertexLayout::operator==(const VertexLayout& other) const
 {
+    if (m_hash != other.m_hash)
+    {
+        return false;
+    }
+
     if (m_elements.size() != other.m_elements.size())
     {
         return false;
@@ -90,4 +99,18 @@ void VertexLayout::Clear()
 {
     m_elements.clear();
     m_stride = 0;
+    UpdateHash();
+}
+
+void VertexLayout::UpdateHash()
+{
+    uint64_t hash = VertexLayoutHash::OffsetBasis;
+
+    for (const auto& element : m_elements)
+    {
+        hash = VertexLayoutHash::HashElement(hash, element.SemanticName.data(), element.SemanticName.size(),
+            element.SemanticIndex, element.Format, element.Offset, element.Slot);
+    }
+
+    m_hash = VertexLayoutHash::HashValue(hash, m_stride);
 }
\ No newline at end of file
@@ -1,9 +1,13 @@
 // VertexLayout.h
 #pragma once
 #include "Renderer/Resources/VertexFormat.h"
+#include <array>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstdint>
+#include <cstddef>
+#include <functional>
 
 /**
  * @brief Ԫ - API޹
@@ -34,6 +38,60 @@ struct VertexElement
     }
 };
 
+/**
+ * @brief ֹϣFNV-1a 64λ
+ * @details ʱVertexLayoutͱڵStaticVertexLayoutһ׺֤ͬһ߹ϣһ
+ */
+namespace VertexLayoutHash
+{
+    constexpr uint64_t OffsetBasis = 14695981039346656037ull;
+    constexpr uint64_t Prime = 1099511628211ull;
+
+    constexpr uint64_t HashBytes(uint64_t hash, const char* data, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= Prime;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Сֽ32λƽֽ̨޹أ
+     */
+    constexpr uint64_t HashValue(uint64_t hash, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            hash ^= (value >> (i * 8)) & 0xFFu;
+            hash *= Prime;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Сֽ64λȵ32λٸ32λ
+     */
+    constexpr uint64_t HashValue64(uint64_t hash, uint64_t value)
+    {
+        hash = HashValue(hash, static_cast<uint32_t>(value));
+        return HashValue(hash, static_cast<uint32_t>(value >> 32));
+    }
+
+    constexpr uint64_t HashElement(uint64_t hash, const char* semanticName, size_t nameLength,
+        uint32_t semanticIndex, VertexFormat format, uint32_t offset, uint32_t slot)
+    {
+        // ƴϳȣֶƴӳֽͬ
+        hash = HashValue(hash, static_cast<uint32_t>(nameLength));
+        hash = HashBytes(hash, semanticName, nameLength);
+        hash = HashValue(hash, semanticIndex);
+        hash = HashValue(hash, static_cast<uint32_t>(format));
+        hash = HashValue(hash, offset);
+        return HashValue(hash, slot);
+    }
+}
+
 /**
  * @brief 㲼 - API޹صĲ
  * @details ֻĽṹκȾAPIضϢ
@@ -73,7 +131,7 @@ public:
     /**
      * @brief ò
      */
-    void SetStride(uint32_t stride) { m_stride = stride; }
+    void SetStride(uint32_t stride) { m_stride = stride; UpdateHash(); }
 
     /**
      * @brief ȡ
@@ -91,7 +149,13 @@ public:
     void Clear();
 
     /**
-     * @brief Ƚϲ
+     * @brief ȡֹϣ64λԪغͲ仯Զ£
+     * @details ֵͬĹϣһͬϣVertexLayoutRegistryפO(1)Ƚ
+     */
+    uint64_t GetHash() const { return m_hash; }
+
+    /**
+     * @brief ȽϲȱȽϹϣͬʱأ
      */
     bool operator==(const VertexLayout& other) const;
     bool operator!=(const VertexLayout& other) const { return !(*this == other); }
@@ -102,6 +166,96 @@ public:
     const std::vector<VertexElement>& GetElements() const { return m_elements; }
 
 private:
+    /**
+     * @brief ¼ϣ
+     */
+    void UpdateHash();
+
     std::vector<VertexElement> m_elements;
     uint32_t m_stride = 0;
+    uint64_t m_hash = 0;
+};
+
+/**
+ * @brief ڶԪأΪַָ룬ڴ棩
+ */
+struct StaticVertexElement
+{
+    const char* SemanticName = nullptr;
+    uint32_t SemanticIndex = 0;
+    VertexFormat Format = VertexFormat::Unknown;
+    uint32_t Offset = 0;
+    uint32_t Slot = 0;
+};
+
+/**
+ * @brief ڶ㲼
+ * @details SVertexбڱɣƫoffsetofΪsizeofstatic_assert
+ *          HashͬVertexLayout::GetHash()ͬ
+ */
+template<size_t N>
+struct StaticVertexLayout
+{
+    std::array<StaticVertexElement, N> Elements{};
+    uint32_t Stride = 0;
+    uint64_t Hash = 0;
+
+    static constexpr size_t ElementCount = N;
+
+    /**
+     * @brief ԪغͲϣ
+     */
+    constexpr uint64_t ComputeHash() const
+    {
+        uint64_t hash = VertexLayoutHash::OffsetBasis;
+        for (const StaticVertexElement& element : Elements)
+        {
+            hash = VertexLayoutHash::HashElement(hash, element.SemanticName,
+                std::char_traits<char>::length(element.SemanticName),
+                element.SemanticIndex, element.Format, element.Offset, element.Slot);
+        }
+        return VertexLayoutHash::HashValue(hash, Stride);
+    }
+
+    /**
+     * @brief ԪأҲnullptrڱʹã
+     */
+    constexpr const StaticVertexElement* FindElement(std::string_view semanticName, uint32_t semanticIndex = 0) const
+    {
+        for (const StaticVertexElement& element : Elements)
+        {
+            if (semanticName == element.SemanticName && element.SemanticIndex == semanticIndex)
+            {
+                return &element;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief תΪʱ
+     */
+    VertexLayout ToLayout() const
+    {
+        VertexLayout layout;
+        for (const StaticVertexElement& element : Elements)
+        {
+            layout.AddElement(element.SemanticName, element.Format, element.Offset,
+                element.SemanticIndex, element.Slot);
+        }
+        layout.SetStride(Stride);
+        return layout;
+    }
+};
+
+/**
+ * @brief VertexLayoutֱΪunordered_mapļ
+ */
+template<>
+struct std::hash<VertexLayout>
+{
+    size_t operator()(const VertexLayout& layout) const noexcept
+    {
+        return static_cast<size_t>(layout.GetHash());
+    }
 };
\ No newline at end of file
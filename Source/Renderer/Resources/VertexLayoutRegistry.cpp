@@ -0,0 +1,83 @@
+// VertexLayoutRegistry.cpp
+#include "Renderer/Resources/VertexLayoutRegistry.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief פ洢
+     * @details ϣͰͰȽԴϣͻunique_ptr汣ַ֤ȶ
+     */
+    struct InternTable
+    {
+        std::shared_mutex Mutex;
+        std::unordered_map<uint64_t, std::vector<std::unique_ptr<VertexLayout>>> Buckets;
+        size_t Count = 0;
+    };
+
+    InternTable& GetTable()
+    {
+        static InternTable table;
+        return table;
+    }
+
+    const VertexLayout* FindInBucket(const std::vector<std::unique_ptr<VertexLayout>>& bucket, const VertexLayout& layout)
+    {
+        for (const auto& candidate : bucket)
+        {
+            if (*candidate == layout)
+            {
+                return candidate.get();
+            }
+        }
+        return nullptr;
+    }
+}
+
+VertexLayoutHandle VertexLayoutRegistry::Intern(const VertexLayout& layout)
+{
+    if (!layout.IsValid())
+    {
+        return VertexLayoutHandle();
+    }
+
+    InternTable& table = GetTable();
+    const uint64_t hash = layout.GetHash();
+
+    // вֻ֣Ҫ
+    {
+        std::shared_lock<std::shared_mutex> lock(table.Mutex);
+        auto it = table.Buckets.find(hash);
+        if (it != table.Buckets.end())
+        {
+            if (const VertexLayout* existing = FindInBucket(it->second, layout))
+            {
+                return VertexLayoutHandle(existing);
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(table.Mutex);
+    auto& bucket = table.Buckets[hash];
+
+    // дڼѱ̲߳
+    if (const VertexLayout* existing = FindInBucket(bucket, layout))
+    {
+        return VertexLayoutHandle(existing);
+    }
+
+    bucket.push_back(std::make_unique<VertexLayout>(layout));
+    ++table.Count;
+    return VertexLayoutHandle(bucket.back().get());
+}
+
+size_t VertexLayoutRegistry::GetInternedCount()
+{
+    InternTable& table = GetTable();
+    std::shared_lock<std::shared_mutex> lock(table.Mutex);
+    return table.Count;
+}
@@ -0,0 +1,86 @@
+// VertexLayoutRegistry.h
+#pragma once
+#include "Renderer/Resources/VertexLayout.h"
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief פĶ㲼־
+ * @details ͬĲפָͬһ淶ʵȽֻȽָ룬Ϊϣֱʹòֹϣ
+ * @note ĬϹľЧ淶ʵڳǰͷţ⿽ͳڱ
+ */
+class VertexLayoutHandle
+{
+public:
+    VertexLayoutHandle() = default;
+
+    /**
+     * @brief ǷЧ
+     */
+    bool IsValid() const { return m_layout != nullptr; }
+
+    /**
+     * @brief ȡ淶֣Ч
+     */
+    const VertexLayout& Get() const { return *m_layout; }
+    const VertexLayout& operator*() const { return *m_layout; }
+    const VertexLayout* operator->() const { return m_layout; }
+
+    /**
+     * @brief ȡֹϣЧΪ0
+     */
+    uint64_t GetHash() const { return m_layout ? m_layout->GetHash() : 0; }
+
+    bool operator==(const VertexLayoutHandle& other) const { return m_layout == other.m_layout; }
+    bool operator!=(const VertexLayoutHandle& other) const { return m_layout != other.m_layout; }
+
+private:
+    friend class VertexLayoutRegistry;
+
+    explicit VertexLayoutHandle(const VertexLayout* layout) : m_layout(layout) {}
+
+    const VertexLayout* m_layout = nullptr;
+};
+
+template<>
+struct std::hash<VertexLayoutHandle>
+{
+    size_t operator()(const VertexLayoutHandle& handle) const noexcept
+    {
+        return static_cast<size_t>(handle.GetHash());
+    }
+};
+
+
+/**
+ * @brief 㲼פ
+ * @details Ѳֹ淶ΪΨһʵPSO벼ֻԼDynamicVertexDataO(1)Լ
+ * @note ̰߳ȫפĲֻĿеĲ٣
+ */
+class VertexLayoutRegistry
+{
+public:
+    /**
+     * @brief פ֣ͬĲַͬһЧַЧ
+     */
+    static VertexLayoutHandle Intern(const VertexLayout& layout);
+
+    /**
+     * @brief ȡͶӦľÿֻפһΣ
+     */
+    template<typename VertexType>
+    static VertexLayoutHandle Get()
+    {
+        static const VertexLayoutHandle handle = Intern(VertexType::GetLayout());
+        return handle;
+    }
+
+    /**
+     * @brief ȡפĲ
+     */
+    static size_t GetInternedCount();
+
+private:
+    VertexLayoutRegistry() = delete;  // ̬
+};
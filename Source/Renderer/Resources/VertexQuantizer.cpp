@@ -0,0 +1,541 @@
+// VertexQuantizer.cpp
+#include "Renderer/Resources/VertexQuantizer.h"
+#include "Renderer/Resources/VertexKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // ÿδĶм仺屣L1/L2
+    constexpr size_t kChunkSize = 1024;
+
+    /**
+     * @brief Ԫصı뷽ʽ
+     */
+    enum class EncodeMode
+    {
+        Copy,               // ʽֱͬӿ
+        Float,              // floatfloatֻı
+        Half,               // floatת뾫
+        Snorm16,            // floatת16λSNORM
+        Unorm8,             // floatת8λUNORM
+        Octahedral,         // 루Short4_Normʱzԭw
+        BoundsSnorm16,      // λ԰Χ
+    };
+
+    uint32_t GetFloatComponentCount(VertexFormat format)
+    {
+        switch (format)
+        {
+        case VertexFormat::Float1: return 1;
+        case VertexFormat::Float2: return 2;
+        case VertexFormat::Float3: return 3;
+        case VertexFormat::Float4: return 4;
+        default: return 0;
+        }
+    }
+
+    uint32_t GetTargetComponentCount(VertexFormat format)
+    {
+        switch (format)
+        {
+        case VertexFormat::Half2:
+        case VertexFormat::Short2_Norm: return 2;
+        case VertexFormat::Half4:
+        case VertexFormat::Short4_Norm:
+        case VertexFormat::UByte4_Norm: return 4;
+        default: return GetFloatComponentCount(format);
+        }
+    }
+
+    bool IsDirectionSemantic(const std::string& semanticName)
+    {
+        return semanticName == "NORMAL" || semanticName == "TANGENT" || semanticName == "BINORMAL";
+    }
+
+    const char* GetFormatName(VertexFormat format)
+    {
+        switch (format)
+        {
+        case VertexFormat::Float1: return "Float1";
+        case VertexFormat::Float2: return "Float2";
+        case VertexFormat::Float3: return "Float3";
+        case VertexFormat::Float4: return "Float4";
+        case VertexFormat::Half2: return "Half2";
+        case VertexFormat::Half4: return "Half4";
+        case VertexFormat::UByte4_Norm: return "UByte4_Norm";
+        case VertexFormat::UByte4: return "UByte4";
+        case VertexFormat::Short2_Norm: return "Short2_Norm";
+        case VertexFormat::Short4_Norm: return "Short4_Norm";
+        default: return "Other";
+        }
+    }
+
+    EncodeMode SelectEncodeMode(const VertexElement& source, const VertexElement& target)
+    {
+        if (source.Format == target.Format)
+        {
+            return EncodeMode::Copy;
+        }
+
+        uint32_t sourceComponents = GetFloatComponentCount(source.Format);
+        if (sourceComponents > 0)
+        {
+            switch (target.Format)
+            {
+            case VertexFormat::Float1:
+            case VertexFormat::Float2:
+            case VertexFormat::Float3:
+            case VertexFormat::Float4:
+                return EncodeMode::Float;
+
+            case VertexFormat::Half2:
+            case VertexFormat::Half4:
+                return EncodeMode::Half;
+
+            case VertexFormat::UByte4_Norm:
+                return EncodeMode::Unorm8;
+
+            case VertexFormat::Short2_Norm:
+                return sourceComponents >= 3 ? EncodeMode::Octahedral : EncodeMode::Snorm16;
+
+            case VertexFormat::Short4_Norm:
+                if (source.SemanticName == "POSITION" && sourceComponents >= 3)
+                {
+                    return EncodeMode::BoundsSnorm16;
+                }
+                if (IsDirectionSemantic(source.SemanticName) && sourceComponents == 4)
+                {
+                    return EncodeMode::Octahedral;
+                }
+                return EncodeMode::Snorm16;
+
+            default:
+                break;
+            }
+        }
+
+        throw std::runtime_error("Unsupported vertex quantization: " + source.SemanticName +
+            "[" + std::to_string(source.SemanticIndex) + "] " + GetFormatName(source.Format) +
+            " -> " + GetFormatName(target.Format));
+    }
+
+    const VertexElement* FindElement(const VertexLayout& layout, const std::string& semanticName, uint32_t semanticIndex)
+    {
+        for (const VertexElement& element : layout.GetElements())
+        {
+            if (element.SemanticName == semanticName && element.SemanticIndex == semanticIndex)
+            {
+                return &element;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief ӿ粽ռÿ4floatȱٵķ(0, 0, 0, 1)
+     */
+    void GatherFloat4(const uint8_t* src, size_t stride, uint32_t components, float* dst, size_t count)
+    {
+        static const float kDefaults[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float* out = dst + i * 4;
+            std::memcpy(out, src + i * stride, components * sizeof(float));
+            for (uint32_t c = components; c < 4; ++c)
+            {
+                out[c] = kDefaults[c];
+            }
+        }
+    }
+
+    void ScatterStrided(const void* src, size_t elementSize, uint8_t* dst, size_t stride, size_t count)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(src);
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(dst + i * stride, bytes + i * elementSize, elementSize);
+        }
+    }
+
+    inline float SnormToFloat(int16_t value)
+    {
+        return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    inline float SignNotZero(float value)
+    {
+        return value >= 0.0f ? 1.0f : -1.0f;
+    }
+
+    /**
+     * @brief ۼ
+     */
+    struct ErrorAccumulator
+    {
+        double Max = 0.0;
+        double Sum = 0.0;
+
+        void Add(double error)
+        {
+            Max = std::max(Max, error);
+            Sum += error;
+        }
+    };
+
+    /**
+     * @brief йõм仺
+     */
+    struct ChunkBuffers
+    {
+        std::vector<float> Original = std::vector<float>(kChunkSize * 4);
+        std::vector<float> Encoded = std::vector<float>(kChunkSize * 4);
+        std::vector<float> Decoded = std::vector<float>(kChunkSize * 4);
+        std::vector<uint16_t> Packed16 = std::vector<uint16_t>(kChunkSize * 4);
+        std::vector<uint8_t> Packed8 = std::vector<uint8_t>(kChunkSize * 4);
+    };
+
+    /**
+     * @brief Ԫصж
+     */
+    void QuantizeElement(const DynamicVertexData& source, const VertexElement& sourceElement,
+        DynamicVertexData& target, const VertexElement& targetElement, EncodeMode mode,
+        VertexQuantizationReport& report, ChunkBuffers& buffers, ErrorAccumulator& error)
+    {
+        const size_t vertexCount = source.GetVertexCount();
+        const size_t sourceStride = source.GetStride();
+        const size_t targetStride = target.GetStride();
+        const uint8_t* sourceBase = static_cast<const uint8_t*>(source.GetData()) + sourceElement.Offset;
+        uint8_t* targetBase = static_cast<uint8_t*>(target.GetData()) + targetElement.Offset;
+
+        if (mode == EncodeMode::Copy)
+        {
+            uint32_t size = GetVertexFormatSize(sourceElement.Format);
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                std::memcpy(targetBase + i * targetStride, sourceBase + i * sourceStride, size);
+            }
+            return;
+        }
+
+        const uint32_t sourceComponents = GetFloatComponentCount(sourceElement.Format);
+        const uint32_t targetComponents = GetTargetComponentCount(targetElement.Format);
+        const size_t targetSize = GetVertexFormatSize(targetElement.Format);
+
+        if (mode == EncodeMode::BoundsSnorm16)
+        {
+            VertexKernels::BoundingBox bounds = VertexKernels::ComputeBounds(sourceBase, sourceStride, vertexCount);
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                float halfExtent = (bounds.Max[axis] - bounds.Min[axis]) * 0.5f;
+                report.PositionOffset[axis] = (bounds.Max[axis] + bounds.Min[axis]) * 0.5f;
+                report.PositionScale[axis] = halfExtent > 0.0f ? halfExtent : 1.0f;
+            }
+        }
+
+        float* original = buffers.Original.data();
+        float* encoded = buffers.Encoded.data();
+        float* decoded = buffers.Decoded.data();
+
+        for (size_t start = 0; start < vertexCount; start += kChunkSize)
+        {
+            const size_t count = std::min(kChunkSize, vertexCount - start);
+            const size_t scalarCount = count * targetComponents;
+
+            GatherFloat4(sourceBase + start * sourceStride, sourceStride, sourceComponents, original, count);
+
+            // 1. ԤĿΪfloat
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float* in = original + i * 4;
+                float* out = encoded + i * targetComponents;
+
+                switch (mode)
+                {
+                case EncodeMode::Octahedral:
+                    VertexQuantizer::OctahedralEncode(in, out);
+                    if (targetComponents == 4)
+                    {
+                        out[2] = in[3];
+                        out[3] = 0.0f;
+                    }
+                    break;
+
+                case EncodeMode::BoundsSnorm16:
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        out[axis] = (in[axis] - report.PositionOffset[axis]) / report.PositionScale[axis];
+                    }
+                    out[3] = 1.0f;
+                    break;
+
+                default:
+                    std::memcpy(out, in, targetComponents * sizeof(float));
+                    break;
+                }
+            }
+
+            // 2. תдĿ겼֣ͬʱͳ
+            uint8_t* targetChunk = targetBase + start * targetStride;
+            switch (mode)
+            {
+            case EncodeMode::Float:
+                ScatterStrided(encoded, targetSize, targetChunk, targetStride, count);
+                std::memcpy(decoded, encoded, scalarCount * sizeof(float));
+                break;
+
+            case EncodeMode::Half:
+                VertexKernels::FloatToHalf(encoded, buffers.Packed16.data(), scalarCount);
+                VertexKernels::HalfToFloat(buffers.Packed16.data(), decoded, scalarCount);
+                ScatterStrided(buffers.Packed16.data(), targetSize, targetChunk, targetStride, count);
+                break;
+
+            case EncodeMode::Unorm8:
+                VertexKernels::FloatToUnorm8(encoded, buffers.Packed8.data(), scalarCount);
+                for (size_t i = 0; i < scalarCount; ++i)
+                {
+                    decoded[i] = buffers.Packed8[i] / 255.0f;
+                }
+                ScatterStrided(buffers.Packed8.data(), targetSize, targetChunk, targetStride, count);
+                break;
+
+            default:
+            {
+                int16_t* packed = reinterpret_cast<int16_t*>(buffers.Packed16.data());
+                VertexKernels::FloatToSnorm16(encoded, packed, scalarCount);
+                for (size_t i = 0; i < scalarCount; ++i)
+                {
+                    decoded[i] = SnormToFloat(packed[i]);
+                }
+                ScatterStrided(packed, targetSize, targetChunk, targetStride, count);
+                break;
+            }
+            }
+
+            // 3. 򰴼нǣλûԭģͿռ䣬ఴ
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float* in = original + i * 4;
+                const float* out = decoded + i * targetComponents;
+
+                if (mode == EncodeMode::Octahedral)
+                {
+                    float direction[3];
+                    VertexQuantizer::OctahedralDecode(out, direction);
+
+                    // СǶacos(dot)Ȳatan2(|a x b|, a . b)double¼
+                    double ax = in[0], ay = in[1], az = in[2];
+                    double bx = direction[0], by = direction[1], bz = direction[2];
+                    double cx = ay * bz - az * by;
+                    double cy = az * bx - ax * bz;
+                    double cz = ax * by - ay * bx;
+                    double dot = ax * bx + ay * by + az * bz;
+                    bool isZero = ax == 0.0 && ay == 0.0 && az == 0.0;
+                    error.Add(isZero ? 0.0 :
+                        std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot) * (180.0 / 3.14159265358979323846));
+                }
+                else if (mode == EncodeMode::BoundsSnorm16)
+                {
+                    double maxError = 0.0;
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        float restored = out[axis] * report.PositionScale[axis] + report.PositionOffset[axis];
+                        maxError = std::max(maxError, static_cast<double>(std::fabs(restored - in[axis])));
+                    }
+                    error.Add(maxError);
+                }
+                else
+                {
+                    double maxError = 0.0;
+                    for (uint32_t c = 0; c < targetComponents; ++c)
+                    {
+                        maxError = std::max(maxError, static_cast<double>(std::fabs(out[c] - in[c])));
+                    }
+                    error.Add(maxError);
+                }
+            }
+        }
+    }
+}
+
+// =======================================================================
+//                        
+// =======================================================================
+
+VertexLayout VertexQuantizer::BuildCompactLayout(const VertexLayout& source, const VertexQuantizationOptions& options)
+{
+    VertexLayout result;
+    uint32_t offset = 0;
+
+    for (const VertexElement& element : source.GetElements())
+    {
+        VertexFormat format = element.Format;
+        uint32_t components = GetFloatComponentCount(element.Format);
+
+        if (element.SemanticName == "POSITION")
+        {
+            if (options.QuantizePositions && components >= 3)
+            {
+                format = VertexFormat::Short4_Norm;
+            }
+        }
+        else if (IsDirectionSemantic(element.SemanticName))
+        {
+            if (options.EncodeDirections && components >= 3)
+            {
+                format = components == 4 ? VertexFormat::Short4_Norm : VertexFormat::Short2_Norm;
+            }
+        }
+        else if (element.SemanticName == "TEXCOORD")
+        {
+            if (options.HalfTexCoords && components > 0)
+            {
+                format = components <= 2 ? VertexFormat::Half2 : VertexFormat::Half4;
+            }
+        }
+        else if (element.SemanticName == "COLOR")
+        {
+            if (options.PackColors && components >= 3)
+            {
+                format = VertexFormat::UByte4_Norm;
+            }
+        }
+
+        result.AddElement(element.SemanticName, format, offset, element.SemanticIndex, element.Slot);
+
+        // иʽ4ֽڵı4ֽڶ
+        offset += (GetVertexFormatSize(format) + 3) & ~3u;
+    }
+
+    result.CalculateStride();
+    return result;
+}
+
+
+// =======================================================================
+//                        
+// =======================================================================
+
+DynamicVertexData VertexQuantizer::Quantize(const DynamicVertexData& source, const VertexLayout& target,
+    VertexQuantizationReport* report)
+{
+    const VertexLayout& sourceLayout = source.GetLayout();
+    if (!sourceLayout.IsValid() || !target.IsValid())
+    {
+        throw std::invalid_argument("VertexQuantizer: source and target layouts must be valid");
+    }
+
+    // ȽȫԪأ֤ʽ֧ʱƷ
+    std::vector<const VertexElement*> sourceElements;
+    std::vector<EncodeMode> modes;
+    for (const VertexElement& element : target.GetElements())
+    {
+        const VertexElement* sourceElement = FindElement(sourceLayout, element.SemanticName, element.SemanticIndex);
+        if (!sourceElement)
+        {
+            throw std::runtime_error("VertexQuantizer: source has no element " + element.SemanticName +
+                "[" + std::to_string(element.SemanticIndex) + "]");
+        }
+
+        EncodeMode mode = SelectEncodeMode(*sourceElement, element);
+        if (mode == EncodeMode::BoundsSnorm16 && !report)
+        {
+            throw std::invalid_argument("VertexQuantizer: quantized positions require a report to return decode parameters");
+        }
+
+        sourceElements.push_back(sourceElement);
+        modes.push_back(mode);
+    }
+
+    VertexQuantizationReport localReport;
+    VertexQuantizationReport& outReport = report ? *report : localReport;
+    outReport = VertexQuantizationReport();
+    outReport.VertexCount = source.GetVertexCount();
+    outReport.SourceStride = sourceLayout.GetStride();
+    outReport.TargetStride = target.GetStride();
+
+    DynamicVertexData result;
+    result.Resize(target, source.GetVertexCount());
+    if (!result.IsValid())
+    {
+        return result;
+    }
+
+    // Ԫֽ֮㣬֤ȷ
+    std::memset(result.GetData(), 0, result.GetDataSize());
+
+    ChunkBuffers buffers;
+    for (uint32_t i = 0; i < target.GetElementCount(); ++i)
+    {
+        const VertexElement& targetElement = target.GetElement(i);
+
+        ErrorAccumulator error;
+        QuantizeElement(source, *sourceElements[i], result, targetElement, modes[i], outReport, buffers, error);
+
+        VertexElementError elementError;
+        elementError.SemanticName = targetElement.SemanticName;
+        elementError.SemanticIndex = targetElement.SemanticIndex;
+        elementError.SourceFormat = sourceElements[i]->Format;
+        elementError.TargetFormat = targetElement.Format;
+        elementError.IsAngular = modes[i] == EncodeMode::Octahedral;
+        elementError.MaxError = error.Max;
+        elementError.MeanError = error.Sum / static_cast<double>(source.GetVertexCount());
+        outReport.Elements.push_back(elementError);
+    }
+
+    return result;
+}
+
+
+// =======================================================================
+//                        
+// =======================================================================
+
+void VertexQuantizer::OctahedralEncode(const float direction[3], float outEncoded[2])
+{
+    float sum = std::fabs(direction[0]) + std::fabs(direction[1]) + std::fabs(direction[2]);
+    if (sum <= 0.0f)
+    {
+        outEncoded[0] = 0.0f;
+        outEncoded[1] = 0.0f;
+        return;
+    }
+
+    float x = direction[0] / sum;
+    float y = direction[1] / sum;
+
+    // °ضԽ۵
+    if (direction[2] < 0.0f)
+    {
+        float foldedX = (1.0f - std::fabs(y)) * SignNotZero(x);
+        float foldedY = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    outEncoded[0] = x;
+    outEncoded[1] = y;
+}
+
+void VertexQuantizer::OctahedralDecode(const float encoded[2], float outDirection[3])
+{
+    float x = encoded[0];
+    float y = encoded[1];
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+
+    if (z < 0.0f)
+    {
+        float unfoldedX = (1.0f - std::fabs(y)) * SignNotZero(x);
+        float unfoldedY = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = unfoldedX;
+        y = unfoldedY;
+    }
+
+    float length = std::sqrt(x * x + y * y + z * z);
+    outDirection[0] = x / length;
+    outDirection[1] = y / length;
+    outDirection[2] = z / length;
+}
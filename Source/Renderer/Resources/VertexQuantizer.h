@@ -0,0 +1,84 @@
+// VertexQuantizer.h
+#pragma once
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/VertexLayout.h"
+#include "Renderer/Resources/VertexFormat.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * @brief ѹֵѡ
+ */
+struct VertexQuantizationOptions
+{
+    bool QuantizePositions = false;     // POSITIONѹΪShort4_Norm԰ΧУɫPositionOffset/PositionScaleԭ
+    bool EncodeDirections = true;       // NORMAL/TANGENT/BINORMALΪShort2_NormFloat4wShort4_Norm
+    bool HalfTexCoords = true;          // TEXCOORDѹΪHalf2/Half4
+    bool PackColors = true;             // COLORѹΪUByte4_Norm
+};
+
+/**
+ * @brief Ԫص
+ */
+struct VertexElementError
+{
+    std::string SemanticName;
+    uint32_t SemanticIndex = 0;
+    VertexFormat SourceFormat = VertexFormat::Unknown;
+    VertexFormat TargetFormat = VertexFormat::Unknown;
+    bool IsAngular = false;             // ΪtrueʱλΪǶȣȣΪľ
+    double MaxError = 0.0;
+    double MeanError = 0.0;
+};
+
+/**
+ * @brief 
+ */
+struct VertexQuantizationReport
+{
+    size_t VertexCount = 0;
+    uint32_t SourceStride = 0;
+    uint32_t TargetStride = 0;
+
+    // λý룺pos = snorm * PositionScale + PositionOffsetδλʱΪ01
+    float PositionOffset[3] = { 0.0f, 0.0f, 0.0f };
+    float PositionScale[3] = { 1.0f, 1.0f, 1.0f };
+
+    std::vector<VertexElementError> Elements;
+};
+
+/**
+ * @brief 
+ * @details ȫfloatDynamicVertexData±뵽յĿ겼֣뾫UV巨ߡUNORM8ɫΧλã
+ *          ռVertexKernelsת
+ * @note Ŀ겼ֵԪذԴֶӦȱٵķװĹ(0, 0, 0, 1)
+ */
+class VertexQuantizer
+{
+public:
+    /**
+     * @brief Դɽղ֣Ԫ˳򲻱䣬ƫ½У
+     */
+    static VertexLayout BuildCompactLayout(const VertexLayout& source, const VertexQuantizationOptions& options = {});
+
+    /**
+     * @brief ѶĿ겼
+     * @details ԴԪȱʧʽϲ֧ʱ׳쳣Ŀ겼λʱ봫reportȡؽ
+     */
+    static DynamicVertexData Quantize(const DynamicVertexData& source, const VertexLayout& target,
+        VertexQuantizationReport* report = nullptr);
+
+    /**
+     * @brief 뵥λ[-1, 1]
+     */
+    static void OctahedralEncode(const float direction[3], float outEncoded[2]);
+
+    /**
+     * @brief 루ѹһ
+     */
+    static void OctahedralDecode(const float encoded[2], float outDirection[3]);
+
+private:
+    VertexQuantizer() = delete;  // ̬
+};
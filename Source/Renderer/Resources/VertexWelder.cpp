@@ -0,0 +1,523 @@
+// VertexWelder.cpp
+#include "Renderer/Resources/VertexWelder.h"
+#include "Timer/Clock.h"
+#include "Timer/Profiler.h"
+#include "Core/Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <xmmintrin.h>
+#define KJ_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#define KJ_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define KJ_PREFETCH(address) ((void)(address))
+#endif
+
+namespace
+{
+    // ÿĶ
+    constexpr size_t kBatchSize = 64 * 1024;
+
+    // Զڻ棬ÿ̽ⶼһô棻ۺǰãǰôԤȡ
+    constexpr size_t kPrefetchDistance = 16;
+
+    // ƿıعʱ̽ôλûҵλþͷ
+    constexpr size_t kMaxProbes = 1024;
+
+    // HyperLogLogͼļĴ2^12ƵԼ1.6%
+    constexpr uint32_t kSketchBits = 12;
+    constexpr size_t kSketchSize = size_t(1) << kSketchBits;
+
+    // ղ
+    constexpr uint64_t kEmptySlot = 0;
+
+    /**
+     * @brief ȽϼһΣԭֽڣݲȡfloat
+     */
+    struct KeyPart
+    {
+        uint32_t Offset = 0;        // ڶеƫ
+        uint32_t Size = 0;          // ԭֽ
+        uint32_t Components = 0;    // ȡķΪ0ʱԭ
+        double InverseEpsilon = 0.0;
+    };
+
+    inline int64_t QuantizeComponent(float value, double inverseEpsilon)
+    {
+        // floor(x + 0.5)std::floorûSSE4.1ʱǺãýض
+        const double scaled = static_cast<double>(value) * inverseEpsilon + 0.5;
+        if (scaled > -9.0e18 && scaled < 9.0e18)
+        {
+            const int64_t truncated = static_cast<int64_t>(scaled);
+            return static_cast<double>(truncated) > scaled ? truncated - 1 : truncated;
+        }
+        // NaNͳΧֵλ֣ȡȡ
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return std::numeric_limits<int64_t>::min() + bits;
+    }
+
+    inline uint64_t HashKey(const uint8_t* key, size_t size)
+    {
+        uint64_t hash = static_cast<uint64_t>(size) * 0x9E3779B97F4A7C15ull;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t value;
+            std::memcpy(&value, key + i, sizeof(value));
+            hash = (hash ^ value) * 0xC2B2AE3D27D4EB4Full;
+            hash ^= hash >> 29;
+        }
+        if (i < size)
+        {
+            uint64_t value = 0;
+            std::memcpy(&value, key + i, size - i);
+            hash = (hash ^ value) * 0xC2B2AE3D27D4EB4Full;
+        }
+        hash ^= hash >> 32;
+        hash *= 0xD6E8FEB86659FD93ull;
+        return hash ^ (hash >> 32);
+    }
+
+    inline void AddToSketch(uint8_t* sketch, uint32_t hash)
+    {
+        // kSketchBitsλѡĴλǰ+1ȣһڱλ32 - kSketchBits + 1
+        const uint32_t index = hash >> (32 - kSketchBits);
+        const uint32_t rest = hash << kSketchBits | 1u << (kSketchBits - 1);
+        const uint8_t rank = static_cast<uint8_t>(std::countl_zero(rest) + 1);
+        sketch[index] = std::max(sketch[index], rank);
+    }
+
+    double EstimateDistinctCount(const uint8_t* sketch)
+    {
+        const double registerCount = static_cast<double>(kSketchSize);
+        double sum = 0.0;
+        size_t zeroCount = 0;
+        for (size_t j = 0; j < kSketchSize; ++j)
+        {
+            sum += std::ldexp(1.0, -static_cast<int>(sketch[j]));
+            zeroCount += sketch[j] == 0 ? 1 : 0;
+        }
+        const double estimate = 0.7213 / (1.0 + 1.079 / registerCount) * registerCount * registerCount / sum;
+        // СʱռĴԼ
+        if (estimate <= 2.5 * registerCount && zeroCount > 0)
+        {
+            return registerCount * std::log(registerCount / static_cast<double>(zeroCount));
+        }
+        return estimate;
+    }
+
+    /**
+     * @brief ѡгĸΣؼֽΪձʾֱӱȽ
+     */
+    uint32_t BuildKeyParts(const VertexDataView& vertices, const VertexWeldOptions& options, std::vector<KeyPart>& outParts)
+    {
+        outParts.clear();
+        if (options.Attributes.empty())
+        {
+            return vertices.GetStride();
+        }
+
+        uint32_t keySize = 0;
+        for (const VertexWeldAttribute& attribute : options.Attributes)
+        {
+            const VertexAttributeHandle handle = vertices.FindAttribute(attribute.SemanticName, attribute.SemanticIndex);
+            if (!handle.IsValid())
+            {
+                throw std::runtime_error("VertexWelder: vertex has no element " + attribute.SemanticName +
+                    std::to_string(attribute.SemanticIndex));
+            }
+            if (!(attribute.Epsilon >= 0.0f))
+            {
+                throw std::invalid_argument("VertexWelder: epsilon of " + attribute.SemanticName + " must not be negative");
+            }
+
+            KeyPart part;
+            part.Offset = handle.Offset;
+            if (attribute.Epsilon > 0.0f)
+            {
+                if (handle.Format != VertexFormat::Float1 && handle.Format != VertexFormat::Float2 &&
+                    handle.Format != VertexFormat::Float3 && handle.Format != VertexFormat::Float4)
+                {
+                    throw std::runtime_error("VertexWelder: epsilon is only supported for float elements, " +
+                        attribute.SemanticName + " is not");
+                }
+                part.Components = handle.Size / sizeof(float);
+                part.InverseEpsilon = 1.0 / static_cast<double>(attribute.Epsilon);
+                keySize += part.Components * sizeof(int64_t);
+            }
+            else
+            {
+                part.Size = handle.Size;
+                keySize += part.Size;
+            }
+            outParts.push_back(part);
+        }
+
+        if (!options.IgnoreOtherAttributes)
+        {
+            for (const VertexElement& element : vertices.GetLayout().GetElements())
+            {
+                const bool listed = std::any_of(options.Attributes.begin(), options.Attributes.end(),
+                    [&element](const VertexWeldAttribute& attribute)
+                    {
+                        return attribute.SemanticName == element.SemanticName && attribute.SemanticIndex == element.SemanticIndex;
+                    });
+                if (!listed)
+                {
+                    KeyPart part;
+                    part.Offset = element.Offset;
+                    part.Size = GetVertexFormatSize(element.Format);
+                    keySize += part.Size;
+                    outParts.push_back(part);
+                }
+            }
+        }
+        return keySize;
+    }
+
+    void WriteKey(const uint8_t* vertex, const std::vector<KeyPart>& parts, uint8_t* key)
+    {
+        for (const KeyPart& part : parts)
+        {
+            if (part.Components == 0)
+            {
+                std::memcpy(key, vertex + part.Offset, part.Size);
+                key += part.Size;
+                continue;
+            }
+            for (uint32_t c = 0; c < part.Components; ++c)
+            {
+                float value;
+                std::memcpy(&value, vertex + part.Offset + c * sizeof(float), sizeof(value));
+                const int64_t quantized = QuantizeComponent(value, part.InverseEpsilon);
+                std::memcpy(key, &quantized, sizeof(quantized));
+                key += sizeof(quantized);
+            }
+        }
+    }
+
+    inline void WriteIndex(uint8_t* data, MeshIndexFormat format, size_t position, uint32_t value)
+    {
+        if (format == MeshIndexFormat::UInt16)
+        {
+            const uint16_t narrow = static_cast<uint16_t>(value);
+            std::memcpy(data + position * sizeof(uint16_t), &narrow, sizeof(narrow));
+        }
+        else
+        {
+            std::memcpy(data + position * sizeof(uint32_t), &value, sizeof(value));
+        }
+    }
+
+    VertexWeldResult WeldImpl(const VertexDataView& vertices, const uint32_t* indices, size_t indexCount,
+        const VertexWeldOptions& options)
+    {
+        KJ_PROFILE_SCOPE("Weld Vertices");
+        const int64_t start = SteadyClock::Now();
+
+        if (!vertices.IsValid())
+        {
+            throw std::invalid_argument("VertexWelder: vertex data is empty or has an invalid layout");
+        }
+        const size_t vertexCount = vertices.GetVertexCount();
+        // ۺҲҪŽ32λ
+        if (vertexCount + vertexCount / 2 > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::invalid_argument("VertexWelder: too many vertices for 32-bit indices");
+        }
+        if (indices == nullptr && indexCount > 0)
+        {
+            throw std::invalid_argument("VertexWelder: index count is set but indices are null");
+        }
+
+        std::vector<KeyPart> parts;
+        const uint32_t keySize = BuildKeyParts(vertices, options, parts);
+        const uint32_t stride = vertices.GetStride();
+        const uint8_t* source = static_cast<const uint8_t*>(vertices.GetData());
+
+        const uint32_t threadCount = Parallel::ResolveThreadCount(options.ThreadCount);
+        const size_t batchCount = (vertexCount + kBatchSize - 1) / kBatchSize;
+
+        VertexWeldResult result;
+        result.InputVertexCount = vertexCount;
+        result.ThreadCount = static_cast<uint32_t>(std::min<size_t>(threadCount, batchCount));
+
+        // Ƚʱֱöݵʡһݿ
+        std::vector<uint8_t> keyStorage;
+        if (!parts.empty())
+        {
+            keyStorage.resize(vertexCount * keySize);
+        }
+        const uint8_t* keys = parts.empty() ? source : keyStorage.data();
+        const size_t keyStride = parts.empty() ? stride : keySize;
+
+        // ϣֻ32λźڴĴ±ţ˳㰴HyperLogLogͼΨһ
+        std::vector<uint32_t> hashes(vertexCount);
+        std::vector<uint8_t> sketches(batchCount * kSketchSize, 0);
+        Parallel::Run(batchCount, threadCount, "Vertex Weld", [&](size_t batch)
+        {
+            KJ_PROFILE_SCOPE("Hash Vertices");
+            uint8_t* sketch = sketches.data() + batch * kSketchSize;
+            const size_t end = std::min(vertexCount, (batch + 1) * kBatchSize);
+            for (size_t i = batch * kBatchSize; i < end; ++i)
+            {
+                if (!parts.empty())
+                {
+                    WriteKey(source + i * stride, parts, keyStorage.data() + i * keySize);
+                }
+                const uint32_t hash = static_cast<uint32_t>(HashKey(keys + i * keyStride, keySize));
+                hashes[i] = hash;
+                AddToSketch(sketch, hash);
+            }
+        });
+        for (size_t batch = 1; batch < batchCount; ++batch)
+        {
+            for (size_t j = 0; j < kSketchSize; ++j)
+            {
+                sketches[j] = std::max(sketches[j], sketches[batch * kSketchSize + j]);
+            }
+        }
+
+        // ƵΨһһңΨһֻ1/61/3뿪ȷڴֶȱҳ
+        // ƫС̽ʱű1.5̽
+        size_t maxCapacity = 64;
+        while (maxCapacity < vertexCount + vertexCount / 2)
+        {
+            maxCapacity <<= 1;
+        }
+        const double estimate = EstimateDistinctCount(sketches.data());
+        size_t capacity = 64;
+        while (capacity < maxCapacity && static_cast<double>(capacity) < estimate * 2.0)
+        {
+            capacity <<= 1;
+        }
+        std::vector<uint8_t>().swap(sketches);
+
+        // 32λϣ32λ涥+1ϣͬĲ۲ȥһֻ̽һô档
+        // ڵĲȼRemapResolveʱɴ
+        result.Remap.resize(vertexCount);
+        std::vector<std::atomic<uint64_t>> table;
+        while (true)
+        {
+            table = std::vector<std::atomic<uint64_t>>(capacity);
+            const size_t mask = capacity - 1;
+            const size_t probeLimit = capacity < maxCapacity ? kMaxProbes : capacity;
+            std::atomic<bool> overflow = false;
+
+            // ղCASռסͬʱѲıŻɽСģ˭Ȳ붼Ӱ
+            Parallel::Run(batchCount, threadCount, "Vertex Weld", [&](size_t batch)
+            {
+                KJ_PROFILE_SCOPE("Insert Vertices");
+                const size_t end = std::min(vertexCount, (batch + 1) * kBatchSize);
+                for (size_t i = batch * kBatchSize; i < end; ++i)
+                {
+                    if (i + kPrefetchDistance < end)
+                    {
+                        KJ_PREFETCH(&table[hashes[i + kPrefetchDistance] & mask]);
+                    }
+                    const uint64_t hashBits = static_cast<uint64_t>(hashes[i]) << 32;
+                    const uint64_t entry = hashBits | static_cast<uint64_t>(i + 1);
+                    size_t slot = hashes[i] & mask;
+                    size_t probes = 0;
+                    uint64_t current = table[slot].load(std::memory_order_relaxed);
+                    while (true)
+                    {
+                        if (current == kEmptySlot)
+                        {
+                            if (table[slot].compare_exchange_weak(current, entry, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                            continue;
+                        }
+                        const size_t other = static_cast<uint32_t>(current) - 1;
+                        if ((current & ~0xFFFFFFFFull) == hashBits &&
+                            std::memcmp(keys + other * keyStride, keys + i * keyStride, keySize) == 0)
+                        {
+                            // ͬһֻͬļCASʧܺضıԱ
+                            while (entry < current && !table[slot].compare_exchange_weak(current, entry, std::memory_order_relaxed))
+                            {
+                            }
+                            break;
+                        }
+                        if (++probes == probeLimit || overflow.load(std::memory_order_relaxed))
+                        {
+                            overflow.store(true, std::memory_order_relaxed);
+                            return;
+                        }
+                        slot = (slot + 1) & mask;
+                        current = table[slot].load(std::memory_order_relaxed);
+                    }
+                    result.Remap[i] = static_cast<uint32_t>(slot);
+                }
+            });
+
+            if (!overflow.load())
+            {
+                break;
+            }
+            capacity = std::min(capacity * 4, maxCapacity);
+        }
+
+        // ÿԼĲȡһСĶ㣬ͳÿΨһ
+        std::vector<size_t> batchUniqueCounts(batchCount, 0);
+        Parallel::Run(batchCount, threadCount, "Vertex Weld", [&](size_t batch)
+        {
+            KJ_PROFILE_SCOPE("Resolve Vertices");
+            const size_t end = std::min(vertexCount, (batch + 1) * kBatchSize);
+            size_t uniqueCount = 0;
+            for (size_t i = batch * kBatchSize; i < end; ++i)
+            {
+                if (i + kPrefetchDistance < end)
+                {
+                    KJ_PREFETCH(&table[result.Remap[i + kPrefetchDistance]]);
+                }
+                const uint32_t representative = static_cast<uint32_t>(table[result.Remap[i]].load(std::memory_order_relaxed)) - 1;
+                result.Remap[i] = representative;
+                uniqueCount += representative == i ? 1 : 0;
+            }
+            batchUniqueCounts[batch] = uniqueCount;
+        });
+        std::vector<std::atomic<uint64_t>>().swap(table);
+        std::vector<uint8_t>().swap(keyStorage);
+
+        size_t outputCount = 0;
+        for (size_t& count : batchUniqueCounts)
+        {
+            const size_t batchStart = outputCount;
+            outputCount += count;
+            count = batchStart;
+        }
+
+        result.Vertices = DynamicVertexData(vertices.GetLayout(), outputCount);
+        uint8_t* destination = static_cast<uint8_t*>(result.Vertices.GetData());
+        Parallel::Run(batchCount, threadCount, "Vertex Weld", [&](size_t batch)
+        {
+            KJ_PROFILE_SCOPE("Compact Vertices");
+            const size_t end = std::min(vertexCount, (batch + 1) * kBatchSize);
+            uint32_t next = static_cast<uint32_t>(batchUniqueCounts[batch]);
+            for (size_t i = batch * kBatchSize; i < end; ++i)
+            {
+                if (result.Remap[i] == i)
+                {
+                    hashes[i] = next;
+                    std::memcpy(destination + static_cast<size_t>(next) * stride, source + i * stride, stride);
+                    ++next;
+                }
+            }
+        });
+
+        result.IndexFormat = options.AllowIndex16 && outputCount <= 0x10000 ? MeshIndexFormat::UInt16 : MeshIndexFormat::UInt32;
+        result.IndexCount = indices != nullptr ? indexCount : vertexCount;
+        result.IndexData.resize(result.IndexCount * GetMeshIndexSize(result.IndexFormat));
+        uint8_t* indexData = result.IndexData.data();
+
+        // ±һѾдãܿȡRemap
+        Parallel::Run(batchCount, threadCount, "Vertex Weld", [&](size_t batch)
+        {
+            KJ_PROFILE_SCOPE("Remap Vertices");
+            const size_t end = std::min(vertexCount, (batch + 1) * kBatchSize);
+            for (size_t i = batch * kBatchSize; i < end; ++i)
+            {
+                const uint32_t vertex = hashes[result.Remap[i]];
+                result.Remap[i] = vertex;
+                if (indices == nullptr)
+                {
+                    WriteIndex(indexData, result.IndexFormat, i, vertex);
+                }
+            }
+        });
+
+        if (indices != nullptr)
+        {
+            const size_t indexBatchCount = (indexCount + kBatchSize - 1) / kBatchSize;
+            std::atomic<bool> outOfRange = false;
+            Parallel::Run(indexBatchCount, threadCount, "Vertex Weld", [&](size_t batch)
+            {
+                KJ_PROFILE_SCOPE("Remap Indices");
+                const size_t end = std::min(indexCount, (batch + 1) * kBatchSize);
+                for (size_t i = batch * kBatchSize; i < end; ++i)
+                {
+                    const uint32_t index = indices[i];
+                    if (index >= vertexCount)
+                    {
+                        outOfRange.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                    WriteIndex(indexData, result.IndexFormat, i, result.Remap[index]);
+                }
+            });
+            if (outOfRange.load())
+            {
+                throw std::invalid_argument("VertexWelder: index is out of range (" + std::to_string(vertexCount) + " vertices)");
+            }
+        }
+
+        result.Milliseconds = static_cast<double>(SteadyClock::Now() - start) / 1.0e6;
+        return result;
+    }
+}
+
+
+double VertexWeldResult::GetReductionRatio() const
+{
+    const size_t outputCount = GetOutputVertexCount();
+    return outputCount > 0 ? static_cast<double>(InputVertexCount) / static_cast<double>(outputCount) : 0.0;
+}
+
+
+uint32_t VertexWeldResult::GetIndex(size_t index) const
+{
+    if (IndexFormat == MeshIndexFormat::UInt16)
+    {
+        uint16_t value;
+        std::memcpy(&value, IndexData.data() + index * sizeof(uint16_t), sizeof(value));
+        return value;
+    }
+    uint32_t value;
+    std::memcpy(&value, IndexData.data() + index * sizeof(uint32_t), sizeof(value));
+    return value;
+}
+
+
+std::vector<uint32_t> VertexWeldResult::CopyIndices() const
+{
+    std::vector<uint32_t> indices(IndexCount);
+    if (IndexFormat == MeshIndexFormat::UInt32 && IndexCount > 0)
+    {
+        std::memcpy(indices.data(), IndexData.data(), IndexCount * sizeof(uint32_t));
+        return indices;
+    }
+    for (size_t i = 0; i < IndexCount; ++i)
+    {
+        indices[i] = GetIndex(i);
+    }
+    return indices;
+}
+
+
+VertexWeldResult VertexWelder::Weld(const VertexDataView& vertices, const VertexWeldOptions& options)
+{
+    return WeldImpl(vertices, nullptr, 0, options);
+}
+
+
+VertexWeldResult VertexWelder::Weld(const VertexDataView& vertices, const uint32_t* indices, size_t indexCount,
+    const VertexWeldOptions& options)
+{
+    if (indices == nullptr && indexCount == 0)
+    {
+        // ʲôֿ
+        static const uint32_t kNoIndices = 0;
+        return WeldImpl(vertices, &kNoIndices, 0, options);
+    }
+    return WeldImpl(vertices, indices, indexCount, options);
+}
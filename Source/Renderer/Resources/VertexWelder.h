@@ -0,0 +1,88 @@
+// VertexWelder.h
+#pragma once
+#include "Renderer/Resources/DynamicVertexData.h"
+#include "Renderer/Resources/MeshFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief ݲȽϵ
+ */
+struct VertexWeldAttribute
+{
+    std::string SemanticName;
+    uint32_t SemanticIndex = 0;
+    float Epsilon = 0.0f;       // 0ʾλȽϣ0ʱֻ֧Float1~Float4EpsilonȡȽ
+};
+
+/**
+ * @brief ѡ
+ */
+struct VertexWeldOptions
+{
+    std::vector<VertexWeldAttribute> Attributes;    // ΪʱȽֽڣ䣩
+    bool IgnoreOtherAttributes = false;             // AttributesǿʱûгԪزȽϣϲȡһֵ
+    bool AllowIndex16 = true;                       // Ӻ󶥵65536ʱ16λ
+    uint32_t ThreadCount = 0;                       // 0ʾӲ߳
+};
+
+/**
+ * @brief ӽ
+ */
+struct VertexWeldResult
+{
+    DynamicVertexData Vertices;                     // һγֵ˳еΨһ
+    MeshIndexFormat IndexFormat = MeshIndexFormat::None;
+    std::vector<uint8_t> IndexData;                 // IndexFormatŵб
+    size_t IndexCount = 0;
+    std::vector<uint32_t> Remap;                    // 붥 -> 
+
+    size_t InputVertexCount = 0;
+    uint32_t ThreadCount = 0;
+    double Milliseconds = 0.0;
+
+    size_t GetOutputVertexCount() const { return Vertices.GetVertexCount(); }
+
+    /**
+     * @brief 붥 / һӽ36
+     */
+    double GetReductionRatio() const;
+
+    /**
+     * @brief ȡһ鷶Χ
+     */
+    uint32_t GetIndex(size_t index) const;
+
+    /**
+     * @brief չ32λ
+     */
+    std::vector<uint32_t> CopyIndices() const;
+};
+
+/**
+ * @brief ̶߳㺸
+ * @details ÿȲȽϼֽڣѡ԰ݲȡֵ͹ϣ
+ *          ٲвһſѰַCASռۣͬСĶţHyperLogLogƵΨһһοã
+ *          ǰ׺͸ΨһŲ߳޹
+ * @note ݲȡڸڶ㲻ϲȡͬ
+ */
+class VertexWelder
+{
+public:
+    /**
+     * @brief ÿһΣ
+     * @details 32λΧݲԲڡfloatʽʱ׳쳣
+     */
+    static VertexWeldResult Weld(const VertexDataView& vertices, const VertexWeldOptions& options = {});
+
+    /**
+     * @brief RemapдûõĶ
+     */
+    static VertexWeldResult Weld(const VertexDataView& vertices, const uint32_t* indices, size_t indexCount,
+        const VertexWeldOptions& options = {});
+
+private:
+    VertexWelder() = delete;  // ̬
+};
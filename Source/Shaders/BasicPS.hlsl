@@ -10,5 +10,10 @@ struct VertexOut
 
 float4 PS(VertexOut pin) : SV_Target
 {
+#ifdef SELECTED
+    //ѡеɫƫһ㣨༭BasicPSSELECTED廭
+    return float4(lerp(pin.Color.rgb, float3(1.0f, 0.6f, 0.1f), 0.4f), pin.Color.a);
+#else
     return pin.Color;
+#endif
 }
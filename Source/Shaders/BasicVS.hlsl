@@ -22,13 +22,13 @@ cbuffer ObjectConstants : register(b1)
 //shuru
 struct VertexIn
 {
-    float3 PosL : POSITIONT;//ֲֲֲ
+    float3 PosL : POSITION;//ֲֲֲ
     float4 Color : COLOR;
 };
 
 struct VertexOut
 {
-    float PosH : SV_POSITION;
+    float4 PosH : SV_POSITION;
     float4 Color : COLOR;
 };
 
@@ -0,0 +1,36 @@
+#include "Timer/Clock.h"
+#include <chrono>
+#include <stdexcept>
+
+static_assert(std::chrono::steady_clock::period::num == 1 &&
+	std::chrono::steady_clock::period::den == SteadyClock::kFrequency, "steady_clockľȲ");
+
+
+int64_t SteadyClock::Now()
+{
+	return static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+
+SteadyClock& SteadyClock::Get()
+{
+	static SteadyClock clock;
+	return clock;
+}
+
+
+ManualClock::ManualClock(int64_t frequency, int64_t startCount)
+	: m_frequency(frequency)
+	, m_count(startCount)
+{
+	if (frequency <= 0)
+	{
+		throw std::invalid_argument("ManualClockƵʱ0");
+	}
+}
+
+
+void ManualClock::AdvanceSeconds(double seconds)
+{
+	m_count += static_cast<int64_t>(seconds * static_cast<double>(m_frequency));
+}
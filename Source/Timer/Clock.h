@@ -0,0 +1,52 @@
+#pragma once
+//ʱӺˣPerformanceTimerGameTimerͨȡֱֵwindows.h
+//ĬSteadyClockstd::chrono::steady_clockMSVCQueryPerformanceCounterLinuxclock_gettime(CLOCK_MONOTONIC)
+//ʱManualClockʱȫɵƽȷ
+#include <cstdint>
+
+class IClock
+{
+public:
+	virtual ~IClock() = default;
+
+	//ǰֵ
+	virtual int64_t GetCount() const = 0;
+
+	//ÿٸ
+	virtual int64_t GetFrequency() const = 0;
+};
+
+
+class SteadyClock final : public IClock
+{
+public:
+	//steady_clockļλ루MSVClibstdc++ǣ
+	static constexpr int64_t kFrequency = 1000000000;
+
+	int64_t GetCount() const override { return Now(); }
+	int64_t GetFrequency() const override { return kFrequency; }
+
+	//麯İ汾·ֱ
+	static int64_t Now();
+
+	//ȫʵ
+	static SteadyClock& Get();
+};
+
+
+class ManualClock final : public IClock
+{
+public:
+	explicit ManualClock(int64_t frequency = SteadyClock::kFrequency, int64_t startCount = 0);
+
+	int64_t GetCount() const override { return m_count; }
+	int64_t GetFrequency() const override { return m_frequency; }
+
+	void SetCount(int64_t count) { m_count = count; }
+	void Advance(int64_t counts) { m_count += counts; }
+	void AdvanceSeconds(double seconds);
+
+private:
+	int64_t m_frequency;
+	int64_t m_count;
+};
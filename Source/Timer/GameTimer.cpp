@@ -2,14 +2,20 @@
 
 
 GameTimer::GameTimer()
+	: GameTimer(PerformanceTimer::GetClock())
 {
 	PerformanceTimer::Initialize();
-	m_secondsPerCount = PerformanceTimer::GetSecondsPerCount();
+}
+
+GameTimer::GameTimer(const IClock& clock)
+	: m_clock(&clock)
+	, m_secondsPerCount(1.0 / static_cast<double>(clock.GetFrequency()))
+{
 }
 
 void GameTimer::Reset()
 {
-	m_baseCounts = PerformanceTimer::GetCount();
+	m_baseCounts = m_clock->GetCount();
 	m_prevCounts = m_baseCounts;
 	m_currCounts = m_baseCounts;
 	m_stopCounts = 0;
@@ -20,7 +26,7 @@ void GameTimer::Reset()
 
 void GameTimer::Start()
 {
-	_int64 startCounts = PerformanceTimer::GetCount();
+	int64_t startCounts = m_clock->GetCount();
 
 	if (m_isStopped)
 	{
@@ -37,7 +43,7 @@ void GameTimer::Stop()
 {
 	if (!m_isStopped)
 	{
-		m_stopCounts = PerformanceTimer::GetCount();
+		m_stopCounts = m_clock->GetCount();
 		m_isStopped = true;
 	}
 }
@@ -46,7 +52,7 @@ void GameTimer::Pause()
 {
 	if (!m_isPaused && !m_isStopped)
 	{
-		m_stopCounts = PerformanceTimer::GetCount();
+		m_stopCounts = m_clock->GetCount();
 		m_isPaused = true;
 	}
 }
@@ -55,7 +61,7 @@ void GameTimer::Resume()
 {
 	if (m_isPaused && !m_isStopped)
 	{
-		_int64 currentCounts = PerformanceTimer::GetCount();
+		int64_t currentCounts = m_clock->GetCount();
 
 		m_pausedCounts += (currentCounts - m_stopCounts);
 		m_prevCounts = currentCounts;
@@ -70,34 +76,38 @@ void GameTimer::Tick()
 	if (m_isStopped || m_isPaused)
 	{
 		m_deltaCounts = 0;
+		m_deltaSeconds = 0.0f;
 		return;
 	}
 
-	m_currCounts = PerformanceTimer::GetCount();
-	m_deltaCounts = PerformanceTimer::GetDeltaCount(m_prevCounts, m_currCounts);
+	m_currCounts = m_clock->GetCount();
+	m_deltaCounts = m_currCounts - m_prevCounts;
 
 	m_prevCounts = m_currCounts;
 
 	if (m_deltaCounts < 0) m_deltaCounts = 0;
+
+	//ÿֻ֡ﻻһ
+	m_deltaSeconds = static_cast<float>(CountsToSeconds(m_deltaCounts));
 }
 
 float GameTimer::TotalTimeSeconds() const
 {
-	_int64 totalCounts = TotalTimeCounts();
-	return static_cast<float>(PerformanceTimer::CountsToSeconds(totalCounts));
+	int64_t totalCounts = TotalTimeCounts();
+	return static_cast<float>(CountsToSeconds(totalCounts));
 }
 
 float GameTimer::DeltaTimeSeconds() const
 {
-	return static_cast<float>(PerformanceTimer::CountsToSeconds(m_deltaCounts));
+	return m_deltaSeconds;
 }
 float GameTimer::DeltaTime() const
 {
-	return static_cast<float>(PerformanceTimer::CountsToSeconds(m_deltaCounts));
+	return m_deltaSeconds;
 }
 
 
-_int64 GameTimer::TotalTimeCounts() const
+int64_t GameTimer::TotalTimeCounts() const
 {
 	if (m_isStopped)
 	{
@@ -112,24 +122,24 @@ _int64 GameTimer::TotalTimeCounts() const
 	return m_currCounts - m_baseCounts - m_pausedCounts;
 }
 
-_int64 GameTimer::DeltaTimeCounts() const
+int64_t GameTimer::DeltaTimeCounts() const
 {
 	return m_deltaCounts;
 }
 
 float GameTimer::GetBaseTime() const
 {
-	return static_cast<float>(PerformanceTimer::CountsToSeconds(m_baseCounts));
+	return static_cast<float>(CountsToSeconds(m_baseCounts));
 }
 
 float GameTimer::GetCurrentTime() const
 {
-	return static_cast<float>(PerformanceTimer::CountsToSeconds(m_currCounts));
+	return static_cast<float>(CountsToSeconds(m_currCounts));
 }
 
 float GameTimer::GetPausedTime() const
 {
-	return static_cast<float>(PerformanceTimer::CountsToSeconds(m_pausedCounts));
+	return static_cast<float>(CountsToSeconds(m_pausedCounts));
 }
 
 
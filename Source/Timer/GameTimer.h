@@ -1,11 +1,19 @@
 #pragma once
-#include <windows.h>
+#include <cstdint>
 #include "Timer/PerformanceTimer.h"
+#include "Timer/Clock.h"
+#ifdef _WIN32
+//windows.hGetCurrentTimeдͬԱҲһ£֤а߿ͬһ
+#include <windows.h>
+#endif
 
 class GameTimer
 {
 public:
+	//PerformanceTimerǰʱ
 	GameTimer();
+	//ָʱӣﴫManualClockʱӵҪGameTimer
+	explicit GameTimer(const IClock& clock);
 	~GameTimer()=default;
 
 	//ǵýÿ
@@ -18,8 +26,8 @@ public:
 	float DeltaTime() const;
 
 	//һ¼ֵ汾
-	_int64 TotalTimeCounts() const;
-	_int64 DeltaTimeCounts() const;
+	int64_t TotalTimeCounts() const;
+	int64_t DeltaTimeCounts() const;
 
 	
 		 
@@ -43,21 +51,25 @@ public:
 	float GetCurrentTime() const;
 	float GetPausedTime() const;
 
-	_int64 GetBaseTimeCounts() const { return m_baseCounts; }
-	_int64 GetCurrentTimeCounts() const { return m_currCounts; }
-	_int64 GetPausedTimeCounts() const { return m_pausedCounts; }
+	int64_t GetBaseTimeCounts() const { return m_baseCounts; }
+	int64_t GetCurrentTimeCounts() const { return m_currCounts; }
+	int64_t GetPausedTimeCounts() const { return m_pausedCounts; }
 
 
 private:
+	double CountsToSeconds(int64_t counts) const { return static_cast<double>(counts) * m_secondsPerCount; }
+
+	const IClock* m_clock = nullptr;
 	double m_secondsPerCount = 0.0;
 
-	_int64 m_deltaCounts = -1;
+	int64_t m_deltaCounts = -1;
+	float m_deltaSeconds = 0.0f;   //TickʱãDeltaTime()ÿ֡ദòٻ
 
-	_int64 m_baseCounts = 0;
-	_int64 m_pausedCounts = 0;
-	_int64 m_stopCounts = 0;
-	_int64 m_prevCounts = 0;
-	_int64 m_currCounts = 0;
+	int64_t m_baseCounts = 0;
+	int64_t m_pausedCounts = 0;
+	int64_t m_stopCounts = 0;
+	int64_t m_prevCounts = 0;
+	int64_t m_currCounts = 0;
 
 	bool m_isPaused = false;
 	bool m_isStopped = false;
@@ -7,13 +7,21 @@
 QueryPerformanceFrequencyǻȡʱƵʣҲÿٴ
 QueryPerformanceCounterǻȡǰļֵ
 
+ڼֵIClockȡĬϵSteadyClockWindowsϵ»API
+Linuxclock_gettimeλ룻ʱSetClockManualClock
 */
 
 
 namespace PerformanceTimer {
 
 	static double s_secondsPerCount = 0.0;
-	static _int64 s_frequency = 0;
+	static int64_t s_frequency = 0;
+	static IClock* s_clock = nullptr;    //nullptrʾĬϵSteadyClock̬ʼ˳
+
+	static IClock& CurrentClock()
+	{
+		return s_clock ? *s_clock : SteadyClock::Get();
+	}
 
 	//ǻܣصʱdouble
 
@@ -27,20 +35,30 @@ namespace PerformanceTimer {
 		}
 
 
-		LARGE_INTEGER countsPerSec;
-		QueryPerformanceFrequency(&countsPerSec);
-		s_frequency = countsPerSec.QuadPart;
-		s_secondsPerCount = 1.0 / static_cast<double>(countsPerSec.QuadPart);
+		s_frequency = CurrentClock().GetFrequency();
+		s_secondsPerCount = 1.0 / static_cast<double>(s_frequency);
 
 		initialized = true;
 	}
 
 
+	void SetClock(IClock* clock)
+	{
+		s_clock = clock;
+		s_frequency = CurrentClock().GetFrequency();
+		s_secondsPerCount = 1.0 / static_cast<double>(s_frequency);
+	}
+
+
+	IClock& GetClock()
+	{
+		return CurrentClock();
+	}
+
+
 	double GetTime()
 	{
-		LARGE_INTEGER currentTime;
-		QueryPerformanceCounter(&currentTime);
-		return static_cast<double>(currentTime.QuadPart)*s_secondsPerCount;
+		return static_cast<double>(CurrentClock().GetCount())*s_secondsPerCount;
 	}
 
 
@@ -63,31 +81,29 @@ namespace PerformanceTimer {
 
 
 
-	_int64 GetCount()
+	int64_t GetCount()
 	{
-		LARGE_INTEGER currentTime;
-		QueryPerformanceCounter(&currentTime);
-		return currentTime.QuadPart;
+		return CurrentClock().GetCount();
 	}
 
 
 
-	_int64 GetDeltaCount(_int64 lastCount, _int64 currCount)
+	int64_t GetDeltaCount(int64_t lastCount, int64_t currCount)
 	{
 		return currCount - lastCount;
 	}
 
-	double CountsToSeconds(_int64 counts)
+	double CountsToSeconds(int64_t counts)
 	{
 		return static_cast<double>(counts) * s_secondsPerCount;
 	}
 
-	_int64 SecondsToCounts(double seconds)
+	int64_t SecondsToCounts(double seconds)
 	{
-		return static_cast<_int64>(seconds / s_secondsPerCount);
+		return static_cast<int64_t>(seconds / s_secondsPerCount);
 	}
 
-	_int64 GetFrequencyCounts()
+	int64_t GetFrequencyCounts()
 	{
 		return s_frequency;
 	}
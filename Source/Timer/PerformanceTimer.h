@@ -1,12 +1,20 @@
 #pragma once
 //ܼʱϾһ㣬дߺͲд
-#include <windows.h>
+#include <cstdint>
+#include "Timer/Clock.h"
 
 namespace PerformanceTimer
 {
 	//ʼֻгʱ
 	void Initialize();
 
+	//ʱӺˣﻻManualClocknullptrָĬϵSteadyClock
+	//ֻ׶λã̰߳ȫ
+	void SetClock(IClock* clock);
+
+	//ǰʹõʱ
+	IClock& GetClock();
+
 	//ȡǰʱ
 	double GetTime();
 
@@ -20,16 +28,17 @@ namespace PerformanceTimer
 
 
 	//ΪGameTimerչ
-	_int64 GetCount();
-	_int64 GetDeltaCount(_int64 lastCount, _int64 currCount);
+	int64_t GetCount();
+	int64_t GetDeltaCount(int64_t lastCount, int64_t currCount);
 
 
 	//ת
-	double CountsToSeconds(_int64 counts);
+	double CountsToSeconds(int64_t counts);
 
-	_int64 SecondsToCounts(double seconds);
+	int64_t SecondsToCounts(double seconds);
 
-	_int64 GetFrequencyCounts(double seconds);
+	//ÿٸ
+	int64_t GetFrequencyCounts();
 
 	// ȡתϵ
 	double GetSecondsPerCount();
@@ -0,0 +1,415 @@
+#include "Timer/Profiler.h"
+#include "Timer/Clock.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <utility>
+
+/*
+¼һ·Ľṹ
+ÿ̵߳һμ¼ʱһThreadBufferλ壩ֻ֮߳д
+дλreleaseд̲
+EndFrame߳acquireдϴζλ֮ļ¼
+߿ڿͬʱϵĲλԿٶһдǵǲ㶪
+λֶζrelaxedԭӱx64Ͼͨmovݾ
+߳˳ʱΪУ֮½̸߳ãûļ¼ᱻռ
+*/
+
+namespace Profiler {
+
+	static constexpr size_t kRingCapacity = 8192;                 //ÿ̵߳ĻλС2ݣ
+	static constexpr size_t kMaxCapturedEvents = 4 * 1024 * 1024; //¼ޣֹֹͣڴԹ
+
+	static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "λС2");
+
+	struct Slot
+	{
+		std::atomic<const char*> Name{ nullptr };
+		std::atomic<uint64_t> StartNs{ 0 };
+		std::atomic<uint64_t> EndNs{ 0 };
+		std::atomic<uint32_t> ThreadId{ 0 };
+		std::atomic<uint32_t> Depth{ 0 };
+	};
+
+	struct ThreadBuffer
+	{
+		std::array<Slot, kRingCapacity> Slots;
+		std::atomic<uint64_t> WriteIndex{ 0 };  //д߶
+		uint64_t ReadIndex = 0;                 //ֻߣs_mutex
+		std::atomic<bool> InUse{ false };
+	};
+
+	//߲ȫ״̬s_mutex
+	static std::mutex s_mutex;
+	static std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+	static std::map<uint32_t, std::string> s_threadNames;
+	static uint32_t s_nextThreadId = 1;
+
+	static std::vector<ZoneEvent> s_frameEvents;     //EndFrameõʱ飬ñÿ֡
+	static std::vector<ZoneEvent> s_capturedEvents;
+	static bool s_capturing = false;
+	static uint64_t s_capturedDropped = 0;
+
+	static FrameStats s_lastFrame;
+	static uint64_t s_frameIndex = 0;
+	static uint64_t s_lastFrameEndNs = 0;
+
+
+	//߳˳ʱ黹
+	struct ThreadContext
+	{
+		ThreadBuffer* Buffer = nullptr;
+		uint32_t ThreadId = 0;
+		uint32_t Depth = 0;
+
+		~ThreadContext()
+		{
+			if (Buffer)
+			{
+				Buffer->InUse.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+	static thread_local ThreadContext t_context;
+
+
+	//һ壬̵ֻ߳һμ¼ʱߵ
+	static ThreadContext& AcquireContext()
+	{
+		ThreadContext& context = t_context;
+		if (context.Buffer)
+		{
+			return context;
+		}
+
+		std::lock_guard<std::mutex> lock(s_mutex);
+		for (auto& buffer : s_buffers)
+		{
+			if (!buffer->InUse.load(std::memory_order_acquire))
+			{
+				context.Buffer = buffer.get();
+				break;
+			}
+		}
+		if (!context.Buffer)
+		{
+			s_buffers.push_back(std::make_unique<ThreadBuffer>());
+			context.Buffer = s_buffers.back().get();
+		}
+		context.Buffer->InUse.store(true, std::memory_order_relaxed);
+		context.ThreadId = s_nextThreadId++;
+		return context;
+	}
+
+
+	uint64_t GetTimestampNs()
+	{
+		static_assert(SteadyClock::kFrequency == 1000000000, "ʱ¼");
+		static const int64_t s_base = SteadyClock::Now();
+		return static_cast<uint64_t>(SteadyClock::Now() - s_base);
+	}
+
+
+	void SetThreadName(const char* name)
+	{
+		ThreadContext& context = AcquireContext();
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_threadNames[context.ThreadId] = name ? name : "";
+	}
+
+
+	void RecordZone(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth)
+	{
+		ThreadContext& context = AcquireContext();
+		ThreadBuffer& buffer = *context.Buffer;
+
+		const uint64_t writeIndex = buffer.WriteIndex.load(std::memory_order_relaxed);
+		//Ǳߵacquireդԣ߶дĲλʱһҲܿһεд
+		std::atomic_thread_fence(std::memory_order_release);
+		Slot& slot = buffer.Slots[writeIndex & (kRingCapacity - 1)];
+		slot.Name.store(name, std::memory_order_relaxed);
+		slot.StartNs.store(startNs, std::memory_order_relaxed);
+		slot.EndNs.store(endNs, std::memory_order_relaxed);
+		slot.ThreadId.store(context.ThreadId, std::memory_order_relaxed);
+		slot.Depth.store(depth, std::memory_order_relaxed);
+		buffer.WriteIndex.store(writeIndex + 1, std::memory_order_release);
+	}
+
+
+	//һļ¼outضs_mutexѳУ
+	static uint64_t DrainBuffer(ThreadBuffer& buffer, std::vector<ZoneEvent>& out)
+	{
+		uint64_t dropped = 0;
+		const uint64_t writeIndex = buffer.WriteIndex.load(std::memory_order_acquire);
+		uint64_t readIndex = buffer.ReadIndex;
+		if (writeIndex - readIndex > kRingCapacity)
+		{
+			dropped += writeIndex - readIndex - kRingCapacity;
+			readIndex = writeIndex - kRingCapacity;
+		}
+
+		const size_t first = out.size();
+		for (uint64_t i = readIndex; i < writeIndex; ++i)
+		{
+			const Slot& slot = buffer.Slots[i & (kRingCapacity - 1)];
+			ZoneEvent event;
+			event.Name = slot.Name.load(std::memory_order_relaxed);
+			event.StartNs = slot.StartNs.load(std::memory_order_relaxed);
+			event.EndNs = slot.EndNs.load(std::memory_order_relaxed);
+			event.ThreadId = slot.ThreadId.load(std::memory_order_relaxed);
+			event.Depth = slot.Depth.load(std::memory_order_relaxed);
+			out.push_back(event);
+		}
+
+		//ڼ䱻߸ǣڸǣĲλݲţ
+		//дΪwʱ߿дwһҲǲλw-kRingCapacity
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t writeAfter = buffer.WriteIndex.load(std::memory_order_relaxed);
+		if (writeAfter + 1 - readIndex > kRingCapacity)
+		{
+			const uint64_t overwritten = std::min<uint64_t>(writeAfter + 1 - readIndex - kRingCapacity, writeIndex - readIndex);
+			out.erase(out.begin() + first, out.begin() + first + static_cast<size_t>(overwritten));
+			dropped += overwritten;
+		}
+
+		buffer.ReadIndex = writeIndex;
+		return dropped;
+	}
+
+
+	//߳ؽǶ׹ϵÿʱ䣬ֺٰȻ
+	static void Aggregate(std::vector<ZoneEvent>& events, std::vector<ZoneStats>& zones)
+	{
+		std::sort(events.begin(), events.end(), [](const ZoneEvent& a, const ZoneEvent& b)
+			{
+				if (a.ThreadId != b.ThreadId) return a.ThreadId < b.ThreadId;
+				if (a.StartNs != b.StartNs) return a.StartNs < b.StartNs;
+				return a.Depth < b.Depth;
+			});
+
+		std::vector<uint64_t> childNs(events.size(), 0);
+		std::vector<size_t> stack;
+		for (size_t i = 0; i < events.size(); ++i)
+		{
+			const ZoneEvent& event = events[i];
+			if (i > 0 && events[i - 1].ThreadId != event.ThreadId)
+			{
+				stack.clear();
+			}
+			while (!stack.empty() && events[stack.back()].Depth >= event.Depth)
+			{
+				stack.pop_back();
+			}
+			//ܻûһ֡ʱûпɿ۳Ķ
+			if (!stack.empty() && events[stack.back()].Depth + 1 == event.Depth)
+			{
+				childNs[stack.back()] += event.EndNs - event.StartNs;
+			}
+			stack.push_back(i);
+		}
+
+		//ְݱȽϣͬ뵥Ԫַͬܲͬ
+		std::map<std::pair<std::string_view, uint32_t>, size_t> lookup;
+		zones.clear();
+		for (size_t i = 0; i < events.size(); ++i)
+		{
+			const ZoneEvent& event = events[i];
+			const std::string_view name = event.Name ? std::string_view(event.Name) : std::string_view();
+			auto [it, inserted] = lookup.try_emplace({ name, event.Depth }, zones.size());
+			if (inserted)
+			{
+				ZoneStats stats;
+				stats.Name = event.Name;
+				stats.Depth = event.Depth;
+				zones.push_back(stats);
+			}
+
+			const uint64_t totalNs = event.EndNs - event.StartNs;
+			const uint64_t selfNs = totalNs > childNs[i] ? totalNs - childNs[i] : 0;
+			ZoneStats& stats = zones[it->second];
+			++stats.CallCount;
+			stats.TotalMs += static_cast<double>(totalNs) * 1e-6;
+			stats.SelfMs += static_cast<double>(selfNs) * 1e-6;
+		}
+
+		std::sort(zones.begin(), zones.end(), [](const ZoneStats& a, const ZoneStats& b)
+			{
+				return a.TotalMs > b.TotalMs;
+			});
+	}
+
+
+	void EndFrame()
+	{
+		const uint64_t nowNs = GetTimestampNs();
+
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_frameEvents.clear();
+		uint64_t dropped = 0;
+		for (auto& buffer : s_buffers)
+		{
+			dropped += DrainBuffer(*buffer, s_frameEvents);
+		}
+
+		if (s_capturing)
+		{
+			const size_t room = kMaxCapturedEvents - std::min(kMaxCapturedEvents, s_capturedEvents.size());
+			const size_t count = std::min(room, s_frameEvents.size());
+			s_capturedEvents.insert(s_capturedEvents.end(), s_frameEvents.begin(), s_frameEvents.begin() + count);
+			s_capturedDropped += dropped + (s_frameEvents.size() - count);
+		}
+
+		s_lastFrame.FrameIndex = s_frameIndex++;
+		s_lastFrame.FrameMs = static_cast<double>(nowNs - s_lastFrameEndNs) * 1e-6;
+		s_lastFrame.DroppedEvents = dropped;
+		Aggregate(s_frameEvents, s_lastFrame.Zones);
+		s_lastFrameEndNs = nowNs;
+	}
+
+
+	const FrameStats& GetLastFrameStats()
+	{
+		return s_lastFrame;
+	}
+
+
+	void StartCapture()
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_capturedEvents.clear();
+		s_capturedDropped = 0;
+		s_capturing = true;
+	}
+
+
+	void StopCapture()
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_capturing = false;
+	}
+
+
+	bool IsCapturing()
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		return s_capturing;
+	}
+
+
+	size_t GetCapturedEventCount()
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		return s_capturedEvents.size();
+	}
+
+
+	//JSONַת
+	static void WriteJsonString(std::ostream& stream, std::string_view text)
+	{
+		stream << '"';
+		for (char c : text)
+		{
+			switch (c)
+			{
+			case '"': stream << "\\\""; break;
+			case '\\': stream << "\\\\"; break;
+			case '\n': stream << "\\n"; break;
+			case '\r': stream << "\\r"; break;
+			case '\t': stream << "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					char escaped[8];
+					std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+					stream << escaped;
+				}
+				else
+				{
+					stream << c;
+				}
+				break;
+			}
+		}
+		stream << '"';
+	}
+
+
+	//תtraceõ΢룬뾫
+	static void WriteMicroseconds(std::ostream& stream, uint64_t ns)
+	{
+		char text[32];
+		std::snprintf(text, sizeof(text), "%llu.%03u",
+			static_cast<unsigned long long>(ns / 1000), static_cast<unsigned>(ns % 1000));
+		stream << text;
+	}
+
+
+	bool WriteChromeTrace(std::ostream& stream)
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+
+		stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool first = true;
+		for (const auto& [threadId, name] : s_threadNames)
+		{
+			stream << (first ? "\n" : ",\n");
+			first = false;
+			stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId << ",\"args\":{\"name\":";
+			WriteJsonString(stream, name);
+			stream << "}}";
+		}
+
+		for (const ZoneEvent& event : s_capturedEvents)
+		{
+			stream << (first ? "\n" : ",\n");
+			first = false;
+			stream << "{\"name\":";
+			WriteJsonString(stream, event.Name ? event.Name : "");
+			stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.ThreadId << ",\"ts\":";
+			WriteMicroseconds(stream, event.StartNs);
+			stream << ",\"dur\":";
+			WriteMicroseconds(stream, event.EndNs - event.StartNs);
+			stream << ",\"args\":{\"depth\":" << event.Depth << "}}";
+		}
+
+		stream << "\n],\"otherData\":{\"droppedEvents\":" << s_capturedDropped << "}}\n";
+		return static_cast<bool>(stream);
+	}
+
+
+	bool WriteChromeTrace(const std::string& path)
+	{
+		std::ofstream file(path, std::ios::out | std::ios::trunc);
+		if (!file)
+		{
+			return false;
+		}
+		return WriteChromeTrace(static_cast<std::ostream&>(file));
+	}
+
+
+	ScopedZone::ScopedZone(const char* name)
+		: m_name(name)
+		, m_startNs(0)
+		, m_depth(AcquireContext().Depth++)
+	{
+		m_startNs = GetTimestampNs();
+	}
+
+
+	ScopedZone::~ScopedZone()
+	{
+		const uint64_t endNs = GetTimestampNs();
+		--t_context.Depth;
+		RecordZone(m_name, m_startNs, endNs, m_depth);
+	}
+
+}
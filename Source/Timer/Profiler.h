@@ -0,0 +1,102 @@
+#pragma once
+//CPUֲ֡KJ_PROFILE_SCOPE("")ʱ¼һ䣬
+//ÿ߳дԼĻλ壨ߣ߳ÿ֡KJ_PROFILE_FRAME()ռܣ
+//¼һεChrome tracechrome://tracing  ui.perfetto.dev 򿪣
+//KJ_PROFILE_ENABLEDΪ0ʱչΪգ׮ȫ
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#ifndef KJ_PROFILE_ENABLED
+#define KJ_PROFILE_ENABLED 1
+#endif
+
+namespace Profiler
+{
+	//һ¼
+	struct ZoneEvent
+	{
+		const char* Name = nullptr;   //Ǿ̬ڵַ
+		uint64_t StartNs = 0;
+		uint64_t EndNs = 0;
+		uint32_t ThreadId = 0;
+		uint32_t Depth = 0;           //Ƕȣ0Ϊ
+	};
+
+	//һ֡ͬͬĻ
+	struct ZoneStats
+	{
+		const char* Name = nullptr;
+		uint32_t Depth = 0;
+		uint32_t CallCount = 0;
+		double TotalMs = 0.0;
+		double SelfMs = 0.0;          //ȥֱʱ
+	};
+
+	struct FrameStats
+	{
+		uint64_t FrameIndex = 0;
+		double FrameMs = 0.0;
+		uint64_t DroppedEvents = 0;   //λ屻Ƕļ¼
+		std::vector<ZoneStats> Zones; //ʱӴС
+	};
+
+
+	//ǰʱ䣨룬ӵһεÿʼƣ
+	uint64_t GetTimestampNs();
+
+	//ǰ֣߳traceʱʾ
+	void SetThreadName(const char* name);
+
+	//¼һ䣨һͨScopedZoneʹã
+	void RecordZone(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth);
+
+	//֡ռ̵߳ļ¼ܳһ֡ͳƣֻһ̣̣߳߳
+	void EndFrame();
+
+	//һ֡ͳƣEndFrameͬһ߳ʹã
+	const FrameStats& GetLastFrameStats();
+
+
+	//¼ƣʼÿ֡ռļ¼ֱStopCapture
+	void StartCapture();
+	void StopCapture();
+	bool IsCapturing();
+	size_t GetCapturedEventCount();
+
+	//¼ļ¼дChrome trace JSON
+	bool WriteChromeTrace(std::ostream& stream);
+	bool WriteChromeTrace(const std::string& path);
+
+
+	//RAII
+	class ScopedZone
+	{
+	public:
+		explicit ScopedZone(const char* name);
+		~ScopedZone();
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+
+	private:
+		const char* m_name;
+		uint64_t m_startNs;
+		uint32_t m_depth;
+	};
+}
+
+
+#define KJ_PROFILE_CONCAT_INNER(a, b) a##b
+#define KJ_PROFILE_CONCAT(a, b) KJ_PROFILE_CONCAT_INNER(a, b)
+
+#if KJ_PROFILE_ENABLED
+#define KJ_PROFILE_SCOPE(name) ::Profiler::ScopedZone KJ_PROFILE_CONCAT(kjProfileZone, __LINE__)(name)
+#define KJ_PROFILE_FRAME() ::Profiler::EndFrame()
+#define KJ_PROFILE_THREAD(name) ::Profiler::SetThreadName(name)
+#else
+#define KJ_PROFILE_SCOPE(name) ((void)0)
+#define KJ_PROFILE_FRAME() ((void)0)
+#define KJ_PROFILE_THREAD(name) ((void)0)
+#endif